@@ -64,6 +64,12 @@ std::ostream &operator<<(std::ostream &os, MetaServerOpType optype) {
     case MetaServerOpType::GetOrModifyS3ChunkInfo:
         os << "GetOrModifyS3ChunkInfo";
         break;
+    case MetaServerOpType::BatchUpdateInode:
+        os << "BatchUpdateInode";
+        break;
+    case MetaServerOpType::CreateInodeAndDentry:
+        os << "CreateInodeAndDentry";
+        break;
     default:
         os << "Unknow opType";
     }
@@ -89,6 +89,10 @@ void InitExcutorOption(Configuration *conf, ExcutorOpt *opts) {
     conf->GetValueFatalIfFail("excutorOpt.maxRetryTimesBeforeConsiderSuspend",
                               &opts->maxRetryTimesBeforeConsiderSuspend);
     conf->GetValueFatalIfFail("excutorOpt.batchLimit", &opts->batchLimit);
+    conf->GetValueFatalIfFail("excutorOpt.batchUpdateLimit",
+                              &opts->batchUpdateLimit);
+    conf->GetValueFatalIfFail("excutorOpt.batchUpdateMaxBytes",
+                              &opts->batchUpdateMaxBytes);
     conf->GetValueFatalIfFail("fuseClient.enableMultiMountPointRename",
                               &opts->enableRenameParallel);
 }
@@ -134,6 +138,22 @@ void InitDiskCacheOption(Configuration *conf,
                               &diskCacheOption->avgReadFileBytes);
     conf->GetValueFatalIfFail("diskCache.avgReadFileIops",
                               &diskCacheOption->avgReadFileIops);
+    LOG_IF(WARNING, !conf->GetUInt64Value("diskCache.packMaxObjSize",
+                                          &diskCacheOption->packMaxObjSize))
+        << "Not found `diskCache.packMaxObjSize` in conf, use default value `"
+        << diskCacheOption->packMaxObjSize << '`';
+    LOG_IF(WARNING, !conf->GetUInt64Value("diskCache.packSize",
+                                          &diskCacheOption->packSize))
+        << "Not found `diskCache.packSize` in conf, use default value `"
+        << diskCacheOption->packSize << '`';
+    LOG_IF(WARNING, !conf->GetUInt64Value("diskCache.packLingerMs",
+                                          &diskCacheOption->packLingerMs))
+        << "Not found `diskCache.packLingerMs` in conf, use default value `"
+        << diskCacheOption->packLingerMs << '`';
+    LOG_IF(WARNING, !conf->GetBoolValue("diskCache.directIO",
+                                        &diskCacheOption->directIO))
+        << "Not found `diskCache.directIO` in conf, use default value `"
+        << diskCacheOption->directIO << '`';
 }
 
 void InitS3Option(Configuration *conf, S3Option *s3Opt) {
@@ -155,6 +175,11 @@ void InitS3Option(Configuration *conf, S3Option *s3Opt) {
                               &s3Opt->s3ClientAdaptorOpt.writeCacheMaxByte);
     conf->GetValueFatalIfFail("s3.readCacheMaxByte",
                               &s3Opt->s3ClientAdaptorOpt.readCacheMaxByte);
+    LOG_IF(WARNING, !conf->GetBoolValue(
+                        "s3.readCacheAdmission",
+                        &s3Opt->s3ClientAdaptorOpt.readCacheAdmission))
+        << "Not found `s3.readCacheAdmission` in conf, use default value `"
+        << s3Opt->s3ClientAdaptorOpt.readCacheAdmission << '`';
     conf->GetValueFatalIfFail("s3.nearfullRatio",
                               &s3Opt->s3ClientAdaptorOpt.nearfullRatio);
     conf->GetValueFatalIfFail("s3.baseSleepUs",
@@ -186,6 +211,17 @@ void InitVolumeOption(Configuration *conf, VolumeOption *volumeOpt) {
     } else {
         CHECK(false) << "only support bitmap allocator";
     }
+
+    auto* cacheOpt = &volumeOpt->allocatorOption.allocCacheOption;
+    LOG_IF(WARNING,
+           !conf->GetUInt32Value("volume.alloccache.shards", &cacheOpt->shards))
+        << "Not found `volume.alloccache.shards` in conf, use default value `"
+        << cacheOpt->shards << '`';
+    LOG_IF(WARNING, !conf->GetUInt64Value("volume.alloccache.refill_size",
+                                          &cacheOpt->refillSize))
+        << "Not found `volume.alloccache.refill_size` in conf, use default "
+           "value `"
+        << cacheOpt->refillSize << '`';
 }
 
 void InitExtentManagerOption(Configuration *conf,
@@ -234,6 +270,16 @@ void InitFuseClientOption(Configuration *conf, FuseClientOption *clientOption) {
                               &clientOption->iCacheLruSize);
     conf->GetValueFatalIfFail("fuseClient.dCacheLruSize",
                               &clientOption->dCacheLruSize);
+    LOG_IF(WARNING, !conf->GetUInt64Value("fuseClient.dCacheNegativeLruSize",
+                                      &clientOption->dCacheNegativeLruSize))
+        << "Not found `fuseClient.dCacheNegativeLruSize` in conf, "
+           "use default value `"
+        << clientOption->dCacheNegativeLruSize << '`';
+    LOG_IF(WARNING, !conf->GetUInt32Value("fuseClient.dCacheNegativeTimeoutMs",
+                                      &clientOption->dCacheNegativeTimeoutMs))
+        << "Not found `fuseClient.dCacheNegativeTimeoutMs` in conf, "
+           "use default value `"
+        << clientOption->dCacheNegativeTimeoutMs << '`';
     conf->GetValueFatalIfFail("fuseClient.enableICacheMetrics",
                               &clientOption->enableICacheMetrics);
     conf->GetValueFatalIfFail("fuseClient.enableDCacheMetrics",
@@ -249,6 +295,12 @@ void InitFuseClientOption(Configuration *conf, FuseClientOption *clientOption) {
         << "Not found `fuseClient.enableSplice` in conf, use default value `"
         << std::boolalpha << clientOption->enableFuseSplice << '`';
 
+    LOG_IF(WARNING, !conf->GetBoolValue("fuseClient.enableCompoundCreate",
+                                        &clientOption->enableCompoundCreate))
+        << "Not found `fuseClient.enableCompoundCreate` in conf, "
+           "use default value `"
+        << std::boolalpha << clientOption->enableCompoundCreate << '`';
+
     SetBrpcOpt(conf);
 }
 
@@ -67,6 +67,9 @@ struct ExcutorOpt {
     uint64_t minRetryTimesForceTimeoutBackoff = 5;
     uint64_t maxRetryTimesBeforeConsiderSuspend = 20;
     uint32_t batchLimit = 100;
+    // limits of one BatchUpdateInode rpc, in update count and request bytes
+    uint32_t batchUpdateLimit = 1000;
+    uint64_t batchUpdateMaxBytes = 4ull * 1024 * 1024;
     bool enableRenameParallel = false;
 };
 
@@ -113,6 +116,16 @@ struct DiskCacheOption {
     uint64_t avgFlushIops;
     // the read throttle iops of disk cache
     uint64_t avgReadFileIops;
+    // data not bigger than packMaxObjSize is appended to a pack obj shared
+    // by many inodes instead of being uploaded as its own objs, 0 to disable
+    uint64_t packMaxObjSize = 0;
+    // a pack is sealed and uploaded once it's bigger than packSize
+    uint64_t packSize = 4 * 1024 * 1024;
+    // or after it has been open for packLingerMs
+    uint64_t packLingerMs = 1000;
+    // read and write cache files with O_DIRECT, so cached data isn't kept
+    // in page cache again
+    bool directIO = false;
 };
 
 struct S3ClientAdaptorOption {
@@ -127,6 +140,9 @@ struct S3ClientAdaptorOption {
     uint32_t flushIntervalSec;
     uint64_t writeCacheMaxByte;
     uint64_t readCacheMaxByte;
+    // admit data into a full read cache only if it's accessed more
+    // frequently than the one to evict
+    bool readCacheAdmission = false;
     uint32_t nearfullRatio;
     uint32_t baseSleepUs;
     DiskCacheOption diskCacheOpt;
@@ -146,10 +162,16 @@ struct BitmapAllocatorOption {
     double smallAllocProportion;
 };
 
+struct AllocCacheOption {
+    uint32_t shards = 0;
+    uint64_t refillSize = 0;
+};
+
 struct VolumeAllocatorOption {
     std::string type;
     BitmapAllocatorOption bitmapAllocatorOption;
     BlockGroupOption blockGroupOption;
+    AllocCacheOption allocCacheOption;
 };
 
 struct VolumeOption {
@@ -182,6 +204,9 @@ struct FuseClientOption {
     uint32_t maxNameLength;
     uint64_t iCacheLruSize;
     uint64_t dCacheLruSize;
+    // cache lookups of dentries not exist, for dCacheNegativeTimeoutMs
+    uint64_t dCacheNegativeLruSize = 65536;
+    uint32_t dCacheNegativeTimeoutMs = 1000;
     bool enableICacheMetrics;
     bool enableDCacheMetrics;
 
@@ -190,6 +215,8 @@ struct FuseClientOption {
     bool enableMultiMountPointRename = false;
 
     bool enableFuseSplice = false;
+
+    bool enableCompoundCreate = false;
 };
 
 void InitFuseClientOption(Configuration *conf, FuseClientOption *clientOption);
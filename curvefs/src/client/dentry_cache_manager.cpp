@@ -27,8 +27,12 @@
 #include <vector>
 #include <utility>
 #include <unordered_map>
+#include <algorithm>
+
+#include "src/common/timeutility.h"
 
 using ::curvefs::metaserver::MetaStatusCode_Name;
+using ::curve::common::TimeUtility;
 
 namespace curvefs {
 namespace client {
@@ -44,30 +48,68 @@ namespace client {
 using curve::common::WriteLockGuard;
 using NameLockGuard = ::curve::common::GenericNameLockGuard<Mutex>;
 
+CURVEFS_ERROR DentryCacheManagerImpl::Init(uint64_t cacheSize,
+                                           bool enableCacheMetrics,
+                                           uint64_t negativeCacheSize,
+                                           uint32_t negativeTimeoutMs) {
+    if (enableCacheMetrics) {
+        dCache_ = std::make_shared<
+            LRUCache<uint64_t, Dentry>>(cacheSize,
+                std::make_shared<CacheMetrics>("dcache"));
+    } else {
+        dCache_ = std::make_shared<
+            LRUCache<uint64_t, Dentry>>(cacheSize);
+    }
+
+    if (negativeCacheSize > 0 && negativeTimeoutMs > 0) {
+        negativeTimeoutMs_ = negativeTimeoutMs;
+        if (enableCacheMetrics) {
+            negativeCache_ = std::make_shared<
+                LRUCache<uint64_t, NegativeDentry>>(negativeCacheSize,
+                    std::make_shared<CacheMetrics>("negative_dcache"));
+        } else {
+            negativeCache_ = std::make_shared<
+                LRUCache<uint64_t, NegativeDentry>>(negativeCacheSize);
+        }
+        parentVersion_ =
+            std::make_shared<LRUCache<uint64_t, uint64_t>>(negativeCacheSize);
+    }
+    return CURVEFS_ERROR::OK;
+}
+
 void DentryCacheManagerImpl::InsertOrReplaceCache(const Dentry &dentry) {
-    std::string key = GetDentryCacheKey(dentry.parentinodeid(), dentry.name());
+    std::string lockKey =
+        GetDentryCacheKey(dentry.parentinodeid(), dentry.name());
+    NameLockGuard lock(nameLock_, lockKey);
+    BumpParentVersion(dentry.parentinodeid());
     if (!curvefs::client::common::FLAGS_enableCto) {
-        NameLockGuard lock(nameLock_, key);
-        dCache_->Put(key, dentry);
+        dCache_->Put(DentryCacheKey(dentry.parentinodeid(), dentry.name()),
+                     dentry);
     }
 }
 
 void DentryCacheManagerImpl::DeleteCache(uint64_t parentId,
                                          const std::string &name) {
-    std::string key = GetDentryCacheKey(parentId, name);
-    NameLockGuard lock(nameLock_, key);
-    dCache_->Remove(key);
+    std::string lockKey = GetDentryCacheKey(parentId, name);
+    NameLockGuard lock(nameLock_, lockKey);
+    dCache_->Remove(DentryCacheKey(parentId, name));
 }
 
 CURVEFS_ERROR DentryCacheManagerImpl::GetDentry(uint64_t parent,
                                                 const std::string &name,
                                                 Dentry *out) {
-    std::string key = GetDentryCacheKey(parent, name);
-    NameLockGuard lock(nameLock_, key);
+    uint64_t key = DentryCacheKey(parent, name);
+    // concurrent lookups of the same dentry wait here, and the later ones
+    // are served by the cache filled by the first one
+    std::string lockKey = GetDentryCacheKey(parent, name);
+    NameLockGuard lock(nameLock_, lockKey);
     bool ok = dCache_->Get(key, out);
-    if (ok) {
+    if (ok && out->parentinodeid() == parent && out->name() == name) {
         return CURVEFS_ERROR::OK;
     }
+    if (IsNegativeCached(key, parent, name)) {
+        return CURVEFS_ERROR::NOTEXIST;
+    }
 
     MetaStatusCode ret = metaClient_->GetDentry(fsId_, parent, name, out);
     if (ret != MetaStatusCode::OK) {
@@ -75,6 +117,9 @@ CURVEFS_ERROR DentryCacheManagerImpl::GetDentry(uint64_t parent,
             << "metaClient_ GetDentry failed, MetaStatusCode = " << ret
             << ", MetaStatusCode_Name = " << MetaStatusCode_Name(ret)
             << ", parent = " << parent << ", name = " << name;
+        if (ret == MetaStatusCode::NOT_FOUND) {
+            AddNegativeCache(key, parent, name);
+        }
         return MetaStatusCodeToCurvefsErrCode(ret);
     }
 
@@ -84,10 +129,66 @@ CURVEFS_ERROR DentryCacheManagerImpl::GetDentry(uint64_t parent,
     return CURVEFS_ERROR::OK;
 }
 
+bool DentryCacheManagerImpl::IsNegativeCached(uint64_t key, uint64_t parent,
+                                              const std::string &name) {
+    if (negativeCache_ == nullptr) {
+        return false;
+    }
+    NegativeDentry negative;
+    if (!negativeCache_->Get(key, &negative) || negative.parent != parent ||
+        negative.name != name) {
+        return false;
+    }
+    if (TimeUtility::GetTimeofDayMs() >= negative.expireMs ||
+        negative.parentVersion != GetParentVersion(parent)) {
+        negativeCache_->Remove(key);
+        return false;
+    }
+    return true;
+}
+
+void DentryCacheManagerImpl::AddNegativeCache(uint64_t key, uint64_t parent,
+                                              const std::string &name) {
+    if (negativeCache_ == nullptr ||
+        curvefs::client::common::FLAGS_enableCto) {
+        return;
+    }
+    NegativeDentry negative;
+    negative.parent = parent;
+    negative.name = name;
+    negative.expireMs = TimeUtility::GetTimeofDayMs() + negativeTimeoutMs_;
+    negative.parentVersion = GetParentVersion(parent);
+    negativeCache_->Put(key, negative);
+}
+
+void DentryCacheManagerImpl::BumpParentVersion(uint64_t parent) {
+    if (negativeCache_ == nullptr) {
+        return;
+    }
+    std::lock_guard<Mutex> lk(versionMtx_);
+    uint64_t evicted = 0;
+    if (parentVersion_->Put(parent, ++versionSeq_, &evicted)) {
+        evictedVersion_ = std::max(evictedVersion_, evicted);
+    }
+}
+
+uint64_t DentryCacheManagerImpl::GetParentVersion(uint64_t parent) {
+    std::lock_guard<Mutex> lk(versionMtx_);
+    uint64_t version = 0;
+    if (parentVersion_->Get(parent, &version)) {
+        return version;
+    }
+    return evictedVersion_;
+}
+
 CURVEFS_ERROR DentryCacheManagerImpl::CreateDentry(const Dentry &dentry) {
-    std::string key = GetDentryCacheKey(dentry.parentinodeid(), dentry.name());
-    NameLockGuard lock(nameLock_, key);
+    std::string lockKey =
+        GetDentryCacheKey(dentry.parentinodeid(), dentry.name());
+    NameLockGuard lock(nameLock_, lockKey);
+    uint64_t key = DentryCacheKey(dentry.parentinodeid(), dentry.name());
     MetaStatusCode ret = metaClient_->CreateDentry(dentry);
+    // it may exist even if failed, e.g. created by others
+    BumpParentVersion(dentry.parentinodeid());
     if (ret != MetaStatusCode::OK) {
         LOG(ERROR) << "metaClient_ CreateDentry failed, MetaStatusCode = "
                    << ret
@@ -105,9 +206,9 @@ CURVEFS_ERROR DentryCacheManagerImpl::CreateDentry(const Dentry &dentry) {
 
 CURVEFS_ERROR DentryCacheManagerImpl::DeleteDentry(uint64_t parent,
                                                    const std::string &name) {
-    std::string key = GetDentryCacheKey(parent, name);
-    NameLockGuard lock(nameLock_, key);
-    dCache_->Remove(key);
+    std::string lockKey = GetDentryCacheKey(parent, name);
+    NameLockGuard lock(nameLock_, lockKey);
+    dCache_->Remove(DentryCacheKey(parent, name));
 
     MetaStatusCode ret = metaClient_->DeleteDentry(fsId_, parent, name);
     if (ret != MetaStatusCode::OK && ret != MetaStatusCode::NOT_FOUND) {
@@ -123,40 +224,50 @@ CURVEFS_ERROR DentryCacheManagerImpl::ListDentry(uint64_t parent,
                                                  std::list<Dentry> *dentryList,
                                                  uint32_t limit,
                                                  bool onlyDir) {
-    bool perceed = true;
-    MetaStatusCode ret = MetaStatusCode::OK;
     dentryList->clear();
     std::string last = "";
-    do {
+    bool finished = false;
+    while (!finished) {
         std::list<Dentry> part;
-        ret = metaClient_->ListDentry(fsId_, parent, last, limit, onlyDir,
-                                      &part);
-        VLOG(6) << "ListDentry fsId = " << fsId_ << ", parent = " << parent
-                << ", last = " << last << ", count = " << limit
-                << ", onlyDir = " << onlyDir
-                << ", ret = " << ret << ", part.size() = " << part.size();
-        if (ret != MetaStatusCode::OK) {
-            if (MetaStatusCode::NOT_FOUND == ret) {
-                return CURVEFS_ERROR::OK;
-            }
-            LOG(ERROR) << "metaClient_ ListDentry failed, MetaStatusCode = "
-                       << ret
-                       << ", MetaStatusCode_Name = " << MetaStatusCode_Name(ret)
-                       << ", parent = " << parent << ", last = " << last
-                       << ", count = " << limit << ", onlyDir = " << onlyDir;
-            return MetaStatusCodeToCurvefsErrCode(ret);
-        }
-        if (part.size() < limit) {
-            perceed = false;
+        CURVEFS_ERROR ret =
+            ListDentryPage(parent, last, limit, &part, &finished, onlyDir);
+        if (ret != CURVEFS_ERROR::OK) {
+            return ret;
         }
         if (!part.empty()) {
             last = part.back().name();
             dentryList->splice(dentryList->end(), part);
         }
-    } while (perceed);
+    }
 
     return CURVEFS_ERROR::OK;
 }
 
+CURVEFS_ERROR DentryCacheManagerImpl::ListDentryPage(uint64_t parent,
+    const std::string &last, uint32_t limit, std::list<Dentry> *dentryList,
+    bool *finished, bool onlyDir) {
+    dentryList->clear();
+    MetaStatusCode ret = metaClient_->ListDentry(fsId_, parent, last, limit,
+                                                 onlyDir, dentryList);
+    VLOG(6) << "ListDentry fsId = " << fsId_ << ", parent = " << parent
+            << ", last = " << last << ", count = " << limit
+            << ", onlyDir = " << onlyDir
+            << ", ret = " << ret << ", part.size() = " << dentryList->size();
+    if (ret != MetaStatusCode::OK) {
+        if (MetaStatusCode::NOT_FOUND == ret) {
+            *finished = true;
+            return CURVEFS_ERROR::OK;
+        }
+        LOG(ERROR) << "metaClient_ ListDentry failed, MetaStatusCode = "
+                   << ret
+                   << ", MetaStatusCode_Name = " << MetaStatusCode_Name(ret)
+                   << ", parent = " << parent << ", last = " << last
+                   << ", count = " << limit << ", onlyDir = " << onlyDir;
+        return MetaStatusCodeToCurvefsErrCode(ret);
+    }
+    *finished = dentryList->size() < limit;
+    return CURVEFS_ERROR::OK;
+}
+
 }  // namespace client
 }  // namespace curvefs
@@ -24,6 +24,7 @@
 #ifndef CURVEFS_SRC_CLIENT_DENTRY_CACHE_MANAGER_H_
 #define CURVEFS_SRC_CLIENT_DENTRY_CACHE_MANAGER_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <list>
@@ -54,7 +55,11 @@ class DentryCacheManager {
         fsId_ = fsId;
     }
 
-    virtual CURVEFS_ERROR Init(uint64_t cacheSize, bool enableCacheMetrics) = 0;
+    // lookups of dentries not exist are cached for |negativeTimeoutMs|
+    // in a cache of |negativeCacheSize|, 0 to disable
+    virtual CURVEFS_ERROR Init(uint64_t cacheSize, bool enableCacheMetrics,
+                               uint64_t negativeCacheSize = 0,
+                               uint32_t negativeTimeoutMs = 0) = 0;
 
     virtual void InsertOrReplaceCache(const Dentry& dentry) = 0;
 
@@ -72,34 +77,48 @@ class DentryCacheManager {
         std::list<Dentry> *dentryList, uint32_t limit,
         bool onlyDir = false) = 0;
 
+    // list at most |limit| dentries after |last|, |finished| is set if
+    // there are no more dentries
+    virtual CURVEFS_ERROR ListDentryPage(uint64_t parent,
+        const std::string &last, uint32_t limit,
+        std::list<Dentry> *dentryList, bool *finished,
+        bool onlyDir = false) = 0;
+
  protected:
     uint32_t fsId_;
 };
 
 static const char* kDentryKeyDelimiter = ":";
 
+// a dentry which is not exist
+struct NegativeDentry {
+    uint64_t parent;
+    std::string name;
+    uint64_t expireMs;
+    // version of parent when it's cached
+    uint64_t parentVersion;
+};
+
 class DentryCacheManagerImpl : public DentryCacheManager {
  public:
     DentryCacheManagerImpl()
       : metaClient_(std::make_shared<MetaServerClientImpl>()),
-        dCache_(nullptr) {}
+        dCache_(nullptr),
+        negativeTimeoutMs_(0),
+        versionSeq_(0),
+        evictedVersion_(0) {}
 
     explicit DentryCacheManagerImpl(
         const std::shared_ptr<MetaServerClient> &metaClient)
       : metaClient_(metaClient),
-        dCache_(nullptr) {}
-
-    CURVEFS_ERROR Init(uint64_t cacheSize, bool enableCacheMetrics) override {
-        if (enableCacheMetrics) {
-            dCache_ = std::make_shared<
-                LRUCache<std::string, Dentry>>(cacheSize,
-                    std::make_shared<CacheMetrics>("dcache"));
-        } else {
-            dCache_ = std::make_shared<
-                LRUCache<std::string, Dentry>>(cacheSize);
-        }
-        return CURVEFS_ERROR::OK;
-    }
+        dCache_(nullptr),
+        negativeTimeoutMs_(0),
+        versionSeq_(0),
+        evictedVersion_(0) {}
+
+    CURVEFS_ERROR Init(uint64_t cacheSize, bool enableCacheMetrics,
+                       uint64_t negativeCacheSize = 0,
+                       uint32_t negativeTimeoutMs = 0) override;
 
     void InsertOrReplaceCache(const Dentry& dentry) override;
 
@@ -117,15 +136,49 @@ class DentryCacheManagerImpl : public DentryCacheManager {
         std::list<Dentry> *dentryList, uint32_t limit,
         bool dirOnly = false) override;
 
+    CURVEFS_ERROR ListDentryPage(uint64_t parent,
+        const std::string &last, uint32_t limit,
+        std::list<Dentry> *dentryList, bool *finished,
+        bool onlyDir = false) override;
+
     std::string GetDentryCacheKey(uint64_t parent, const std::string &name) {
         return std::to_string(parent) + kDentryKeyDelimiter + name;
     }
 
+    // different dentries may have the same key, so the dentry got from
+    // cache must be checked
+    static uint64_t DentryCacheKey(uint64_t parent, const std::string &name) {
+        return (parent * 0x9e3779b97f4a7c15ULL) ^
+               std::hash<std::string>()(name);
+    }
+
+ private:
+    bool IsNegativeCached(uint64_t key, uint64_t parent,
+                          const std::string &name);
+
+    void AddNegativeCache(uint64_t key, uint64_t parent,
+                          const std::string &name);
+
+    // drop all negative cache of the parent
+    void BumpParentVersion(uint64_t parent);
+
+    uint64_t GetParentVersion(uint64_t parent);
+
  private:
     std::shared_ptr<MetaServerClient> metaClient_;
-    // key is parentId + name
-    std::shared_ptr<LRUCache<std::string, Dentry>> dCache_;
+    // key is DentryCacheKey(parentId, name)
+    std::shared_ptr<LRUCache<uint64_t, Dentry>> dCache_;
     curve::common::GenericNameLock<Mutex> nameLock_;
+
+    // nullptr if negative cache is disabled
+    std::shared_ptr<LRUCache<uint64_t, NegativeDentry>> negativeCache_;
+    uint32_t negativeTimeoutMs_;
+    // version of parent is bumped once a dentry is created in it,
+    // versions of parents evicted are not bigger than evictedVersion_
+    std::shared_ptr<LRUCache<uint64_t, uint64_t>> parentVersion_;
+    uint64_t versionSeq_;
+    uint64_t evictedVersion_;
+    Mutex versionMtx_;
 };
 
 }  // namespace client
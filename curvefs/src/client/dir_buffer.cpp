@@ -23,9 +23,34 @@
 
 #include "curvefs/src/client/dir_buffer.h"
 
+#include <glog/logging.h>
+
+#include <utility>
+
 namespace curvefs {
 namespace client {
 
+namespace {
+
+void *RunPrefetch(void *arg) {
+    static_cast<DirBufferHead *>(arg)->prefetchTask();
+    return nullptr;
+}
+
+}  // namespace
+
+bool DirBufferHead::StartPrefetch(std::function<void()> task) {
+    WaitPrefetch();
+    prefetchTask = std::move(task);
+    if (bthread_start_background(&prefetchTid, nullptr, RunPrefetch,
+                                 this) != 0) {
+        LOG(WARNING) << "start prefetch bthread failed";
+        prefetchTid = INVALID_BTHREAD;
+        prefetchTask = nullptr;
+        return false;
+    }
+    return true;
+}
 
 uint64_t DirBuffer::DirBufferNew() {
     uint64_t dindex = index_++;
@@ -47,23 +72,32 @@ DirBufferHead* DirBuffer::DirBufferGet(uint64_t dindex) {
 
 // TODO(xuchaojie) : these two function need to be called in right place.
 void DirBuffer::DirBufferRelease(uint64_t dindex) {
-    curve::common::WriteLockGuard wlg(bufferMtx_);
-    auto it = buffer_.find(dindex);
-    if (it != buffer_.end()) {
-        free(it->second->p);
-        delete it->second;
+    DirBufferHead *head = nullptr;
+    {
+        curve::common::WriteLockGuard wlg(bufferMtx_);
+        auto it = buffer_.find(dindex);
+        if (it == buffer_.end()) {
+            return;
+        }
+        head = it->second;
         buffer_.erase(it);
     }
+    // waiting for prefetch outside the lock, which may take a rpc round trip
+    free(head->p);
+    delete head;
 }
 
 void DirBuffer::DirBufferFreeAll() {
-    curve::common::WriteLockGuard wlg(bufferMtx_);
-    for (auto it : buffer_) {
+    std::unordered_map<uint64_t, DirBufferHead*> buffer;
+    {
+        curve::common::WriteLockGuard wlg(bufferMtx_);
+        buffer.swap(buffer_);
+        index_ = 0;
+    }
+    for (auto it : buffer) {
         free(it.second->p);
         delete it.second;
     }
-    buffer_.clear();
-    index_ = 0;
 }
 
 }  // namespace client
@@ -24,24 +24,82 @@
 #ifndef CURVEFS_SRC_CLIENT_DIR_BUFFER_H_
 #define CURVEFS_SRC_CLIENT_DIR_BUFFER_H_
 
+#include <bthread/bthread.h>
+
 #include <cstdint>
+#include <cstdlib>
+#include <functional>
 #include <unordered_map>
 #include <deque>
 #include <atomic>
+#include <list>
+#include <string>
 
+#include "curvefs/proto/metaserver.pb.h"
+#include "curvefs/src/client/error_code.h"
 #include "src/common/concurrent/concurrent.h"
 
 namespace curvefs {
 namespace client {
 
+using curvefs::metaserver::Dentry;
+
+// Directory is listed page by page, only the page being read by kernel is
+// kept in buffer, and the next page is listed in background meanwhile.
 struct DirBufferHead {
-    bool wasRead;
     size_t size;
     char *p;
+    // offset of p in the whole directory stream
+    size_t offset;
+    // name of the last dentry listed, the next page starts after it
+    std::string last;
+    // all dentries are listed
+    bool finished;
+    // the next page listed in background
+    bthread_t prefetchTid;
+    std::function<void()> prefetchTask;
+    CURVEFS_ERROR prefetchRet;
+    std::list<Dentry> prefetchDentrys;
+    bool prefetchFinished;
     DirBufferHead()
-        : wasRead(false),
-          size(0),
-          p(nullptr) {}
+        : size(0),
+          p(nullptr),
+          offset(0),
+          finished(false),
+          prefetchTid(INVALID_BTHREAD),
+          prefetchRet(CURVEFS_ERROR::OK),
+          prefetchFinished(false) {}
+
+    ~DirBufferHead() {
+        WaitPrefetch();
+    }
+
+    // run |task| in a bthread, return false if it can not be started
+    bool StartPrefetch(std::function<void()> task);
+
+    bool IsPrefetching() const {
+        return prefetchTid != INVALID_BTHREAD;
+    }
+
+    void WaitPrefetch() {
+        if (prefetchTid != INVALID_BTHREAD) {
+            bthread_join(prefetchTid, nullptr);
+            prefetchTid = INVALID_BTHREAD;
+            prefetchTask = nullptr;
+        }
+    }
+
+    // list from the beginning again, e.g. after rewinddir
+    void Reset() {
+        WaitPrefetch();
+        prefetchDentrys.clear();
+        free(p);
+        p = nullptr;
+        size = 0;
+        offset = 0;
+        last.clear();
+        finished = false;
+    }
 };
 
 // directory buffer
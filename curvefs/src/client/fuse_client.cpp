@@ -120,7 +120,9 @@ CURVEFS_ERROR FuseClient::Init(const FuseClientOption &option) {
     }
 
     ret3 =
-        dentryManager_->Init(option.dCacheLruSize, option.enableDCacheMetrics);
+        dentryManager_->Init(option.dCacheLruSize, option.enableDCacheMetrics,
+                             option.dCacheNegativeLruSize,
+                             option.dCacheNegativeTimeoutMs);
     if (ret3 != CURVEFS_ERROR::OK) {
         return ret3;
     }
@@ -345,6 +347,69 @@ CURVEFS_ERROR FuseClient::FuseOpOpen(fuse_req_t req, fuse_ino_t ino,
     return ret;
 }
 
+CURVEFS_ERROR FuseClient::CreateInodeAndDentry(
+    const InodeParam &param, const char *name,
+    std::shared_ptr<InodeWrapper> *inodeWrapper) {
+    Dentry dentry;
+    dentry.set_fsid(param.fsId);
+    dentry.set_parentinodeid(param.parent);
+    dentry.set_name(name);
+    dentry.set_type(param.type);
+    if (param.type == FsFileType::TYPE_FILE ||
+        param.type == FsFileType::TYPE_S3) {
+        dentry.set_flag(DentryFlag::TYPE_FILE_FLAG);
+    }
+
+    CURVEFS_ERROR ret;
+    if (option_.enableCompoundCreate) {
+        ret = inodeManager_->CreateInodeAndDentry(param, name, *inodeWrapper);
+        if (ret == CURVEFS_ERROR::OK) {
+            dentry.set_inodeid((*inodeWrapper)->GetInodeId());
+            dentryManager_->InsertOrReplaceCache(dentry);
+            VLOG(6) << "inodeManager CreateInodeAndDentry success"
+                    << ", parent = " << param.parent << ", name = " << name
+                    << ", inode id = " << dentry.inodeid();
+            return ret;
+        } else if (ret != CURVEFS_ERROR::NO_SPACE) {
+            // the request may have been applied even if it failed, e.g.
+            // rpc timeout, so don't create the file again in another way
+            return ret;
+        }
+        // the partition of parent can't allocate inode any more
+        LOG(WARNING) << "inodeManager CreateInodeAndDentry fail, ret = " << ret
+                     << ", parent = " << param.parent << ", name = " << name
+                     << ", create inode and dentry separately";
+    }
+
+    ret = inodeManager_->CreateInode(param, *inodeWrapper);
+    if (ret != CURVEFS_ERROR::OK) {
+        LOG(ERROR) << "inodeManager CreateInode fail, ret = " << ret
+                   << ", parent = " << param.parent << ", name = " << name
+                   << ", mode = " << param.mode;
+        return ret;
+    }
+
+    uint64_t inodeId = (*inodeWrapper)->GetInodeId();
+    VLOG(6) << "inodeManager CreateInode success"
+            << ", parent = " << param.parent << ", name = " << name
+            << ", mode = " << param.mode << ", inode id = " << inodeId;
+
+    dentry.set_inodeid(inodeId);
+    ret = dentryManager_->CreateDentry(dentry);
+    if (ret != CURVEFS_ERROR::OK) {
+        LOG(ERROR) << "dentryManager_ CreateDentry fail, ret = " << ret
+                   << ", parent = " << param.parent << ", name = " << name
+                   << ", mode = " << param.mode;
+
+        CURVEFS_ERROR ret2 = inodeManager_->DeleteInode(inodeId);
+        if (ret2 != CURVEFS_ERROR::OK) {
+            LOG(ERROR) << "Also delete inode failed, ret = " << ret2
+                       << ", inodeid = " << inodeId;
+        }
+    }
+    return ret;
+}
+
 CURVEFS_ERROR FuseClient::MakeNode(fuse_req_t req, fuse_ino_t parent,
                                    const char *name, mode_t mode,
                                    FsFileType type, dev_t rdev,
@@ -368,41 +433,8 @@ CURVEFS_ERROR FuseClient::MakeNode(fuse_req_t req, fuse_ino_t parent,
     param.parent = parent;
 
     std::shared_ptr<InodeWrapper> inodeWrapper;
-    CURVEFS_ERROR ret = inodeManager_->CreateInode(param, inodeWrapper);
-    if (ret != CURVEFS_ERROR::OK) {
-        LOG(ERROR) << "inodeManager CreateInode fail, ret = " << ret
-                   << ", parent = " << parent << ", name = " << name
-                   << ", mode = " << mode;
-        return ret;
-    }
-
-    VLOG(6) << "inodeManager CreateInode success"
-            << ", parent = " << parent << ", name = " << name
-            << ", mode = " << mode
-            << ", inode id = " << inodeWrapper->GetInodeId();
-
-    Dentry dentry;
-    dentry.set_fsid(fsInfo_->fsid());
-    dentry.set_inodeid(inodeWrapper->GetInodeId());
-    dentry.set_parentinodeid(parent);
-    dentry.set_name(name);
-    dentry.set_type(inodeWrapper->GetType());
-    if (type == FsFileType::TYPE_FILE || type == FsFileType::TYPE_S3) {
-        dentry.set_flag(DentryFlag::TYPE_FILE_FLAG);
-    }
-
-    ret = dentryManager_->CreateDentry(dentry);
+    CURVEFS_ERROR ret = CreateInodeAndDentry(param, name, &inodeWrapper);
     if (ret != CURVEFS_ERROR::OK) {
-        LOG(ERROR) << "dentryManager_ CreateDentry fail, ret = " << ret
-                   << ", parent = " << parent << ", name = " << name
-                   << ", mode = " << mode;
-
-        CURVEFS_ERROR ret2 =
-            inodeManager_->DeleteInode(inodeWrapper->GetInodeId());
-        if (ret2 != CURVEFS_ERROR::OK) {
-            LOG(ERROR) << "Also delete inode failed, ret = " << ret2
-                       << ", inodeid = " << inodeWrapper->GetInodeId();
-        }
         return ret;
     }
 
@@ -594,8 +626,56 @@ static void dirbuf_add(fuse_req_t req, struct DirBufferHead *b,
     b->p = static_cast<char *>(realloc(b->p, b->size));
     memset(&stbuf, 0, sizeof(stbuf));
     stbuf.st_ino = dentry.inodeid();
+    // offset of next entry in the whole directory stream
     fuse_add_direntry(req, b->p + oldsize, b->size - oldsize,
-                      dentry.name().c_str(), &stbuf, b->size);
+                      dentry.name().c_str(), &stbuf, b->offset + b->size);
+}
+
+CURVEFS_ERROR FuseClient::ReadDirPage(fuse_req_t req, fuse_ino_t ino,
+                                      DirBufferHead *bufHead) {
+    auto limit = option_.listDentryLimit;
+    std::list<Dentry> dentryList;
+    bool finished = false;
+    CURVEFS_ERROR ret;
+    if (bufHead->IsPrefetching()) {
+        bufHead->WaitPrefetch();
+        ret = bufHead->prefetchRet;
+        dentryList.swap(bufHead->prefetchDentrys);
+        finished = bufHead->prefetchFinished;
+    } else {
+        ret = dentryManager_->ListDentryPage(ino, bufHead->last, limit,
+                                             &dentryList, &finished);
+    }
+    if (ret != CURVEFS_ERROR::OK) {
+        LOG(ERROR) << "dentryManager_ ListDentryPage fail, ret = " << ret
+                   << ", parent = " << ino << ", last = " << bufHead->last;
+        return ret;
+    }
+
+    // the current page has been consumed by kernel
+    bufHead->offset += bufHead->size;
+    free(bufHead->p);
+    bufHead->p = nullptr;
+    bufHead->size = 0;
+    for (const auto &dentry : dentryList) {
+        dirbuf_add(req, bufHead, dentry);
+    }
+    if (!dentryList.empty()) {
+        bufHead->last = dentryList.back().name();
+    }
+    bufHead->finished = finished;
+
+    // list next page while kernel is consuming this one
+    if (!finished) {
+        std::string last = bufHead->last;
+        // if prefetch can't be started, next page is listed when needed
+        bufHead->StartPrefetch([this, ino, last, limit, bufHead]() {
+            bufHead->prefetchRet = dentryManager_->ListDentryPage(
+                ino, last, limit, &bufHead->prefetchDentrys,
+                &bufHead->prefetchFinished);
+        });
+    }
+    return CURVEFS_ERROR::OK;
 }
 
 CURVEFS_ERROR FuseClient::FuseOpReadDir(fuse_req_t req, fuse_ino_t ino,
@@ -616,23 +696,21 @@ CURVEFS_ERROR FuseClient::FuseOpReadDir(fuse_req_t req, fuse_ino_t ino,
 
     uint64_t dindex = fi->fh;
     DirBufferHead *bufHead = dirBuf_->DirBufferGet(dindex);
-    if (!bufHead->wasRead) {
-        std::list<Dentry> dentryList;
-        auto limit = option_.listDentryLimit;
-        ret = dentryManager_->ListDentry(ino, &dentryList, limit);
+    size_t offset = static_cast<size_t>(off);
+    // the pages before current one are released, list again from beginning
+    if (offset < bufHead->offset) {
+        bufHead->Reset();
+    }
+    while (!bufHead->finished &&
+           offset >= bufHead->offset + bufHead->size) {
+        ret = ReadDirPage(req, ino, bufHead);
         if (ret != CURVEFS_ERROR::OK) {
-            LOG(ERROR) << "dentryManager_ ListDentry fail, ret = " << ret
-                       << ", parent = " << ino;
             return ret;
         }
-        for (const auto &dentry : dentryList) {
-            dirbuf_add(req, bufHead, dentry);
-        }
-        bufHead->wasRead = true;
     }
-    if (off < bufHead->size) {
-        *buffer = bufHead->p + off;
-        *rSize = std::min(bufHead->size - off, size);
+    if (offset < bufHead->offset + bufHead->size) {
+        *buffer = bufHead->p + (offset - bufHead->offset);
+        *rSize = std::min(bufHead->offset + bufHead->size - offset, size);
     } else {
         *buffer = nullptr;
         *rSize = 0;
@@ -932,31 +1010,8 @@ CURVEFS_ERROR FuseClient::FuseOpSymlink(fuse_req_t req, const char *link,
     param.parent = parent;
 
     std::shared_ptr<InodeWrapper> inodeWrapper;
-    CURVEFS_ERROR ret = inodeManager_->CreateInode(param, inodeWrapper);
-    if (ret != CURVEFS_ERROR::OK) {
-        LOG(ERROR) << "inodeManager CreateInode fail, ret = " << ret
-                   << ", parent = " << parent << ", name = " << name
-                   << ", mode = " << param.mode;
-        return ret;
-    }
-    Dentry dentry;
-    dentry.set_fsid(fsInfo_->fsid());
-    dentry.set_inodeid(inodeWrapper->GetInodeId());
-    dentry.set_parentinodeid(parent);
-    dentry.set_name(name);
-    dentry.set_type(inodeWrapper->GetType());
-    ret = dentryManager_->CreateDentry(dentry);
+    CURVEFS_ERROR ret = CreateInodeAndDentry(param, name, &inodeWrapper);
     if (ret != CURVEFS_ERROR::OK) {
-        LOG(ERROR) << "dentryManager_ CreateDentry fail, ret = " << ret
-                   << ", parent = " << parent << ", name = " << name
-                   << ", mode = " << param.mode;
-
-        CURVEFS_ERROR ret2 =
-            inodeManager_->DeleteInode(inodeWrapper->GetInodeId());
-        if (ret2 != CURVEFS_ERROR::OK) {
-            LOG(ERROR) << "Also delete inode failed, ret = " << ret2
-                       << ", inodeid = " << inodeWrapper->GetInodeId();
-        }
         return ret;
     }
 
@@ -250,6 +250,13 @@ class FuseClient {
     CURVEFS_ERROR RemoveNode(fuse_req_t req, fuse_ino_t parent,
                              const char* name, bool idDir);
 
+    // create inode and its dentry, in one rpc if compound create is enabled
+    // and the partition of parent can allocate the inode, otherwise create
+    // inode first and then dentry
+    CURVEFS_ERROR CreateInodeAndDentry(
+        const InodeParam& param, const char* name,
+        std::shared_ptr<InodeWrapper>* inodeWrapper);
+
     void GetDentryParamFromInode(
         const std::shared_ptr<InodeWrapper> &inodeWrapper_,
         fuse_entry_param *param);
@@ -275,6 +282,10 @@ class FuseClient {
 
     virtual void FlushInodeLoop();
 
+    // list the next page of directory into buffer
+    CURVEFS_ERROR ReadDirPage(fuse_req_t req, fuse_ino_t ino,
+                              DirBufferHead *bufHead);
+
     virtual void FlushData() = 0;
 
  protected:
@@ -107,6 +107,11 @@ CURVEFS_ERROR FuseVolumeClient::FuseOpInit(void *userdata,
     option.allocatorOption.bitmapAllocatorOption.smallAllocProportion =
         volOpts_.allocatorOption.bitmapAllocatorOption.smallAllocProportion;
 
+    option.allocCacheOption.shards =
+        volOpts_.allocatorOption.allocCacheOption.shards;
+    option.allocCacheOption.refillSize =
+        volOpts_.allocatorOption.allocCacheOption.refillSize;
+
     spaceManager_ = absl::make_unique<SpaceManagerImpl>(option, mdsClient_,
                                                         blockDeviceClient_);
 
@@ -26,6 +26,7 @@
 #include <glog/logging.h>
 
 #include <map>
+#include <vector>
 #include <utility>
 
 using ::curvefs::metaserver::Inode;
@@ -169,6 +170,33 @@ CURVEFS_ERROR InodeCacheManagerImpl::CreateInode(
                    << ", MetaStatusCode_Name = " << MetaStatusCode_Name(ret);
         return MetaStatusCodeToCurvefsErrCode(ret);
     }
+    PutNewInode(std::move(inode), out);
+    return CURVEFS_ERROR::OK;
+}
+
+CURVEFS_ERROR InodeCacheManagerImpl::CreateInodeAndDentry(
+    const InodeParam &param, const std::string &name,
+    std::shared_ptr<InodeWrapper> &out) {
+    Inode inode;
+    MetaStatusCode ret = metaClient_->CreateInodeAndDentry(param, name, &inode);
+    if (ret != MetaStatusCode::OK) {
+        LOG(WARNING) << "metaClient_ CreateInodeAndDentry failed"
+                     << ", MetaStatusCode = " << ret
+                     << ", MetaStatusCode_Name = " << MetaStatusCode_Name(ret)
+                     << ", parent = " << param.parent << ", name = " << name;
+        // the partition of parent can't allocate inode any more, caller can
+        // still create the inode in another partition
+        if (ret == MetaStatusCode::PARTITION_ALLOC_ID_FAIL) {
+            return CURVEFS_ERROR::NO_SPACE;
+        }
+        return MetaStatusCodeToCurvefsErrCode(ret);
+    }
+    PutNewInode(std::move(inode), out);
+    return CURVEFS_ERROR::OK;
+}
+
+void InodeCacheManagerImpl::PutNewInode(Inode &&inode,
+    std::shared_ptr<InodeWrapper> &out) {
     uint64_t inodeid = inode.inodeid();
     out = std::make_shared<InodeWrapper>(
         std::move(inode), metaClient_);
@@ -182,7 +210,6 @@ CURVEFS_ERROR InodeCacheManagerImpl::CreateInode(
     if (eliminated) {
         eliminatedOne->FlushAsync();
     }
-    return CURVEFS_ERROR::OK;
 }
 
 CURVEFS_ERROR InodeCacheManagerImpl::DeleteInode(uint64_t inodeid) {
@@ -228,10 +255,36 @@ void InodeCacheManagerImpl::FlushInodeOnce() {
         curve::common::LockGuard lg(dirtyMapMutex_);
         temp_.swap(dirtyMap_);
     }
+
+    // flush dirty inodes by batch to avoid one rpc per inode
+    std::vector<std::shared_ptr<InodeWrapper>> inodes;
+    std::vector<UpdateInodeRequest> updates;
+    inodes.reserve(temp_.size());
+    updates.reserve(temp_.size());
     for (auto it = temp_.begin(); it != temp_.end(); it++) {
+        UpdateInodeRequest update;
         curve::common::UniqueLock ulk = it->second->GetUniqueLock();
-        it->second->FlushAsync();
+        if (it->second->PrepareBatchUpdate(&update)) {
+            inodes.emplace_back(it->second);
+            updates.emplace_back(std::move(update));
+        }
+    }
+    if (updates.empty()) {
+        return;
     }
+
+    // release each inode as soon as its own batch returns, rather than
+    // holding all of them until the slowest partition responds
+    std::vector<MetaStatusCode> statusCodes;
+    metaClient_->BatchUpdateInode(fsId_, updates, &statusCodes,
+        [&inodes](size_t index, MetaStatusCode code) {
+            inodes[index]->FinishBatchUpdate(code);
+        });
+}
+
+bool InodeCacheManagerImpl::GetPartitionId(uint64_t inodeId,
+                                           PartitionID *partitionId) {
+    return metaClient_->GetPartitionId(fsId_, inodeId, partitionId);
 }
 
 }  // namespace client
@@ -76,6 +76,11 @@ class InodeCacheManager {
     virtual CURVEFS_ERROR CreateInode(const InodeParam &param,
         std::shared_ptr<InodeWrapper> &out) = 0;   // NOLINT
 
+    // create inode in the partition of parent together with its dentry
+    virtual CURVEFS_ERROR CreateInodeAndDentry(const InodeParam &param,
+        const std::string &name,
+        std::shared_ptr<InodeWrapper> &out) = 0;   // NOLINT
+
     virtual CURVEFS_ERROR DeleteInode(uint64_t inodeid) = 0;
 
     virtual void ClearInodeCache(uint64_t inodeid) = 0;
@@ -87,6 +92,9 @@ class InodeCacheManager {
 
     virtual void FlushInodeOnce() = 0;
 
+    virtual bool GetPartitionId(uint64_t inodeId,
+                                PartitionID *partitionId) = 0;
+
  protected:
     uint32_t fsId_;
 };
@@ -126,6 +134,10 @@ class InodeCacheManagerImpl : public InodeCacheManager {
     CURVEFS_ERROR CreateInode(const InodeParam &param,
         std::shared_ptr<InodeWrapper> &out) override;    // NOLINT
 
+    CURVEFS_ERROR CreateInodeAndDentry(const InodeParam &param,
+        const std::string &name,
+        std::shared_ptr<InodeWrapper> &out) override;    // NOLINT
+
     CURVEFS_ERROR DeleteInode(uint64_t inodeid) override;
 
     void ClearInodeCache(uint64_t inodeid) override;
@@ -137,6 +149,12 @@ class InodeCacheManagerImpl : public InodeCacheManager {
 
     void FlushInodeOnce() override;
 
+    bool GetPartitionId(uint64_t inodeId, PartitionID *partitionId) override;
+
+ private:
+    void PutNewInode(Inode &&inode,
+                     std::shared_ptr<InodeWrapper> &out);  // NOLINT
+
  private:
     std::shared_ptr<MetaServerClient> metaClient_;
     std::shared_ptr<LRUCache<uint64_t, std::shared_ptr<InodeWrapper>>> iCache_;
@@ -33,6 +33,7 @@ namespace client {
 using rpcclient::MetaServerClient;
 using rpcclient::MetaServerClientImpl;
 using rpcclient::MetaServerClientDone;
+using rpcclient::FillUpdateInodeRequest;
 
 std::ostream &operator<<(std::ostream &os, const struct stat &attr) {
     os << "{ st_ino = " << attr.st_ino << ", st_mode = " << attr.st_mode
@@ -196,6 +197,48 @@ void InodeWrapper::FlushS3ChunkInfoAsync() {
     }
 }
 
+bool InodeWrapper::PrepareBatchUpdate(UpdateInodeRequest *update) {
+    bool hasS3ChunkInfo = inode_.type() == FsFileType::TYPE_S3 &&
+                          !s3ChunkInfoAdd_.empty();
+    if (!dirty_ && !hasS3ChunkInfo) {
+        return false;
+    }
+
+    LockSyncingInode();
+    LockSyncingS3ChunkInfo();
+
+    // poolId, copysetId and partitionId are filled by metaserver client
+    update->set_fsid(inode_.fsid());
+    update->set_inodeid(inode_.inodeid());
+    if (dirty_) {
+        if (inode_.type() == FsFileType::TYPE_FILE) {
+            auto tmp = extentCache_.ToInodePb();
+            inode_.mutable_volumeextentmap()->swap(tmp);
+        }
+
+        FillUpdateInodeRequest(inode_, InodeOpenStatusChange::NOCHANGE,
+                               update);
+        dirty_ = false;
+    }
+
+    if (hasS3ChunkInfo) {
+        update->mutable_s3chunkinfomap()->swap(s3ChunkInfoAdd_);
+    }
+    return true;
+}
+
+void InodeWrapper::FinishBatchUpdate(MetaStatusCode code) {
+    if (code != MetaStatusCode::OK && code != MetaStatusCode::NOT_FOUND) {
+        LOG(ERROR) << "metaClient_ BatchUpdateInode failed, "
+                   << "MetaStatusCode: " << code
+                   << ", MetaStatusCode_Name: " << MetaStatusCode_Name(code)
+                   << ", inodeid: " << inode_.inodeid();
+        MarkInodeError();
+    }
+    ReleaseSyncingS3ChunkInfo();
+    ReleaseSyncingInode();
+}
+
 CURVEFS_ERROR InodeWrapper::RefreshS3ChunkInfo() {
     curve::common::UniqueLock lock = GetSyncingS3ChunkInfoUniqueLock();
     google::protobuf::Map<
@@ -215,6 +258,19 @@ CURVEFS_ERROR InodeWrapper::RefreshS3ChunkInfo() {
     return CURVEFS_ERROR::OK;
 }
 
+const S3ChunkInfoIndex *InodeWrapper::GetS3ChunkInfoIndexUnlocked(
+    uint64_t chunkIndex) {
+    auto it = inode_.s3chunkinfomap().find(chunkIndex);
+    if (it == inode_.s3chunkinfomap().end()) {
+        s3ChunkInfoIndex_.erase(chunkIndex);
+        return nullptr;
+    }
+
+    S3ChunkInfoIndex &index = s3ChunkInfoIndex_[chunkIndex];
+    index.Update(it->second);
+    return &index;
+}
+
 CURVEFS_ERROR InodeWrapper::LinkLocked(uint64_t parent) {
     curve::common::UniqueLock lg(mtx_);
     uint32_t old = inode_.nlink();
@@ -29,6 +29,7 @@
 #include <utility>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "curvefs/src/common/define.h"
 #include "curvefs/proto/metaserver.pb.h"
@@ -36,12 +37,14 @@
 #include "curvefs/src/client/rpcclient/metaserver_client.h"
 #include "src/common/concurrent/concurrent.h"
 #include "curvefs/src/client/volume/extent_cache.h"
+#include "curvefs/src/client/s3/s3_chunk_info_index.h"
 
 using ::curvefs::metaserver::Inode;
 using ::curvefs::metaserver::InodeOpenStatusChange;
 using ::curvefs::metaserver::VolumeExtentList;
 using ::curvefs::metaserver::S3ChunkInfoList;
 using ::curvefs::metaserver::S3ChunkInfo;
+using ::curvefs::metaserver::UpdateInodeRequest;
 
 namespace curvefs {
 namespace client {
@@ -294,8 +297,21 @@ class InodeWrapper : public std::enable_shared_from_this<InodeWrapper> {
 
     void FlushS3ChunkInfoAsync();
 
+    // collect dirty attributes and unsynced s3chunkinfo into |update| for a
+    // batched flush, the caller should hold the inode lock.
+    // return false if nothing need to flush, otherwise the syncing locks are
+    // held until FinishBatchUpdate() is called
+    bool PrepareBatchUpdate(UpdateInodeRequest *update);
+
+    void FinishBatchUpdate(MetaStatusCode code);
+
     CURVEFS_ERROR RefreshS3ChunkInfo();
 
+    // index of the s3chunkinfolist of chunk, it's synced with the list on
+    // every call. return nullptr if the chunk has no s3chunkinfo.
+    // caller should hold mtx_
+    const S3ChunkInfoIndex *GetS3ChunkInfoIndexUnlocked(uint64_t chunkIndex);
+
     CURVEFS_ERROR Open();
 
     bool IsOpen();
@@ -373,6 +389,8 @@ class InodeWrapper : public std::enable_shared_from_this<InodeWrapper> {
     InodeStatus status_;
 
     google::protobuf::Map<uint64_t, S3ChunkInfoList> s3ChunkInfoAdd_;
+    // key is chunk index
+    std::unordered_map<uint64_t, S3ChunkInfoIndex> s3ChunkInfoIndex_;
 
     std::shared_ptr<MetaServerClient> metaClient_;
     bool dirty_;
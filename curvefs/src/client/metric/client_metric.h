@@ -75,8 +75,10 @@ struct MetaServerClientMetric {
     InterfaceMetric batchGetXattr;
     InterfaceMetric createInode;
     InterfaceMetric updateInode;
+    InterfaceMetric batchUpdateInode;
     InterfaceMetric deleteInode;
     InterfaceMetric createRootInode;
+    InterfaceMetric createInodeAndDentry;
     InterfaceMetric appendS3ChunkInfo;
 
     // tnx
@@ -98,8 +100,10 @@ struct MetaServerClientMetric {
           batchGetXattr(prefix, "batchGetXattr"),
           createInode(prefix, "createInode"),
           updateInode(prefix, "updateInode"),
+          batchUpdateInode(prefix, "batchUpdateInode"),
           deleteInode(prefix, "deleteInode"),
           createRootInode(prefix, "createRootInode"),
+          createInodeAndDentry(prefix, "createInodeAndDentry"),
           appendS3ChunkInfo(prefix, "appendS3ChunkInfo"),
           prepareRenameTx(prefix, "prepareRenameTx"),
           createPartition(prefix, "createPartition") {}
@@ -188,12 +192,17 @@ struct S3MultiManagerMetric {
     const std::string prefix;
     bvar::Adder<int64_t> fileManagerNum;
     bvar::Adder<int64_t> chunkCacheNum;
+    // data caches admitted to or rejected by read cache
+    bvar::Adder<int64_t> readCacheAdmit;
+    bvar::Adder<int64_t> readCacheReject;
 
     explicit S3MultiManagerMetric(
         const std::string &prefix_ = "curvefs_client_manager")
         : prefix(prefix_) {
         fileManagerNum.expose_as(prefix, "file_manager_num");
         chunkCacheNum.expose_as(prefix, "chunk_cache_num");
+        readCacheAdmit.expose_as(prefix, "read_cache_admit");
+        readCacheReject.expose_as(prefix, "read_cache_reject");
     }
 };
 
@@ -222,6 +231,7 @@ struct S3Metric {
     InterfaceMetric adaptorWriteDiskCache;
     InterfaceMetric adaptorReadS3;
     InterfaceMetric adaptorReadDiskCache;
+    InterfaceMetric adaptorReadMemCache;
     bvar::LatencyRecorder readSize;
     bvar::LatencyRecorder writeSize;
 
@@ -234,6 +244,7 @@ struct S3Metric {
           adaptorWriteDiskCache(prefix, fsName + "_adaptor_write_disk_cache"),
           adaptorReadS3(prefix, fsName + "_adaptor_read_s3"),
           adaptorReadDiskCache(prefix, fsName + "_adaptor_read_disk_cache"),
+          adaptorReadMemCache(prefix, fsName + "_adaptor_read_mem_cache"),
           readSize(prefix, fsName + "_adaptor_read_size"),
           writeSize(prefix, fsName + "_adaptor_write_size") {}
 };
@@ -22,6 +22,10 @@
 
 #include "curvefs/src/client/rpcclient/metaserver_client.h"
 
+#include <bthread/bthread.h>
+#include <butil/fast_rand.h>
+
+#include <functional>
 #include <vector>
 #include <utility>
 #include <algorithm>
@@ -39,6 +43,10 @@ using curvefs::metaserver::BatchGetInodeAttrRequest;
 using curvefs::metaserver::BatchGetInodeAttrResponse;
 using curvefs::metaserver::BatchGetXAttrRequest;
 using curvefs::metaserver::BatchGetXAttrResponse;
+using curvefs::metaserver::BatchUpdateInodeRequest;
+using curvefs::metaserver::BatchUpdateInodeResponse;
+using curvefs::metaserver::CreateInodeAndDentryRequest;
+using curvefs::metaserver::CreateInodeAndDentryResponse;
 
 namespace curvefs {
 namespace client {
@@ -53,6 +61,7 @@ using UpdateInodeExcutor = TaskExecutor;
 using GetInodeExcutor = TaskExecutor;
 using BatchGetInodeAttrExcutor = TaskExecutor;
 using BatchGetXAttrExcutor = TaskExecutor;
+using BatchUpdateInodeExcutor = TaskExecutor;
 using GetOrModifyS3ChunkInfoExcutor = TaskExecutor;
 
 using ::curvefs::common::LatencyUpdater;
@@ -659,6 +668,33 @@ MetaStatusCode MetaServerClientImpl::BatchGetXAttr(uint32_t fsId,
     return MetaStatusCode::OK;
 }
 
+void FillUpdateInodeRequest(const Inode &inode,
+                            InodeOpenStatusChange statusChange,
+                            UpdateInodeRequest *request) {
+    request->set_inodeid(inode.inodeid());
+    request->set_fsid(inode.fsid());
+    request->set_length(inode.length());
+    request->set_ctime(inode.ctime());
+    request->set_ctime_ns(inode.ctime_ns());
+    request->set_mtime(inode.mtime());
+    request->set_mtime_ns(inode.mtime_ns());
+    request->set_atime(inode.atime());
+    request->set_atime_ns(inode.atime_ns());
+    request->set_uid(inode.uid());
+    request->set_gid(inode.gid());
+    request->set_mode(inode.mode());
+    request->set_nlink(inode.nlink());
+    request->set_inodeopenstatuschange(statusChange);
+    *(request->mutable_parent()) = inode.parent();
+    if (inode.xattr_size() > 0) {
+        *(request->mutable_xattr()) = inode.xattr();
+    }
+
+    if (!inode.volumeextentmap().empty()) {
+        *(request->mutable_volumeextentmap()) = inode.volumeextentmap();
+    }
+}
+
 MetaStatusCode
 MetaServerClientImpl::UpdateInode(const Inode &inode,
                                   InodeOpenStatusChange statusChange) {
@@ -671,26 +707,7 @@ MetaServerClientImpl::UpdateInode(const Inode &inode,
         request.set_poolid(poolID);
         request.set_copysetid(copysetID);
         request.set_partitionid(partitionID);
-        request.set_inodeid(inode.inodeid());
-        request.set_fsid(inode.fsid());
-        request.set_length(inode.length());
-        request.set_ctime(inode.ctime());
-        request.set_mtime(inode.mtime());
-        request.set_atime(inode.atime());
-        request.set_uid(inode.uid());
-        request.set_gid(inode.gid());
-        request.set_mode(inode.mode());
-        request.set_nlink(inode.nlink());
-        request.set_inodeopenstatuschange(statusChange);
-        *(request.mutable_parent()) = inode.parent();
-        if (inode.xattr_size() > 0) {
-            *(request.mutable_xattr()) = inode.xattr();
-        }
-
-        if (!inode.volumeextentmap().empty()) {
-            auto *exts = request.mutable_volumeextentmap();
-            *exts = inode.volumeextentmap();
-        }
+        FillUpdateInodeRequest(inode, statusChange, &request);
 
         curvefs::metaserver::MetaServerService_Stub stub(channel);
         stub.UpdateInode(cntl, &request, &response, nullptr);
@@ -790,26 +807,7 @@ void MetaServerClientImpl::UpdateInodeAsync(
         request.set_poolid(poolID);
         request.set_copysetid(copysetID);
         request.set_partitionid(partitionID);
-        request.set_inodeid(inode.inodeid());
-        request.set_fsid(inode.fsid());
-        request.set_length(inode.length());
-        request.set_ctime(inode.ctime());
-        request.set_mtime(inode.mtime());
-        request.set_atime(inode.atime());
-        request.set_uid(inode.uid());
-        request.set_gid(inode.gid());
-        request.set_mode(inode.mode());
-        request.set_nlink(inode.nlink());
-        request.set_inodeopenstatuschange(statusChange);
-        *(request.mutable_parent()) = inode.parent();
-        if (inode.xattr_size() > 0) {
-            *(request.mutable_xattr()) = inode.xattr();
-        }
-
-        if (!inode.volumeextentmap().empty()) {
-            auto *exts = request.mutable_volumeextentmap();
-            *exts = inode.volumeextentmap();
-        }
+        FillUpdateInodeRequest(inode, statusChange, &request);
 
         auto *rpcDone = new UpdateInodeRpcDone(taskExecutorDone,
             metaserverClientMetric_);
@@ -828,6 +826,174 @@ void MetaServerClientImpl::UpdateInodeAsync(
     excutor->DoAsyncRPCTask(taskDone);
 }
 
+namespace {
+
+void *RunBatchUpdateInode(void *arg) {
+    (*static_cast<std::function<void()> *>(arg))();
+    return nullptr;
+}
+
+}  // namespace
+
+MetaStatusCode MetaServerClientImpl::BatchUpdateInode(uint32_t fsId,
+    const std::vector<UpdateInodeRequest> &updates,
+    std::vector<MetaStatusCode> *statusCodes,
+    const BatchUpdateInodeDone &done) {
+    statusCodes->assign(updates.size(), MetaStatusCode::UNKNOWN_ERROR);
+
+    // group updates by partition
+    std::unordered_map<uint32_t, std::vector<size_t>> groups;
+    for (size_t i = 0; i < updates.size(); i++) {
+        uint32_t pId = 0;
+        if (!metaCache_->GetPartitionIdByInodeId(
+                fsId, updates[i].inodeid(), &pId)) {
+            LOG(ERROR) << "BatchUpdateInode get partitionId by inodeId fail"
+                       << ", fsId = " << fsId
+                       << ", inodeId = " << updates[i].inodeid();
+            (*statusCodes)[i] = MetaStatusCode::NOT_FOUND;
+            if (done) {
+                done(i, MetaStatusCode::NOT_FOUND);
+            }
+            continue;
+        }
+        groups[pId].push_back(i);
+    }
+
+    // split each group by count and bytes limit
+    uint32_t limit = std::max<uint32_t>(1, opt_.batchUpdateLimit);
+    std::vector<std::vector<size_t>> batches;
+    for (const auto &group : groups) {
+        std::vector<size_t> batch;
+        uint64_t bytes = 0;
+        for (size_t index : group.second) {
+            uint64_t size = updates[index].ByteSizeLong();
+            if (!batch.empty() && (batch.size() >= limit ||
+                bytes + size > opt_.batchUpdateMaxBytes)) {
+                batches.emplace_back(std::move(batch));
+                batch.clear();
+                bytes = 0;
+            }
+            batch.push_back(index);
+            bytes += size;
+        }
+        if (!batch.empty()) {
+            batches.emplace_back(std::move(batch));
+        }
+    }
+
+    // send batches concurrently, as they mostly belong to different
+    // partitions, and each batch only writes its own slots of |statusCodes|
+    if (batches.size() == 1) {
+        BatchUpdateInodeOnce(fsId, updates, batches[0], statusCodes, done);
+    } else if (batches.size() > 1) {
+        std::vector<std::function<void()>> runners;
+        runners.reserve(batches.size());
+        for (const auto &batch : batches) {
+            runners.emplace_back([&, this]() {
+                BatchUpdateInodeOnce(fsId, updates, batch, statusCodes, done);
+            });
+        }
+        std::vector<bthread_t> tids(runners.size(), INVALID_BTHREAD);
+        for (size_t i = 0; i < runners.size(); i++) {
+            if (bthread_start_background(&tids[i], nullptr,
+                    RunBatchUpdateInode, &runners[i]) != 0) {
+                LOG(WARNING) << "BatchUpdateInode start bthread failed, "
+                             << "run in current thread";
+                tids[i] = INVALID_BTHREAD;
+                runners[i]();
+            }
+        }
+        for (const auto &tid : tids) {
+            if (tid != INVALID_BTHREAD) {
+                bthread_join(tid, nullptr);
+            }
+        }
+    }
+
+    for (const auto &code : *statusCodes) {
+        if (code != MetaStatusCode::OK) {
+            return code;
+        }
+    }
+    return MetaStatusCode::OK;
+}
+
+void MetaServerClientImpl::BatchUpdateInodeOnce(uint32_t fsId,
+    const std::vector<UpdateInodeRequest> &updates,
+    const std::vector<size_t> &indexes,
+    std::vector<MetaStatusCode> *statusCodes,
+    const BatchUpdateInodeDone &done) {
+    auto task = RPCTask {
+        metaserverClientMetric_->batchUpdateInode.qps.count << 1;
+        LatencyUpdater updater(
+            &metaserverClientMetric_->batchUpdateInode.latency);
+        BatchUpdateInodeRequest request;
+        BatchUpdateInodeResponse response;
+        request.set_poolid(poolID);
+        request.set_copysetid(copysetID);
+        request.set_partitionid(partitionID);
+        request.set_fsid(fsId);
+        for (size_t index : indexes) {
+            UpdateInodeRequest *update = request.add_update();
+            *update = updates[index];
+            update->set_poolid(poolID);
+            update->set_copysetid(copysetID);
+            update->set_partitionid(partitionID);
+        }
+
+        curvefs::metaserver::MetaServerService_Stub stub(channel);
+        stub.BatchUpdateInode(cntl, &request, &response, nullptr);
+
+        if (cntl->Failed()) {
+            metaserverClientMetric_->batchUpdateInode.eps.count << 1;
+            LOG(WARNING) << "BatchUpdateInode Failed, errorcode = "
+                         << cntl->ErrorCode()
+                         << ", error content:" << cntl->ErrorText()
+                         << ", log id = " << cntl->log_id();
+            return -cntl->ErrorCode();
+        }
+
+        MetaStatusCode ret = response.statuscode();
+        if (ret != MetaStatusCode::OK) {
+            LOG(WARNING) << "BatchUpdateInode failed, errcode = "
+                         << ret << ", errmsg = "
+                         << MetaStatusCode_Name(ret);
+        } else if (response.has_appliedindex() &&
+                   response.updatestatuscode_size() ==
+                       static_cast<int>(indexes.size())) {
+            for (size_t i = 0; i < indexes.size(); i++) {
+                (*statusCodes)[indexes[i]] =
+                    response.updatestatuscode(i);
+            }
+            metaCache_->UpdateApplyIndex(
+                CopysetGroupID(poolID, copysetID),
+                response.appliedindex());
+        } else {
+            LOG(WARNING) << "BatchUpdateInode ok, but applyIndex or"
+                         << " updateStatusCode not match in response: "
+                         << response.ShortDebugString();
+            return -1;
+        }
+        return ret;
+    };
+    auto taskCtx = std::make_shared<TaskContext>(
+        MetaServerOpType::BatchUpdateInode, task, fsId,
+        updates[indexes[0]].inodeid());
+    BatchUpdateInodeExcutor excutor(
+        opt_, metaCache_, channelManager_, taskCtx);
+    auto ret = ConvertToMetaStatusCode(excutor.DoRPCTask());
+    if (ret != MetaStatusCode::OK) {
+        for (size_t index : indexes) {
+            (*statusCodes)[index] = ret;
+        }
+    }
+    if (done) {
+        for (size_t index : indexes) {
+            done(index, (*statusCodes)[index]);
+        }
+    }
+}
+
 bool MetaServerClientImpl::ParseS3MetaStreamBuffer(butil::IOBuf* buffer,
                                                    uint64_t* chunkIndex,
                                                    S3ChunkInfoList* list) {
@@ -1121,6 +1287,82 @@ MetaStatusCode MetaServerClientImpl::CreateInode(const InodeParam &param,
     return ConvertToMetaStatusCode(excutor.DoRPCTask());
 }
 
+MetaStatusCode MetaServerClientImpl::CreateInodeAndDentry(
+    const InodeParam &param, const std::string &name, Inode *out) {
+    // all retries carry the same request id, so metaserver can return the
+    // inode created by a previous try whose response was lost
+    const uint64_t requestId = butil::fast_rand() | 1;
+    auto task = RPCTask {
+        metaserverClientMetric_->createInodeAndDentry.qps.count << 1;
+        LatencyUpdater updater(
+            &metaserverClientMetric_->createInodeAndDentry.latency);
+        CreateInodeAndDentryResponse response;
+        CreateInodeAndDentryRequest request;
+        request.set_poolid(poolID);
+        request.set_copysetid(copysetID);
+        request.set_partitionid(partitionID);
+        request.set_name(name);
+        request.set_txid(txId);
+        request.set_requestid(requestId);
+        CreateInodeRequest *inode = request.mutable_inode();
+        inode->set_poolid(poolID);
+        inode->set_copysetid(copysetID);
+        inode->set_partitionid(partitionID);
+        inode->set_fsid(param.fsId);
+        inode->set_length(param.length);
+        inode->set_uid(param.uid);
+        inode->set_gid(param.gid);
+        inode->set_mode(param.mode);
+        inode->set_type(param.type);
+        inode->set_rdev(param.rdev);
+        inode->set_symlink(param.symlink);
+        inode->set_parent(param.parent);
+        curvefs::metaserver::MetaServerService_Stub stub(channel);
+        stub.CreateInodeAndDentry(cntl, &request, &response, nullptr);
+
+        if (cntl->Failed()) {
+            metaserverClientMetric_->createInodeAndDentry.eps.count << 1;
+            LOG(WARNING) << "CreateInodeAndDentry Failed, errorcode = "
+                         << cntl->ErrorCode()
+                         << ", error content:" << cntl->ErrorText()
+                         << ", log id = " << cntl->log_id();
+            return -cntl->ErrorCode();
+        }
+
+        MetaStatusCode ret = response.statuscode();
+        if (ret != MetaStatusCode::OK) {
+            LOG(WARNING) << "CreateInodeAndDentry:  param = " << param
+                         << ", name = " << name
+                         << ", errcode = " << ret
+                         << ", errmsg = " << MetaStatusCode_Name(ret)
+                         << ", pool: " << poolID << ", copyset: " << copysetID
+                         << ", partition: " << partitionID;
+        } else if (response.has_inode() && response.has_appliedindex()) {
+            *out = response.inode();
+
+            metaCache_->UpdateApplyIndex(CopysetGroupID(poolID, copysetID),
+                                         response.appliedindex());
+        } else {
+            LOG(WARNING) << "CreateInodeAndDentry:  param = " << param
+                         << " ok, but applyIndex or inode not set in response:"
+                         << response.DebugString();
+            return -1;
+        }
+
+        VLOG(6) << "CreateInodeAndDentry done, request: "
+                << request.DebugString()
+                << "response: " << response.DebugString();
+        return ret;
+    };
+
+    auto taskCtx = std::make_shared<TaskContext>(
+        MetaServerOpType::CreateInodeAndDentry, task, param.fsId,
+        param.parent, false, opt_.enableRenameParallel);
+    CreateInodeAndDentryExcutor excutor(opt_, metaCache_, channelManager_,
+                                        taskCtx);
+    return ConvertToMetaStatusCode(excutor.DoRPCTask());
+}
+
 MetaStatusCode MetaServerClientImpl::DeleteInode(uint32_t fsId,
                                                  uint64_t inodeid) {
     auto task = RPCTask {
@@ -1173,6 +1415,11 @@ MetaStatusCode MetaServerClientImpl::DeleteInode(uint32_t fsId,
     return ConvertToMetaStatusCode(excutor.DoRPCTask());
 }
 
+bool MetaServerClientImpl::GetPartitionId(uint32_t fsId, uint64_t inodeId,
+                                          PartitionID *partitionId) {
+    return metaCache_->GetPartitionIdByInodeId(fsId, inodeId, partitionId);
+}
+
 }  // namespace rpcclient
 }  // namespace client
 }  // namespace curvefs
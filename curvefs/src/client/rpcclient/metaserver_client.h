@@ -23,6 +23,7 @@
 #ifndef CURVEFS_SRC_CLIENT_RPCCLIENT_METASERVER_CLIENT_H_
 #define CURVEFS_SRC_CLIENT_RPCCLIENT_METASERVER_CLIENT_H_
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <string>
@@ -45,6 +46,7 @@ using ::curvefs::metaserver::FsFileType;
 using ::curvefs::metaserver::Inode;
 using ::curvefs::metaserver::InodeOpenStatusChange;
 using ::curvefs::metaserver::InodeAttr;
+using ::curvefs::metaserver::UpdateInodeRequest;
 using ::curvefs::metaserver::XAttr;
 using ::curvefs::metaserver::MetaStatusCode;
 using ::curvefs::metaserver::S3ChunkInfoList;
@@ -57,6 +59,16 @@ namespace rpcclient {
 
 using S3ChunkInfoMap = google::protobuf::Map<uint64_t, S3ChunkInfoList>;
 
+// called with the index in the batch and the status of an update
+using BatchUpdateInodeDone =
+    std::function<void(size_t index, MetaStatusCode code)>;
+
+// fill attributes of |inode| into |request|, the location of the inode
+// (poolId, copysetId and partitionId) is left to the caller
+void FillUpdateInodeRequest(const Inode &inode,
+                            InodeOpenStatusChange statusChange,
+                            UpdateInodeRequest *request);
+
 class MetaServerClient {
  public:
     MetaServerClient() {}
@@ -108,6 +120,16 @@ class MetaServerClient {
                                   InodeOpenStatusChange statusChange =
                                       InodeOpenStatusChange::NOCHANGE) = 0;
 
+    // updates are grouped by partition, each group is sent in one rpc and
+    // applied by metaserver as a single raft log entry. s3ChunkInfoMap of
+    // each update is appended to the inode. the status of each update is
+    // returned in |statusCodes| in the same order as |updates|, and |done|
+    // is called for each update as soon as its group returns
+    virtual MetaStatusCode BatchUpdateInode(uint32_t fsId,
+        const std::vector<UpdateInodeRequest> &updates,
+        std::vector<MetaStatusCode> *statusCodes,
+        const BatchUpdateInodeDone &done = nullptr) = 0;
+
     virtual MetaStatusCode GetOrModifyS3ChunkInfo(
         uint32_t fsId, uint64_t inodeId,
         const google::protobuf::Map<
@@ -124,7 +146,17 @@ class MetaServerClient {
 
     virtual MetaStatusCode CreateInode(const InodeParam &param, Inode *out) = 0;
 
+    // create inode in the partition of |param.parent| and the dentry |name|
+    // of it in one rpc, returns PARTITION_ALLOC_ID_FAIL if the partition of
+    // parent can't allocate inode any more
+    virtual MetaStatusCode CreateInodeAndDentry(const InodeParam &param,
+                                                const std::string &name,
+                                                Inode *out) = 0;
+
     virtual MetaStatusCode DeleteInode(uint32_t fsId, uint64_t inodeid) = 0;
+
+    virtual bool GetPartitionId(uint32_t fsId, uint64_t inodeId,
+                                PartitionID *partitionId) = 0;
 };
 
 class MetaServerClientImpl : public MetaServerClient {
@@ -177,6 +209,11 @@ class MetaServerClientImpl : public MetaServerClient {
                           InodeOpenStatusChange statusChange =
                               InodeOpenStatusChange::NOCHANGE) override;
 
+    MetaStatusCode BatchUpdateInode(uint32_t fsId,
+        const std::vector<UpdateInodeRequest> &updates,
+        std::vector<MetaStatusCode> *statusCodes,
+        const BatchUpdateInodeDone &done = nullptr) override;
+
     MetaStatusCode GetOrModifyS3ChunkInfo(
         uint32_t fsId, uint64_t inodeId,
         const google::protobuf::Map<
@@ -193,8 +230,15 @@ class MetaServerClientImpl : public MetaServerClient {
 
     MetaStatusCode CreateInode(const InodeParam &param, Inode *out) override;
 
+    MetaStatusCode CreateInodeAndDentry(const InodeParam &param,
+                                        const std::string &name,
+                                        Inode *out) override;
+
     MetaStatusCode DeleteInode(uint32_t fsId, uint64_t inodeid) override;
 
+    bool GetPartitionId(uint32_t fsId, uint64_t inodeId,
+                        PartitionID *partitionId) override;
+
  private:
     bool ParseS3MetaStreamBuffer(butil::IOBuf* buffer,
                                  uint64_t* chunkIndex,
@@ -202,6 +246,13 @@ class MetaServerClientImpl : public MetaServerClient {
 
     bool HandleS3MetaStreamBuffer(butil::IOBuf* buffer, S3ChunkInfoMap* out);
 
+    // send updates of |indexes| (same partition) in one rpc
+    void BatchUpdateInodeOnce(uint32_t fsId,
+        const std::vector<UpdateInodeRequest> &updates,
+        const std::vector<size_t> &indexes,
+        std::vector<MetaStatusCode> *statusCodes,
+        const BatchUpdateInodeDone &done);
+
  private:
     ExcutorOpt opt_;
 
@@ -142,9 +142,8 @@ bool TaskExecutor::OnReturn(int retCode) {
         case MetaStatusCode::PARTITION_ALLOC_ID_FAIL:
             // TODO(@lixiaocui @cw123): metaserver and mds heartbeat should
             // report this status
-            needRetry = true;
             // need choose a new coopyset
-            OnPartitionAllocIDFail();
+            needRetry = OnPartitionAllocIDFail();
             break;
 
         case MetaStatusCode::RPC_STREAM_ERROR:
@@ -252,8 +251,9 @@ void TaskExecutor::RefreshLeader() {
     task_->retryDirectly = (oldTarget != task_->target.metaServerID);
 }
 
-void TaskExecutor::OnPartitionAllocIDFail() {
+bool TaskExecutor::OnPartitionAllocIDFail() {
     metaCache_->MarkPartitionUnavailable(task_->target.partitionID);
+    return true;
 }
 
 uint64_t TaskExecutor::OverLoadBackOff() {
@@ -327,6 +327,11 @@ bool CreateInodeExcutor::GetTarget() {
     return true;
 }
 
+bool CreateInodeAndDentryExcutor::OnPartitionAllocIDFail() {
+    TaskExecutor::OnPartitionAllocIDFail();
+    return false;
+}
+
 }  // namespace rpcclient
 }  // namespace client
 }  // namespace curvefs
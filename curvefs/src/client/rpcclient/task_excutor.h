@@ -140,7 +140,8 @@ class TaskExecutor {
     void OnSuccess();
     void OnReDirected();
     void OnCopysetNotExist();
-    void OnPartitionAllocIDFail();
+    // return whether the task should be retried
+    virtual bool OnPartitionAllocIDFail();
 
     // retry policy
     void RefreshLeader();
@@ -224,6 +225,21 @@ class CreateInodeExcutor : public TaskExecutor {
     bool GetTarget() override;
 };
 
+// the inode must be allocated in the partition of parent, so the task fails
+// directly instead of choosing another partition when the partition is full
+class CreateInodeAndDentryExcutor : public TaskExecutor {
+ public:
+    explicit CreateInodeAndDentryExcutor(
+        const ExcutorOpt &opt,
+        const std::shared_ptr<MetaCache> &metaCache,
+        const std::shared_ptr<ChannelManager<MetaserverID>> &channelManager,
+        const std::shared_ptr<TaskContext> &task)
+        : TaskExecutor(opt, metaCache, channelManager, task) {}
+
+ protected:
+    bool OnPartitionAllocIDFail() override;
+};
+
 }  // namespace rpcclient
 }  // namespace client
 }  // namespace curvefs
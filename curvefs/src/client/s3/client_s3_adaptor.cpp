@@ -62,6 +62,9 @@ S3ClientAdaptorImpl::Init(
     inodeManager_ = inodeManager;
     mdsClient_ = mdsClient;
     fsCacheManager_ = fsCacheManager;
+    if (option.readCacheAdmission && fsCacheManager_ != nullptr) {
+        fsCacheManager_->EnableAdmission(blockSize_);
+    }
     waitInterval_.Init(option.intervalSec * 1000);
     diskCacheManagerImpl_ = diskCacheManagerImpl;
     if (HasDiskCache()) {
@@ -94,6 +97,7 @@ S3ClientAdaptorImpl::Init(
               << ", flushIntervalSec: " << option.flushIntervalSec
               << ", writeCacheMaxByte: " << option.writeCacheMaxByte
               << ", readCacheMaxByte: " << option.readCacheMaxByte
+              << ", readCacheAdmission: " << option.readCacheAdmission
               << ", nearfullRatio: " << option.nearfullRatio
               << ", baseSleepUs: " << option.baseSleepUs;
     // start chunk flush threads
@@ -89,6 +89,26 @@ void FsCacheManager::ReleaseFileCacheManager(uint64_t inodeId) {
     return;
 }
 
+void FsCacheManager::EnableAdmission(uint64_t blockSize) {
+    if (blockSize == 0) {
+        return;
+    }
+    // one key per block, it's enough to count in blocks for read cache
+    blockSize_ = blockSize;
+    sketch_.reset(new FrequencySketch(readCacheMaxByte_ / blockSize));
+}
+
+void FsCacheManager::RecordAccess(uint64_t inodeId, uint64_t chunkIndex,
+                                  uint64_t chunkPos, uint64_t len) {
+    if (sketch_ == nullptr) {
+        return;
+    }
+    uint64_t pos = chunkPos / blockSize_ * blockSize_;
+    for (; pos < chunkPos + len; pos += blockSize_) {
+        sketch_->Increment(AccessKey(inodeId, chunkIndex, pos));
+    }
+}
+
 bool FsCacheManager::Set(DataCachePtr dataCache,
                          std::list<DataCachePtr>::iterator *outIter) {
     std::lock_guard<std::mutex> lk(lruMtx_);
@@ -98,6 +118,15 @@ bool FsCacheManager::Set(DataCachePtr dataCache,
     if (readCacheMaxByte_ == 0) {
         return false;
     }
+    // data cache which is colder than the one to be evicted is not
+    // cached, it's still read from disk cache or s3 next time
+    if (sketch_ != nullptr && lruByte_ >= readCacheMaxByte_ &&
+        !lruReadDataCacheList_.empty() &&
+        !sketch_->Admit(AccessKey(dataCache),
+                        AccessKey(lruReadDataCacheList_.back()))) {
+        g_s3MultiManagerMetric->readCacheReject << 1;
+        return false;
+    }
     // trim cache without consider dataCache's size, because its size is
     // expected to be very smaller than `readCacheMaxByte_`
     if (lruByte_ >= readCacheMaxByte_) {
@@ -122,6 +151,9 @@ bool FsCacheManager::Set(DataCachePtr dataCache,
         releaseReadCache_.Release(&retired);
     }
 
+    if (sketch_ != nullptr) {
+        g_s3MultiManagerMetric->readCacheAdmit << 1;
+    }
     lruByte_ += dataCache->GetActualLen();
     dataCache->SetReadCacheState(true);
     lruReadDataCacheList_.push_front(std::move(dataCache));
@@ -264,7 +296,7 @@ FileCacheManager::FindOrCreateChunkCacheManager(uint64_t index) {
     }
 
     ChunkCacheManagerPtr chunkCacheManager =
-        std::make_shared<ChunkCacheManager>(index, s3ClientAdaptor_);
+        std::make_shared<ChunkCacheManager>(index, s3ClientAdaptor_, inode_);
     auto ret = chunkCacheMap_.emplace(index, chunkCacheManager);
     g_s3MultiManagerMetric->chunkCacheNum << 1;
     assert(ret.second);
@@ -275,6 +307,8 @@ FileCacheManager::FindOrCreateChunkCacheManager(uint64_t index) {
 int FileCacheManager::Read(uint64_t inodeId, uint64_t offset, uint64_t length,
                            char *dataBuf) {
     uint64_t chunkSize = s3ClientAdaptor_->GetChunkSize();
+    uint64_t start = butil::cpuwide_time_us();
+    auto fsCacheManager = s3ClientAdaptor_->GetFsCacheManager();
     uint64_t index = offset / chunkSize;
     uint64_t chunkPos = offset % chunkSize;
     uint64_t readLen = 0;
@@ -291,6 +325,9 @@ int FileCacheManager::Read(uint64_t inodeId, uint64_t offset, uint64_t length,
         } else {
             readLen = length;
         }
+        if (fsCacheManager != nullptr) {
+            fsCacheManager->RecordAccess(inode_, index, chunkPos, readLen);
+        }
         ChunkCacheManagerPtr chunkCacheManager =
         FindOrCreateChunkCacheManager(index);
         chunkCacheManager->ReadChunk(index, chunkPos, readLen, dataBuf,
@@ -303,6 +340,17 @@ int FileCacheManager::Read(uint64_t inodeId, uint64_t offset, uint64_t length,
         chunkPos = (chunkPos + readLen) % chunkSize;
     }
 
+    // bytes read from memory cache
+    uint64_t missLen = 0;
+    for (const auto &request : totalRequests) {
+        missLen += request.len;
+    }
+    if (readOffset > missLen && s3ClientAdaptor_->s3Metric_.get() != nullptr) {
+        s3ClientAdaptor_->CollectMetrics(
+            &s3ClientAdaptor_->s3Metric_->adaptorReadMemCache,
+            readOffset - missLen, start);
+    }
+
     if (totalRequests.empty()) {
         VLOG(3) << "read cache is all the hits.";
         return readOffset;
@@ -343,10 +391,12 @@ int FileCacheManager::Read(uint64_t inodeId, uint64_t offset, uint64_t length,
                         memset(dataBuf + iter->bufOffset, 0, iter->len);
                         continue;
                     }
+                    const S3ChunkInfoIndex *s3InfoIndex =
+                        inodeWrapper->GetS3ChunkInfoIndexUnlocked(iter->index);
                     std::vector<S3ReadRequest> s3Requests;
-                    GenerateS3Request(*iter, s3InfoListIter->second, dataBuf,
-                                      &s3Requests, inode->fsid(),
-                                      inode->inodeid());
+                    GenerateS3Request(*iter, s3InfoListIter->second,
+                                      *s3InfoIndex, dataBuf, &s3Requests,
+                                      inode->fsid(), inode->inodeid());
                     totalS3Requests.insert(totalS3Requests.end(),
                                            s3Requests.begin(),
                                            s3Requests.end());
@@ -451,6 +501,15 @@ int FileCacheManager::ReadFromS3(const std::vector<S3ReadRequest> &requests,
                 << ",objectOffset:" << objectOffset << ",chunkid"
                 << iter->chunkId << ",fsid" << iter->fsId
                 << ",inodeId:" << iter->inodeId;
+        if (iter->packId != 0) {
+            int ret = ReadFromPack(*iter, response.GetDataBuf());
+            if (ret < 0) {
+                return ret;
+            }
+            response.SetReadOffset(iter->readOffset);
+            responses->emplace_back(std::move(response));
+            continue;
+        }
         // prefetch read
         if (s3ClientAdaptor_->HasDiskCache()) {
             uint64_t blockIndexTmp = blockIndex;
@@ -608,6 +667,40 @@ class AsyncPrefetchCallback {
     S3ClientAdaptorImpl *s3Client_;
 };
 
+int FileCacheManager::ReadFromPack(const S3ReadRequest &request,
+                                   char *buf) {
+    std::string name =
+        curvefs::common::s3util::GenPackName(request.fsId, request.packId);
+    uint64_t start = butil::cpuwide_time_us();
+    int ret = 0;
+    if (s3ClientAdaptor_->HasDiskCache() &&
+        s3ClientAdaptor_->GetDiskCacheManager()->IsCached(name)) {
+        VLOG(9) << "cached in disk: " << name;
+        ret = s3ClientAdaptor_->GetDiskCacheManager()->Read(
+            name, buf, request.packOffset, request.len);
+        if (s3ClientAdaptor_->s3Metric_.get() != nullptr) {
+            s3ClientAdaptor_->CollectMetrics(
+                &s3ClientAdaptor_->s3Metric_->adaptorReadDiskCache,
+                request.len, start);
+        }
+    } else {
+        VLOG(9) << "not cached in disk: " << name;
+        ret = s3ClientAdaptor_->GetS3Client()->Download(
+            name, buf, request.packOffset, request.len);
+        if (s3ClientAdaptor_->s3Metric_.get() != nullptr) {
+            s3ClientAdaptor_->CollectMetrics(
+                &s3ClientAdaptor_->s3Metric_->adaptorReadS3, request.len,
+                start);
+        }
+    }
+    if (ret < 0) {
+        LOG(ERROR) << "get pack obj failed, name is: " << name
+                   << ", offset is: " << request.packOffset
+                   << ", len: " << request.len << ", ret is: " << ret;
+    }
+    return ret;
+}
+
 void FileCacheManager::PrefetchS3Objs(std::vector<std::string> prefetchObjs) {
     uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
     for (auto &obj : prefetchObjs) {
@@ -706,6 +799,9 @@ void FileCacheManager::HandleReadRequest(
                 s3Request.compaction = s3ChunkInfo.compaction();
                 s3Request.fsId = fsId;
                 s3Request.inodeId = inodeId;
+                s3Request.packId = s3ChunkInfo.packid();
+                s3Request.packOffset = s3ChunkInfo.packoffset() +
+                                       s3Request.offset - s3ChunkInfoOffset;
                 requests->push_back(s3Request);
             }
             /*
@@ -726,6 +822,9 @@ void FileCacheManager::HandleReadRequest(
                 s3Request.compaction = s3ChunkInfo.compaction();
                 s3Request.fsId = fsId;
                 s3Request.inodeId = inodeId;
+                s3Request.packId = s3ChunkInfo.packid();
+                s3Request.packOffset = s3ChunkInfo.packoffset() +
+                                       s3Request.offset - s3ChunkInfoOffset;
                 requests->push_back(s3Request);
             }
             ReadRequest splitRequest;
@@ -767,6 +866,9 @@ void FileCacheManager::HandleReadRequest(
                 s3Request.compaction = s3ChunkInfo.compaction();
                 s3Request.fsId = fsId;
                 s3Request.inodeId = inodeId;
+                s3Request.packId = s3ChunkInfo.packid();
+                s3Request.packOffset = s3ChunkInfo.packoffset() +
+                                       s3Request.offset - s3ChunkInfoOffset;
                 requests->push_back(s3Request);
             }
             /*
@@ -791,6 +893,9 @@ void FileCacheManager::HandleReadRequest(
                 s3Request.compaction = s3ChunkInfo.compaction();
                 s3Request.fsId = fsId;
                 s3Request.inodeId = inodeId;
+                s3Request.packId = s3ChunkInfo.packid();
+                s3Request.packOffset = s3ChunkInfo.packoffset() +
+                                       s3Request.offset - s3ChunkInfoOffset;
                 requests->push_back(s3Request);
             }
             readOffset += s3ChunkInfoOffset + s3ChunkInfoLen - fileOffset;
@@ -813,63 +918,52 @@ void FileCacheManager::HandleReadRequest(
 }
 
 
-void FileCacheManager::GenerateS3Request(ReadRequest request,
-                                         const S3ChunkInfoList &s3ChunkInfoList,
-                                         char *dataBuf,
-                                         std::vector<S3ReadRequest> *requests,
-                                         uint64_t fsId, uint64_t inodeId) {
-    // first is chunkPos, user read request is split into multiple,
-    // and emplace in the readRequests;
-    std::map<uint64_t, ReadRequest> readRequests;
-
+void FileCacheManager::GenerateS3Request(
+    ReadRequest request, const S3ChunkInfoList &s3ChunkInfoList,
+    const S3ChunkInfoIndex &s3ChunkInfoIndex, char *dataBuf,
+    std::vector<S3ReadRequest> *requests, uint64_t fsId, uint64_t inodeId) {
     VLOG(9) << "GenerateS3Request start request index:" << request.index
             << ",chunkPos:" << request.chunkPos << ",len:" << request.len
             << ",bufOffset:" << request.bufOffset;
-    readRequests.emplace(request.chunkPos, request);
-    for (int i = s3ChunkInfoList.s3chunks_size() - 1; i >= 0; i--) {
-        const S3ChunkInfo &s3ChunkInfo = s3ChunkInfoList.s3chunks(i);
-        // readRequests is split by current s3ChunkInfo, emplace_back to the
-        // addReadRequests
-        std::vector<ReadRequest> addReadRequests;
-        // if readRequest is split to one or two, old readRequest should be
-        // delete,
-        std::vector<uint64_t> deletingReq;
-        for (auto readRequestIter = readRequests.begin();
-             readRequestIter != readRequests.end(); readRequestIter++) {
-            HandleReadRequest(readRequestIter->second, s3ChunkInfo,
-                              &addReadRequests, &deletingReq, requests, dataBuf,
-                              fsId, inodeId);
-        }
-
-        for (auto iter = deletingReq.begin(); iter != deletingReq.end();
-             iter++) {
-            readRequests.erase(*iter);
-        }
-
-        for (auto addIter = addReadRequests.begin();
-             addIter != addReadRequests.end(); addIter++) {
-            auto ret = readRequests.emplace(addIter->chunkPos, *addIter);
-            if (!ret.second) {
-                LOG(ERROR) << "read request emplace failed. chunkPos:"
-                           << addIter->chunkPos << ",len:" << addIter->len
-                           << ",index:" << addIter->index
-                           << ",bufOffset:" << addIter->bufOffset;
-            }
-        }
 
-        if (readRequests.empty()) {
-            VLOG(6) << "readRequests has hit s3ChunkInfos.";
-            break;
-        }
-    }
-
-    for (auto emptyIter = readRequests.begin(); emptyIter != readRequests.end();
-         emptyIter++) {
-        VLOG(9) << "empty buf index:" << emptyIter->second.index
-                << ", chunkPos:" << emptyIter->second.chunkPos
-                << ", len:" << emptyIter->second.len
-                << ", bufOffset:" << emptyIter->second.bufOffset;
-        memset(dataBuf + emptyIter->second.bufOffset, 0, emptyIter->second.len);
+    uint64_t chunkSize = s3ClientAdaptor_->GetChunkSize();
+    uint64_t chunkStart = request.index * chunkSize;
+    uint64_t fileOffset = chunkStart + request.chunkPos;
+    std::vector<S3ChunkInfoIndex::Extent> extents;
+    s3ChunkInfoIndex.Find(fileOffset, request.len, &extents);
+
+    // each extent is covered by one s3chunkinfo entirely, so it's not split
+    // by HandleReadRequest
+    std::vector<ReadRequest> addReadRequests;
+    std::vector<uint64_t> deletingReq;
+    uint64_t pos = fileOffset;
+    for (const auto &extent : extents) {
+        if (extent.offset > pos) {
+            VLOG(9) << "empty buf index:" << request.index
+                    << ", chunkPos:" << pos - chunkStart
+                    << ", len:" << extent.offset - pos;
+            memset(dataBuf + request.bufOffset + (pos - fileOffset), 0,
+                   extent.offset - pos);
+        }
+
+        ReadRequest extentRequest;
+        extentRequest.index = request.index;
+        extentRequest.chunkPos = extent.offset - chunkStart;
+        extentRequest.len = extent.len;
+        extentRequest.bufOffset =
+            request.bufOffset + (extent.offset - fileOffset);
+        HandleReadRequest(extentRequest, s3ChunkInfoList.s3chunks(extent.pos),
+                          &addReadRequests, &deletingReq, requests, dataBuf,
+                          fsId, inodeId);
+        pos = extent.offset + extent.len;
+    }
+
+    if (pos < fileOffset + request.len) {
+        VLOG(9) << "empty buf index:" << request.index
+                << ", chunkPos:" << pos - chunkStart
+                << ", len:" << fileOffset + request.len - pos;
+        memset(dataBuf + request.bufOffset + (pos - fileOffset), 0,
+               fileOffset + request.len - pos);
     }
 
     auto s3RequestIter = requests->begin();
@@ -2206,6 +2300,16 @@ CURVEFS_ERROR DataCache::Flush(uint64_t inodeId, bool toS3) {
         s3ClientAdaptor_->IsReadWriteCache() &&
         !s3ClientAdaptor_->GetDiskCacheManager()->IsDiskCacheFull() &&
         !toS3;
+    uint64_t packId = 0;
+    uint64_t packOffset = 0;
+    bool packed = useDiskCache &&
+                  FlushToPack(inodeId, chunkId, data, &packId, &packOffset);
+    if (packed) {
+        // data is in the pack file of disk cache now, which will be
+        // uploaded as a whole
+        tmpLen = 0;
+        writeOffset = len_;
+    }
     while (tmpLen > 0) {
         if (blockPos + tmpLen > blockSize) {
             n = blockSize - blockPos;
@@ -2233,7 +2337,7 @@ CURVEFS_ERROR DataCache::Flush(uint64_t inodeId, bool toS3) {
     pendingReq.fetch_add(uploadTasks.size(), std::memory_order_seq_cst);
     VLOG(9) << "DataCache::Flush data cache flush pendingReq init: "
         << pendingReq.load(std::memory_order_seq_cst);
-    assert(pendingReq.load(std::memory_order_seq_cst) != 0);
+    assert(packed || pendingReq.load(std::memory_order_seq_cst) != 0);
     if (pendingReq.load(std::memory_order_seq_cst)) {
         VLOG(9) << "wait for pendingReq";
         for (auto iter = uploadTasks.begin(); iter != uploadTasks.end();
@@ -2265,6 +2369,10 @@ CURVEFS_ERROR DataCache::Flush(uint64_t inodeId, bool toS3) {
 
         S3ChunkInfo info;
         PrepareS3ChunkInfo(chunkId, offset, writeOffset, &info);
+        if (packed) {
+            info.set_packid(packId);
+            info.set_packoffset(packOffset);
+        }
         inodeWrapper->AppendS3ChunkInfo(chunkIndex, info);
         s3ClientAdaptor_->GetInodeCacheManager()->ShipToFlush(inodeWrapper);
     }
@@ -2272,6 +2380,38 @@ CURVEFS_ERROR DataCache::Flush(uint64_t inodeId, bool toS3) {
     return CURVEFS_ERROR::OK;
 }
 
+bool DataCache::FlushToPack(uint64_t inodeId, uint64_t chunkId,
+                            const char *data, uint64_t *packId,
+                            uint64_t *packOffset) {
+    auto diskCacheManager = s3ClientAdaptor_->GetDiskCacheManager();
+    if (!diskCacheManager->IsPackable(len_)) {
+        return false;
+    }
+
+    // small objects of inodes in the same partition share one pack, so the
+    // pack can be collected by the metaserver of that partition
+    PartitionID partitionId;
+    if (!s3ClientAdaptor_->GetInodeCacheManager()->GetPartitionId(
+            inodeId, &partitionId)) {
+        LOG(WARNING) << "get partition id fail, inodeId: " << inodeId;
+        return false;
+    }
+
+    // the chunkId is used as pack id if a new pack is opened
+    int ret = diskCacheManager->WritePack(s3ClientAdaptor_->GetFsId(),
+                                          partitionId, chunkId, data, len_,
+                                          packId, packOffset);
+    if (ret < 0) {
+        LOG(WARNING) << "write pack fail, inodeId: " << inodeId
+                     << ", len: " << len_ << ", ret: " << ret;
+        return false;
+    }
+    VLOG(9) << "flush to pack, inodeId: " << inodeId
+            << ", packId: " << *packId << ", packOffset: " << *packOffset
+            << ", len: " << len_;
+    return true;
+}
+
 void DataCache::PrepareS3ChunkInfo(uint64_t chunkId, uint64_t offset,
     uint64_t len, S3ChunkInfo *info) {
     info->set_chunkid(chunkId);
@@ -36,6 +36,8 @@
 #include "curvefs/proto/metaserver.pb.h"
 #include "curvefs/src/client/error_code.h"
 #include "curvefs/src/client/s3/client_s3.h"
+#include "curvefs/src/client/s3/frequency_sketch.h"
+#include "curvefs/src/client/s3/s3_chunk_info_index.h"
 #include "curvefs/src/client/common/common.h"
 #include "src/common/concurrent/concurrent.h"
 #include "src/common/timeutility.h"
@@ -82,6 +84,8 @@ struct S3ReadRequest {
     uint64_t fsId;
     uint64_t inodeId;
     uint64_t compaction;
+    uint64_t packId;      // 0 if the data is not packed
+    uint64_t packOffset;  // offset in pack obj of the data at offset
 };
 
 struct ObjectChunkInfo {
@@ -142,6 +146,7 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
     }
 
     uint64_t GetActualLen() { return actualLen_; }
+    ChunkCacheManagerPtr GetChunkCacheManager() { return chunkCacheManager_; }
 
     virtual CURVEFS_ERROR Flush(uint64_t inodeId, bool toS3 = false);
     void Release();
@@ -172,6 +177,8 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
  private:
     void PrepareS3ChunkInfo(uint64_t chunkId, uint64_t offset,
         uint64_t len, S3ChunkInfo *info);
+    bool FlushToPack(uint64_t inodeId, uint64_t chunkId, const char *data,
+                     uint64_t *packId, uint64_t *packOffset);
     void CopyBufToDataCache(uint64_t dataCachePos, uint64_t len,
                              const char *data);
     void AddDataBefore(uint64_t len, const char *data);
@@ -212,8 +219,9 @@ class S3ReadResponse {
 class ChunkCacheManager
     : public std::enable_shared_from_this<ChunkCacheManager> {
  public:
-    ChunkCacheManager(uint64_t index, S3ClientAdaptorImpl *s3ClientAdaptor)
-        : index_(index), s3ClientAdaptor_(s3ClientAdaptor),
+    ChunkCacheManager(uint64_t index, S3ClientAdaptorImpl *s3ClientAdaptor,
+                      uint64_t inodeId = 0)
+        : index_(index), inodeId_(inodeId), s3ClientAdaptor_(s3ClientAdaptor),
           flushingDataCache_(nullptr) {}
     virtual ~ChunkCacheManager() = default;
     void ReadChunk(uint64_t index, uint64_t chunkPos, uint64_t readLen,
@@ -239,6 +247,7 @@ class ChunkCacheManager
     virtual CURVEFS_ERROR Flush(uint64_t inodeId, bool force,
                                 bool toS3 = false);
     uint64_t GetIndex() { return index_; }
+    uint64_t GetInodeId() { return inodeId_; }
     bool IsEmpty() {
         ReadLockGuard writeCacheLock(rwLockChunk_);
         return (dataWCacheMap_.empty() && dataRCacheMap_.empty());
@@ -270,6 +279,7 @@ class ChunkCacheManager
     }
  private:
     uint64_t index_;
+    uint64_t inodeId_;
     std::map<uint64_t, DataCachePtr> dataWCacheMap_;  // first is pos in chunk
     std::map<uint64_t, std::list<DataCachePtr>::iterator>
         dataRCacheMap_;  // first is pos in chunk
@@ -310,11 +320,13 @@ class FileCacheManager {
                     const char *dataBuf);
     void GenerateS3Request(ReadRequest request,
                            const S3ChunkInfoList &s3ChunkInfoList,
+                           const S3ChunkInfoIndex &s3ChunkInfoIndex,
                            char *dataBuf, std::vector<S3ReadRequest> *requests,
                            uint64_t fsId, uint64_t inodeId);
     int ReadFromS3(const std::vector<S3ReadRequest> &requests,
                             std::vector<S3ReadResponse> *responses,
                             uint64_t fileLen);
+    int ReadFromPack(const S3ReadRequest &request, char *buf);
     void PrefetchS3Objs(std::vector<std::string> prefetchObjs);
     void HandleReadRequest(const ReadRequest &request,
                            const S3ChunkInfo &s3ChunkInfo,
@@ -353,6 +365,14 @@ class FsCacheManager {
                                                      uint64_t inodeId);
     void ReleaseFileCacheManager(uint64_t inodeId);
 
+    // enable TinyLFU admission of read cache, data cache evicting the
+    // least recently used one is admitted only if it's accessed more often
+    void EnableAdmission(uint64_t blockSize);
+
+    // record an access to the block of file, for read cache admission
+    void RecordAccess(uint64_t inodeId, uint64_t chunkIndex,
+                      uint64_t chunkPos, uint64_t len);
+
     bool Set(DataCachePtr dataCache,
              std::list<DataCachePtr>::iterator *outIter);
     bool Delete(std::list<DataCachePtr>::iterator iter);
@@ -438,6 +458,18 @@ class FsCacheManager {
     }
 
  private:
+    uint64_t AccessKey(uint64_t inodeId, uint64_t chunkIndex,
+                       uint64_t chunkPos) {
+        return (inodeId << 32) ^ (chunkIndex << 16) ^ (chunkPos / blockSize_);
+    }
+
+    uint64_t AccessKey(const DataCachePtr &dataCache) {
+        auto chunkCacheManager = dataCache->GetChunkCacheManager();
+        return AccessKey(chunkCacheManager->GetInodeId(),
+                         chunkCacheManager->GetIndex(),
+                         dataCache->GetChunkPos());
+    }
+
     class ReadCacheReleaseExecutor {
      public:
         ReadCacheReleaseExecutor();
@@ -470,6 +502,9 @@ class FsCacheManager {
     std::atomic<uint64_t> wDataCacheByte_;
     uint64_t readCacheMaxByte_;
     uint64_t writeCacheMaxByte_;
+    // admission policy of read cache, nullptr if disabled
+    std::unique_ptr<FrequencySketch> sketch_;
+    uint64_t blockSize_ = 0;
     S3ClientAdaptorImpl *s3ClientAdaptor_;
     bool isWaiting_;
     std::mutex mutex_;
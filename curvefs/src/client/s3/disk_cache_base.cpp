@@ -26,6 +26,10 @@
 #include <fcntl.h>
 #include <sys/types.h>
 #include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
 
 #include "curvefs/src/client/s3/disk_cache_base.h"
 
@@ -36,6 +40,25 @@ namespace client {
 #define CACHE_WRITE_DIR "cachewrite"
 #define CACHE_READ_DIR  "cacheread"
 
+namespace {
+
+// alignment of buffer, offset and length required by O_DIRECT
+const uint64_t kDirectIOAlignment = 4096;
+
+uint64_t AlignUp(uint64_t value) {
+    return (value + kDirectIOAlignment - 1) & ~(kDirectIOAlignment - 1);
+}
+
+char *AllocAligned(uint64_t size) {
+    void *buf = nullptr;
+    if (posix_memalign(&buf, kDirectIOAlignment, size) != 0) {
+        return nullptr;
+    }
+    return reinterpret_cast<char *>(buf);
+}
+
+}  // namespace
+
 void DiskCacheBase::Init(std::shared_ptr<PosixWrapper> wrapper,
                          const std::string cacheDir) {
     cacheDir_ = cacheDir;
@@ -119,5 +142,73 @@ int DiskCacheBase::LoadAllCacheFile(std::set<std::string> *cachedObj) {
     return 0;
 }
 
+int DiskCacheBase::OpenCacheFile(const std::string &path, int flags,
+                                 bool *direct) {
+    *direct = false;
+    if (directIO_) {
+        int fd = posixWrapper_->open(path.c_str(), flags | O_DIRECT, MODE);
+        if (fd >= 0 || errno != EINVAL) {
+            *direct = (fd >= 0);
+            return fd;
+        }
+        // file system of cache dir doesn't support O_DIRECT, e.g. tmpfs
+        LOG_FIRST_N(WARNING, 1) << "open with O_DIRECT failed, use buffered io"
+                                << ", dir = " << cacheDir_;
+    }
+    return posixWrapper_->open(path.c_str(), flags, MODE);
+}
+
+ssize_t DiskCacheBase::DirectWrite(int fd, const char *buf, uint64_t length) {
+    uint64_t alignedLen = AlignUp(length);
+    char *alignedBuf = AllocAligned(alignedLen);
+    if (alignedBuf == nullptr) {
+        LOG(ERROR) << "alloc aligned buffer failed, size = " << alignedLen;
+        return -1;
+    }
+    memcpy(alignedBuf, buf, length);
+    memset(alignedBuf + length, 0, alignedLen - length);
+    ssize_t ret = posixWrapper_->pwrite(fd, alignedBuf, alignedLen, 0);
+    free(alignedBuf);
+    if (ret < 0 || static_cast<uint64_t>(ret) < alignedLen) {
+        LOG(ERROR) << "direct write error, ret = " << ret
+                   << ", errno = " << errno << ", length = " << alignedLen;
+        return -1;
+    }
+    // drop the padding
+    if (posixWrapper_->ftruncate(fd, length) < 0) {
+        LOG(ERROR) << "ftruncate error, errno = " << errno
+                   << ", length = " << length;
+        return -1;
+    }
+    return length;
+}
+
+ssize_t DiskCacheBase::DirectRead(int fd, char *buf, uint64_t offset,
+                                  uint64_t length) {
+    uint64_t start = offset & ~(kDirectIOAlignment - 1);
+    uint64_t alignedLen = AlignUp(offset + length) - start;
+    char *alignedBuf = AllocAligned(alignedLen);
+    if (alignedBuf == nullptr) {
+        LOG(ERROR) << "alloc aligned buffer failed, size = " << alignedLen;
+        return -1;
+    }
+    ssize_t ret = posixWrapper_->pread(fd, alignedBuf, alignedLen, start);
+    if (ret < 0) {
+        LOG(ERROR) << "direct read error, ret = " << ret
+                   << ", errno = " << errno << ", offset = " << start
+                   << ", length = " << alignedLen;
+        free(alignedBuf);
+        return ret;
+    }
+    uint64_t head = offset - start;
+    uint64_t readLen = 0;
+    if (static_cast<uint64_t>(ret) > head) {
+        readLen = std::min(static_cast<uint64_t>(ret) - head, length);
+        memcpy(buf, alignedBuf + head, readLen);
+    }
+    free(alignedBuf);
+    return readLen;
+}
+
 }  // namespace client
 }  // namespace curvefs
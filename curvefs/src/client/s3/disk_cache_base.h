@@ -58,9 +58,35 @@ class DiskCacheBase {
 
     virtual int LoadAllCacheFile(std::set<std::string> *cachedObj);
 
+    /**
+     * @brief Read/Write cache file with O_DIRECT, bypassing page cache.
+    */
+    void SetDirectIO(bool directIO) { directIO_ = directIO; }
+
+ protected:
+    /**
+     * @brief Open cache file, with O_DIRECT if direct io is enabled and
+     *        supported by the file system of cache dir.
+     * @param[out] direct whether the file is opened with O_DIRECT
+    */
+    int OpenCacheFile(const std::string &path, int flags, bool *direct);
+    /**
+     * @brief Write the whole file opened with O_DIRECT from the beginning.
+     *        Data is padded to alignment and file is truncated to length.
+     * @return length written, or < 0 if failed
+    */
+    ssize_t DirectWrite(int fd, const char *buf, uint64_t length);
+    /**
+     * @brief Read file opened with O_DIRECT.
+     * @return length read, which is less than length at end of file,
+     *         or < 0 if failed
+    */
+    ssize_t DirectRead(int fd, char *buf, uint64_t offset, uint64_t length);
+
  private:
     std::string cacheIoDir_;
     std::string cacheDir_;
+    bool directIO_ = false;
 
     // file system operation encapsulation
     std::shared_ptr<PosixWrapper> posixWrapper_;
@@ -86,7 +86,11 @@ int DiskCacheManager::Init(S3Client *client,
 
     cacheWrite_->Init(client_, posixWrapper_, cacheDir_,
                       option.diskCacheOpt.asyncLoadPeriodMs, cachedObjName_);
+    cacheWrite_->InitPack(option.diskCacheOpt.packSize,
+                          option.diskCacheOpt.packLingerMs);
     cacheRead_->Init(posixWrapper_, cacheDir_);
+    cacheWrite_->SetDirectIO(option.diskCacheOpt.directIO);
+    cacheRead_->SetDirectIO(option.diskCacheOpt.directIO);
     int ret;
     ret = CreateDir();
     if (ret < 0) {
@@ -128,6 +132,7 @@ int DiskCacheManager::Init(S3Client *client,
               << ", cmdTimeoutSec is: " << cmdTimeoutSec_
               << ", safeRatio is: " << safeRatio_
               << ", fullRatio is: " << fullRatio_
+              << ", directIO is: " << option.diskCacheOpt.directIO
               << ", disk used bytes: " << GetDiskUsedbytes();
     return 0;
 }
@@ -174,6 +179,7 @@ bool DiskCacheManager::IsCached(const std::string name) {
 int DiskCacheManager::UmountDiskCache() {
     LOG(INFO) << "umount disk cache.";
     int ret;
+    cacheWrite_->SealAllPacks();
     ret = cacheWrite_->UploadAllCacheWriteFile();
     if (ret < 0) {
         LOG(ERROR) << "umount disk cache error.";
@@ -231,6 +237,21 @@ int DiskCacheManager::WriteDiskFile(const std::string fileName, const char *buf,
     return ret;
 }
 
+int DiskCacheManager::WritePackFile(uint32_t fsId, uint32_t partitionId,
+                                    uint64_t packId, const char *buf,
+                                    uint64_t length, bool force,
+                                    uint64_t *usedPackId,
+                                    uint64_t *packOffset) {
+    // write throttle
+    diskCacheThrottle_.Add(false, length);
+    int ret = cacheWrite_->WritePackFile(fsId, partitionId, packId, buf,
+                                         length, force, usedPackId,
+                                         packOffset);
+    if (ret > 0)
+        AddDiskUsedBytes(ret);
+    return ret;
+}
+
 void DiskCacheManager::AsyncUploadEnqueue(const std::string objName) {
     cacheWrite_->AsyncUploadEnqueue(objName);
 }
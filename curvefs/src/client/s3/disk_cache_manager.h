@@ -81,6 +81,9 @@ class DiskCacheManager {
 
     int WriteDiskFile(const std::string fileName, const char *buf,
                       uint64_t length, bool force = true);
+    int WritePackFile(uint32_t fsId, uint32_t partitionId, uint64_t packId,
+                      const char *buf, uint64_t length, bool force,
+                      uint64_t *usedPackId, uint64_t *packOffset);
     void AsyncUploadEnqueue(const std::string objName);
     virtual int WriteReadDirect(const std::string fileName, const char *buf,
                                 uint64_t length);
@@ -28,6 +28,7 @@
 
 #include "curvefs/src/client/s3/client_s3_adaptor.h"
 #include "curvefs/src/client/s3/disk_cache_manager_impl.h"
+#include "curvefs/src/common/s3util.h"
 
 namespace curvefs {
 
@@ -48,6 +49,7 @@ int DiskCacheManagerImpl::Init(const S3ClientAdaptorOption option) {
     }
 
     forceFlush_ = option.diskCacheOpt.forceFlush;
+    packMaxObjSize_ = option.diskCacheOpt.packMaxObjSize;
     threads_ = option.diskCacheOpt.threads;
     taskPool_.Start(threads_);
     LOG(INFO) << "DiskCacheManagerImpl init end.";
@@ -123,6 +125,44 @@ int DiskCacheManagerImpl::WriteDiskFile(const std::string name, const char *buf,
     return writeRet;
 }
 
+bool DiskCacheManagerImpl::IsPackable(uint64_t length) {
+    return packMaxObjSize_ > 0 && length <= packMaxObjSize_;
+}
+
+int DiskCacheManagerImpl::WritePack(uint32_t fsId, uint32_t partitionId,
+                                    uint64_t packId, const char *buf,
+                                    uint64_t length, uint64_t *usedPackId,
+                                    uint64_t *packOffset) {
+    VLOG(9) << "write pack, partitionId = " << partitionId
+            << ", length = " << length;
+    if (diskCacheManager_->IsDiskCacheFull()) {
+        VLOG(6) << "write pack fail, disk full.";
+        return -1;
+    }
+    int ret = diskCacheManager_->WritePackFile(fsId, partitionId, packId, buf,
+                                               length, forceFlush_,
+                                               usedPackId, packOffset);
+    if (ret < 0) {
+        LOG(ERROR) << "write pack file error. ret = " << ret;
+        return ret;
+    }
+    // the pack is still being appended, link it every time so that the obj
+    // can be read from cache once written, EEXIST is ignored
+    std::string name =
+        curvefs::common::s3util::GenPackName(fsId, *usedPackId);
+    int linkRet = diskCacheManager_->LinkWriteToRead(
+        name, diskCacheManager_->GetCacheWriteFullDir(),
+        diskCacheManager_->GetCacheReadFullDir());
+    if (linkRet < 0) {
+        LOG(ERROR) << "link pack file to read error. linkRet = " << linkRet;
+        return linkRet;
+    }
+    diskCacheManager_->AddCache(name);
+    VLOG(9) << "write pack success, pack = " << name
+            << ", offset = " << *packOffset;
+    return 0;
+}
+
 int DiskCacheManagerImpl::WriteReadDirect(const std::string fileName,
                                           const char *buf, uint64_t length) {
     if (diskCacheManager_->IsDiskCacheFull()) {
@@ -85,6 +85,21 @@ class DiskCacheManagerImpl {
      * @return success: write length, fail : < 0
      */
     int Write(const std::string name, const char *buf, uint64_t length);
+    /**
+     * @brief whether obj of length should be written to a pack
+     */
+    virtual bool IsPackable(uint64_t length);
+    /**
+     * @brief write small obj to the open pack of partition, the pack is
+     *        uploaded as one obj, so that small objs cost less puts
+     * @param[in] packId id of the new pack if a pack need to be opened
+     * @param[out] usedPackId id of the pack which obj is written to
+     * @param[out] packOffset obj offset in the pack
+     * @return success: 0, fail : < 0
+     */
+    virtual int WritePack(uint32_t fsId, uint32_t partitionId,
+                          uint64_t packId, const char *buf, uint64_t length,
+                          uint64_t *usedPackId, uint64_t *packOffset);
     /**
      * @brief whether obj is cached in cached disk
      * @param[in] name obj name
@@ -124,6 +139,7 @@ class DiskCacheManagerImpl {
     std::shared_ptr<DiskCacheManager> diskCacheManager_;
 
     bool forceFlush_;
+    uint64_t packMaxObjSize_ = 0;
     S3Client *client_;
 
     int WriteClosure(std::shared_ptr<PutObjectAsyncContext> context);
@@ -49,12 +49,23 @@ int DiskCacheRead::ReadDiskFile(const std::string name, char *buf,
     std::string fileFullPath;
     int fd, ret;
     fileFullPath = GetCacheIoFullDir() + "/" + name;
-    fd = posixWrapper_->open(fileFullPath.c_str(), O_RDONLY, MODE);
+    bool direct;
+    fd = OpenCacheFile(fileFullPath, O_RDONLY, &direct);
     if (fd < 0) {
         LOG(ERROR) << "open disk file error. file = " << name
                    << ", errno = " << errno;
         return fd;
     }
+    if (direct) {
+        ssize_t readLen = DirectRead(fd, buf, offset, length);
+        posixWrapper_->close(fd);
+        if (readLen >= 0 && readLen < length) {
+            LOG(ERROR) << "read disk file is not entirely. read len = "
+                       << readLen << ", but want len = " << length
+                       << ", file = " << name;
+        }
+        return readLen;
+    }
     off_t seekPos = posixWrapper_->lseek(fd, offset, SEEK_SET);
     if (seekPos < 0) {
         LOG(ERROR) << "lseek disk file error. file = " << name
@@ -131,13 +142,15 @@ int DiskCacheRead::WriteDiskFile(const std::string fileName, const char *buf,
     std::string fileFullPath;
     int fd, ret;
     fileFullPath = GetCacheIoFullDir() + "/" + fileName;
-    fd = posixWrapper_->open(fileFullPath.c_str(), O_RDWR | O_CREAT, MODE);
+    bool direct;
+    fd = OpenCacheFile(fileFullPath, O_RDWR | O_CREAT, &direct);
     if (fd < 0) {
         LOG(ERROR) << "open disk file error. errno = " << errno
                    << ", file = " << fileName;
         return fd;
     }
-    ssize_t writeLen = posixWrapper_->write(fd, buf, length);
+    ssize_t writeLen = direct ? DirectWrite(fd, buf, length)
+                              : posixWrapper_->write(fd, buf, length);
     if (writeLen < 0 || writeLen < length) {
         LOG(ERROR) << "write disk file error. ret = " << writeLen
                    << ", file = " << fileName;
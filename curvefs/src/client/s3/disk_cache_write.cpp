@@ -30,6 +30,7 @@
 
 #include "curvefs/src/client/s3/disk_cache_write.h"
 #include "curvefs/src/common/s3util.h"
+#include "src/common/timeutility.h"
 
 namespace curvefs {
 
@@ -72,7 +73,8 @@ int DiskCacheWrite::ReadFile(const std::string name, char **buf,
     }
     off_t fileSize = statFile.st_size;
     *size = fileSize;
-    fd = posixWrapper_->open(fileFullPath.c_str(), O_RDONLY, MODE);
+    bool direct;
+    fd = OpenCacheFile(fileFullPath, O_RDONLY, &direct);
     if (fd < 0) {
         LOG(ERROR) << "open disk file error. errno = " << errno
                    << ", file = " << name;
@@ -94,7 +96,8 @@ int DiskCacheWrite::ReadFile(const std::string name, char **buf,
         posixWrapper_->close(fd);
         return -1;
     }
-    ssize_t readLen = posixWrapper_->read(fd, buffer, fileSize);
+    ssize_t readLen = direct ? DirectRead(fd, buffer, 0, fileSize)
+                             : posixWrapper_->read(fd, buffer, fileSize);
     if (readLen < 0) {
         LOG(ERROR) << "read file error, ret = " << readLen
                    << ", errno = " << errno << ", file = " << name;
@@ -194,9 +197,11 @@ int DiskCacheWrite::GetUploadFile(const std::string &inode,
         toUpload->swap(waitUpload_);
         return toUpload->size();
     }
+    // data of inode may be in any pack
     waitUpload_.remove_if([&](const std::string &filename) {
         bool inodeFile =
-            curvefs::common::s3util::ValidNameOfInode(inode, filename);
+            curvefs::common::s3util::ValidNameOfInode(inode, filename) ||
+            curvefs::common::s3util::IsPackName(filename);
         if (inodeFile) {
             toUpload->emplace_back(filename);
         }
@@ -216,8 +221,20 @@ int DiskCacheWrite::FileExist(const std::string &inode) {
         return ret;
     }
 
+    // sealed packs are waited too, but not the open ones, which are
+    // sealed after this upload
+    std::set<std::string> openPacks;
+    {
+        std::lock_guard<bthread::Mutex> lk(packMtx_);
+        for (const auto &item : openPacks_) {
+            openPacks.insert(item.second->name);
+        }
+    }
+
     for (auto iter = cachedObj.begin(); iter != cachedObj.end(); iter++) {
-        bool exist = curvefs::common::s3util::ValidNameOfInode(inode, *iter);
+        bool exist = curvefs::common::s3util::ValidNameOfInode(inode, *iter) ||
+                     (curvefs::common::s3util::IsPackName(*iter) &&
+                      openPacks.count(*iter) == 0);
         if (exist) {
             return 1;
         }
@@ -232,6 +249,9 @@ int DiskCacheWrite::UploadFileByInode(const std::string &inode) {
         return -1;
     }
 
+    // data of inode may be in the open packs
+    SealAllPacks();
+
     // upload file of inode
     std::list<std::string> toUpload;
     do {
@@ -281,6 +301,7 @@ int DiskCacheWrite::AsyncUploadFunc() {
             LOG(INFO) << "async upload thread stop.";
             return 0;
         }
+        SealPacks(false);
         toUpload.clear();
         if (GetUploadFile("", &toUpload) <= 0) {
             continue;
@@ -421,13 +442,15 @@ int DiskCacheWrite::WriteDiskFile(const std::string fileName, const char *buf,
     std::string fileFullPath;
     int fd, ret;
     fileFullPath = GetCacheIoFullDir() + "/" + fileName;
-    fd = posixWrapper_->open(fileFullPath.c_str(), O_RDWR | O_CREAT, MODE);
+    bool direct;
+    fd = OpenCacheFile(fileFullPath, O_RDWR | O_CREAT, &direct);
     if (fd < 0) {
         LOG(ERROR) << "open disk file error. errno = " << errno
                    << ", file = " << fileName;
         return fd;
     }
-    ssize_t writeLen = posixWrapper_->write(fd, buf, length);
+    ssize_t writeLen = direct ? DirectWrite(fd, buf, length)
+                              : posixWrapper_->write(fd, buf, length);
     if (writeLen < 0 || writeLen < length) {
         LOG(ERROR) << "write disk file error. ret: " << writeLen
                    << ", file: " << fileName
@@ -459,5 +482,128 @@ int DiskCacheWrite::WriteDiskFile(const std::string fileName, const char *buf,
     return writeLen;
 }
 
+int DiskCacheWrite::WriteDiskFileAt(const std::string &fileName,
+                                    const char *buf, uint64_t length,
+                                    uint64_t offset, bool force) {
+    VLOG(6) << "WriteDiskFileAt start. name = " << fileName
+            << ", offset = " << offset << ", length = " << length;
+    std::string fileFullPath = GetCacheIoFullDir() + "/" + fileName;
+    int fd = posixWrapper_->open(fileFullPath.c_str(), O_RDWR | O_CREAT, MODE);
+    if (fd < 0) {
+        LOG(ERROR) << "open disk file error. errno = " << errno
+                   << ", file = " << fileName;
+        return fd;
+    }
+    ssize_t writeLen = posixWrapper_->pwrite(fd, buf, length, offset);
+    if (writeLen < 0 || writeLen < length) {
+        LOG(ERROR) << "write disk file error. ret: " << writeLen
+                   << ", file: " << fileName << ", offset: " << offset
+                   << ", error: " << errno;
+        posixWrapper_->close(fd);
+        return -1;
+    }
+
+    // force to flush
+    if (force) {
+        int ret = posixWrapper_->fdatasync(fd);
+        if (ret < 0) {
+            LOG(ERROR) << "fdatasync error. errno = " << errno
+                       << ", file = " << fileName;
+            posixWrapper_->close(fd);
+            return -1;
+        }
+    }
+
+    int ret = posixWrapper_->close(fd);
+    if (ret < 0) {
+        LOG(ERROR) << "close disk file error. errno = " << errno
+                   << ", file = " << fileName;
+        return -1;
+    }
+    return writeLen;
+}
+
+void DiskCacheWrite::InitPack(uint64_t packSize, uint64_t packLingerMs) {
+    packSize_ = packSize;
+    packLingerMs_ = packLingerMs;
+}
+
+int DiskCacheWrite::WritePackFile(uint32_t fsId, uint32_t partitionId,
+                                  uint64_t packId, const char *buf,
+                                  uint64_t length, bool force,
+                                  uint64_t *usedPackId, uint64_t *packOffset) {
+    // reserve space in the open pack, and write out of lock
+    std::shared_ptr<Pack> pack;
+    {
+        std::lock_guard<bthread::Mutex> lk(packMtx_);
+        auto iter = openPacks_.find(partitionId);
+        if (iter != openPacks_.end() &&
+            iter->second->size + length > packSize_) {
+            SealPackUnlocked(iter->second);
+            openPacks_.erase(iter);
+            iter = openPacks_.end();
+        }
+        if (iter == openPacks_.end()) {
+            pack = std::make_shared<Pack>();
+            pack->id = packId;
+            pack->name = curvefs::common::s3util::GenPackName(fsId, packId);
+            pack->size = 0;
+            pack->inflight = 0;
+            pack->openTimeMs = curve::common::TimeUtility::GetTimeofDayMs();
+            pack->sealed = false;
+            openPacks_.emplace(partitionId, pack);
+            VLOG(6) << "open pack " << pack->name
+                    << ", partitionId = " << partitionId;
+        } else {
+            pack = iter->second;
+        }
+        *packOffset = pack->size;
+        pack->size += length;
+        pack->inflight++;
+    }
+
+    int ret = WriteDiskFileAt(pack->name, buf, length, *packOffset, force);
+    {
+        // sealed pack is uploaded after the last append finished
+        std::lock_guard<bthread::Mutex> lk(packMtx_);
+        pack->inflight--;
+        if (pack->sealed && pack->inflight == 0) {
+            AsyncUploadEnqueue(pack->name);
+        }
+    }
+    if (ret < 0) {
+        LOG(ERROR) << "write pack file error, pack = " << pack->name
+                   << ", offset = " << *packOffset << ", length = " << length;
+        return ret;
+    }
+    *usedPackId = pack->id;
+    return ret;
+}
+
+void DiskCacheWrite::SealPackUnlocked(const std::shared_ptr<Pack> &pack) {
+    VLOG(6) << "seal pack " << pack->name << ", size = " << pack->size;
+    pack->sealed = true;
+    if (pack->inflight == 0) {
+        AsyncUploadEnqueue(pack->name);
+    }
+}
+
+void DiskCacheWrite::SealPacks(bool all) {
+    uint64_t now = curve::common::TimeUtility::GetTimeofDayMs();
+    std::lock_guard<bthread::Mutex> lk(packMtx_);
+    for (auto iter = openPacks_.begin(); iter != openPacks_.end();) {
+        if (all || iter->second->openTimeMs + packLingerMs_ <= now) {
+            SealPackUnlocked(iter->second);
+            iter = openPacks_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void DiskCacheWrite::SealAllPacks() {
+    SealPacks(true);
+}
+
 }  // namespace client
 }  // namespace curvefs
@@ -30,6 +30,7 @@
 #include <string>
 #include <list>
 #include <set>
+#include <unordered_map>
 
 #include "src/common/concurrent/concurrent.h"
 #include "src/common/interruptible_sleeper.h"
@@ -93,6 +94,28 @@ class DiskCacheWrite : public DiskCacheBase {
     virtual int WriteDiskFile(const std::string fileName,
                               const char* buf, uint64_t length,
                               bool force = true);
+    /**
+     * @brief set the options of packing small objs
+     * @param[in] packSize seal the pack once it's bigger than packSize
+     * @param[in] packLingerMs seal the pack after it's open for packLingerMs
+     */
+    void InitPack(uint64_t packSize, uint64_t packLingerMs);
+    /**
+     * @brief append obj to the open pack of partition in write cache disk,
+     *        the pack is uploaded as one obj after being sealed
+     * @param[in] packId id of the new pack if a pack need to be opened
+     * @param[out] usedPackId id of the pack which obj is appended to
+     * @param[out] packOffset obj offset in the pack
+     * @return success: write length, fail : < 0
+     */
+    virtual int WritePackFile(uint32_t fsId, uint32_t partitionId,
+                              uint64_t packId, const char* buf,
+                              uint64_t length, bool force,
+                              uint64_t* usedPackId, uint64_t* packOffset);
+    /**
+     * @brief seal all open packs, and upload them
+     */
+    virtual void SealAllPacks();
     /**
     * @brief after reboot，upload all files store in write cache to s3
     */
@@ -134,7 +157,24 @@ class DiskCacheWrite : public DiskCacheBase {
     }
 
  private:
+    // pack of small objs, appended by many inodes of one partition
+    struct Pack {
+        uint64_t id;
+        std::string name;
+        // bytes reserved by appends
+        uint64_t size;
+        // appends are writing to disk
+        uint32_t inflight;
+        uint64_t openTimeMs;
+        bool sealed;
+    };
+
     int AsyncUploadFunc();
+    int WriteDiskFileAt(const std::string& fileName, const char* buf,
+                        uint64_t length, uint64_t offset, bool force);
+    // seal packs open for packLingerMs_, or all of them
+    void SealPacks(bool all);
+    void SealPackUnlocked(const std::shared_ptr<Pack>& pack);
     void UploadFile(const std::list<std::string> &toUpload,
                     std::shared_ptr<SynchronizationTask> syncTask = nullptr);
     bool WriteCacheValid();
@@ -154,6 +194,12 @@ class DiskCacheWrite : public DiskCacheBase {
     std::shared_ptr<DiskCacheMetric> metric_;
 
     std::shared_ptr<LRUCache<std::string, bool>> cachedObjName_;
+
+    uint64_t packSize_ = 0;
+    uint64_t packLingerMs_ = 0;
+    // partition id -> open pack
+    std::unordered_map<uint32_t, std::shared_ptr<Pack>> openPacks_;
+    bthread::Mutex packMtx_;
 };
 
 }  // namespace client
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#include "curvefs/src/client/s3/frequency_sketch.h"
+
+#include <algorithm>
+
+namespace curvefs {
+namespace client {
+
+namespace {
+
+const uint64_t kSeeds[] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+                           0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+
+uint64_t Mix(uint64_t key, uint64_t seed) {
+    uint64_t h = (key + seed) * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 32;
+    h *= 0xd6e8feb86659fd93ULL;
+    h ^= h >> 32;
+    return h;
+}
+
+}  // namespace
+
+FrequencySketch::FrequencySketch(uint64_t capacity)
+    : width_(1024), additions_(0) {
+    while (width_ < capacity) {
+        width_ <<= 1;
+    }
+    table_.reset(new std::atomic<uint8_t>[width_ * kDepth]());
+    sampleSize_ = width_ * 10;
+}
+
+uint64_t FrequencySketch::IndexOf(uint64_t key, int row) const {
+    return row * width_ + (Mix(key, kSeeds[row]) & (width_ - 1));
+}
+
+void FrequencySketch::Increment(uint64_t key) {
+    bool added = false;
+    for (int i = 0; i < kDepth; i++) {
+        std::atomic<uint8_t> &counter = table_[IndexOf(key, i)];
+        uint8_t count = counter.load(std::memory_order_relaxed);
+        while (count < kMaxCount &&
+               !counter.compare_exchange_weak(count, count + 1,
+                                              std::memory_order_relaxed)) {
+        }
+        if (count < kMaxCount) {
+            added = true;
+        }
+    }
+
+    // only the one reaching the sample size ages the counters
+    if (added && additions_.fetch_add(1, std::memory_order_relaxed) + 1 ==
+                     sampleSize_) {
+        Reset();
+    }
+}
+
+uint32_t FrequencySketch::Estimate(uint64_t key) {
+    uint8_t freq = kMaxCount;
+    for (int i = 0; i < kDepth; i++) {
+        freq = std::min(freq,
+            table_[IndexOf(key, i)].load(std::memory_order_relaxed));
+    }
+    return freq;
+}
+
+bool FrequencySketch::Admit(uint64_t candidate, uint64_t victim) {
+    // the victim wins on tie, otherwise a scan of keys accessed once
+    // flushes the cache
+    return Estimate(candidate) > Estimate(victim);
+}
+
+void FrequencySketch::Reset() {
+    for (uint64_t i = 0; i < width_ * kDepth; i++) {
+        uint8_t count = table_[i].load(std::memory_order_relaxed);
+        while (!table_[i].compare_exchange_weak(count, count >> 1,
+                                                std::memory_order_relaxed)) {
+        }
+    }
+    additions_.fetch_sub(sampleSize_ / 2, std::memory_order_relaxed);
+}
+
+}  // namespace client
+}  // namespace curvefs
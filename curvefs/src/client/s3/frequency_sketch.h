@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#ifndef CURVEFS_SRC_CLIENT_S3_FREQUENCY_SKETCH_H_
+#define CURVEFS_SRC_CLIENT_S3_FREQUENCY_SKETCH_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace curvefs {
+namespace client {
+
+// Approximate access frequency of keys, used as the admission policy of
+// read cache (TinyLFU).
+//
+// It's a count-min sketch with 4 rows of small saturating counters. Once the
+// number of increments reaches the sample size, all counters are halved, so
+// the frequency reflects recent accesses and old hot keys age out.
+//
+// It's lock free as it's consulted on every block read, counters are updated
+// by CAS and a concurrent aging only makes the estimation a bit less precise.
+class FrequencySketch {
+ public:
+    // |capacity| is the expected number of keys in cache
+    explicit FrequencySketch(uint64_t capacity);
+
+    void Increment(uint64_t key);
+
+    uint32_t Estimate(uint64_t key);
+
+    // whether |candidate| should replace |victim| in a full cache
+    bool Admit(uint64_t candidate, uint64_t victim);
+
+ private:
+    uint64_t IndexOf(uint64_t key, int row) const;
+
+    void Reset();
+
+ private:
+    static constexpr int kDepth = 4;
+    static constexpr uint8_t kMaxCount = 15;
+
+    uint64_t width_;
+    std::unique_ptr<std::atomic<uint8_t>[]> table_;
+    std::atomic<uint64_t> additions_;
+    uint64_t sampleSize_;
+};
+
+}  // namespace client
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_CLIENT_S3_FREQUENCY_SKETCH_H_
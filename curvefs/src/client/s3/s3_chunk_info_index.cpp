@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#include "curvefs/src/client/s3/s3_chunk_info_index.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace curvefs {
+namespace client {
+
+bool S3ChunkInfoIndex::IsSame(const S3ChunkInfo &lhs,
+                              const S3ChunkInfo &rhs) {
+    return lhs.chunkid() == rhs.chunkid() &&
+           lhs.compaction() == rhs.compaction() &&
+           lhs.offset() == rhs.offset() && lhs.len() == rhs.len();
+}
+
+void S3ChunkInfoIndex::Clear() {
+    extents_.clear();
+    applied_ = 0;
+}
+
+void S3ChunkInfoIndex::Update(const S3ChunkInfoList &list) {
+    int size = list.s3chunks_size();
+    // s3chunkinfos are only appended to the list in client, otherwise the
+    // list is replaced by a new one
+    if (applied_ > size ||
+        (applied_ > 0 && (!IsSame(first_, list.s3chunks(0)) ||
+                          !IsSame(last_, list.s3chunks(applied_ - 1))))) {
+        Clear();
+    }
+
+    if (applied_ == size) {
+        return;
+    }
+
+    for (int i = applied_; i < size; i++) {
+        Apply(list.s3chunks(i), i);
+    }
+    if (applied_ == 0) {
+        first_ = list.s3chunks(0);
+    }
+    last_ = list.s3chunks(size - 1);
+    applied_ = size;
+}
+
+void S3ChunkInfoIndex::Apply(const S3ChunkInfo &info, int pos) {
+    if (info.len() == 0) {
+        return;
+    }
+
+    uint64_t start = info.offset();
+    uint64_t end = info.offset() + info.len();
+
+    // split the segment across start
+    auto iter = extents_.lower_bound(start);
+    if (iter != extents_.begin()) {
+        auto prev = std::prev(iter);
+        if (prev->second.end > start) {
+            if (prev->second.end > end) {
+                extents_.emplace(end, Segment{prev->second.end,
+                                              prev->second.pos});
+            }
+            prev->second.end = start;
+        }
+    }
+
+    // remove segments covered, and cut the one across end
+    while (iter != extents_.end() && iter->first < end) {
+        if (iter->second.end > end) {
+            Segment tail = iter->second;
+            extents_.erase(iter);
+            extents_.emplace(end, tail);
+            break;
+        }
+        iter = extents_.erase(iter);
+    }
+
+    extents_.emplace(start, Segment{end, pos});
+}
+
+void S3ChunkInfoIndex::Find(uint64_t offset, uint64_t len,
+                            std::vector<Extent> *extents) const {
+    uint64_t end = offset + len;
+    auto iter = extents_.upper_bound(offset);
+    if (iter != extents_.begin()) {
+        auto prev = std::prev(iter);
+        if (prev->second.end > offset) {
+            iter = prev;
+        }
+    }
+
+    for (; iter != extents_.end() && iter->first < end; ++iter) {
+        uint64_t start = std::max(iter->first, offset);
+        uint64_t stop = std::min(iter->second.end, end);
+        extents->push_back(Extent{start, stop - start, iter->second.pos});
+    }
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#ifndef CURVEFS_SRC_CLIENT_S3_S3_CHUNK_INFO_INDEX_H_
+#define CURVEFS_SRC_CLIENT_S3_S3_CHUNK_INFO_INDEX_H_
+
+#include <map>
+#include <vector>
+
+#include "curvefs/proto/metaserver.pb.h"
+
+namespace curvefs {
+namespace client {
+
+using curvefs::metaserver::S3ChunkInfo;
+using curvefs::metaserver::S3ChunkInfoList;
+
+// Interval index of the visible parts of a chunk's S3ChunkInfoList.
+//
+// S3ChunkInfos in the list are in version order, a later one overwrites the
+// overlapping part of the earlier ones. The index keeps the non-overlapping
+// visible ranges, so the s3chunkinfos covering a read range are found in
+// O(log n) instead of walking all of the overwrite fragments.
+class S3ChunkInfoIndex {
+ public:
+    struct Extent {
+        // file offset
+        uint64_t offset;
+        uint64_t len;
+        // position of the s3chunkinfo in list
+        int pos;
+    };
+
+    // Make the index up to date with |list|. s3chunkinfos appended since
+    // last update are applied incrementally, and the index is rebuilt if the
+    // list has been replaced, e.g. after compaction or refresh.
+    void Update(const S3ChunkInfoList &list);
+
+    // Get the visible extents overlapping [offset, offset + len) in offset
+    // order, extents are clipped to the range and holes are not returned.
+    void Find(uint64_t offset, uint64_t len,
+              std::vector<Extent> *extents) const;
+
+    size_t Size() const {
+        return extents_.size();
+    }
+
+ private:
+    struct Segment {
+        uint64_t end;
+        int pos;
+    };
+
+    void Clear();
+
+    void Apply(const S3ChunkInfo &info, int pos);
+
+    static bool IsSame(const S3ChunkInfo &lhs, const S3ChunkInfo &rhs);
+
+ private:
+    // key is start offset of segment
+    std::map<uint64_t, Segment> extents_;
+
+    // number of s3chunkinfos applied
+    int applied_ = 0;
+
+    // the first and last applied s3chunkinfo, used to check whether the
+    // applied part of list is unchanged
+    S3ChunkInfo first_;
+    S3ChunkInfo last_;
+};
+
+}  // namespace client
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_CLIENT_S3_S3_CHUNK_INFO_INDEX_H_
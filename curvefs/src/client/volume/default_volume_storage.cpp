@@ -37,6 +37,7 @@
 #include "curvefs/src/client/volume/extent_cache.h"
 #include "curvefs/src/client/volume/utils.h"
 #include "curvefs/src/common/metric_utils.h"
+#include "src/common/concurrent/count_down_event.h"
 
 namespace curvefs {
 namespace client {
@@ -45,6 +46,7 @@ namespace common {
 DECLARE_bool(enableCto);
 }  // namespace common
 
+using ::curve::common::CountDownEvent;
 using ::curvefs::common::LatencyUpdater;
 
 namespace {
@@ -70,6 +72,34 @@ std::ostream& operator<<(std::ostream& os, const std::vector<IOPart>& iov) {
     return os;
 }
 
+// Submit all parts to block device asynchronously, and wait until all of
+// them are finished
+ssize_t ReadvAndWait(BlockDeviceClient* blockDev,
+                     const std::vector<ReadPart>& reads) {
+    CountDownEvent event(1);
+    ssize_t result = -1;
+    blockDev->AioReadv(reads, [&event, &result](ssize_t ret) {
+        result = ret;
+        event.Signal();
+    });
+
+    event.Wait();
+    return result;
+}
+
+ssize_t WritevAndWait(BlockDeviceClient* blockDev,
+                      const std::vector<WritePart>& writes) {
+    CountDownEvent event(1);
+    ssize_t result = -1;
+    blockDev->AioWritev(writes, [&event, &result](ssize_t ret) {
+        result = ret;
+        event.Signal();
+    });
+
+    event.Wait();
+    return result;
+}
+
 }  // namespace
 
 ssize_t DefaultVolumeStorage::Write(uint64_t ino,
@@ -97,7 +127,7 @@ ssize_t DefaultVolumeStorage::Write(uint64_t ino,
     VLOG(9) << "write ino: " << ino << ", offset: " << offset
             << ", len: " << len << ", block write requests: " << writes;
 
-    ssize_t nr = blockDeviceClient_->Writev(writes);
+    ssize_t nr = WritevAndWait(blockDeviceClient_, writes);
     // TODO(wuhanqing): enable check `nr != len`, currently, backend storage
     // will return larger value if write request is smaller than backend
     // storage's block size
@@ -153,7 +183,7 @@ ssize_t DefaultVolumeStorage::Read(uint64_t ino,
         VLOG(9) << "read ino: " << ino << ", offset: " << offset
             << ", len: " << len << ", block read requests: " << reads;
 
-        ssize_t nr = blockDeviceClient_->Readv(reads);
+        ssize_t nr = ReadvAndWait(blockDeviceClient_, reads);
         // TODO(wuhanqing): enable check `(nr+total) != len`, currently, backend
         // storage will return larger value if write request is smaller than
         // backend storage's block size
@@ -32,6 +32,12 @@ bool ValidNameOfInode(const std::string &inode, const std::string &objName) {
     curve::common::SplitString(objName, "_", &res);
     return res.size() == 5 && res[1] == inode;
 }
+
+bool IsPackName(const std::string &objName) {
+    std::vector<std::string> res;
+    curve::common::SplitString(objName, "_", &res);
+    return res.size() == 3 && res[1] == "pack";
+}
 }  // namespace s3util
 }  // namespace common
 }  // namespace curvefs
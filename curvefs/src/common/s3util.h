@@ -37,8 +37,15 @@ inline std::string GenObjName(uint64_t chunkid, uint64_t index,
            std::to_string(compaction);
 }
 
+// pack obj holds small data of many inodes, named by fsid and pack id
+inline std::string GenPackName(uint64_t fsid, uint64_t packid) {
+    return std::to_string(fsid) + "_pack_" + std::to_string(packid);
+}
+
 bool ValidNameOfInode(const std::string &inode, const std::string &objName);
 
+bool IsPackName(const std::string &objName);
+
 }  // namespace s3util
 }  // namespace common
 }  // namespace curvefs
@@ -121,6 +121,10 @@ int PosixWrapper::fallocate(int fd, int mode, off_t offset, off_t len) {
     return ::syscall(SYS_fallocate, fd, mode, offset, len);
 }
 
+int PosixWrapper::ftruncate(int fd, off_t length) {
+    return ::ftruncate(fd, length);
+}
+
 int PosixWrapper::fsync(int fd) {
     return ::fsync(fd);
 }
@@ -61,6 +61,7 @@ class PosixWrapper {
                            off_t offset);
     virtual int fstat(int fd, struct stat *buf);
     virtual int fallocate(int fd, int mode, off_t offset, off_t len);
+    virtual int ftruncate(int fd, off_t length);
     virtual int fsync(int fd);
     virtual int fdatasync(int fd);
     virtual int statfs(const char *path, struct statfs *buf);
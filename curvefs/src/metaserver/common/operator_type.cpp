@@ -55,6 +55,12 @@ const char* OperatorTypeName(OperatorType type) {
             return "DeletePartition";
         case OperatorType::PrepareRenameTx:
             return "PrepareRenameTx";
+        case OperatorType::GetOrModifyS3ChunkInfo:
+            return "GetOrModifyS3ChunkInfo";
+        case OperatorType::BatchUpdateInode:
+            return "BatchUpdateInode";
+        case OperatorType::CreateInodeAndDentry:
+            return "CreateInodeAndDentry";
         default:
             return "Unknown";
     }
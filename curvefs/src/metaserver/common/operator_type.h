@@ -44,6 +44,8 @@ enum class OperatorType : uint32_t {
     DeletePartition,
     PrepareRenameTx,
     GetOrModifyS3ChunkInfo,
+    BatchUpdateInode,
+    CreateInodeAndDentry,
     /** Add new operator before `OperatorTypeMax` **/
     OperatorTypeMax,
 };
@@ -278,6 +278,9 @@ class OnSnapshotSaveDoneClosureImpl : public OnSnapshotSaveDoneClosure {
 
         if (ctx_->success) {
             writer_->add_file(kMetaDataFilename);
+            for (const auto& filename : files_) {
+                writer_->add_file(filename);
+            }
         }
 
         RaftSnapshotMetric::GetInstance().OnSnapshotSaveDone(ctx_);
@@ -297,11 +300,16 @@ class OnSnapshotSaveDoneClosureImpl : public OnSnapshotSaveDoneClosure {
                    << MetaStatusCode_Name(code);
     }
 
+    void AddFile(const std::string& filename) override {
+        files_.push_back(filename);
+    }
+
  private:
     CopysetNode* node_;
     braft::SnapshotWriter* writer_;
     braft::Closure* snapDone_;
     RaftSnapshotMetric::MetricContext* ctx_;
+    std::vector<std::string> files_;
 };
 
 void CopysetNode::on_snapshot_save(braft::SnapshotWriter* writer,
@@ -165,6 +165,8 @@ OPERATOR_ON_APPLY(BatchGetInodeAttr);
 OPERATOR_ON_APPLY(BatchGetXAttr);
 OPERATOR_ON_APPLY(CreateInode);
 OPERATOR_ON_APPLY(UpdateInode);
+OPERATOR_ON_APPLY(BatchUpdateInode);
+OPERATOR_ON_APPLY(CreateInodeAndDentry);
 OPERATOR_ON_APPLY(DeleteInode);
 OPERATOR_ON_APPLY(CreateRootInode);
 OPERATOR_ON_APPLY(CreatePartition);
@@ -244,6 +246,8 @@ OPERATOR_ON_APPLY_FROM_LOG(CreateDentry);
 OPERATOR_ON_APPLY_FROM_LOG(DeleteDentry);
 OPERATOR_ON_APPLY_FROM_LOG(CreateInode);
 OPERATOR_ON_APPLY_FROM_LOG(UpdateInode);
+OPERATOR_ON_APPLY_FROM_LOG(BatchUpdateInode);
+OPERATOR_ON_APPLY_FROM_LOG(CreateInodeAndDentry);
 OPERATOR_ON_APPLY_FROM_LOG(DeleteInode);
 OPERATOR_ON_APPLY_FROM_LOG(CreateRootInode);
 OPERATOR_ON_APPLY_FROM_LOG(CreatePartition);
@@ -296,6 +300,8 @@ OPERATOR_REDIRECT(BatchGetInodeAttr);
 OPERATOR_REDIRECT(BatchGetXAttr);
 OPERATOR_REDIRECT(CreateInode);
 OPERATOR_REDIRECT(UpdateInode);
+OPERATOR_REDIRECT(BatchUpdateInode);
+OPERATOR_REDIRECT(CreateInodeAndDentry);
 OPERATOR_REDIRECT(GetOrModifyS3ChunkInfo);
 OPERATOR_REDIRECT(DeleteInode);
 OPERATOR_REDIRECT(CreateRootInode);
@@ -319,6 +325,8 @@ OPERATOR_ON_FAILED(BatchGetInodeAttr);
 OPERATOR_ON_FAILED(BatchGetXAttr);
 OPERATOR_ON_FAILED(CreateInode);
 OPERATOR_ON_FAILED(UpdateInode);
+OPERATOR_ON_FAILED(BatchUpdateInode);
+OPERATOR_ON_FAILED(CreateInodeAndDentry);
 OPERATOR_ON_FAILED(GetOrModifyS3ChunkInfo);
 OPERATOR_ON_FAILED(DeleteInode);
 OPERATOR_ON_FAILED(CreateRootInode);
@@ -342,6 +350,8 @@ OPERATOR_HASH_CODE(BatchGetInodeAttr);
 OPERATOR_HASH_CODE(BatchGetXAttr);
 OPERATOR_HASH_CODE(CreateInode);
 OPERATOR_HASH_CODE(UpdateInode);
+OPERATOR_HASH_CODE(BatchUpdateInode);
+OPERATOR_HASH_CODE(CreateInodeAndDentry);
 OPERATOR_HASH_CODE(GetOrModifyS3ChunkInfo);
 OPERATOR_HASH_CODE(DeleteInode);
 OPERATOR_HASH_CODE(CreateRootInode);
@@ -375,6 +385,8 @@ OPERATOR_TYPE(BatchGetInodeAttr);
 OPERATOR_TYPE(BatchGetXAttr);
 OPERATOR_TYPE(CreateInode);
 OPERATOR_TYPE(UpdateInode);
+OPERATOR_TYPE(BatchUpdateInode);
+OPERATOR_TYPE(CreateInodeAndDentry);
 OPERATOR_TYPE(GetOrModifyS3ChunkInfo);
 OPERATOR_TYPE(DeleteInode);
 OPERATOR_TYPE(CreateRootInode);
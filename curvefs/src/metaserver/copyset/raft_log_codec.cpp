@@ -155,6 +155,13 @@ std::unique_ptr<MetaOperator> RaftLogCodec::Decode(CopysetNode* node,
             return ParseFromRaftLog<GetOrModifyS3ChunkInfoOperator,
                                     GetOrModifyS3ChunkInfoRequest>(
                                         node, type, meta);
+        case OperatorType::BatchUpdateInode:
+            return ParseFromRaftLog<BatchUpdateInodeOperator,
+                                    BatchUpdateInodeRequest>(node, type, meta);
+        case OperatorType::CreateInodeAndDentry:
+            return ParseFromRaftLog<CreateInodeAndDentryOperator,
+                                    CreateInodeAndDentryRequest>(
+                                        node, type, meta);
         default:
             LOG(ERROR) << "unexpected type: " << static_cast<uint32_t>(type);
             return nullptr;
@@ -452,5 +452,10 @@ MetaStatusCode InodeManager::InsertInode(const Inode &inode) {
 bool InodeManager::GetInodeIdList(std::list<uint64_t>* inodeIdList) {
     return inodeStorage_->GetInodeIdList(inodeIdList);
 }
+
+bool InodeManager::GetPackIds(std::unordered_set<uint64_t>* referred,
+                              std::unordered_set<uint64_t>* orphaned) {
+    return inodeStorage_->GetPackIds(referred, orphaned);
+}
 }  // namespace metaserver
 }  // namespace curvefs
@@ -27,6 +27,7 @@
 #include <memory>
 #include <string>
 #include <list>
+#include <unordered_set>
 #include "curvefs/proto/metaserver.pb.h"
 #include "curvefs/src/metaserver/inode_storage.h"
 #include "curvefs/src/metaserver/trash.h"
@@ -95,6 +96,9 @@ class InodeManager {
 
     bool GetInodeIdList(std::list<uint64_t>* inodeIdList);
 
+    bool GetPackIds(std::unordered_set<uint64_t>* referred,
+                    std::unordered_set<uint64_t>* orphaned);
+
  private:
     void GenerateInodeInternal(uint64_t inodeId, const InodeParam &param,
                                Inode *inode);
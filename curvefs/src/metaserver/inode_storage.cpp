@@ -48,7 +48,8 @@ InodeStorage::InodeStorage(std::shared_ptr<KVStorage> kvStorage,
     : kvStorage_(kvStorage),
       table4inode_(RealTablename(kTypeInode, tablename)),
       table4s3chunkinfo_(RealTablename(kTypeS3ChunkInfo, tablename)),
-      conv_(std::make_shared<Converter>()) {}
+      conv_(std::make_shared<Converter>()),
+      mayHavePacks_(true) {}
 
 MetaStatusCode InodeStorage::Insert(const Inode& inode) {
     WriteLockGuard writeLockGuard(rwLock_);
@@ -192,6 +193,13 @@ MetaStatusCode InodeStorage::AddS3ChunkInfoList(
                             firstChunkId, lastChunkId, size);
     std::string skey = conv_->SerializeToString(key);
 
+    for (const auto& info : list2add->s3chunks()) {
+        if (info.packid() != 0) {
+            mayHavePacks_.store(true);
+            break;
+        }
+    }
+
     Status s = txn->SSet(table4s3chunkinfo_, skey, *list2add);
     return s.ok() ? MetaStatusCode::OK :
                     MetaStatusCode::STORAGE_INTERNAL_ERROR;
@@ -378,6 +386,7 @@ MetaStatusCode InodeStorage::Clear() {
     }
 
     keySet_.clear();
+    mayHavePacks_.store(true);
     return MetaStatusCode::OK;
 }
 
@@ -393,5 +402,47 @@ bool InodeStorage::GetInodeIdList(std::list<uint64_t>* inodeIdList) {
     return true;
 }
 
+bool InodeStorage::GetPackIds(std::unordered_set<uint64_t>* referred,
+                              std::unordered_set<uint64_t>* orphaned) {
+    ReadLockGuard readLockGuard(rwLock_);
+    if (!mayHavePacks_.load()) {
+        return true;
+    }
+
+    auto iterator = GetAllS3ChunkInfoList();
+    if (iterator->Status() != 0) {
+        LOG(ERROR) << "Get all s3chunkinfo failed";
+        return false;
+    }
+
+    Key4S3ChunkInfoList key;
+    S3ChunkInfoList list;
+    for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
+        if (!conv_->ParseFromString(iterator->Key(), &key) ||
+            !iterator->ParseFromValue(&list)) {
+            return false;
+        }
+
+        bool exist = FindKey(
+            conv_->SerializeToString(Key4Inode(key.fsId, key.inodeId)));
+        for (const auto& info : list.s3chunks()) {
+            if (info.packid() == 0) {
+                continue;
+            }
+            if (exist) {
+                referred->insert(info.packid());
+            } else {
+                orphaned->insert(info.packid());
+            }
+        }
+    }
+
+    // writers are excluded by the lock, so no pack is added meanwhile
+    if (referred->empty() && orphaned->empty()) {
+        mayHavePacks_.store(false);
+    }
+    return true;
+}
+
 }  // namespace metaserver
 }  // namespace curvefs
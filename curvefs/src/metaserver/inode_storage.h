@@ -23,6 +23,7 @@
 #ifndef CURVEFS_SRC_METASERVER_INODE_STORAGE_H_
 #define CURVEFS_SRC_METASERVER_INODE_STORAGE_H_
 
+#include <atomic>
 #include <functional>
 #include <utility>
 #include <unordered_map>
@@ -30,6 +31,7 @@
 #include <list>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "src/common/concurrent/rw_lock.h"
 #include "curvefs/proto/metaserver.pb.h"
@@ -132,6 +134,22 @@ class InodeStorage {
 
     bool GetInodeIdList(std::list<uint64_t>* inodeIdList);
 
+    /**
+     * @brief get ids of pack objs referred by s3chunkinfos in storage
+     * @param[out] referred: packs referred by existing inodes
+     * @param[out] orphaned: packs referred by s3chunkinfo lists left by
+     *                       deleted inodes
+     * @note the scan is skipped if no pack is referred since last scan
+     * @return If scan storage failed, return false; else return true
+     */
+    bool GetPackIds(std::unordered_set<uint64_t>* referred,
+                    std::unordered_set<uint64_t>* orphaned);
+
+    // tables of kv storage which the inodes and s3chunkinfo lists stored in
+    std::vector<std::string> GetTablenames() {
+        return std::vector<std::string>{ table4inode_, table4s3chunkinfo_ };
+    }
+
  private:
     MetaStatusCode AddS3ChunkInfoList(
         std::shared_ptr<StorageTransaction> txn,
@@ -196,6 +214,9 @@ class InodeStorage {
     std::unordered_set<std::string> keySet_;
     // key: Hash(inode), value: the number of inode's chunkinfo size
     std::unordered_map<std::string, uint64_t> inodeS3MetaSize_;
+    // whether s3chunkinfo lists in storage may refer to pack objs,
+    // it's cleared by a scan which finds no pack
+    std::atomic<bool> mayHavePacks_;
 };
 
 }  // namespace metaserver
@@ -43,6 +43,8 @@ using ::curvefs::metaserver::copyset::BatchGetXAttrOperator;
 using ::curvefs::metaserver::copyset::CreateInodeOperator;
 using ::curvefs::metaserver::copyset::CreateRootInodeOperator;
 using ::curvefs::metaserver::copyset::UpdateInodeOperator;
+using ::curvefs::metaserver::copyset::BatchUpdateInodeOperator;
+using ::curvefs::metaserver::copyset::CreateInodeAndDentryOperator;
 using ::curvefs::metaserver::copyset::GetOrModifyS3ChunkInfoOperator;
 using ::curvefs::metaserver::copyset::DeleteInodeOperator;
 using ::curvefs::metaserver::copyset::UpdateInodeS3VersionOperator;
@@ -208,6 +210,29 @@ void MetaServerServiceImpl::UpdateInode(
                                            request->copysetid());
 }
 
+void MetaServerServiceImpl::BatchUpdateInode(
+    ::google::protobuf::RpcController* controller,
+    const ::curvefs::metaserver::BatchUpdateInodeRequest* request,
+    ::curvefs::metaserver::BatchUpdateInodeResponse* response,
+    ::google::protobuf::Closure* done) {
+    OperatorHelper helper(copysetNodeManager_, inflightThrottle_);
+    helper.operator()<BatchUpdateInodeOperator>(controller, request, response,
+                                                done, request->poolid(),
+                                                request->copysetid());
+}
+
+void MetaServerServiceImpl::CreateInodeAndDentry(
+    ::google::protobuf::RpcController* controller,
+    const ::curvefs::metaserver::CreateInodeAndDentryRequest* request,
+    ::curvefs::metaserver::CreateInodeAndDentryResponse* response,
+    ::google::protobuf::Closure* done) {
+    OperatorHelper helper(copysetNodeManager_, inflightThrottle_);
+    helper.operator()<CreateInodeAndDentryOperator>(controller, request,
+                                                    response, done,
+                                                    request->poolid(),
+                                                    request->copysetid());
+}
+
 void MetaServerServiceImpl::GetOrModifyS3ChunkInfo(
     ::google::protobuf::RpcController* controller,
     const ::curvefs::metaserver::GetOrModifyS3ChunkInfoRequest* request,
@@ -83,6 +83,16 @@ class MetaServerServiceImpl : public MetaServerService {
                      const ::curvefs::metaserver::UpdateInodeRequest* request,
                      ::curvefs::metaserver::UpdateInodeResponse* response,
                      ::google::protobuf::Closure* done) override;
+    void BatchUpdateInode(
+        ::google::protobuf::RpcController* controller,
+        const ::curvefs::metaserver::BatchUpdateInodeRequest* request,
+        ::curvefs::metaserver::BatchUpdateInodeResponse* response,
+        ::google::protobuf::Closure* done) override;
+    void CreateInodeAndDentry(
+        ::google::protobuf::RpcController* controller,
+        const ::curvefs::metaserver::CreateInodeAndDentryRequest* request,
+        ::curvefs::metaserver::CreateInodeAndDentryResponse* response,
+        ::google::protobuf::Closure* done) override;
     void GetOrModifyS3ChunkInfo(
         ::google::protobuf::RpcController* controller,
         const ::curvefs::metaserver::GetOrModifyS3ChunkInfoRequest* request,
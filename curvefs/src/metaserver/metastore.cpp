@@ -20,6 +20,7 @@
  * @Author: chenwei
  */
 #include "curvefs/src/metaserver/metastore.h"
+#include <butil/file_util.h>
 #include <glog/logging.h>
 #include <thread>  // NOLINT
 #include <unordered_map>
@@ -39,6 +40,14 @@ using ::curvefs::metaserver::storage::DumpFileClosure;
 using KVStorage = ::curvefs::metaserver::storage::KVStorage;
 using Key4S3ChunkInfoList = ::curvefs::metaserver::storage::Key4S3ChunkInfoList;
 
+namespace {
+
+// the checkpoint of rocksdb storage is placed beside the metadata file,
+// e.g: snapshot/metadata => snapshot/metadata.checkpoint
+const char* const kCheckpointSuffix = ".checkpoint";
+
+}  // namespace
+
 MetaStoreImpl::MetaStoreImpl(copyset::CopysetNode* node,
                              std::shared_ptr<KVStorage> kvStorage)
     : copysetNode_(node),
@@ -49,7 +58,13 @@ bool MetaStoreImpl::Load(const std::string& pathname) {
     // Load from raft snap file to memory
     WriteLockGuard writeLockGuard(rwLock_);
     MetaStoreFStream fstream(&partitionMap_, kvStorage_);
-    auto succ = fstream.Load(pathname);
+    bool succ;
+    std::string checkpoint = pathname + kCheckpointSuffix;
+    if (butil::DirectoryExists(butil::FilePath(checkpoint))) {
+        succ = fstream.LoadCheckpoint(pathname, checkpoint);
+    } else {
+        succ = fstream.Load(pathname);
+    }
     if (!succ) {
         partitionMap_.clear();
         LOG(ERROR) << "Load metadata failed.";
@@ -74,7 +89,22 @@ void MetaStoreImpl::SaveBackground(const std::string& path,
                                    OnSnapshotSaveDoneClosure* done) {
     LOG(INFO) << "Save metadata to file background.";
     MetaStoreFStream fstream(&partitionMap_, kvStorage_);
-    bool succ = fstream.Save(path, child);
+    bool succ;
+    if (kvStorage_->Type() == KVStorage::STORAGE_TYPE::ROCKSDB_STORAGE) {
+        // rocksdb storage exports the tables of this copyset to sst files
+        // instead of serializing the entries one by one
+        std::vector<std::string> files;
+        std::string checkpoint = path + kCheckpointSuffix;
+        succ = fstream.SaveCheckpoint(path, checkpoint, &files, child);
+        if (succ) {
+            auto dirname = butil::FilePath(checkpoint).BaseName().value();
+            for (const auto& filename : files) {
+                done->AddFile(dirname + "/" + filename);
+            }
+        }
+    } else {
+        succ = fstream.Save(path, child);
+    }
     LOG(INFO) << "Save metadata to file " << (succ ? "success" : "fail");
 
     if (succ) {
@@ -312,29 +342,37 @@ MetaStatusCode MetaStoreImpl::PrepareRenameTx(
 }
 
 // inode
-MetaStatusCode MetaStoreImpl::CreateInode(const CreateInodeRequest* request,
-                                          CreateInodeResponse* response) {
-    InodeParam param;
-    param.fsId = request->fsid();
-    param.length = request->length();
-    param.uid = request->uid();
-    param.gid = request->gid();
-    param.mode = request->mode();
-    param.type = request->type();
-    param.parent = request->parent();
-    param.rdev = request->rdev();
-    param.symlink = "";
-    if (param.type == FsFileType::TYPE_SYM_LINK) {
-        if (!request->has_symlink()) {
-            response->set_statuscode(MetaStatusCode::SYM_LINK_EMPTY);
+namespace {
+
+MetaStatusCode ToInodeParam(const CreateInodeRequest& request,
+                            InodeParam* param) {
+    param->fsId = request.fsid();
+    param->length = request.length();
+    param->uid = request.uid();
+    param->gid = request.gid();
+    param->mode = request.mode();
+    param->type = request.type();
+    param->parent = request.parent();
+    param->rdev = request.rdev();
+    param->symlink = "";
+    if (param->type == FsFileType::TYPE_SYM_LINK) {
+        if (!request.has_symlink() || request.symlink().empty()) {
             return MetaStatusCode::SYM_LINK_EMPTY;
         }
+        param->symlink = request.symlink();
+    }
+    return MetaStatusCode::OK;
+}
 
-        param.symlink = request->symlink();
-        if (param.symlink.empty()) {
-            response->set_statuscode(MetaStatusCode::SYM_LINK_EMPTY);
-            return MetaStatusCode::SYM_LINK_EMPTY;
-        }
+}  // namespace
+
+MetaStatusCode MetaStoreImpl::CreateInode(const CreateInodeRequest* request,
+                                          CreateInodeResponse* response) {
+    InodeParam param;
+    MetaStatusCode rc = ToInodeParam(*request, &param);
+    if (rc != MetaStatusCode::OK) {
+        response->set_statuscode(rc);
+        return rc;
     }
 
     ReadLockGuard readLockGuard(rwLock_);
@@ -516,6 +554,78 @@ MetaStatusCode MetaStoreImpl::UpdateInode(const UpdateInodeRequest* request,
     return status;
 }
 
+MetaStatusCode MetaStoreImpl::BatchUpdateInode(
+    const BatchUpdateInodeRequest* request,
+    BatchUpdateInodeResponse* response) {
+    ReadLockGuard readLockGuard(rwLock_);
+    std::shared_ptr<Partition> partition = GetPartition(request->partitionid());
+    if (partition == nullptr) {
+        MetaStatusCode status = MetaStatusCode::PARTITION_NOT_FOUND;
+        response->set_statuscode(status);
+        return status;
+    }
+
+    for (const auto& update : request->update()) {
+        MetaStatusCode status = MetaStatusCode::OK;
+        if (!update.volumeextentmap().empty() &&
+            !update.s3chunkinfomap().empty()) {
+            LOG(ERROR) << "only one of type space info, choose volume or s3"
+                       << ", inodeId = " << update.inodeid();
+            status = MetaStatusCode::PARAM_ERROR;
+        } else {
+            status = partition->UpdateInode(update);
+        }
+
+        if (status == MetaStatusCode::OK && !update.s3chunkinfomap().empty()) {
+            std::shared_ptr<Iterator> iterator;
+            status = partition->GetOrModifyS3ChunkInfo(
+                update.fsid(), update.inodeid(), update.s3chunkinfomap(),
+                S3ChunkInfoMap(), false, &iterator);
+        }
+
+        if (status != MetaStatusCode::OK) {
+            LOG(WARNING) << "BatchUpdateInode fail, inodeId = "
+                         << update.inodeid() << ", partitionId = "
+                         << request->partitionid()
+                         << ", retCode = " << MetaStatusCode_Name(status);
+        }
+        response->add_updatestatuscode(status);
+    }
+
+    // failed updates are reported by updateStatusCode, the others are applied
+    response->set_statuscode(MetaStatusCode::OK);
+    return MetaStatusCode::OK;
+}
+
+MetaStatusCode MetaStoreImpl::CreateInodeAndDentry(
+    const CreateInodeAndDentryRequest* request,
+    CreateInodeAndDentryResponse* response) {
+    InodeParam param;
+    MetaStatusCode status = ToInodeParam(request->inode(), &param);
+    if (status != MetaStatusCode::OK) {
+        response->set_statuscode(status);
+        return status;
+    }
+
+    ReadLockGuard readLockGuard(rwLock_);
+    std::shared_ptr<Partition> partition = GetPartition(request->partitionid());
+    if (partition == nullptr) {
+        status = MetaStatusCode::PARTITION_NOT_FOUND;
+        response->set_statuscode(status);
+        return status;
+    }
+
+    status = partition->CreateInodeAndDentry(param, request->name(),
+                                             request->txid(),
+                                             request->requestid(),
+                                             response->mutable_inode());
+    response->set_statuscode(status);
+    if (status != MetaStatusCode::OK) {
+        response->clear_inode();
+    }
+    return status;
+}
+
 MetaStatusCode MetaStoreImpl::GetOrModifyS3ChunkInfo(
     const GetOrModifyS3ChunkInfoRequest* request,
     GetOrModifyS3ChunkInfoResponse* response,
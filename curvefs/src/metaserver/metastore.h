@@ -62,6 +62,10 @@ using curvefs::metaserver::CreateInodeRequest;
 using curvefs::metaserver::CreateInodeResponse;
 using curvefs::metaserver::UpdateInodeRequest;
 using curvefs::metaserver::UpdateInodeResponse;
+using curvefs::metaserver::BatchUpdateInodeRequest;
+using curvefs::metaserver::BatchUpdateInodeResponse;
+using curvefs::metaserver::CreateInodeAndDentryRequest;
+using curvefs::metaserver::CreateInodeAndDentryResponse;
 using curvefs::metaserver::DeleteInodeRequest;
 using curvefs::metaserver::DeleteInodeResponse;
 using curvefs::metaserver::CreateRootInodeRequest;
@@ -141,6 +145,14 @@ class MetaStore {
     virtual MetaStatusCode UpdateInode(const UpdateInodeRequest* request,
                                        UpdateInodeResponse* response) = 0;
 
+    virtual MetaStatusCode BatchUpdateInode(
+        const BatchUpdateInodeRequest* request,
+        BatchUpdateInodeResponse* response) = 0;
+
+    virtual MetaStatusCode CreateInodeAndDentry(
+        const CreateInodeAndDentryRequest* request,
+        CreateInodeAndDentryResponse* response) = 0;
+
     virtual MetaStatusCode GetOrModifyS3ChunkInfo(
         const GetOrModifyS3ChunkInfoRequest* request,
         GetOrModifyS3ChunkInfoResponse* response,
@@ -209,6 +221,17 @@ class MetaStoreImpl : public MetaStore {
     MetaStatusCode UpdateInode(const UpdateInodeRequest* request,
                                UpdateInodeResponse* response) override;
 
+    // apply updates of inodes in the same partition one by one, the status
+    // of each update is set in response
+    MetaStatusCode BatchUpdateInode(
+        const BatchUpdateInodeRequest* request,
+        BatchUpdateInodeResponse* response) override;
+
+    // create inode in the partition of parent and the dentry of it together
+    MetaStatusCode CreateInodeAndDentry(
+        const CreateInodeAndDentryRequest* request,
+        CreateInodeAndDentryResponse* response) override;
+
     std::shared_ptr<Partition> GetPartition(uint32_t partitionId);
 
     MetaStatusCode GetOrModifyS3ChunkInfo(
@@ -24,9 +24,12 @@
 #include <vector>
 #include <unordered_map>
 
+#include "absl/cleanup/cleanup.h"
 #include "curvefs/proto/common.pb.h"
 #include "curvefs/proto/metaserver.pb.h"
 #include "curvefs/src/metaserver/metastore_fstream.h"
+#include "curvefs/src/metaserver/inode_storage.h"
+#include "curvefs/src/metaserver/dentry_storage.h"
 #include "curvefs/src/metaserver/storage/storage_fstream.h"
 
 namespace curvefs {
@@ -283,6 +286,57 @@ bool MetaStoreFStream::Load(const std::string& pathname) {
     return LoadFromFile(pathname, callback);
 }
 
+bool MetaStoreFStream::LoadFromIterator(uint32_t partitionId,
+                                        std::shared_ptr<Iterator> iterator,
+                                        LoadEntryFunc load) {
+    if (iterator->Status() != 0) {
+        return false;
+    }
+
+    for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
+        if (!(this->*load)(partitionId, iterator->Key(), iterator->Value())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MetaStoreFStream::LoadCheckpoint(const std::string& pathname,
+                                      const std::string& checkpoint) {
+    if (!Load(pathname)) {  // partition and pending tx
+        return false;
+    }
+
+    auto storage = kvStorage_->OpenCheckpoint(checkpoint);
+    if (nullptr == storage) {
+        return false;
+    }
+    auto defer = absl::MakeCleanup([&storage]() { storage->Close(); });
+
+    for (const auto& item : *partitionMap_) {
+        auto partitionId = item.first;
+        auto partition = item.second;
+        InodeStorage inodeStorage(storage, partition->GetInodeTablename());
+        DentryStorage dentryStorage(storage, partition->GetDentryTablename());
+
+        bool succ =
+            LoadFromIterator(partitionId, inodeStorage.GetAllInode(),
+                             &MetaStoreFStream::LoadInode) &&
+            LoadFromIterator(partitionId, dentryStorage.GetAll(),
+                             &MetaStoreFStream::LoadDentry) &&
+            LoadFromIterator(partitionId, inodeStorage.GetAllS3ChunkInfoList(),
+                             &MetaStoreFStream::LoadInodeS3ChunkInfoList);
+        if (!succ) {
+            LOG(ERROR) << "Load partition from checkpoint failed"
+                       << ", partitionId = " << partitionId;
+            return false;
+        }
+    }
+
+    LOG(INFO) << "MetaStoreFStream load checkpoint success";
+    return true;
+}
+
 bool MetaStoreFStream::Save(const std::string& path,
                             DumpFileClosure* done) {
     ChildrenType children;
@@ -319,5 +373,42 @@ bool MetaStoreFStream::Save(const std::string& path,
     return succ;
 }
 
+bool MetaStoreFStream::SaveCheckpoint(const std::string& path,
+                                      const std::string& checkpoint,
+                                      std::vector<std::string>* files,
+                                      DumpFileClosure* done) {
+    ChildrenType children;
+    children.push_back(NewPartitionIterator());  // partition
+    for (const auto& item : *partitionMap_) {
+        children.push_back(NewPendingTxIterator(item.second));  // pending tx
+    }
+
+    for (const auto& child : children) {
+        if (nullptr == child) {
+            done->Runned();
+            return false;
+        }
+    }
+
+    // only the tables of partitions in this metastore are dumped,
+    // and |done| is runned once the point-in-time view of them is taken
+    std::vector<std::string> tablenames;
+    for (const auto& item : *partitionMap_) {
+        auto names = item.second->GetStorageTablenames();
+        tablenames.insert(tablenames.end(), names.begin(), names.end());
+    }
+    bool succ = kvStorage_->Checkpoint(checkpoint, tablenames, files, done);
+    if (!succ) {
+        LOG(ERROR) << "Create checkpoint of storage failed";
+        return false;
+    }
+
+    auto mergeIterator = std::make_shared<MergeIterator>(children);
+    succ = SaveToFile(path, mergeIterator, false);
+    LOG(INFO) << "MetaStoreFStream save checkpoint "
+              << (succ ? "success" : "fail");
+    return succ;
+}
+
 }  // namespace metaserver
 }  // namespace curvefs
@@ -23,6 +23,7 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "curvefs/proto/metaserver.pb.h"
 #include "curvefs/src/metaserver/partition.h"
@@ -53,7 +54,26 @@ class MetaStoreFStream {
     bool Save(const std::string& path,
               DumpFileClosure* done);
 
+    // Only partitions and pending txs are saved to |path|, the others
+    // are kept in the checkpoint of storage which created under |checkpoint|,
+    // so the entries needn't be serialized one by one.
+    bool SaveCheckpoint(const std::string& path,
+                        const std::string& checkpoint,
+                        std::vector<std::string>* files,
+                        DumpFileClosure* done);
+
+    bool LoadCheckpoint(const std::string& pathname,
+                        const std::string& checkpoint);
+
  private:
+    using LoadEntryFunc = bool (MetaStoreFStream::*)(uint32_t partitionId,
+                                                     const std::string& key,
+                                                     const std::string& value);
+
+    bool LoadFromIterator(uint32_t partitionId,
+                          std::shared_ptr<Iterator> iterator,
+                          LoadEntryFunc load);
+
     bool LoadPartition(uint32_t partitionId,
                        const std::string& key,
                        const std::string& value);
@@ -200,6 +200,79 @@ MetaStatusCode Partition::CreateInode(const InodeParam &param,
     return inodeManager_->CreateInode(inodeId, param, inode);
 }
 
+MetaStatusCode Partition::CreateInodeAndDentry(const InodeParam &param,
+                                               const std::string& name,
+                                               uint64_t txId,
+                                               uint64_t requestId,
+                                               Inode* inode) {
+    if (!IsInodeBelongs(param.fsId, param.parent)) {
+        return MetaStatusCode::PARTITION_ID_MISSMATCH;
+    }
+
+    // check the parent and the name before allocating inode, so nothing
+    // will be left behind if dentry can't be created
+    InodeAttr parentAttr;
+    MetaStatusCode ret = inodeManager_->GetInodeAttr(param.fsId, param.parent,
+                                                     &parentAttr);
+    if (ret != MetaStatusCode::OK) {
+        return ret;
+    }
+
+    Dentry dentry;
+    dentry.set_fsid(param.fsId);
+    dentry.set_parentinodeid(param.parent);
+    dentry.set_name(name);
+    dentry.set_txid(txId);
+    Dentry exist = dentry;
+    ret = GetDentry(&exist);
+    if (ret == MetaStatusCode::OK) {
+        // the request has been applied before, e.g. client retried after
+        // rpc timeout, return the inode created by it like CreateDentry
+        if (requestId != 0 && exist.requestid() == requestId) {
+            VLOG(3) << "CreateInodeAndDentry idempotence, fsId = "
+                    << param.fsId << ", parent = " << param.parent
+                    << ", name = " << name << ", inodeId = "
+                    << exist.inodeid() << ", requestId = " << requestId;
+            return inodeManager_->GetInode(param.fsId, exist.inodeid(),
+                                           inode);
+        }
+        return MetaStatusCode::DENTRY_EXIST;
+    } else if (ret != MetaStatusCode::NOT_FOUND) {
+        return ret;
+    }
+
+    ret = CreateInode(param, inode);
+    if (ret != MetaStatusCode::OK) {
+        return ret;
+    }
+
+    dentry.set_inodeid(inode->inodeid());
+    dentry.set_type(param.type);
+    // same as the dentry created by client
+    if (param.type == FsFileType::TYPE_FILE ||
+        param.type == FsFileType::TYPE_S3) {
+        dentry.set_flag(DentryFlag::TYPE_FILE_FLAG);
+    }
+    if (requestId != 0) {
+        dentry.set_requestid(requestId);
+    }
+    ret = CreateDentry(dentry);
+    if (ret != MetaStatusCode::OK) {
+        LOG(ERROR) << "CreateInodeAndDentry create dentry fail, fsId = "
+                   << param.fsId << ", parent = " << param.parent
+                   << ", name = " << name << ", inodeId = " << inode->inodeid()
+                   << ", retCode = " << MetaStatusCode_Name(ret);
+        auto ret2 = inodeManager_->DeleteInode(param.fsId, inode->inodeid());
+        if (ret2 != MetaStatusCode::OK) {
+            LOG(ERROR) << "CreateInodeAndDentry also delete inode fail"
+                       << ", fsId = " << param.fsId
+                       << ", inodeId = " << inode->inodeid()
+                       << ", retCode = " << MetaStatusCode_Name(ret2);
+        }
+    }
+    return ret;
+}
+
 MetaStatusCode Partition::CreateRootInode(const InodeParam &param) {
     if (!IsInodeBelongs(param.fsId)) {
         return MetaStatusCode::PARTITION_ID_MISSMATCH;
@@ -400,5 +473,11 @@ std::string Partition::GetDentryTablename() {
     return oss.str();
 }
 
+std::vector<std::string> Partition::GetStorageTablenames() {
+    auto tablenames = inodeStorage_->GetTablenames();
+    tablenames.push_back(GetDentryTablename());
+    return tablenames;
+}
+
 }  // namespace metaserver
 }  // namespace curvefs
@@ -79,6 +79,15 @@ class Partition {
                                Inode* inode);
 
     MetaStatusCode CreateRootInode(const InodeParam &param);
+
+    // create an inode in this partition and link it to `param.parent`,
+    // the parent must belong to this partition too
+    MetaStatusCode CreateInodeAndDentry(const InodeParam &param,
+                                        const std::string& name,
+                                        uint64_t txId,
+                                        uint64_t requestId,
+                                        Inode* inode);
+
     MetaStatusCode GetInode(uint32_t fsId, uint64_t inodeId, Inode* inode);
 
     MetaStatusCode GetInodeAttr(uint32_t fsId, uint64_t inodeId,
@@ -145,6 +154,9 @@ class Partition {
 
     std::string GetDentryTablename();
 
+    // all tables of kv storage which used by this partition
+    std::vector<std::string> GetStorageTablenames();
+
     std::shared_ptr<Iterator> GetAllInode();
 
     std::shared_ptr<Iterator> GetAllDentry();
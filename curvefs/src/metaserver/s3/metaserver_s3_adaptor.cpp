@@ -66,6 +66,10 @@ int S3ClientAdaptorImpl::DeleteInodeByDeleteSingleChunk(const Inode &inode) {
         for (int i = 0; i < s3ChunkInfolist.s3chunks_size(); ++i) {
             // traverse chunks to delete blocks
             S3ChunkInfo chunkInfo = s3ChunkInfolist.s3chunks(i);
+            // pack obj is shared with other inodes, collected by s3compact
+            if (chunkInfo.packid() != 0) {
+                continue;
+            }
             // delete chunkInfo from client
             uint64_t fsId = inode.fsid();
             uint64_t inodeId = inode.inodeid();
@@ -172,6 +176,10 @@ void S3ClientAdaptorImpl::GenObjNameListForChunkInfoList(
     std::list<std::string> *objList) {
     for (int i = 0; i < s3ChunkInfolist.s3chunks_size(); ++i) {
         S3ChunkInfo chunkInfo = s3ChunkInfolist.s3chunks(i);
+        // pack obj is shared with other inodes, collected by s3compact
+        if (chunkInfo.packid() != 0) {
+            continue;
+        }
         std::list<std::string> tempObjList;
         GenObjNameListForChunkInfo(fsId, inodeId, chunkInfo, &tempObjList);
 
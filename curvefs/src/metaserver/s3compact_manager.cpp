@@ -133,6 +133,8 @@ void S3CompactWorkQueueOption::Init(std::shared_ptr<Configuration> conf) {
     conf->GetValueFatalIfFail("s3compactwq.s3_read_max_retry", &s3ReadMaxRetry);
     conf->GetValueFatalIfFail("s3compactwq.s3_read_retry_interval",
                               &s3ReadRetryInterval);
+    conf->GetValueFatalIfFail("s3compactwq.pack_gc_grace_sec",
+                              &packGCGraceSec);
 }
 
 void S3CompactManager::Init(std::shared_ptr<Configuration> conf) {
@@ -231,6 +233,8 @@ void S3CompactManager::Enqueue() {
             s3compactworkqueueImpl_->Enqueue(
                 inodeManager, Key4Inode(fsid, inodeid), pinfo);
         }
+        // collect pack objs after a round of compaction of the partition
+        s3compactworkqueueImpl_->EnqueuePackGC(inodeManager, pinfo);
     }
     {
         WriteLockGuard l(rwLock_);
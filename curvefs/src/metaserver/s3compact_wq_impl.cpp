@@ -29,6 +29,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -36,6 +37,7 @@
 #include "curvefs/src/common/s3util.h"
 #include "curvefs/src/metaserver/copyset/copyset_node_manager.h"
 #include "curvefs/src/metaserver/copyset/meta_operator.h"
+#include "src/common/timeutility.h"
 
 using curve::common::Configuration;
 using curve::common::InitS3AdaptorOptionExceptS3InfoOption;
@@ -85,6 +87,35 @@ void S3CompactWorkQueueImpl::Enqueue(std::shared_ptr<InodeManager> inodeManager,
     notEmpty_.notify_one();
 }
 
+void S3CompactWorkQueueImpl::EnqueuePackGC(
+    std::shared_ptr<InodeManager> inodeManager, PartitionInfo pinfo) {
+    std::unique_lock<std::mutex> guard(mutex_);
+
+    while (IsFullUnlock()) {
+        notFull_.wait(guard);
+    }
+
+    auto copysetNode = copysetNodeMgr_->GetSharedCopysetNode(pinfo.poolid(),
+                                                             pinfo.copysetid());
+    if (!copysetNode) {
+        VLOG(6) << "Copyset node not found, poolid: " << pinfo.poolid()
+                << ", copysetid: " << pinfo.copysetid()
+                << ", fsid: " << pinfo.fsid()
+                << ", partitionid: " << pinfo.partitionid();
+        return;
+    }
+
+    struct S3CompactTask t {
+        inodeManager, Key4Inode(pinfo.fsid(), 0), pinfo,
+            std::make_shared<CopysetNodeWrapper>(copysetNode)
+    };
+
+    auto task =
+        std::bind(&S3CompactWorkQueueImpl::CollectPacks, this, std::move(t));
+    queue_.push_back(std::move(task));
+    notEmpty_.notify_one();
+}
+
 std::function<void()> S3CompactWorkQueueImpl::Dequeue() {
     std::unique_lock<std::mutex> guard(mutex_);
     while (queue_.empty() && running_.load(std::memory_order_acquire)) {
@@ -112,31 +143,45 @@ void S3CompactWorkQueueImpl::ThreadFunc() {
 std::vector<uint64_t> S3CompactWorkQueueImpl::GetNeedCompact(
     const ::google::protobuf::Map<uint64_t, S3ChunkInfoList>& s3chunkinfoMap,
     uint64_t inodeLen, uint64_t chunkSize) {
-    std::vector<uint64_t> needCompact;
+    // chunk index -> fragmentation score
+    // the score is the number of s3chunkinfos, each of them is a fragment
+    // to walk through when reading the chunk
+    std::vector<std::pair<uint64_t, uint64_t>> candidates;
     for (const auto& item : s3chunkinfoMap) {
-        if (needCompact.size() >= opts_.maxChunksPerCompact) {
-            VLOG(9) << "s3compact: reach max chunks to compact per time";
-            break;
-        }
         if (item.first * chunkSize > inodeLen - 1) {
             // we need delete this chunk
-            needCompact.push_back(item.first);
+            candidates.emplace_back(item.first, UINT64_MAX);
             continue;
         }
-        if (static_cast<uint64_t>(item.second.s3chunks_size()) >
-            opts_.fragmentThreshold) {
-            needCompact.push_back(item.first);
+        const auto& l = item.second;
+        uint64_t score = l.s3chunks_size();
+        if (score > opts_.fragmentThreshold) {
+            candidates.emplace_back(item.first, score);
         } else {
-            const auto& l = item.second;
             for (int i = 0; i < l.s3chunks_size(); i++) {
                 if (l.s3chunks(i).offset() + l.s3chunks(i).len() > inodeLen) {
                     // part of chunk is useless, we need to delete them
-                    needCompact.push_back(item.first);
+                    candidates.emplace_back(item.first, score);
                     break;
                 }
             }
         }
     }
+
+    // compact the most fragmented chunks first
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const std::pair<uint64_t, uint64_t>& lhs,
+                        const std::pair<uint64_t, uint64_t>& rhs) {
+                         return lhs.second > rhs.second;
+                     });
+    std::vector<uint64_t> needCompact;
+    for (const auto& candidate : candidates) {
+        if (needCompact.size() >= opts_.maxChunksPerCompact) {
+            VLOG(9) << "s3compact: reach max chunks to compact per time";
+            break;
+        }
+        needCompact.push_back(candidate.first);
+    }
     return needCompact;
 }
 
@@ -227,12 +272,103 @@ S3CompactWorkQueueImpl::BuildValidList(const S3ChunkInfoList& s3chunkinfolist,
         const auto& info = s3chunkinfolist.s3chunks(v.second.second);
         validList.emplace_back(v.first, v.second.first, info.chunkid(),
                                info.compaction(), info.offset(), info.len(),
-                               info.zero());
+                               info.zero(), info.packid(),
+                               info.packoffset());
     }
 
     return validList;
 }
 
+std::vector<struct S3CompactWorkQueueImpl::S3CompactRange>
+S3CompactWorkQueueImpl::GenCompactRanges(
+    const struct S3CompactCtx& ctx, const std::list<struct Node>& validList) {
+    std::vector<struct S3CompactRange> ranges;
+    if (validList.empty()) {
+        return ranges;
+    }
+
+    const auto& blockSize = ctx.blockSize;
+    const auto& chunkSize = ctx.chunkSize;
+    uint64_t chunkBegin = validList.front().begin / chunkSize * chunkSize;
+    // split valid list at block boundary
+    std::vector<struct S3CompactBlock> blocks;
+    for (const auto& node : validList) {
+        uint64_t begin = node.begin;
+        while (begin <= node.end) {
+            uint64_t index = (begin - chunkBegin) / blockSize;
+            uint64_t end =
+                std::min(node.end, chunkBegin + (index + 1) * blockSize - 1);
+            if (blocks.empty() || blocks.back().index != index) {
+                blocks.emplace_back();
+                blocks.back().index = index;
+            }
+            blocks.back().nodes.emplace_back(
+                begin, end, node.chunkid, node.compaction, node.chunkoff,
+                node.chunklen, node.zero, node.packid, node.packoffset);
+            begin = end + 1;
+        }
+    }
+
+    // a block is clean if it's covered by only one node, and the node is
+    // exactly what the block obj holds, so the obj can be reused
+    auto isClean = [&](const struct S3CompactBlock& block) {
+        if (block.nodes.size() != 1) {
+            return false;
+        }
+        const auto& node = block.nodes.front();
+        if (node.zero) {
+            return true;
+        }
+        if (node.packid != 0) {
+            // data in pack obj is moved out of it, so the pack can be freed
+            return false;
+        }
+        uint64_t blockBegin = chunkBegin + block.index * blockSize;
+        uint64_t objBegin = std::max(node.chunkoff, blockBegin);
+        uint64_t objEnd = std::min(node.chunkoff + node.chunklen - 1,
+                                   blockBegin + blockSize - 1);
+        return node.begin == objBegin && node.end == objEnd;
+    };
+
+    auto build = [&](bool keepClean) {
+        ranges.clear();
+        for (const auto& block : blocks) {
+            bool rewrite = !(keepClean && isClean(block));
+            const auto& first = block.nodes.front();
+            bool merge = false;
+            if (!ranges.empty() && ranges.back().rewrite == rewrite) {
+                const auto& prev = ranges.back();
+                if (rewrite) {
+                    merge = prev.blocks.back().index + 1 == block.index;
+                } else {
+                    // kept blocks are merged if they are continuous parts of
+                    // the same s3chunkinfo
+                    const auto& prevNode = prev.blocks.back().nodes.back();
+                    merge = prevNode.chunkid == first.chunkid &&
+                            prevNode.compaction == first.compaction &&
+                            prevNode.zero == first.zero &&
+                            prev.end + 1 == first.begin;
+                }
+            }
+            if (!merge) {
+                ranges.emplace_back();
+                ranges.back().rewrite = rewrite;
+                ranges.back().begin = first.begin;
+            }
+            ranges.back().end = block.nodes.back().end;
+            ranges.back().blocks.push_back(block);
+        }
+    };
+
+    build(true);
+    if (ranges.size() > opts_.fragmentThreshold) {
+        // too many clean blocks from different s3chunkinfos, rewrite all of
+        // them, otherwise the chunk is still fragmented after compaction
+        build(false);
+    }
+    return ranges;
+}
+
 void S3CompactWorkQueueImpl::GenS3ReadRequests(
     const struct S3CompactCtx& ctx, const std::list<struct Node>& validList,
     std::vector<struct S3Request>* reqs, struct S3NewChunkInfo* newChunkInfo) {
@@ -244,43 +380,61 @@ void S3CompactWorkQueueImpl::GenS3ReadRequests(
         if (curr->zero) {
             reqs->emplace_back(reqIndex++, true, "", 0,
                                curr->end - curr->begin + 1);
+            if (next != validList.end() && curr->end + 1 < next->begin) {
+                // hole, append 0
+                reqs->emplace_back(reqIndex++, true, "", 0,
+                                   next->begin - curr->end - 1);
+            }
             curr = next;
             continue;
         }
 
-        const auto& blockSize = ctx.blockSize;
-        const auto& chunkSize = ctx.chunkSize;
-        uint64_t beginRoundDown = curr->begin / chunkSize * chunkSize;
-        uint64_t startIndex = (curr->begin - beginRoundDown) / blockSize;
-        for (uint64_t index = startIndex;
-             beginRoundDown + index * blockSize <= curr->end; index++) {
-            // read the block obj
-            std::string objName = curvefs::common::s3util::GenObjName(
-                curr->chunkid, index, curr->compaction, ctx.fsId, ctx.inodeId);
-            uint64_t s3objBegin =
-                std::max(curr->chunkoff, beginRoundDown + index * blockSize);
-            uint64_t s3objEnd =
-                std::min(curr->chunkoff + curr->chunklen - 1,
-                         beginRoundDown + (index + 1) * blockSize - 1);
-            if (curr->begin >= s3objBegin && curr->end <= s3objEnd) {
-                // all what we need is only part of block
-                reqs->emplace_back(reqIndex++, false, std::move(objName),
-                                   curr->begin - s3objBegin,
-                                   curr->end - curr->begin + 1);
-            } else if (curr->begin >= s3objBegin && curr->end > s3objEnd) {
-                // not last block, what we need is part of block
-                reqs->emplace_back(reqIndex++, false, std::move(objName),
-                                   curr->begin - s3objBegin,
-                                   s3objEnd - curr->begin + 1);
-            } else if (curr->begin < s3objBegin && curr->end > s3objEnd) {
-                // what we need is full block
-                reqs->emplace_back(reqIndex++, false, std::move(objName), 0,
-                                   blockSize);
-            } else if (curr->begin < s3objBegin && curr->end <= s3objEnd) {
-                // last block, what we need is part of block
-                reqs->emplace_back(reqIndex++, false, std::move(objName), 0,
-                                   curr->end - s3objBegin + 1);
-                break;
+        if (curr->packid != 0) {
+            // data is in a pack obj, read the part of it directly
+            reqs->emplace_back(
+                reqIndex++, false,
+                curvefs::common::s3util::GenPackName(ctx.fsId, curr->packid),
+                curr->packoffset + curr->begin - curr->chunkoff,
+                curr->end - curr->begin + 1);
+        } else {
+            const auto& blockSize = ctx.blockSize;
+            const auto& chunkSize = ctx.chunkSize;
+            uint64_t beginRoundDown = curr->begin / chunkSize * chunkSize;
+            uint64_t startIndex = (curr->begin - beginRoundDown) / blockSize;
+            for (uint64_t index = startIndex;
+                 beginRoundDown + index * blockSize <= curr->end; index++) {
+                // read the block obj
+                std::string objName = curvefs::common::s3util::GenObjName(
+                    curr->chunkid, index, curr->compaction, ctx.fsId,
+                    ctx.inodeId);
+                uint64_t s3objBegin = std::max(
+                    curr->chunkoff, beginRoundDown + index * blockSize);
+                uint64_t s3objEnd =
+                    std::min(curr->chunkoff + curr->chunklen - 1,
+                             beginRoundDown + (index + 1) * blockSize - 1);
+                if (curr->begin >= s3objBegin && curr->end <= s3objEnd) {
+                    // all what we need is only part of block
+                    reqs->emplace_back(reqIndex++, false, std::move(objName),
+                                       curr->begin - s3objBegin,
+                                       curr->end - curr->begin + 1);
+                } else if (curr->begin >= s3objBegin &&
+                           curr->end > s3objEnd) {
+                    // not last block, what we need is part of block
+                    reqs->emplace_back(reqIndex++, false, std::move(objName),
+                                       curr->begin - s3objBegin,
+                                       s3objEnd - curr->begin + 1);
+                } else if (curr->begin < s3objBegin &&
+                           curr->end > s3objEnd) {
+                    // what we need is full block
+                    reqs->emplace_back(reqIndex++, false, std::move(objName),
+                                       0, blockSize);
+                } else if (curr->begin < s3objBegin &&
+                           curr->end <= s3objEnd) {
+                    // last block, what we need is part of block
+                    reqs->emplace_back(reqIndex++, false, std::move(objName),
+                                       0, curr->end - s3objBegin + 1);
+                    break;
+                }
             }
         }
 
@@ -432,6 +586,43 @@ int S3CompactWorkQueueImpl::WriteFullChunk(
     return 0;
 }
 
+int S3CompactWorkQueueImpl::RewriteRange(const struct S3CompactCtx& ctx,
+                                         const struct S3CompactRange& range,
+                                         uint64_t newChunkId,
+                                         uint64_t newCompaction,
+                                         std::vector<std::string>* objsAdded) {
+    uint64_t chunkBegin = range.begin / ctx.chunkSize * ctx.chunkSize;
+    // read and write block by block, so at most one block is in memory
+    for (const auto& block : range.blocks) {
+        uint64_t blockBegin = chunkBegin + block.index * ctx.blockSize;
+        uint64_t objBegin = std::max(range.begin, blockBegin);
+        uint64_t objEnd = std::min(range.end, blockBegin + ctx.blockSize - 1);
+        struct S3NewChunkInfo newChunkInfo;
+        std::string data;
+        int ret = ReadFullChunk(ctx, block.nodes, &data, &newChunkInfo);
+        if (ret != 0) {
+            LOG(WARNING) << "s3compact: read block failed, index "
+                         << block.index;
+            return ret;
+        }
+        // holes at both ends of the block
+        data.insert(0, block.nodes.front().begin - objBegin, '\0');
+        data.append(objEnd - block.nodes.back().end, '\0');
+
+        newChunkInfo.newChunkId = newChunkId;
+        newChunkInfo.newOff = objBegin;
+        newChunkInfo.newCompaction = newCompaction;
+        ret = WriteFullChunk(ctx, newChunkInfo, data, objsAdded);
+        if (ret != 0) {
+            LOG(WARNING) << "s3compact: write block failed, index "
+                         << block.index;
+            return ret;
+        }
+        bytesRewritten_ << data.size();
+    }
+    return 0;
+}
+
 bool S3CompactWorkQueueImpl::CompactPrecheck(const struct S3CompactTask& task,
                                              Inode* inode) {
     // am i copysetnode leader?
@@ -513,6 +704,8 @@ S3Adapter* S3CompactWorkQueueImpl::SetupS3Adapter(uint64_t fsId,
 void S3CompactWorkQueueImpl::CompactChunk(
     const struct S3CompactCtx& compactCtx, uint64_t index, const Inode& inode,
     std::unordered_map<uint64_t, std::vector<std::string>>* objsAddedMap,
+    std::unordered_map<uint64_t, std::unordered_set<std::string>>*
+        objsKeptMap,
     ::google::protobuf::Map<uint64_t, S3ChunkInfoList>* s3ChunkInfoAdd,
     ::google::protobuf::Map<uint64_t, S3ChunkInfoList>* s3ChunkInfoRemove) {
     auto cleanup = absl::MakeCleanup(
@@ -535,52 +728,107 @@ void S3CompactWorkQueueImpl::CompactChunk(
         s3ChunkInfoRemove->insert({index, s3chunkinfolist});
         return;
     }
-    // 1.2  first read full chunk
-    struct S3NewChunkInfo newChunkInfo;
-    std::string fullChunk;
-    int ret = ReadFullChunk(compactCtx, validList, &fullChunk, &newChunkInfo);
-    if (ret != 0) {
-        LOG(WARNING) << "s3compact: ReadFullChunk failed, index " << index;
-        s3infoCache_->InvalidateS3Info(
-            compactCtx.fsId);  // maybe s3info changed?
-        return;
+    // 1.2 split chunk into ranges, only fragmented ranges are rewritten
+    std::vector<struct S3CompactRange> ranges =
+        GenCompactRanges(compactCtx, validList);
+    // new objs use the biggest chunkid with a compaction never used by it
+    uint64_t newChunkId = 0;
+    for (const auto& node : validList) {
+        if (!node.zero && node.chunkid >= newChunkId) {
+            newChunkId = node.chunkid;
+        }
+    }
+    uint64_t newCompaction = 1;
+    for (int i = 0; i < s3chunkinfolist.s3chunks_size(); i++) {
+        const auto& info = s3chunkinfolist.s3chunks(i);
+        if (info.chunkid() == newChunkId) {
+            newCompaction = std::max(newCompaction, info.compaction() + 1);
+        }
     }
-    VLOG(6) << "s3compact: finish read full chunk, size: " << fullChunk.size();
-    VLOG(6) << "s3compact: new s3chunk info will be id:"
-            << newChunkInfo.newChunkId << ", off:" << newChunkInfo.newOff
-            << ", compaction:" << newChunkInfo.newCompaction;
-    // 1.3 then write objs with newChunkid and newCompaction
+    VLOG(6) << "s3compact: new s3chunk info will be id:" << newChunkId
+            << ", compaction:" << newCompaction
+            << ", ranges:" << ranges.size();
+    // 1.3 rewrite fragmented ranges with newChunkid and newCompaction,
+    // and keep the others referring to their objs
     std::vector<std::string> objsAdded;
-    ret = WriteFullChunk(compactCtx, newChunkInfo, fullChunk, &objsAdded);
-    if (ret != 0) {
-        LOG(WARNING) << "s3compact: WriteFullChunk failed, index " << index;
-        s3infoCache_->InvalidateS3Info(
-            compactCtx.fsId);  // maybe s3info changed?
-        DeleteObjs(objsAdded, compactCtx.s3adapter);
+    std::unordered_set<std::string> objsKept;
+    S3ChunkInfoList toAddList;
+    bool changed = ranges.size() !=
+                   static_cast<size_t>(s3chunkinfolist.s3chunks_size());
+    for (const auto& range : ranges) {
+        S3ChunkInfo* toAdd = toAddList.add_s3chunks();
+        toAdd->set_offset(range.begin);
+        toAdd->set_len(range.end - range.begin + 1);
+        toAdd->set_size(range.end - range.begin + 1);
+        if (range.rewrite) {
+            int ret = RewriteRange(compactCtx, range, newChunkId,
+                                   newCompaction, &objsAdded);
+            if (ret != 0) {
+                LOG(WARNING) << "s3compact: RewriteRange failed, index "
+                             << index;
+                s3infoCache_->InvalidateS3Info(
+                    compactCtx.fsId);  // maybe s3info changed?
+                DeleteObjs(objsAdded, compactCtx.s3adapter);
+                return;
+            }
+            toAdd->set_chunkid(newChunkId);
+            toAdd->set_compaction(newCompaction);
+            toAdd->set_zero(false);
+            changed = true;
+            continue;
+        }
+
+        const auto& node = range.blocks.front().nodes.front();
+        toAdd->set_chunkid(node.chunkid);
+        toAdd->set_compaction(node.compaction);
+        toAdd->set_zero(node.zero);
+        if (node.chunkoff != range.begin ||
+            node.chunklen != range.end - range.begin + 1) {
+            changed = true;
+        }
+        if (!node.zero) {
+            for (const auto& block : range.blocks) {
+                objsKept.insert(curvefs::common::s3util::GenObjName(
+                    node.chunkid, block.index, node.compaction,
+                    compactCtx.fsId, compactCtx.inodeId));
+            }
+        }
+    }
+    if (!changed) {
+        VLOG(6) << "s3compact: all s3chunkinfos are still in use, index "
+                << index;
         return;
     }
-    VLOG(6) << "s3compact: finish write full chunk";
+    VLOG(6) << "s3compact: finish rewrite chunk, objs added: "
+            << objsAdded.size() << ", objs kept: " << objsKept.size();
+    // the list is stored and removed by range of chunkid
+    std::sort(toAddList.mutable_s3chunks()->begin(),
+              toAddList.mutable_s3chunks()->end(),
+              [](const S3ChunkInfo& lhs, const S3ChunkInfo& rhs) {
+                  return lhs.chunkid() < rhs.chunkid() ||
+                         (lhs.chunkid() == rhs.chunkid() &&
+                          lhs.offset() < rhs.offset());
+              });
     // 1.4 record add/delete
     objsAddedMap->emplace(index, std::move(objsAdded));
+    objsKeptMap->emplace(index, std::move(objsKept));
     // to add
-    S3ChunkInfoList toAddList;
-    S3ChunkInfo toAdd;
-    toAdd.set_chunkid(newChunkInfo.newChunkId);
-    toAdd.set_compaction(newChunkInfo.newCompaction);
-    toAdd.set_offset(newChunkInfo.newOff);
-    toAdd.set_len(fullChunk.length());
-    toAdd.set_size(fullChunk.length());
-    toAdd.set_zero(false);
-    *toAddList.add_s3chunks() = std::move(toAdd);
     s3ChunkInfoAdd->insert({index, std::move(toAddList)});
     // to remove
     s3ChunkInfoRemove->insert({index, s3chunkinfolist});
 }
 
-void S3CompactWorkQueueImpl::DeleteObjsOfS3ChunkInfoList(
-    const struct S3CompactCtx& ctx, const S3ChunkInfoList& s3chunkinfolist) {
+uint64_t S3CompactWorkQueueImpl::DeleteObjsOfS3ChunkInfoList(
+    const struct S3CompactCtx& ctx, const S3ChunkInfoList& s3chunkinfolist,
+    std::unordered_set<std::string>* objsSkip) {
+    uint64_t bytes = 0;
     for (auto i = 0; i < s3chunkinfolist.s3chunks_size(); i++) {
         const auto& chunkinfo = s3chunkinfolist.s3chunks(i);
+        // pack objs are shared with other inodes, they're collected by
+        // CollectPacks
+        if (chunkinfo.zero() || chunkinfo.packid() != 0) {
+            continue;
+        }
         uint64_t off = chunkinfo.offset();
         uint64_t len = chunkinfo.len();
         uint64_t offRoundDown = off / ctx.chunkSize * ctx.chunkSize;
@@ -590,6 +838,15 @@ void S3CompactWorkQueueImpl::DeleteObjsOfS3ChunkInfoList(
             std::string objName = curvefs::common::s3util::GenObjName(
                 chunkinfo.chunkid(), index, chunkinfo.compaction(), ctx.fsId,
                 ctx.inodeId);
+            // still in use or already deleted
+            if (!objsSkip->insert(objName).second) {
+                continue;
+            }
+            uint64_t s3objBegin =
+                std::max(off, offRoundDown + index * ctx.blockSize);
+            uint64_t s3objEnd = std::min(
+                off + len - 1, offRoundDown + (index + 1) * ctx.blockSize - 1);
+            bytes += s3objEnd - s3objBegin + 1;
             VLOG(6) << "s3compact: delete " << objName;
             const Aws::String aws_key(objName.c_str(), objName.size());
             int r = ctx.s3adapter->DeleteObject(
@@ -598,6 +855,16 @@ void S3CompactWorkQueueImpl::DeleteObjsOfS3ChunkInfoList(
                 VLOG(6) << "s3compact: delete obj " << objName << "failed.";
         }
     }
+    return bytes;
+}
+
+double S3CompactWorkQueueImpl::GetRewritePerReclaim(void* arg) {
+    auto impl = reinterpret_cast<S3CompactWorkQueueImpl*>(arg);
+    uint64_t reclaimed = impl->bytesReclaimed_.get_value();
+    if (reclaimed == 0) {
+        return 0;
+    }
+    return static_cast<double>(impl->bytesRewritten_.get_value()) / reclaimed;
 }
 
 void S3CompactWorkQueueImpl::CompactChunks(const struct S3CompactTask& task) {
@@ -641,6 +908,7 @@ void S3CompactWorkQueueImpl::CompactChunks(const struct S3CompactTask& task) {
             chunkSize, s3adapterIndex, s3adapter
     };
     std::unordered_map<uint64_t, std::vector<std::string>> objsAddedMap;
+    std::unordered_map<uint64_t, std::unordered_set<std::string>> objsKeptMap;
     ::google::protobuf::Map<uint64_t, S3ChunkInfoList> s3ChunkInfoAdd;
     ::google::protobuf::Map<uint64_t, S3ChunkInfoList> s3ChunkInfoRemove;
     std::vector<uint64_t> indexToDelete;
@@ -648,8 +916,8 @@ void S3CompactWorkQueueImpl::CompactChunks(const struct S3CompactTask& task) {
             << ", inodeId:" << inodeId;
     for (const auto& index : needCompact) {
         // s3chunklist order: from small chunkid to big chunkid
-        CompactChunk(compactCtx, index, inode, &objsAddedMap, &s3ChunkInfoAdd,
-                     &s3ChunkInfoRemove);
+        CompactChunk(compactCtx, index, inode, &objsAddedMap, &objsKeptMap,
+                     &s3ChunkInfoAdd, &s3ChunkInfoRemove);
     }
     if (s3ChunkInfoAdd.empty() && s3ChunkInfoRemove.empty()) {
         VLOG(6) << "s3compact: do nothing to metadata";
@@ -684,16 +952,125 @@ void S3CompactWorkQueueImpl::CompactChunks(const struct S3CompactTask& task) {
     }
     VLOG(6) << "s3compact: finish update inode";
 
-    // 3. delete old objs
+    // 3. delete old objs which are not kept
     VLOG(6) << "s3compact: start delete old objs";
+    uint64_t bytesReclaimed = 0;
+    std::unordered_set<uint64_t> packIds;
     for (const auto& index : s3ChunkInfoRemoveIndex) {
         const auto& l = inode.s3chunkinfomap().at(index);
-        DeleteObjsOfS3ChunkInfoList(compactCtx, l);
+        bytesReclaimed +=
+            DeleteObjsOfS3ChunkInfoList(compactCtx, l, &objsKeptMap[index]);
+        for (const auto& info : l.s3chunks()) {
+            if (info.packid() != 0) {
+                packIds.insert(info.packid());
+            }
+        }
+    }
+    if (!packIds.empty()) {
+        AddPackCandidates(compactCtx.pinfo.partitionid(), packIds);
     }
-    VLOG(6) << "s3compact: finish delete objs";
+    bytesReclaimed_ << bytesReclaimed;
+    VLOG(6) << "s3compact: finish delete objs, bytes reclaimed: "
+            << bytesReclaimed;
     s3adapterManager_->ReleaseS3Adapter(s3adapterIndex);
     VLOG(6) << "s3compact: compact successfully";
 }
 
+void S3CompactWorkQueueImpl::AddPackCandidates(
+    uint32_t partitionId, const std::unordered_set<uint64_t>& packIds) {
+    std::lock_guard<std::mutex> guard(packGCMutex_);
+    auto& state = packGCStates_[partitionId];
+    state.candidates.insert(packIds.begin(), packIds.end());
+}
+
+void S3CompactWorkQueueImpl::CollectPacks(const struct S3CompactTask& task) {
+    if (!task.copysetNodeWrapper->IsLeaderTerm()) {
+        VLOG(6) << "s3compact: i am not the leader, skip pack gc";
+        return;
+    }
+
+    const auto& pinfo = task.pinfo;
+    std::unordered_set<uint64_t> referred;
+    std::unordered_set<uint64_t> orphaned;
+    if (!task.inodeManager->GetPackIds(&referred, &orphaned)) {
+        LOG(WARNING) << "s3compact: get pack ids failed, partitionid: "
+                     << pinfo.partitionid();
+        return;
+    }
+
+    // a pack may be referred by inodes whose metadata is not flushed yet,
+    // so it's deleted only if it keeps not being referred for a while
+    uint64_t now = ::curve::common::TimeUtility::GetTimeofDaySec();
+    std::vector<uint64_t> toDelete;
+    {
+        std::lock_guard<std::mutex> guard(packGCMutex_);
+        auto& state = packGCStates_[pinfo.partitionid()];
+        // packs deleted are kept only while orphaned lists refer to them
+        for (auto it = state.deleted.begin(); it != state.deleted.end();) {
+            if (orphaned.count(*it) == 0) {
+                it = state.deleted.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (referred.empty() && orphaned.empty() &&
+            state.candidates.empty() && state.dead.empty()) {
+            // no pack in the partition, nothing to collect
+            packGCStates_.erase(pinfo.partitionid());
+            return;
+        }
+        state.candidates.insert(orphaned.begin(), orphaned.end());
+        for (const auto& packId : state.candidates) {
+            if (state.deleted.count(packId) == 0) {
+                state.dead.emplace(packId, now);
+            }
+        }
+        state.candidates.clear();
+        for (auto it = state.dead.begin(); it != state.dead.end();) {
+            if (referred.count(it->first) != 0) {
+                it = state.dead.erase(it);
+            } else if (now - it->second >= opts_.packGCGraceSec) {
+                toDelete.push_back(it->first);
+                it = state.dead.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    if (toDelete.empty()) {
+        return;
+    }
+
+    uint64_t blockSize, chunkSize;
+    uint64_t s3adapterIndex;
+    S3Adapter* s3adapter = SetupS3Adapter(pinfo.fsid(), &s3adapterIndex,
+                                          &blockSize, &chunkSize);
+    if (s3adapter == nullptr) {
+        // retry in next round
+        std::lock_guard<std::mutex> guard(packGCMutex_);
+        auto& state = packGCStates_[pinfo.partitionid()];
+        for (const auto& packId : toDelete) {
+            state.dead.emplace(packId, 0);
+        }
+        return;
+    }
+
+    std::vector<std::string> objs;
+    objs.reserve(toDelete.size());
+    for (const auto& packId : toDelete) {
+        objs.emplace_back(
+            curvefs::common::s3util::GenPackName(pinfo.fsid(), packId));
+    }
+    DeleteObjs(objs, s3adapter);
+    s3adapterManager_->ReleaseS3Adapter(s3adapterIndex);
+    {
+        std::lock_guard<std::mutex> guard(packGCMutex_);
+        auto& state = packGCStates_[pinfo.partitionid()];
+        state.deleted.insert(toDelete.begin(), toDelete.end());
+    }
+    VLOG(6) << "s3compact: delete " << toDelete.size()
+            << " pack objs of partition " << pinfo.partitionid();
+}
+
 }  // namespace metaserver
 }  // namespace curvefs
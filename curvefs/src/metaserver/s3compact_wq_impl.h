@@ -31,9 +31,12 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include <bvar/bvar.h>
+
 #include "curvefs/src/metaserver/copyset/copyset_node.h"
 #include "curvefs/src/metaserver/inode_storage.h"
 #include "curvefs/src/metaserver/s3compact_manager.h"
@@ -79,15 +82,27 @@ class S3CompactWorkQueueImpl : public TaskThreadPool<> {
         : s3adapterManager_(s3adapterManager),
           s3infoCache_(s3infoCache),
           opts_(opts),
-          copysetNodeMgr_(nodeMgr) {}
+          copysetNodeMgr_(nodeMgr),
+          bytesRewritten_("s3compact_bytes_rewritten"),
+          bytesReclaimed_("s3compact_bytes_reclaimed"),
+          rewritePerReclaim_("s3compact_rewrite_per_reclaim",
+                             &S3CompactWorkQueueImpl::GetRewritePerReclaim,
+                             this) {}
 
     std::shared_ptr<S3AdapterManager> s3adapterManager_;
     std::shared_ptr<S3InfoCache> s3infoCache_;
     S3CompactWorkQueueOption opts_;
     std::deque<Key4Inode> compactingInodes_;
     copyset::CopysetNodeManager* copysetNodeMgr_;
+    // bytes uploaded by compaction and bytes of old objs deleted by it
+    bvar::Adder<uint64_t> bytesRewritten_;
+    bvar::Adder<uint64_t> bytesReclaimed_;
+    bvar::PassiveStatus<double> rewritePerReclaim_;
     void Enqueue(std::shared_ptr<InodeManager> inodeManager, Key4Inode inodeKey,
                  PartitionInfo pinfo);
+    // collect pack objs of the partition which are not referred any more
+    void EnqueuePackGC(std::shared_ptr<InodeManager> inodeManager,
+                       PartitionInfo pinfo);
     std::function<void()> Dequeue();
     void ThreadFunc();
 
@@ -140,16 +155,35 @@ class S3CompactWorkQueueImpl : public TaskThreadPool<> {
         uint64_t chunkoff;
         uint64_t chunklen;
         bool zero;
+        uint64_t packid;      // 0 if data is not in a pack obj
+        uint64_t packoffset;  // offset in pack obj of data at chunkoff
         Node(uint64_t begin, uint64_t end, uint64_t chunkid,
              uint64_t compaction, uint64_t chunkoff, uint64_t chunklen,
-             bool zero)
+             bool zero, uint64_t packid = 0, uint64_t packoffset = 0)
             : begin(begin),
               end(end),
               chunkid(chunkid),
               compaction(compaction),
               chunkoff(chunkoff),
               chunklen(chunklen),
-              zero(zero) {}
+              zero(zero),
+              packid(packid),
+              packoffset(packoffset) {}
+    };
+
+    // valid nodes in one block of chunk
+    struct S3CompactBlock {
+        uint64_t index;  // block index in chunk
+        std::list<struct Node> nodes;
+    };
+
+    // continuous blocks which are kept as they are, or rewritten to new objs
+    // of one new s3chunkinfo
+    struct S3CompactRange {
+        bool rewrite;
+        uint64_t begin;
+        uint64_t end;
+        std::vector<struct S3CompactBlock> blocks;
     };
 
     // closure for updating inode, simply wait
@@ -184,6 +218,9 @@ class S3CompactWorkQueueImpl : public TaskThreadPool<> {
     std::list<struct Node> BuildValidList(
         const S3ChunkInfoList& s3chunkinfolist, uint64_t inodeLen,
         uint64_t index, uint64_t chunkSize);
+    std::vector<struct S3CompactRange> GenCompactRanges(
+        const struct S3CompactCtx& ctx,
+        const std::list<struct Node>& validList);
     void GenS3ReadRequests(const struct S3CompactCtx& ctx,
                            const std::list<struct Node>& validList,
                            std::vector<struct S3Request>* reqs,
@@ -200,17 +237,44 @@ class S3CompactWorkQueueImpl : public TaskThreadPool<> {
                        const struct S3NewChunkInfo& newChunkInfo,
                        const std::string& fullChunk,
                        std::vector<std::string>* objsAdded);
+    int RewriteRange(const struct S3CompactCtx& ctx,
+                     const struct S3CompactRange& range,
+                     uint64_t newChunkId, uint64_t newCompaction,
+                     std::vector<std::string>* objsAdded);
     void CompactChunk(
         const struct S3CompactCtx& compactCtx, uint64_t index,
         const Inode& inode,
         std::unordered_map<uint64_t, std::vector<std::string>>* objsAddedMap,
+        std::unordered_map<uint64_t, std::unordered_set<std::string>>*
+            objsKeptMap,
         ::google::protobuf::Map<uint64_t, S3ChunkInfoList>* s3ChunkInfoAdd,
         ::google::protobuf::Map<uint64_t, S3ChunkInfoList>* s3ChunkInfoRemove);
 
-    void DeleteObjsOfS3ChunkInfoList(const struct S3CompactCtx& ctx,
-                                     const S3ChunkInfoList& s3chunkinfolist);
+    // delete objs of s3chunkinfolist except those in objsSkip, deleted objs
+    // are added to objsSkip. return bytes of objs deleted
+    uint64_t DeleteObjsOfS3ChunkInfoList(
+        const struct S3CompactCtx& ctx, const S3ChunkInfoList& s3chunkinfolist,
+        std::unordered_set<std::string>* objsSkip);
+    static double GetRewritePerReclaim(void* arg);
     // func bind with task
     void CompactChunks(const struct S3CompactTask& task);
+
+    // pack objs are shared by inodes of one partition, they're deleted
+    // only after not being referred by any inode for packGCGraceSec
+    struct PackGCState {
+        // packs no longer referred by s3chunkinfos replaced by compaction
+        std::unordered_set<uint64_t> candidates;
+        // pack id -> time in sec when it's first found not referred
+        std::unordered_map<uint64_t, uint64_t> dead;
+        // packs deleted, orphaned s3chunkinfo lists may still refer to them
+        std::unordered_set<uint64_t> deleted;
+    };
+    std::mutex packGCMutex_;
+    std::unordered_map<uint32_t, PackGCState> packGCStates_;
+    void AddPackCandidates(uint32_t partitionId,
+                           const std::unordered_set<uint64_t>& packIds);
+    // func bind with pack gc task
+    void CollectPacks(const struct S3CompactTask& task);
 };
 
 }  // namespace metaserver
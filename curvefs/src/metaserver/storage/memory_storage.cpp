@@ -301,6 +301,21 @@ Status MemoryStorage::Rollback()  {
     return Status::OK();
 }
 
+bool MemoryStorage::Checkpoint(const std::string& dir,
+                               const std::vector<std::string>& names,
+                               std::vector<std::string>* files,
+                               DumpFileClosure* done) {
+    done->Runned();
+    LOG(ERROR) << "Memory storage not support checkpoint";
+    return false;
+}
+
+std::shared_ptr<KVStorage> MemoryStorage::OpenCheckpoint(
+    const std::string& dir) {
+    LOG(ERROR) << "Memory storage not support checkpoint";
+    return nullptr;
+}
+
 bool MemoryStorage::GetStatistics(StorageStatistics* statistics) {
     statistics->maxMemoryQuotaBytes = options_.maxMemoryQuotaBytes;
     statistics->maxDiskQuotaBytes = options_.maxDiskQuotaBytes;
@@ -26,6 +26,7 @@
 #include <string>
 #include <memory>
 #include <utility>
+#include <vector>
 #include <unordered_map>
 
 #include "absl/container/btree_map.h"
@@ -142,6 +143,15 @@ class MemoryStorage : public KVStorage, public StorageTransaction {
 
     Status Rollback() override;
 
+    // NOTE: memory storage is saved by dumping all entries,
+    // so it doesn't support checkpoint.
+    bool Checkpoint(const std::string& dir,
+                    const std::vector<std::string>& names,
+                    std::vector<std::string>* files,
+                    DumpFileClosure* done) override;
+
+    std::shared_ptr<KVStorage> OpenCheckpoint(const std::string& dir) override;
+
  private:
     RWLock rwLock_;
     StorageOptions options_;
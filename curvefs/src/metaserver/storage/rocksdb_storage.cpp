@@ -23,10 +23,17 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <sstream>
 #include <unordered_map>
+#include <vector>
 
+#include "absl/cleanup/cleanup.h"
+#include "butil/files/file_path.h"
 #include "rocksdb/slice_transform.h"
+#include "rocksdb/sst_file_writer.h"
 #include "curvefs/src/metaserver/storage/utils.h"
 #include "curvefs/src/metaserver/storage/storage.h"
 #include "curvefs/src/metaserver/storage/rocksdb_storage.h"
@@ -37,6 +44,13 @@ namespace storage {
 
 using KeyPair = RocksDBStorage::KeyPair;
 
+namespace {
+
+// sequence of the temporary databases which checkpoints are ingested into
+std::atomic<uint64_t> checkpointSeq(0);
+
+}  // namespace
+
 const std::string RocksDBOptions::kOrderedColumnFamilyName_ =  // NOLINT
     "ordered_column_familiy";
 
@@ -134,13 +148,15 @@ inline ROCKSDB_NAMESPACE::WriteOptions RocksDBOptions::WriteOptions() {
 }
 
 RocksDBStorage::RocksDBStorage()
-    : InTransaction_(false) {}
+    : destroyOnClose_(false),
+      InTransaction_(false) {}
 
 RocksDBStorage::RocksDBStorage(StorageOptions options)
     : inited_(false),
       options_(options),
       rocksdbOptions_(RocksDBOptions(options)),
       counter_(std::make_shared<Counter>()),
+      destroyOnClose_(false),
       InTransaction_(false) {}
 
 RocksDBStorage::RocksDBStorage(const RocksDBStorage& storage,
@@ -152,6 +168,7 @@ RocksDBStorage::RocksDBStorage(const RocksDBStorage& storage,
       txnDB_(storage.txnDB_),
       handles_(storage.handles_),
       counter_(storage.counter_),
+      destroyOnClose_(false),
       InTransaction_(true),
       txn_(txn) {}
 
@@ -221,6 +238,15 @@ bool RocksDBStorage::Close() {
         return false;
     }
     inited_ = false;
+
+    if (destroyOnClose_) {
+        s = ROCKSDB_NAMESPACE::DestroyDB(options_.dataDir, DBOptions());
+        if (!s.ok()) {
+            LOG(ERROR) << "Destroy rocksdb failed, status = "
+                       << s.ToString();
+            return false;
+        }
+    }
     return s.ok();
 }
 
@@ -473,6 +499,159 @@ Status RocksDBStorage::Rollback()  {
     return ToStorageStatus(s);
 }
 
+// The sst files of checkpoint are named by column family
+std::string RocksDBStorage::CheckpointFilename(bool ordered) {
+    return ordered ? "ordered.sst" : "unordered.sst";
+}
+
+bool RocksDBStorage::Checkpoint(const std::string& dir,
+                                const std::vector<std::string>& names,
+                                std::vector<std::string>* files,
+                                DumpFileClosure* done) {
+    if (!inited_) {
+        done->Runned();
+        LOG(ERROR) << "Create checkpoint failed, rocksdb is closed";
+        return false;
+    }
+
+    // all tables are dumped from the same snapshot of database
+    auto readOptions = ReadOptions();
+    readOptions.snapshot = db_->GetSnapshot();
+    done->Runned();
+    auto defer = absl::MakeCleanup([&]() {
+        db_->ReleaseSnapshot(readOptions.snapshot);
+    });
+
+    auto env = db_->GetEnv();
+    ROCKSDB_NAMESPACE::Status s = env->CreateDir(dir);
+    if (!s.ok()) {
+        LOG(ERROR) << "Create checkpoint directory failed, dir = " << dir
+                   << ", status = " << s.ToString();
+        return false;
+    }
+
+    files->clear();
+    auto columnFamilies = ColumnFamilys();
+    RocksDBStorageComparator comparator;
+    for (const auto ordered : {false, true}) {
+        // keys must be added to sst file in order, the prefix of table
+        // is compared first, so we dump tables in the order of prefix
+        std::vector<std::string> prefixes;
+        for (const auto& name : names) {
+            std::string iname = ToInternalName(name, ordered);
+            prefixes.push_back(ToInternalKey(iname, ""));
+        }
+        std::sort(prefixes.begin(), prefixes.end(),
+                  [&](const std::string& a, const std::string& b) {
+                      return comparator.Compare(a, b) < 0;
+                  });
+        prefixes.erase(std::unique(prefixes.begin(), prefixes.end()),
+                       prefixes.end());
+
+        auto handle = GetColumnFamilyHandle(ordered);
+        ROCKSDB_NAMESPACE::Options options(
+            DBOptions(), columnFamilies[ordered ? 1 : 0].options);
+        ROCKSDB_NAMESPACE::SstFileWriter writer(
+            ROCKSDB_NAMESPACE::EnvOptions(), options, handle);
+        std::string filename = CheckpointFilename(ordered);
+        bool opened = false;
+        std::unique_ptr<ROCKSDB_NAMESPACE::Iterator> iter(
+            db_->NewIterator(readOptions, handle));
+        for (const auto& prefix : prefixes) {
+            for (iter->Seek(prefix);
+                 iter->Valid() && iter->key().starts_with(prefix);
+                 iter->Next()) {
+                if (!opened) {
+                    s = writer.Open(dir + "/" + filename);
+                    if (!s.ok()) {
+                        break;
+                    }
+                    opened = true;
+                }
+                s = writer.Put(iter->key(), iter->value());
+                if (!s.ok()) {
+                    break;
+                }
+            }
+            if (s.ok()) {
+                s = iter->status();
+            }
+            if (!s.ok()) {
+                break;
+            }
+        }
+
+        // sst file can't be empty, so it's skipped if no entry dumped
+        if (s.ok() && opened) {
+            s = writer.Finish();
+            files->push_back(filename);
+        }
+        if (!s.ok()) {
+            LOG(ERROR) << "Dump tables to checkpoint failed, dir = " << dir
+                       << ", ordered = " << ordered
+                       << ", status = " << s.ToString();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RocksDBStorage::IngestCheckpoint(const std::string& dir) {
+    auto env = db_->GetEnv();
+    for (const auto ordered : {false, true}) {
+        std::string pathname = dir + "/" + CheckpointFilename(ordered);
+        if (!env->FileExists(pathname).ok()) {  // no entry dumped
+            continue;
+        }
+
+        ROCKSDB_NAMESPACE::IngestExternalFileOptions options;
+        options.move_files = false;  // the snapshot file must be kept
+        ROCKSDB_NAMESPACE::Status s = db_->IngestExternalFile(
+            GetColumnFamilyHandle(ordered), {pathname}, options);
+        if (!s.ok()) {
+            LOG(ERROR) << "Ingest checkpoint file failed, file = " << pathname
+                       << ", status = " << s.ToString();
+            return false;
+        }
+    }
+    return true;
+}
+
+// NOTE: the counter of checkpoint storage is empty, so only the iterators
+// (e.g. HGetAll, SGetAll) are meaningful for it.
+std::shared_ptr<KVStorage> RocksDBStorage::OpenCheckpoint(
+    const std::string& dir) {
+    // the temporary database is placed beside the data directory of
+    // storage instead of |dir|, so it never mixes with the raft snapshot,
+    // e.g: data/storage => data/storage_checkpoint/0
+    std::string root = butil::FilePath(options_.dataDir)
+        .StripTrailingSeparators().value() + "_checkpoint";
+    auto env = ROCKSDB_NAMESPACE::Env::Default();
+    ROCKSDB_NAMESPACE::Status s = env->CreateDirIfMissing(root);
+    if (!s.ok()) {
+        LOG(ERROR) << "Create directory for checkpoint database failed"
+                   << ", dir = " << root << ", status = " << s.ToString();
+        return nullptr;
+    }
+
+    StorageOptions options = options_;
+    options.dataDir = root + "/" + std::to_string(checkpointSeq.fetch_add(1));
+    auto storage = std::make_shared<RocksDBStorage>(options);
+    // clean the database left by last crash
+    ROCKSDB_NAMESPACE::DestroyDB(options.dataDir, storage->DBOptions());
+    if (!storage->Open()) {
+        LOG(ERROR) << "Open database for checkpoint failed, dir = " << dir;
+        return nullptr;
+    }
+
+    storage->destroyOnClose_ = true;
+    if (!storage->IngestCheckpoint(dir)) {
+        storage->Close();
+        return nullptr;
+    }
+    return storage;
+}
+
 bool RocksDBStorage::GetStatistics(StorageStatistics* statistics) {
     statistics->maxMemoryQuotaBytes = options_.maxMemoryQuotaBytes;
     statistics->maxDiskQuotaBytes = options_.maxDiskQuotaBytes;
@@ -188,7 +188,24 @@ class RocksDBStorage : public KVStorage, public StorageTransaction {
 
     Status Rollback() override;
 
+    // NOTE: the tables are exported to sst files (one for each column
+    // family) from a snapshot of database, so neither the memtable is
+    // flushed nor the sst files of database are pinned.
+    bool Checkpoint(const std::string& dir,
+                    const std::vector<std::string>& names,
+                    std::vector<std::string>* files,
+                    DumpFileClosure* done) override;
+
+    // NOTE: the sst files of checkpoint are ingested into a temporary
+    // database under "<dataDir>_checkpoint", which will be destroyed
+    // on close.
+    std::shared_ptr<KVStorage> OpenCheckpoint(const std::string& dir) override;
+
  private:
+    std::string CheckpointFilename(bool ordered);
+
+    bool IngestCheckpoint(const std::string& dir);
+
     ROCKSDB_NAMESPACE::Options DBOptions();
 
     ROCKSDB_NAMESPACE::TransactionDBOptions TransactionDBOptions();
@@ -264,6 +281,7 @@ class RocksDBStorage : public KVStorage, public StorageTransaction {
     TransactionDB* txnDB_;
     std::vector<ColumnFamilyHandle*> handles_;
     std::shared_ptr<Counter> counter_;
+    bool destroyOnClose_;
 
     // for transaction
     bool InTransaction_;
@@ -25,10 +25,12 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "curvefs/src/metaserver/storage/config.h"
 #include "curvefs/src/metaserver/storage/status.h"
 #include "curvefs/src/metaserver/storage/iterator.h"
+#include "curvefs/src/metaserver/storage/dumpfile.h"
 
 namespace curvefs {
 namespace metaserver {
@@ -113,6 +115,20 @@ class KVStorage : public BaseStorage {
     virtual StorageOptions GetStorageOptions() const = 0;
 
     virtual std::shared_ptr<StorageTransaction> BeginTransaction() = 0;
+
+    // Dump the tables |names| at a point-in-time view into files under |dir|,
+    // the created files (relative to |dir|) are returned by |files|.
+    // |done| is runned once the view is taken, the storage can be
+    // modified after that.
+    virtual bool Checkpoint(const std::string& dir,
+                            const std::vector<std::string>& names,
+                            std::vector<std::string>* files,
+                            DumpFileClosure* done) = 0;
+
+    // Open the checkpoint which created by Checkpoint() as a storage,
+    // it should be closed after used.
+    virtual std::shared_ptr<KVStorage> OpenCheckpoint(
+        const std::string& dir) = 0;
 };
 
 bool InitStorage(StorageOptions options);
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: Wednesday Oct 12 14:21:44 CST 2022
+ * Author: wuhanqing
+ */
+
+#include "curvefs/src/volume/alloc_cache.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "curvefs/src/volume/utils.h"
+
+namespace curvefs {
+namespace volume {
+
+AllocCache::AllocCache(const AllocCacheOption& option, RefillFunc refill)
+    : option_(option), refill_(std::move(refill)), cached_(0) {
+    CHECK_GT(option_.shards, 0);
+
+    shards_.reserve(option_.shards);
+    for (uint32_t i = 0; i < option_.shards; ++i) {
+        shards_.push_back(absl::make_unique<Shard>());
+    }
+}
+
+AllocCache::Shard* AllocCache::CurrentShard() {
+    static std::atomic<uint32_t> nextIdx(0);
+    static thread_local uint32_t idx =
+        nextIdx.fetch_add(1, std::memory_order_relaxed);
+
+    return shards_[idx % shards_.size()].get();
+}
+
+uint64_t AllocCache::Take(Shard* shard,
+                          uint64_t size,
+                          const AllocateHint& hint,
+                          std::vector<Extent>* exts) {
+    uint64_t need = size;
+
+    auto take = [&](std::deque<Extent>::iterator it) {
+        uint64_t len = std::min(need, it->len);
+        exts->emplace_back(it->offset, len);
+        need -= len;
+
+        if (len == it->len) {
+            return shard->extents.erase(it);
+        }
+
+        it->offset += len;
+        it->len -= len;
+        return it;
+    };
+
+    // continue from where the previous allocation of this file ended, so
+    // sequential writes get contiguous space
+    if (hint.HasLeftHint()) {
+        auto it = std::find_if(shard->extents.begin(), shard->extents.end(),
+                               [&hint](const Extent& e) {
+                                   return e.offset == hint.leftOffset;
+                               });
+        if (it != shard->extents.end()) {
+            take(it);
+        }
+    }
+
+    auto it = shard->extents.begin();
+    while (need > 0 && it != shard->extents.end()) {
+        it = take(it);
+    }
+
+    cached_.fetch_sub(size - need, std::memory_order_relaxed);
+    return size - need;
+}
+
+bool AllocCache::Alloc(uint64_t size,
+                       const AllocateHint& hint,
+                       std::vector<Extent>* exts) {
+    Shard* shard = CurrentShard();
+    std::unique_lock<std::mutex> lk(shard->mtx);
+
+    const size_t oldSize = exts->size();
+    uint64_t allocated = Take(shard, size, hint, exts);
+    if (allocated == size) {
+        return true;
+    }
+
+    // refill may allocate block groups from mds, and it takes allocators'
+    // lock, so shard lock is released meanwhile to not block other threads
+    // on this shard and to not deadlock with Drain() during shutdown
+    lk.unlock();
+
+    uint64_t need = size - allocated;
+    std::vector<Extent> reserved;
+    bool ret = false;
+    if (option_.refillSize > need) {
+        ret = refill_(option_.refillSize, &reserved);
+        if (!ret) {
+            reserved.clear();
+        }
+    }
+
+    // not enough space for a full refill, try to reserve what we need
+    if (!ret) {
+        ret = refill_(need, &reserved);
+    }
+
+    lk.lock();
+
+    if (!ret) {
+        LOG(ERROR) << "Refill alloc cache failed, need: " << need
+                   << ", refill size: " << option_.refillSize;
+
+        // give back what has been taken from this shard
+        shard->extents.insert(shard->extents.begin(), exts->begin() + oldSize,
+                              exts->end());
+        exts->resize(oldSize);
+        cached_.fetch_add(allocated, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint64_t total = 0;
+    for (const auto& e : reserved) {
+        shard->extents.push_back(e);
+        total += e.len;
+    }
+    cached_.fetch_add(total, std::memory_order_relaxed);
+
+    VLOG(9) << "Refill alloc cache, reserved: " << reserved;
+
+    allocated += Take(shard, need, AllocateHint(), exts);
+    CHECK_EQ(size, allocated);
+    return true;
+}
+
+void AllocCache::Drain(std::vector<Extent>* exts) {
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lk(shard->mtx);
+        for (const auto& e : shard->extents) {
+            exts->push_back(e);
+            cached_.fetch_sub(e.len, std::memory_order_relaxed);
+        }
+        shard->extents.clear();
+    }
+}
+
+}  // namespace volume
+}  // namespace curvefs
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: Wednesday Oct 12 14:21:37 CST 2022
+ * Author: wuhanqing
+ */
+
+#ifndef CURVEFS_SRC_VOLUME_ALLOC_CACHE_H_
+#define CURVEFS_SRC_VOLUME_ALLOC_CACHE_H_
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "curvefs/src/volume/common.h"
+#include "curvefs/src/volume/option.h"
+
+namespace curvefs {
+namespace volume {
+
+// Space reserved from block group allocators in batches.
+//
+// Each thread is bound to one shard, and allocation requests are served from
+// the extents reserved by this shard, so concurrent writers don't contend on
+// the allocators' locks for every allocation. When a shard runs out of space,
+// it reserves at least `refillSize` bytes through `RefillFunc`.
+//
+// Reserved extents are only recorded in memory, bitmap of block group is
+// updated by caller after extents are handed out.
+class AllocCache {
+ public:
+    // reserve exactly `size` bytes, return true if success
+    using RefillFunc =
+        std::function<bool(uint64_t size, std::vector<Extent>* exts)>;
+
+    AllocCache(const AllocCacheOption& option, RefillFunc refill);
+
+    AllocCache(const AllocCache&) = delete;
+    AllocCache& operator=(const AllocCache&) = delete;
+
+    /**
+     * @brief Allocate space from current thread's shard
+     * @param hint if hint.leftOffset is reserved by current shard, space is
+     *        allocated from it first
+     * @return return true if success, otherwise return false
+     */
+    bool Alloc(uint64_t size,
+               const AllocateHint& hint,
+               std::vector<Extent>* exts);
+
+    /**
+     * @brief Take out all reserved extents
+     */
+    void Drain(std::vector<Extent>* exts);
+
+    /**
+     * @brief Total size of reserved extents
+     */
+    uint64_t CachedSize() const {
+        return cached_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    struct Shard {
+        std::mutex mtx;
+        std::deque<Extent> extents;
+    };
+
+    Shard* CurrentShard();
+
+    // take at most `size` bytes from shard, return taken size
+    uint64_t Take(Shard* shard,
+                  uint64_t size,
+                  const AllocateHint& hint,
+                  std::vector<Extent>* exts);
+
+ private:
+    const AllocCacheOption option_;
+    RefillFunc refill_;
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<uint64_t> cached_;
+};
+
+}  // namespace volume
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_VOLUME_ALLOC_CACHE_H_
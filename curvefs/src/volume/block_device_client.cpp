@@ -22,21 +22,30 @@
 
 #include "curvefs/src/volume/block_device_client.h"
 
+#include <butil/time.h>
+#include <bvar/bvar.h>
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <map>
+#include <numeric>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/cleanup/cleanup.h"
 #include "curvefs/src/common/metric_utils.h"
 #include "src/client/service_helper.h"
 #include "src/common/concurrent/count_down_event.h"
+#include "src/common/fast_align.h"
 
 namespace curvefs {
 namespace volume {
 
 using ::curve::client::UserInfo;
+using ::curve::common::align_up;
 using ::curve::common::CountDownEvent;
 using ::curvefs::common::LatencyUpdater;
 
@@ -44,6 +53,252 @@ namespace {
 
 bvar::LatencyRecorder g_write_latency("block_device_write");
 bvar::LatencyRecorder g_read_latency("block_device_read");
+bvar::LatencyRecorder g_aio_write_latency("block_device_aio_write");
+bvar::LatencyRecorder g_aio_read_latency("block_device_aio_read");
+bvar::Adder<uint64_t> g_aio_merged_parts("block_device_aio_merged_parts");
+
+using PaddingReads = std::vector<std::pair<off_t, size_t>>;
+
+// Calculate aligned reads that are needed before writing [offset, length)
+// with aligned range [writeStart, writeEnd), leading and trailing blocks are
+// merged into one read if they are adjacent
+PaddingReads CalcPaddingReads(off_t writeStart,
+                              off_t writeEnd,
+                              off_t offset,
+                              size_t length) {
+    PaddingReads reads;
+    off_t readEnd = 0;
+
+    // Padding leading
+    if (offset != writeStart) {
+        reads.push_back(std::make_pair(writeStart, IO_ALIGNED_BLOCK_SIZE));
+        readEnd = writeStart + IO_ALIGNED_BLOCK_SIZE;
+    }
+
+    // Padding trailing
+    if (offset + length > readEnd && offset + length != writeEnd) {
+        off_t readStart = writeEnd - IO_ALIGNED_BLOCK_SIZE;
+        if (reads.size() == 1 && readStart == readEnd) {
+            reads[0].second = IO_ALIGNED_BLOCK_SIZE * 2;
+        } else {
+            reads.push_back(std::make_pair(readStart, IO_ALIGNED_BLOCK_SIZE));
+        }
+    }
+
+    return reads;
+}
+
+// Parts whose aligned ranges are adjacent or overlapped, they are issued as
+// one io, so each aligned block is read or written at most once
+template <typename Part>
+struct MergedParts {
+    off_t start;
+    off_t end;
+    // bytes covered by parts, overlapped bytes are counted once
+    size_t length;
+    // whether parts cover [start, end) without holes
+    bool continuous;
+    // in the order of submission, so the later of overlapped writes wins
+    // when they're copied into one buffer
+    std::vector<Part> parts;
+
+    explicit MergedParts(const Part& part)
+        : start(part.offset),
+          end(part.offset + part.length),
+          length(part.length),
+          continuous(true) {}
+};
+
+template <typename Part>
+std::vector<MergedParts<Part>> MergeParts(const std::vector<Part>& iov) {
+    std::vector<size_t> order(iov.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&iov](size_t a, size_t b) {
+        return iov[a].offset < iov[b].offset;
+    });
+
+    std::vector<MergedParts<Part>> merged;
+    // indexes in |iov| of each merged parts
+    std::vector<std::vector<size_t>> members;
+    for (auto idx : order) {
+        const auto& part = iov[idx];
+        if (part.length == 0) {
+            continue;
+        }
+
+        // merge if part is adjacent to previous one or they share one block
+        if (merged.empty() ||
+            (part.offset > merged.back().end &&
+             part.offset >=
+                 align_up(merged.back().end, IO_ALIGNED_BLOCK_SIZE))) {
+            merged.emplace_back(part);
+            members.emplace_back(1, idx);
+            continue;
+        }
+
+        auto& last = merged.back();
+        off_t partEnd = part.offset + part.length;
+        last.continuous = last.continuous && part.offset <= last.end;
+        if (partEnd > last.end) {
+            last.length += partEnd - std::max<off_t>(part.offset, last.end);
+            last.end = partEnd;
+        }
+        members.back().push_back(idx);
+        g_aio_merged_parts << 1;
+    }
+
+    for (size_t i = 0; i < merged.size(); ++i) {
+        std::sort(members[i].begin(), members[i].end());
+        merged[i].parts.reserve(members[i].size());
+        for (auto idx : members[i]) {
+            merged[i].parts.push_back(iov[idx]);
+        }
+    }
+
+    return merged;
+}
+
+// Tracks all ios of one AioReadv/AioWritev, and calls user callback after
+// the last one finished
+class AioTracker {
+ public:
+    AioTracker(size_t ios,
+               ssize_t length,
+               bvar::LatencyRecorder* latency,
+               BlockDeviceAioCallback done)
+        : pending_(ios),
+          failed_(false),
+          length_(length),
+          latency_(latency),
+          done_(std::move(done)) {
+        timer_.start();
+    }
+
+    void Finish(bool success) {
+        if (!success) {
+            failed_.store(true, std::memory_order_relaxed);
+        }
+
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+
+        timer_.stop();
+        *latency_ << timer_.u_elapsed();
+        done_(failed_.load(std::memory_order_relaxed) ? -1 : length_);
+        delete this;
+    }
+
+ private:
+    std::atomic<size_t> pending_;
+    std::atomic<bool> failed_;
+    const ssize_t length_;
+    bvar::LatencyRecorder* latency_;
+    butil::Timer timer_;
+    BlockDeviceAioCallback done_;
+};
+
+// Context of one aligned io issued to libcurve
+struct BlockDeviceAioContext : public CurveAioContext {
+    AioTracker* tracker = nullptr;
+    FileClient* fileClient = nullptr;
+    int fd = -1;
+
+    // nullptr if io is issued with user's buffer directly
+    std::unique_ptr<char[]> buffer;
+
+    // read parts that copied out from `buffer` after read
+    std::vector<ReadPart> reads;
+
+    // write parts that copied into `buffer` before write
+    std::vector<WritePart> writes;
+
+    // number of unfinished padding reads before write
+    std::atomic<int> pendingPaddings{0};
+    std::atomic<bool> paddingFailed{false};
+};
+
+// Context of aligned read for unaligned write's leading and trailing block
+struct PaddingReadContext : public CurveAioContext {
+    BlockDeviceAioContext* io = nullptr;
+};
+
+bool AioSucceeded(const CurveAioContext* ctx) {
+    return ctx->ret >= 0 && static_cast<size_t>(ctx->ret) == ctx->length;
+}
+
+void FinishAio(BlockDeviceAioContext* io, bool success) {
+    io->tracker->Finish(success);
+    delete io;
+}
+
+void AioReadCallback(CurveAioContext* ctx) {
+    auto* io = static_cast<BlockDeviceAioContext*>(ctx);
+    bool success = AioSucceeded(ctx);
+    LOG_IF(ERROR, !success) << "Aio read failed, offset: " << ctx->offset
+                            << ", length: " << ctx->length
+                            << ", ret: " << ctx->ret;
+
+    if (success && io->buffer) {
+        for (const auto& part : io->reads) {
+            memcpy(part.data, io->buffer.get() + (part.offset - ctx->offset),
+                   part.length);
+        }
+    }
+
+    FinishAio(io, success);
+}
+
+void AioWriteCallback(CurveAioContext* ctx) {
+    auto* io = static_cast<BlockDeviceAioContext*>(ctx);
+    bool success = AioSucceeded(ctx);
+    LOG_IF(ERROR, !success) << "Aio write failed, offset: " << ctx->offset
+                            << ", length: " << ctx->length
+                            << ", ret: " << ctx->ret;
+
+    FinishAio(io, success);
+}
+
+void IssueAioWrite(BlockDeviceAioContext* io) {
+    if (io->buffer) {
+        for (const auto& part : io->writes) {
+            memcpy(io->buffer.get() + (part.offset - io->offset), part.data,
+                   part.length);
+        }
+    }
+
+    io->op = LIBCURVE_OP::LIBCURVE_OP_WRITE;
+    io->cb = AioWriteCallback;
+    int ret = io->fileClient->AioWrite(io->fd, io);
+    if (ret != LIBCURVE_ERROR::OK) {
+        LOG(ERROR) << "Issue aio write failed, offset: " << io->offset
+                   << ", length: " << io->length << ", ret: " << ret;
+        FinishAio(io, false);
+    }
+}
+
+void PaddingReadCallback(CurveAioContext* ctx) {
+    auto* padding = static_cast<PaddingReadContext*>(ctx);
+    auto* io = padding->io;
+    if (!AioSucceeded(ctx)) {
+        LOG(ERROR) << "Aio padding read failed, offset: " << ctx->offset
+                   << ", length: " << ctx->length << ", ret: " << ctx->ret;
+        io->paddingFailed.store(true, std::memory_order_relaxed);
+    }
+
+    delete padding;
+
+    if (io->pendingPaddings.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    if (io->paddingFailed.load(std::memory_order_relaxed)) {
+        FinishAio(io, false);
+        return;
+    }
+
+    IssueAioWrite(io);
+}
 
 }  // namespace
 
@@ -272,29 +527,147 @@ ssize_t BlockDeviceClientImpl::Writev(const std::vector<WritePart>& writes) {
     return res.load(std::memory_order_relaxed);
 }
 
-bool BlockDeviceClientImpl::WritePadding(char* writeBuffer,
-                                         off_t writeStart,
-                                         off_t writeEnd,
-                                         off_t offset,
-                                         size_t length) {
-    std::vector<std::pair<off_t, size_t>> readvec;  // Align reads
-    off_t readEnd = 0;
+void BlockDeviceClientImpl::AioReadv(const std::vector<ReadPart>& iov,
+                                     BlockDeviceAioCallback done) {
+    if (fd_ < 0) {
+        done(-1);
+        return;
+    }
 
-    // Padding leading
-    if (offset != writeStart) {
-        readvec.push_back(std::make_pair(writeStart, IO_ALIGNED_BLOCK_SIZE));
-        readEnd = writeStart + IO_ALIGNED_BLOCK_SIZE;
+    auto merged = MergeParts(iov);
+    if (merged.empty()) {
+        done(0);
+        return;
     }
 
-    // Padding trailing
-    if (offset + length > readEnd && offset + length != writeEnd) {
-        off_t readStart = writeEnd - IO_ALIGNED_BLOCK_SIZE;
-        if (readvec.size() == 1 && readStart == readEnd) {
-            readvec[0].second = IO_ALIGNED_BLOCK_SIZE * 2;
+    ssize_t total = 0;
+    for (const auto& m : merged) {
+        total += m.length;
+    }
+
+    auto* tracker = new AioTracker(merged.size(), total, &g_aio_read_latency,
+                                   std::move(done));
+
+    for (auto& m : merged) {
+        auto* io = new BlockDeviceAioContext();
+        io->tracker = tracker;
+        io->fileClient = fileClient_.get();
+        io->fd = fd_;
+        io->op = LIBCURVE_OP::LIBCURVE_OP_READ;
+        io->cb = AioReadCallback;
+
+        if (m.parts.size() == 1 && IsAligned(m.start, m.length)) {
+            io->offset = m.start;
+            io->length = m.length;
+            io->buf = m.parts[0].data;
         } else {
-            readvec.push_back(std::make_pair(readStart, IO_ALIGNED_BLOCK_SIZE));
+            auto range = CalcAlignRange(m.start, m.end);
+            io->offset = range.first;
+            io->length = range.second - range.first;
+            io->buffer.reset(new char[io->length]);
+            io->buf = io->buffer.get();
+            io->reads = std::move(m.parts);
+        }
+
+        VLOG(9) << "aio read offset: " << io->offset
+                << ", length: " << io->length;
+
+        int ret = fileClient_->AioRead(fd_, io);
+        if (ret != LIBCURVE_ERROR::OK) {
+            LOG(ERROR) << "Issue aio read failed, offset: " << io->offset
+                       << ", length: " << io->length << ", ret: " << ret;
+            FinishAio(io, false);
+        }
+    }
+}
+
+void BlockDeviceClientImpl::AioWritev(const std::vector<WritePart>& iov,
+                                      BlockDeviceAioCallback done) {
+    if (fd_ < 0) {
+        done(-1);
+        return;
+    }
+
+    auto merged = MergeParts(iov);
+    if (merged.empty()) {
+        done(0);
+        return;
+    }
+
+    ssize_t total = 0;
+    for (const auto& m : merged) {
+        total += m.length;
+    }
+
+    auto* tracker = new AioTracker(merged.size(), total, &g_aio_write_latency,
+                                   std::move(done));
+
+    for (auto& m : merged) {
+        auto* io = new BlockDeviceAioContext();
+        io->tracker = tracker;
+        io->fileClient = fileClient_.get();
+        io->fd = fd_;
+
+        if (m.parts.size() == 1 && IsAligned(m.start, m.length)) {
+            io->offset = m.start;
+            io->length = m.length;
+            io->buf = const_cast<char*>(m.parts[0].data);
+            IssueAioWrite(io);
+            continue;
+        }
+
+        auto range = CalcAlignRange(m.start, m.end);
+        io->offset = range.first;
+        io->length = range.second - range.first;
+        io->buffer.reset(new char[io->length]);
+        io->buf = io->buffer.get();
+        io->writes = std::move(m.parts);
+
+        // parts with holes between them are padded by one read of the whole
+        // aligned range
+        auto paddings =
+            m.continuous
+                ? CalcPaddingReads(range.first, range.second, m.start,
+                                   m.end - m.start)
+                : PaddingReads{{range.first, io->length}};
+        if (paddings.empty()) {
+            IssueAioWrite(io);
+            continue;
+        }
+
+        // write is issued by the last finished padding read
+        io->pendingPaddings.store(paddings.size(), std::memory_order_relaxed);
+        for (const auto& p : paddings) {
+            auto* padding = new PaddingReadContext();
+            padding->io = io;
+            padding->offset = p.first;
+            padding->length = p.second;
+            padding->buf = io->buffer.get() + (p.first - range.first);
+            padding->op = LIBCURVE_OP::LIBCURVE_OP_READ;
+            padding->cb = PaddingReadCallback;
+
+            VLOG(9) << "aio padding read offset: " << padding->offset
+                    << ", length: " << padding->length;
+
+            int ret = fileClient_->AioRead(fd_, padding);
+            if (ret != LIBCURVE_ERROR::OK) {
+                LOG(ERROR) << "Issue aio padding read failed, offset: "
+                           << padding->offset
+                           << ", length: " << padding->length
+                           << ", ret: " << ret;
+                padding->ret = -LIBCURVE_ERROR::FAILED;
+                PaddingReadCallback(padding);
+            }
         }
     }
+}
+
+bool BlockDeviceClientImpl::WritePadding(char* writeBuffer,
+                                         off_t writeStart,
+                                         off_t writeEnd,
+                                         off_t offset,
+                                         size_t length) {
+    auto readvec = CalcPaddingReads(writeStart, writeEnd, offset, length);
 
     for (const auto& item : readvec) {
         auto retCode = AlignRead(writeBuffer + item.first - writeStart,
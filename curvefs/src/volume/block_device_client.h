@@ -23,6 +23,7 @@
 #ifndef CURVEFS_SRC_VOLUME_BLOCK_DEVICE_CLIENT_H_
 #define CURVEFS_SRC_VOLUME_BLOCK_DEVICE_CLIENT_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -40,6 +41,10 @@ using ::curve::client::FileClient;
 
 using Range = std::pair<off_t, off_t>;
 
+// callback of asynchronous io, `ret` is total length of all parts if succeeded,
+// otherwise it's a negative value
+using BlockDeviceAioCallback = std::function<void(ssize_t ret)>;
+
 struct BlockDeviceClientOptions {
     // config path
     std::string configPath;
@@ -125,6 +130,26 @@ class BlockDeviceClient {
     virtual ssize_t Readv(const std::vector<ReadPart>& iov) = 0;
 
     virtual ssize_t Writev(const std::vector<WritePart>& iov) = 0;
+
+    /**
+     * @brief Asynchronous read parts from fd which init by Open()
+     * @param[in] iov read parts, offset and length maybe not aligned
+     * @param[in] done callback that invoked after all parts are finished
+     * @note adjacent parts are merged and issued as one io, buffers of `iov`
+     *       must be valid until `done` is called
+     */
+    virtual void AioReadv(const std::vector<ReadPart>& iov,
+                          BlockDeviceAioCallback done) = 0;
+
+    /**
+     * @brief Asynchronous write parts to fd which init by Open()
+     * @param[in] iov write parts, offset and length maybe not aligned
+     * @param[in] done callback that invoked after all parts are finished
+     * @note adjacent parts are merged and issued as one io, unaligned head and
+     *       tail are padded by reading corresponding blocks first
+     */
+    virtual void AioWritev(const std::vector<WritePart>& iov,
+                           BlockDeviceAioCallback done) = 0;
 };
 
 class BlockDeviceClientImpl : public BlockDeviceClient {
@@ -157,6 +182,12 @@ class BlockDeviceClientImpl : public BlockDeviceClient {
 
     ssize_t Writev(const std::vector<WritePart>& writes) override;
 
+    void AioReadv(const std::vector<ReadPart>& iov,
+                  BlockDeviceAioCallback done) override;
+
+    void AioWritev(const std::vector<WritePart>& iov,
+                   BlockDeviceAioCallback done) override;
+
  private:
     bool WritePadding(char* writeBuffer,
                                off_t writeStart,
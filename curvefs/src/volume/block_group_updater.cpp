@@ -24,11 +24,16 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <climits>
+
 #include "curvefs/src/volume/block_device_client.h"
 
 namespace curvefs {
 namespace volume {
 
+constexpr uint32_t BlockGroupBitmapUpdater::kBitmapPageSize;
+
 void BlockGroupBitmapUpdater::Update(const Extent& ext, Op op) {
     std::lock_guard<std::mutex> lk(lock_);
 
@@ -43,25 +48,76 @@ void BlockGroupBitmapUpdater::Update(const Extent& ext, Op op) {
         bitmap_.Clear(startIdx, endIdx);
     }
 
-    dirty_ = true;
+    MarkDirty(startIdx, endIdx);
+}
+
+void BlockGroupBitmapUpdater::MarkDirty(uint64_t startIdx, uint64_t endIdx) {
+    uint64_t firstPage = startIdx / CHAR_BIT / kBitmapPageSize;
+    uint64_t lastPage = endIdx / CHAR_BIT / kBitmapPageSize;
+
+    for (uint64_t page = firstPage; page <= lastPage; ++page) {
+        dirtyPages_.insert(page);
+    }
+}
+
+void BlockGroupBitmapUpdater::BuildDirtyParts(
+    std::vector<WritePart>* parts) const {
+    const char* data = bitmap_.GetBitmap();
+    const uint64_t bitmapBytes =
+        std::min<uint64_t>(bitmapRange_.length, bitmap_.Size() / CHAR_BIT);
+
+    auto it = dirtyPages_.begin();
+    while (it != dirtyPages_.end()) {
+        uint64_t first = *it;
+        uint64_t last = first;
+        ++it;
+        while (it != dirtyPages_.end() && *it == last + 1) {
+            last = *it;
+            ++it;
+        }
+
+        uint64_t start = first * kBitmapPageSize;
+        if (start >= bitmapBytes) {
+            break;
+        }
+
+        uint64_t end =
+            std::min<uint64_t>((last + 1) * kBitmapPageSize, bitmapBytes);
+        parts->emplace_back(bitmapRange_.offset + start, end - start,
+                            data + start);
+    }
 }
 
 bool BlockGroupBitmapUpdater::Sync() {
     std::lock_guard<std::mutex> lk(lock_);
 
-    if (!dirty_) {
+    if (dirtyPages_.empty()) {
         return true;
     }
 
-    bool ret = blockDev_->Write(bitmap_.GetBitmap(), bitmapRange_.offset,
-                                bitmapRange_.length);
+    std::vector<WritePart> parts;
+    BuildDirtyParts(&parts);
 
-    LOG_IF(ERROR, !ret) << "Sync block group bitmap failed, err: " << ret
-                        << ", block group offset: " << groupOffset_;
+    uint64_t expected = 0;
+    for (const auto& part : parts) {
+        expected += part.length;
+    }
+
+    ssize_t ret = parts.empty() ? 0 : blockDev_->Writev(parts);
+    if (ret < 0 || static_cast<uint64_t>(ret) != expected) {
+        LOG(ERROR) << "Sync block group bitmap failed, err: " << ret
+                   << ", block group offset: " << groupOffset_
+                   << ", dirty pages: " << dirtyPages_.size()
+                   << ", write parts: " << parts.size();
+        return false;
+    }
 
-    dirty_ = !ret;
+    VLOG(9) << "Sync block group bitmap success, block group offset: "
+            << groupOffset_ << ", dirty pages: " << dirtyPages_.size()
+            << ", write parts: " << parts.size() << ", bytes: " << expected;
 
-    return ret;
+    dirtyPages_.clear();
+    return true;
 }
 
 }  // namespace volume
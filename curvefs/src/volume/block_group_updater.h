@@ -24,7 +24,9 @@
 #define CURVEFS_SRC_VOLUME_BLOCK_GROUP_UPDATER_H_
 
 #include <mutex>
+#include <set>
 #include <utility>
+#include <vector>
 
 #include "curvefs/src/volume/common.h"
 #include "src/common/bitmap.h"
@@ -42,6 +44,10 @@ struct BitmapRange {
 };
 
 // bitmap updater for each block group
+//
+// Only the bitmap pages touched since the last successful sync are written
+// back, so a few allocations in a large block group don't rewrite the whole
+// on-disk bitmap.
 class BlockGroupBitmapUpdater {
  public:
     BlockGroupBitmapUpdater(Bitmap bitmap,
@@ -50,8 +56,7 @@ class BlockGroupBitmapUpdater {
                             uint64_t groupOffset,
                             const BitmapRange& range,
                             BlockDeviceClient* blockDev)
-        : dirty_(false),
-          bitmap_(std::move(bitmap)),
+        : bitmap_(std::move(bitmap)),
           blockSize_(blockSize),
           groupSize_(groupSize),
           groupOffset_(groupOffset),
@@ -67,14 +72,26 @@ class BlockGroupBitmapUpdater {
     void Update(const Extent& ext, Op op);
 
     /**
-     * @brief Sync bitmap to backend storage if dirty
+     * @brief Sync dirty bitmap pages to backend storage
      * @return return true if success, otherwise, return false
+     * @note if sync failed, all dirty pages are kept and will be written
+     *       again by next sync
      */
     bool Sync();
 
+    // granularity of dirty tracking, in bytes of on-disk bitmap
+    static constexpr uint32_t kBitmapPageSize = 4 * kKiB;
+
+ private:
+    // mark bitmap pages covered by bits [startIdx, endIdx] as dirty
+    void MarkDirty(uint64_t startIdx, uint64_t endIdx);
+
+    // merge consecutive dirty pages into write parts
+    void BuildDirtyParts(std::vector<WritePart>* parts) const;
+
  private:
     std::mutex lock_;
-    bool dirty_;
+    std::set<uint64_t> dirtyPages_;
     Bitmap bitmap_;
     uint32_t blockSize_;
     uint32_t groupSize_;
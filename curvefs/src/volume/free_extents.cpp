@@ -80,7 +80,7 @@ uint64_t FreeExtents::AllocInternal(const uint64_t size,
     }
 
     uint64_t need = size;
-    std::map<uint64_t, uint64_t>::const_iterator iter;
+    ExtentMap::const_iterator iter;
 
     // 1. find extents that satisfy hint.leftOffset
     if (hint.leftOffset != AllocateHint::INVALID_OFFSET) {
@@ -189,10 +189,12 @@ uint64_t FreeExtents::AvailableBlocks(std::map<uint64_t, uint64_t>* blocks) {
     uint64_t size = 0;
 
     // TODO(wuhanqing): move this calc to DeAlloc
-    *blocks = std::move(blocks_);
-    for (const auto& b : *blocks) {
+    blocks->clear();
+    for (const auto& b : blocks_) {
+        blocks->emplace_hint(blocks->end(), b.first, b.second);
         size += b.second;
     }
+    blocks_.clear();
 
     available_ -= size;
     return size;
@@ -229,7 +231,7 @@ void FreeExtents::DeAllocInternal(const uint64_t off, const uint64_t len) {
     if (iter != extents_.begin()) {
         --iter;
     }
-    if ((iter->first + iter->second) == off) {
+    if (iter != extents_.end() && (iter->first + iter->second) == off) {
         iter->second += len;
         curIter = iter;
     } else {
@@ -242,10 +244,13 @@ void FreeExtents::DeAllocInternal(const uint64_t off, const uint64_t len) {
     const auto endOff = curIter->first + curIter->second;
     iter = extents_.lower_bound(endOff);
     if (iter != extents_.end() && iter->first == endOff) {
+        const auto curOff = curIter->first;
         curIter->second += iter->second;
 
-        // erase current iterator
+        // erase right extent, b-tree erase invalidates all iterators, so
+        // lookup current extent again
         extents_.erase(iter);
+        curIter = extents_.find(curOff);
     }
 
     // split it if it's big enough
@@ -28,6 +28,7 @@
 #include <vector>
 #include <cassert>
 
+#include "absl/container/btree_map.h"
 #include "curvefs/src/volume/common.h"
 
 namespace curvefs {
@@ -96,7 +97,9 @@ class FreeExtents {
     /**
      * @brief Get current available extents
      */
-    std::map<uint64_t, uint64_t> AvailableExtents() const { return extents_; }
+    std::map<uint64_t, uint64_t> AvailableExtents() const {
+        return std::map<uint64_t, uint64_t>(extents_.begin(), extents_.end());
+    }
 
     /**
      * @brief Get currnet available blocks
@@ -122,8 +125,12 @@ class FreeExtents {
     const uint64_t maxExtentSize_;
     uint64_t available_;
 
-    std::map<uint64_t, uint64_t> extents_;
-    std::map<uint64_t, uint64_t> blocks_;
+    // free extents are kept in b-tree rather than red-black tree, nodes are
+    // cache friendly and lookup/erase are cheaper when there are many extents
+    using ExtentMap = absl::btree_map<uint64_t, uint64_t>;
+
+    ExtentMap extents_;
+    ExtentMap blocks_;
 };
 
 }  // namespace volume
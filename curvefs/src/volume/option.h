@@ -51,9 +51,17 @@ struct AllocatorOption {
     BitmapAllocatorOption bitmapAllocatorOption;
 };
 
+struct AllocCacheOption {
+    // number of cache shards, 0 means disable cache
+    uint32_t shards = 0;
+    // size reserved from block groups once a shard runs out of space
+    uint64_t refillSize = 0;
+};
+
 struct SpaceManagerOption {
     AllocatorOption allocatorOption;
     BlockGroupManagerOption blockGroupManagerOption;
+    AllocCacheOption allocCacheOption;
 };
 
 }  // namespace volume
@@ -29,6 +29,7 @@
 #include <utility>
 
 #include "absl/cleanup/cleanup.h"
+#include "absl/memory/memory.h"
 #include "curvefs/src/volume/utils.h"
 #include "src/common/fast_align.h"
 
@@ -53,7 +54,15 @@ SpaceManagerImpl::SpaceManagerImpl(
                                     blockDev,
                                     option.blockGroupManagerOption,
                                     option.allocatorOption)),
-      allocating_(false) {}
+      allocating_(false) {
+    if (option.allocCacheOption.shards > 0) {
+        allocCache_ = absl::make_unique<AllocCache>(
+            option.allocCacheOption,
+            [this](uint64_t size, std::vector<Extent>* exts) {
+                return AllocFromBlockGroups(size, AllocateHint(), exts);
+            });
+    }
+}
 
 bool SpaceManagerImpl::Alloc(uint32_t size,
                              const AllocateHint& hint,
@@ -63,15 +72,42 @@ bool SpaceManagerImpl::Alloc(uint32_t size,
     butil::Timer timer;
     timer.start();
 
+    auto ret = allocCache_ ? allocCache_->Alloc(size, hint, extents)
+                           : AllocFromBlockGroups(size, hint, extents);
+    if (!ret) {
+        LOG(ERROR) << "Allocate space failed, size: " << size;
+        metric_.errorCount << 1;
+        return false;
+    }
+
+    ret = UpdateBitmap(*extents);
+    if (!ret) {
+        LOG(ERROR) << "Update bitmap failed";
+        metric_.errorCount << 1;
+        return false;
+    }
+
+    timer.stop();
+    metric_.allocLatency << timer.u_elapsed();
+    metric_.allocSize << size;
+
+    VLOG(9) << "Alloc success, " << *extents;
+
+    return true;
+}
+
+bool SpaceManagerImpl::AllocFromBlockGroups(uint64_t size,
+                                            const AllocateHint& hint,
+                                            std::vector<Extent>* extents) {
     if (availableBytes_.load(std::memory_order_acquire) < size) {
         auto ret = AllocateBlockGroup();
         if (!ret) {
             LOG(ERROR) << "Allocate block group error";
-            metric_.errorCount << 1;
             return false;
         }
     }
 
+    const size_t oldSize = extents->size();
     int64_t left = size;
     while (left > 0) {
         auto allocated = AllocInternal(left, hint, extents);
@@ -79,29 +115,30 @@ bool SpaceManagerImpl::Alloc(uint32_t size,
             auto ret = AllocateBlockGroup();
             if (!ret) {
                 LOG(ERROR) << "Allocate block group error";
-                metric_.errorCount << 1;
+
+                // give back partial allocated space
+                std::vector<Extent> partial(extents->begin() + oldSize,
+                                            extents->end());
+                extents->resize(oldSize);
+                ReadLockGuard lk(allocatorsLock_);
+                DeAllocToBlockGroups(partial);
                 return false;
             }
         }
         left -= allocated;
     }
 
-    auto ret = UpdateBitmap(*extents);
-    if (!ret) {
-        LOG(ERROR) << "Update bitmap failed";
-        metric_.errorCount << 1;
-        return false;
-    }
-
-    timer.stop();
-    metric_.allocLatency << timer.u_elapsed();
-    metric_.allocSize << size;
-
-    VLOG(9) << "Alloc success, " << *extents;
-
     return true;
 }
 
+void SpaceManagerImpl::DeAllocToBlockGroups(const std::vector<Extent>& exts) {
+    for (const auto& ext : exts) {
+        auto it = allocators_.find(align_down(ext.offset, blockGroupSize_));
+        CHECK(it != allocators_.end()) << "extent: " << ext;
+        it->second->DeAlloc(ext.offset, ext.len);
+    }
+}
+
 bool SpaceManagerImpl::DeAlloc(const std::vector<Extent>& extents) {
     // TODO(wuhanqing): fix
     (void)extents;
@@ -167,13 +204,15 @@ bool SpaceManagerImpl::UpdateBitmap(const std::vector<Extent>& exts) {
     for (auto& ext : exts) {
         BlockGroupBitmapUpdater* updater = FindBitmapUpdater(ext);
         updater->Update(ext, BlockGroupBitmapUpdater::Set);
+        dirty.insert(updater);
     }
 
+    bool ret = true;
     for (auto d : dirty) {
-        d->Sync();
+        ret = d->Sync() && ret;
     }
 
-    return true;
+    return ret;
 }
 
 BlockGroupBitmapUpdater* SpaceManagerImpl::FindBitmapUpdater(
@@ -189,9 +228,19 @@ BlockGroupBitmapUpdater* SpaceManagerImpl::FindBitmapUpdater(
 }
 
 bool SpaceManagerImpl::Shutdown() {
+    // space reserved by alloc cache is never recorded in bitmap, take it out
+    // before locking allocators, so shard locks are never waited for while
+    // holding allocators' lock
+    std::vector<Extent> cached;
+    if (allocCache_) {
+        allocCache_->Drain(&cached);
+    }
+
     WriteLockGuard allocLk(allocatorsLock_);
     WriteLockGuard updaterLk(updatersLock_);
 
+    DeAllocToBlockGroups(cached);
+
     // sync all bitmap updater
     bool ret = false;
     for (auto& updater : bitmapUpdaters_) {
@@ -29,6 +29,7 @@
 
 #include "curvefs/proto/common.pb.h"
 #include "curvefs/src/client/rpcclient/mds_client.h"
+#include "curvefs/src/volume/alloc_cache.h"
 #include "curvefs/src/volume/allocator.h"
 #include "curvefs/src/volume/block_device_client.h"
 #include "curvefs/src/volume/block_group_manager.h"
@@ -75,6 +76,14 @@ class SpaceManagerImpl final : public SpaceManager {
     bool Shutdown() override;
 
  private:
+    /**
+     * @brief Allocate space from block group allocators, and allocate new
+     *        block groups if current ones don't have enough space
+     */
+    bool AllocFromBlockGroups(uint64_t size,
+                              const AllocateHint& hint,
+                              std::vector<Extent>* extents);
+
     int64_t AllocInternal(int64_t size,
                           const AllocateHint& hint,
                           std::vector<Extent>* exts);
@@ -89,6 +98,12 @@ class SpaceManagerImpl final : public SpaceManager {
 
     bool UpdateBitmap(const std::vector<Extent>& exts);
 
+    /**
+     * @brief Give back extents to their block group allocators
+     * @note caller must hold allocatorsLock_
+     */
+    void DeAllocToBlockGroups(const std::vector<Extent>& exts);
+
  private:
     bool AllocateBlockGroup();
 
@@ -111,6 +126,9 @@ class SpaceManagerImpl final : public SpaceManager {
 
     std::unique_ptr<BlockGroupManager> blockGroupManager_;
 
+    // nullptr if alloc cache is disabled
+    std::unique_ptr<AllocCache> allocCache_;
+
     bool allocating_;
     std::mutex mtx_;
     std::condition_variable cond_;
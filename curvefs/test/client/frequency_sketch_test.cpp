@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "curvefs/src/client/s3/frequency_sketch.h"
+
+namespace curvefs {
+namespace client {
+
+TEST(FrequencySketchTest, Estimate) {
+    FrequencySketch sketch(128);
+    ASSERT_EQ(0, sketch.Estimate(1));
+
+    for (int i = 0; i < 5; i++) {
+        sketch.Increment(1);
+    }
+    sketch.Increment(2);
+    ASSERT_EQ(5, sketch.Estimate(1));
+    ASSERT_EQ(1, sketch.Estimate(2));
+    ASSERT_EQ(0, sketch.Estimate(3));
+}
+
+TEST(FrequencySketchTest, Saturate) {
+    FrequencySketch sketch(128);
+    for (int i = 0; i < 100; i++) {
+        sketch.Increment(1);
+    }
+    ASSERT_EQ(15, sketch.Estimate(1));
+}
+
+TEST(FrequencySketchTest, Admit) {
+    FrequencySketch sketch(128);
+    sketch.Increment(1);
+    sketch.Increment(1);
+    sketch.Increment(2);
+
+    ASSERT_TRUE(sketch.Admit(1, 2));
+    ASSERT_FALSE(sketch.Admit(2, 1));
+    // victim wins on tie
+    ASSERT_FALSE(sketch.Admit(3, 4));
+}
+
+TEST(FrequencySketchTest, Aging) {
+    // width is 1024, so counters are halved after 10240 increments
+    FrequencySketch sketch(1);
+    for (int i = 0; i < 8; i++) {
+        sketch.Increment(1);
+    }
+    ASSERT_EQ(8, sketch.Estimate(1));
+
+    for (uint64_t key = 100; key < 100 + 10240; key++) {
+        sketch.Increment(key);
+    }
+    // other keys may share counters with it, but it's halved at least once
+    ASSERT_LT(sketch.Estimate(1), 8);
+}
+
+TEST(FrequencySketchTest, Concurrent) {
+    FrequencySketch sketch(128);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&sketch]() {
+            for (int j = 0; j < 3; j++) {
+                sketch.Increment(1);
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    // no increment is lost and the counter saturates
+    ASSERT_EQ(12, sketch.Estimate(1));
+    for (int i = 0; i < 4; i++) {
+        sketch.Increment(1);
+    }
+    ASSERT_EQ(15, sketch.Estimate(1));
+}
+
+}  // namespace client
+}  // namespace curvefs
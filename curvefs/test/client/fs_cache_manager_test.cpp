@@ -52,6 +52,7 @@ class FsCacheManagerTest : public testing::Test {
         option.intervalSec = 5000;
         option.flushIntervalSec = 5000;
         option.readCacheMaxByte = 104857600;
+        option.readCacheAdmission = false;
         option.diskCacheOpt.diskCacheType = (DiskCacheType)0;
         option.chunkFlushThreads = 5;
         s3ClientAdaptor_ = new S3ClientAdaptorImpl();
@@ -154,6 +155,45 @@ TEST_F(FsCacheManagerTest, test_lru_set_and_delete) {
     }
 }
 
+TEST_F(FsCacheManagerTest, test_lru_admission) {
+    uint64_t blockSize = 1ull * 1024 * 1024;
+    uint64_t dataCacheByte = 4ull * 1024 * 1024;  // 4MiB
+    char *buf = new char[dataCacheByte];
+    std::list<DataCachePtr>::iterator outIter;
+    fsCacheManager_->EnableAdmission(blockSize);
+
+    auto hotChunk =
+        std::make_shared<ChunkCacheManager>(0, s3ClientAdaptor_, 1);
+    auto coldChunk =
+        std::make_shared<ChunkCacheManager>(0, s3ClientAdaptor_, 2);
+    for (int i = 0; i < 3; ++i) {
+        fsCacheManager_->RecordAccess(1, 0, 0, dataCacheByte);
+    }
+    for (size_t i = 0; i < maxReadCacheByte_ / dataCacheByte; ++i) {
+        ASSERT_TRUE(fsCacheManager_->Set(
+            std::make_shared<DataCache>(s3ClientAdaptor_, hotChunk, 0,
+                                        dataCacheByte, buf),
+            &outIter));
+    }
+
+    // cache is full, data accessed once can't evict the hot one
+    fsCacheManager_->RecordAccess(2, 0, 0, dataCacheByte);
+    ASSERT_FALSE(fsCacheManager_->Set(
+        std::make_shared<DataCache>(s3ClientAdaptor_, coldChunk, 0,
+                                    dataCacheByte, buf),
+        &outIter));
+
+    // it's admitted after it becomes hotter than the victim
+    for (int i = 0; i < 3; ++i) {
+        fsCacheManager_->RecordAccess(2, 0, 0, dataCacheByte);
+    }
+    ASSERT_TRUE(fsCacheManager_->Set(
+        std::make_shared<DataCache>(s3ClientAdaptor_, coldChunk, 0,
+                                    dataCacheByte, buf),
+        &outIter));
+    delete[] buf;
+}
+
 TEST_F(FsCacheManagerTest, test_fsSync_ok) {
     uint64_t inodeId = 1;
     auto fileCache = std::make_shared<MockFileCacheManager>();
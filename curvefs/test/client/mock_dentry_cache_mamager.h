@@ -38,8 +38,9 @@ class MockDentryCacheManager : public DentryCacheManager {
     MockDentryCacheManager() {}
     ~MockDentryCacheManager() {}
 
-    MOCK_METHOD2(Init, CURVEFS_ERROR(
-        uint64_t cacheSize, bool enableCacheMetrics));
+    MOCK_METHOD4(Init, CURVEFS_ERROR(
+        uint64_t cacheSize, bool enableCacheMetrics,
+        uint64_t negativeCacheSize, uint32_t negativeTimeoutMs));
 
     MOCK_METHOD1(InsertOrReplaceCache, void(const Dentry& dentry));
 
@@ -57,6 +58,13 @@ class MockDentryCacheManager : public DentryCacheManager {
                                            std::list<Dentry> *dentryList,
                                            uint32_t limit,
                                            bool onlyDir));
+
+    MOCK_METHOD6(ListDentryPage, CURVEFS_ERROR(uint64_t parent,
+                                               const std::string &last,
+                                               uint32_t limit,
+                                               std::list<Dentry> *dentryList,
+                                               bool *finished,
+                                               bool onlyDir));
 };
 
 
@@ -53,6 +53,10 @@ class MockInodeCacheManager : public InodeCacheManager {
     MOCK_METHOD2(CreateInode, CURVEFS_ERROR(const InodeParam &param,
         std::shared_ptr<InodeWrapper> &out));     // NOLINT
 
+    MOCK_METHOD3(CreateInodeAndDentry, CURVEFS_ERROR(const InodeParam &param,
+        const std::string &name,
+        std::shared_ptr<InodeWrapper> &out));     // NOLINT
+
     MOCK_METHOD1(DeleteInode, CURVEFS_ERROR(uint64_t inodeid));
 
     MOCK_METHOD1(ClearInodeCache, void(uint64_t inodeid));
@@ -63,6 +67,9 @@ class MockInodeCacheManager : public InodeCacheManager {
     MOCK_METHOD0(FlushAll, void());
 
     MOCK_METHOD0(FlushInodeOnce, void());
+
+    MOCK_METHOD2(GetPartitionId, bool(uint64_t inodeId,
+                                      PartitionID *partitionId));
 };
 
 }  // namespace client
@@ -91,6 +91,11 @@ class MockMetaServerClient : public MetaServerClient {
                  void(const Inode &inode, MetaServerClientDone *done,
                       InodeOpenStatusChange statusChange));
 
+    MOCK_METHOD4(BatchUpdateInode, MetaStatusCode(
+        uint32_t fsId, const std::vector<UpdateInodeRequest> &updates,
+        std::vector<MetaStatusCode> *statusCodes,
+        const BatchUpdateInodeDone &done));
+
     MOCK_METHOD2(UpdateXattrAsync, void(const Inode &inode,
         MetaServerClientDone *done));
 
@@ -111,7 +116,13 @@ class MockMetaServerClient : public MetaServerClient {
     MOCK_METHOD2(CreateInode, MetaStatusCode(
             const InodeParam &param, Inode *out));
 
+    MOCK_METHOD3(CreateInodeAndDentry, MetaStatusCode(
+            const InodeParam &param, const std::string &name, Inode *out));
+
     MOCK_METHOD2(DeleteInode, MetaStatusCode(uint32_t fsId, uint64_t inodeid));
+
+    MOCK_METHOD3(GetPartitionId, bool(uint32_t fsId, uint64_t inodeId,
+                                      PartitionID *partitionId));
 };
 
 }  // namespace rpcclient
@@ -25,6 +25,7 @@
 #include <gtest/gtest.h>
 #include <google/protobuf/util/message_differencer.h>
 
+#include <atomic>
 #include <thread>
 
 #include "absl/cleanup/cleanup.h"
@@ -45,6 +46,7 @@ using ::testing::DoAll;
 using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::SetArgPointee;
+using ::testing::SaveArgPointee;
 using ::testing::AnyOf;
 
 using ::curvefs::metaserver::Dentry;
@@ -53,6 +55,10 @@ using ::curvefs::metaserver::BatchGetInodeAttrRequest;
 using ::curvefs::metaserver::BatchGetInodeAttrResponse;
 using ::curvefs::metaserver::BatchGetXAttrRequest;
 using ::curvefs::metaserver::BatchGetXAttrResponse;
+using ::curvefs::metaserver::BatchUpdateInodeRequest;
+using ::curvefs::metaserver::BatchUpdateInodeResponse;
+using ::curvefs::metaserver::CreateInodeAndDentryRequest;
+using ::curvefs::metaserver::CreateInodeAndDentryResponse;
 using ::curvefs::common::StreamServer;
 using ::curvefs::common::StreamOptions;
 using ::curvefs::common::StreamConnection;
@@ -1314,6 +1320,190 @@ TEST_F(MetaServerClientImplTest, test_BatchGetXAttr) {
     ASSERT_EQ(MetaStatusCode::RPC_ERROR, status);
 }
 
+TEST_F(MetaServerClientImplTest, test_BatchUpdateInode) {
+    uint32_t fsid = 1;
+    uint32_t partitionID = 200;
+    uint64_t applyIndex = 10;
+    std::vector<UpdateInodeRequest> updates(2);
+    updates[0].set_poolid(0);
+    updates[0].set_copysetid(0);
+    updates[0].set_partitionid(0);
+    updates[0].set_fsid(fsid);
+    updates[0].set_inodeid(1);
+    updates[0].set_length(100);
+    updates[1] = updates[0];
+    updates[1].set_inodeid(2);
+    std::vector<MetaStatusCode> statusCodes;
+
+    EXPECT_CALL(*mockMetacache_.get(), GetPartitionIdByInodeId(_, _, _))
+        .WillRepeatedly(DoAll(SetArgPointee<2>(partitionID), Return(true)));
+    EXPECT_CALL(*mockMetacache_.get(), GetTarget(_, _, _, _, _))
+        .WillRepeatedly(DoAll(SetArgPointee<2>(target_),
+                              SetArgPointee<3>(applyIndex), Return(true)));
+
+    // test0: rpc error
+    EXPECT_CALL(mockMetaServerService_, BatchUpdateInode(_, _, _, _))
+        .WillRepeatedly(
+            Invoke(SetRpcService<BatchUpdateInodeRequest,
+                                 BatchUpdateInodeResponse, true>));
+    MetaStatusCode status =
+        metaserverCli_.BatchUpdateInode(fsid, updates, &statusCodes);
+    ASSERT_EQ(MetaStatusCode::RPC_ERROR, status);
+    ASSERT_EQ(2, statusCodes.size());
+    ASSERT_EQ(MetaStatusCode::RPC_ERROR, statusCodes[1]);
+
+    // test1: updates in one partition are sent in one rpc
+    BatchUpdateInodeResponse response;
+    response.set_statuscode(MetaStatusCode::OK);
+    response.set_appliedindex(applyIndex);
+    response.add_updatestatuscode(MetaStatusCode::OK);
+    response.add_updatestatuscode(MetaStatusCode::NOT_FOUND);
+    BatchUpdateInodeRequest request;
+    EXPECT_CALL(mockMetaServerService_, BatchUpdateInode(_, _, _, _))
+        .WillOnce(DoAll(SaveArgPointee<1>(&request),
+                        SetArgPointee<2>(response),
+                        Invoke(SetRpcService<BatchUpdateInodeRequest,
+                                             BatchUpdateInodeResponse>)));
+    EXPECT_CALL(*mockMetacache_.get(), UpdateApplyIndex(_, _));
+    status = metaserverCli_.BatchUpdateInode(fsid, updates, &statusCodes);
+    ASSERT_EQ(MetaStatusCode::NOT_FOUND, status);
+    ASSERT_EQ(MetaStatusCode::OK, statusCodes[0]);
+    ASSERT_EQ(MetaStatusCode::NOT_FOUND, statusCodes[1]);
+    ASSERT_EQ(2, request.update_size());
+    ASSERT_EQ(partitionID, request.partitionid());
+    ASSERT_EQ(partitionID, request.update(1).partitionid());
+    ASSERT_EQ(2, request.update(1).inodeid());
+
+    // test2: status of updates not match
+    response.clear_updatestatuscode();
+    EXPECT_CALL(mockMetaServerService_, BatchUpdateInode(_, _, _, _))
+        .WillRepeatedly(DoAll(SetArgPointee<2>(response),
+                              Invoke(SetRpcService<BatchUpdateInodeRequest,
+                                     BatchUpdateInodeResponse>)));
+    status = metaserverCli_.BatchUpdateInode(fsid, updates, &statusCodes);
+    ASSERT_EQ(MetaStatusCode::RPC_ERROR, status);
+
+    // test3: updates are split by batchUpdateLimit and sent concurrently
+    opt_.batchUpdateLimit = 1;
+    metaserverCli_.Init(opt_, mockMetacache_,
+                        std::make_shared<ChannelManager<MetaserverID>>());
+    response.clear_updatestatuscode();
+    response.add_updatestatuscode(MetaStatusCode::OK);
+    EXPECT_CALL(mockMetaServerService_, BatchUpdateInode(_, _, _, _))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(response),
+                              Invoke(SetRpcService<BatchUpdateInodeRequest,
+                                     BatchUpdateInodeResponse>)));
+    EXPECT_CALL(*mockMetacache_.get(), UpdateApplyIndex(_, _)).Times(2);
+    std::atomic<int> doneCount(0);
+    status = metaserverCli_.BatchUpdateInode(fsid, updates, &statusCodes,
+        [&](size_t index, MetaStatusCode code) {
+            ASSERT_LT(index, updates.size());
+            ASSERT_EQ(MetaStatusCode::OK, code);
+            doneCount++;
+        });
+    ASSERT_EQ(MetaStatusCode::OK, status);
+    ASSERT_EQ(MetaStatusCode::OK, statusCodes[0]);
+    ASSERT_EQ(MetaStatusCode::OK, statusCodes[1]);
+    ASSERT_EQ(2, doneCount.load());
+
+    // test4: partition of inode not found
+    EXPECT_CALL(*mockMetacache_.get(), GetPartitionIdByInodeId(_, _, _))
+        .WillRepeatedly(Return(false));
+    status = metaserverCli_.BatchUpdateInode(fsid, updates, &statusCodes);
+    ASSERT_EQ(MetaStatusCode::NOT_FOUND, status);
+    ASSERT_EQ(MetaStatusCode::NOT_FOUND, statusCodes[0]);
+}
+
+TEST_F(MetaServerClientImplTest, test_CreateInodeAndDentry) {
+    InodeParam param;
+    param.fsId = 2;
+    param.length = 0;
+    param.uid = 1;
+    param.gid = 1;
+    param.mode = 1;
+    param.type = curvefs::metaserver::FsFileType::TYPE_S3;
+    param.rdev = 0;
+    param.parent = 1;
+    std::string name = "file1";
+    uint64_t applyIndex = 10;
+    curvefs::metaserver::Inode out;
+
+    // the request is sent to the partition of parent
+    EXPECT_CALL(*mockMetacache_.get(), GetTarget(param.fsId, param.parent,
+                                                 _, _, _))
+        .WillRepeatedly(DoAll(SetArgPointee<2>(target_),
+                              SetArgPointee<3>(applyIndex), Return(true)));
+
+    // test0: rpc error
+    EXPECT_CALL(mockMetaServerService_, CreateInodeAndDentry(_, _, _, _))
+        .WillRepeatedly(Invoke(
+            SetRpcService<CreateInodeAndDentryRequest,
+                          CreateInodeAndDentryResponse, true>));
+    MetaStatusCode status =
+        metaserverCli_.CreateInodeAndDentry(param, name, &out);
+    ASSERT_EQ(MetaStatusCode::RPC_ERROR, status);
+
+    // test1: create ok
+    CreateInodeAndDentryResponse response;
+    response.set_statuscode(MetaStatusCode::OK);
+    response.set_appliedindex(applyIndex);
+    response.mutable_inode()->set_inodeid(100);
+    response.mutable_inode()->set_fsid(param.fsId);
+    CreateInodeAndDentryRequest request;
+    EXPECT_CALL(mockMetaServerService_, CreateInodeAndDentry(_, _, _, _))
+        .WillOnce(DoAll(SaveArgPointee<1>(&request),
+                        SetArgPointee<2>(response),
+                        Invoke(SetRpcService<CreateInodeAndDentryRequest,
+                                             CreateInodeAndDentryResponse>)));
+    EXPECT_CALL(*mockMetacache_.get(), UpdateApplyIndex(_, _));
+    status = metaserverCli_.CreateInodeAndDentry(param, name, &out);
+    ASSERT_EQ(MetaStatusCode::OK, status);
+    ASSERT_EQ(100, out.inodeid());
+    ASSERT_EQ(name, request.name());
+    ASSERT_EQ(param.parent, request.inode().parent());
+    ASSERT_EQ(target_.partitionID, request.partitionid());
+    ASSERT_NE(0, request.requestid());
+
+    // test2: partition of parent is full, fail without retry
+    response.set_statuscode(MetaStatusCode::PARTITION_ALLOC_ID_FAIL);
+    EXPECT_CALL(mockMetaServerService_, CreateInodeAndDentry(_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(response),
+                        Invoke(SetRpcService<CreateInodeAndDentryRequest,
+                                             CreateInodeAndDentryResponse>)));
+    EXPECT_CALL(*mockMetacache_.get(),
+                MarkPartitionUnavailable(target_.partitionID))
+        .WillOnce(Return(true));
+    status = metaserverCli_.CreateInodeAndDentry(param, name, &out);
+    ASSERT_EQ(MetaStatusCode::PARTITION_ALLOC_ID_FAIL, status);
+
+    // test3: dentry exist
+    response.set_statuscode(MetaStatusCode::DENTRY_EXIST);
+    EXPECT_CALL(mockMetaServerService_, CreateInodeAndDentry(_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(response),
+                        Invoke(SetRpcService<CreateInodeAndDentryRequest,
+                                             CreateInodeAndDentryResponse>)));
+    status = metaserverCli_.CreateInodeAndDentry(param, name, &out);
+    ASSERT_EQ(MetaStatusCode::DENTRY_EXIST, status);
+
+    // test4: retry after rpc error carries the same request id
+    response.set_statuscode(MetaStatusCode::OK);
+    CreateInodeAndDentryRequest retryRequest;
+    EXPECT_CALL(mockMetaServerService_, CreateInodeAndDentry(_, _, _, _))
+        .WillOnce(DoAll(SaveArgPointee<1>(&request),
+                        Invoke(SetRpcService<CreateInodeAndDentryRequest,
+                                             CreateInodeAndDentryResponse,
+                                             true>)))
+        .WillOnce(DoAll(SaveArgPointee<1>(&retryRequest),
+                        SetArgPointee<2>(response),
+                        Invoke(SetRpcService<CreateInodeAndDentryRequest,
+                                             CreateInodeAndDentryResponse>)));
+    EXPECT_CALL(*mockMetacache_.get(), UpdateApplyIndex(_, _));
+    status = metaserverCli_.CreateInodeAndDentry(param, name, &out);
+    ASSERT_EQ(MetaStatusCode::OK, status);
+    ASSERT_EQ(request.requestid(), retryRequest.requestid());
+}
+
 }  // namespace rpcclient
 }  // namespace client
 }  // namespace curvefs
@@ -91,6 +91,16 @@ class MockMetaServerService : public curvefs::metaserver::MetaServerService {
                       const ::curvefs::metaserver::UpdateInodeRequest *request,
                       ::curvefs::metaserver::UpdateInodeResponse *response,
                       ::google::protobuf::Closure *done));
+    MOCK_METHOD4(BatchUpdateInode,
+        void(::google::protobuf::RpcController *controller,
+             const ::curvefs::metaserver::BatchUpdateInodeRequest *request,
+             ::curvefs::metaserver::BatchUpdateInodeResponse *response,
+             ::google::protobuf::Closure *done));
+    MOCK_METHOD4(CreateInodeAndDentry,
+        void(::google::protobuf::RpcController *controller,
+             const ::curvefs::metaserver::CreateInodeAndDentryRequest *request,
+             ::curvefs::metaserver::CreateInodeAndDentryResponse *response,
+             ::google::protobuf::Closure *done));
     MOCK_METHOD4(DeleteInode,
                  void(::google::protobuf::RpcController *controller,
                       const ::curvefs::metaserver::DeleteInodeRequest *request,
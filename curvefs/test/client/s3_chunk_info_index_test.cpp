@@ -0,0 +1,169 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "curvefs/src/client/s3/s3_chunk_info_index.h"
+
+namespace curvefs {
+namespace client {
+
+namespace {
+
+void AppendS3ChunkInfo(S3ChunkInfoList *list, uint64_t chunkId,
+                       uint64_t offset, uint64_t len) {
+    S3ChunkInfo *info = list->add_s3chunks();
+    info->set_chunkid(chunkId);
+    info->set_compaction(0);
+    info->set_offset(offset);
+    info->set_len(len);
+    info->set_size(len);
+    info->set_zero(false);
+}
+
+void CheckExtent(const S3ChunkInfoIndex::Extent &extent, uint64_t offset,
+                 uint64_t len, int pos) {
+    ASSERT_EQ(offset, extent.offset);
+    ASSERT_EQ(len, extent.len);
+    ASSERT_EQ(pos, extent.pos);
+}
+
+}  // namespace
+
+TEST(S3ChunkInfoIndexTest, FindEmpty) {
+    S3ChunkInfoIndex index;
+    S3ChunkInfoList list;
+    index.Update(list);
+
+    std::vector<S3ChunkInfoIndex::Extent> extents;
+    index.Find(0, 4096, &extents);
+    ASSERT_TRUE(extents.empty());
+}
+
+TEST(S3ChunkInfoIndexTest, OverwriteSplitsOlderInfo) {
+    S3ChunkInfoIndex index;
+    S3ChunkInfoList list;
+    AppendS3ChunkInfo(&list, 1, 0, 4096);
+    AppendS3ChunkInfo(&list, 2, 1024, 1024);
+    index.Update(list);
+    ASSERT_EQ(3, index.Size());
+
+    std::vector<S3ChunkInfoIndex::Extent> extents;
+    index.Find(0, 4096, &extents);
+    ASSERT_EQ(3, extents.size());
+    CheckExtent(extents[0], 0, 1024, 0);
+    CheckExtent(extents[1], 1024, 1024, 1);
+    CheckExtent(extents[2], 2048, 2048, 0);
+
+    // extents are clipped to the range
+    extents.clear();
+    index.Find(512, 1024, &extents);
+    ASSERT_EQ(2, extents.size());
+    CheckExtent(extents[0], 512, 512, 0);
+    CheckExtent(extents[1], 1024, 512, 1);
+}
+
+TEST(S3ChunkInfoIndexTest, OverwriteCoversOlderInfos) {
+    S3ChunkInfoIndex index;
+    S3ChunkInfoList list;
+    AppendS3ChunkInfo(&list, 1, 0, 1024);
+    AppendS3ChunkInfo(&list, 2, 2048, 1024);
+    AppendS3ChunkInfo(&list, 3, 4096, 1024);
+    AppendS3ChunkInfo(&list, 4, 512, 4096);
+    index.Update(list);
+
+    std::vector<S3ChunkInfoIndex::Extent> extents;
+    index.Find(0, 8192, &extents);
+    ASSERT_EQ(3, extents.size());
+    CheckExtent(extents[0], 0, 512, 0);
+    CheckExtent(extents[1], 512, 4096, 3);
+    CheckExtent(extents[2], 4608, 512, 2);
+}
+
+TEST(S3ChunkInfoIndexTest, HolesAreNotReturned) {
+    S3ChunkInfoIndex index;
+    S3ChunkInfoList list;
+    AppendS3ChunkInfo(&list, 1, 1024, 1024);
+    AppendS3ChunkInfo(&list, 2, 4096, 1024);
+    index.Update(list);
+
+    std::vector<S3ChunkInfoIndex::Extent> extents;
+    index.Find(0, 8192, &extents);
+    ASSERT_EQ(2, extents.size());
+    CheckExtent(extents[0], 1024, 1024, 0);
+    CheckExtent(extents[1], 4096, 1024, 1);
+
+    extents.clear();
+    index.Find(2048, 2048, &extents);
+    ASSERT_TRUE(extents.empty());
+}
+
+TEST(S3ChunkInfoIndexTest, IncrementalUpdate) {
+    S3ChunkInfoIndex index;
+    S3ChunkInfoList list;
+    AppendS3ChunkInfo(&list, 1, 0, 4096);
+    index.Update(list);
+
+    AppendS3ChunkInfo(&list, 2, 0, 1024);
+    index.Update(list);
+
+    std::vector<S3ChunkInfoIndex::Extent> extents;
+    index.Find(0, 4096, &extents);
+    ASSERT_EQ(2, extents.size());
+    CheckExtent(extents[0], 0, 1024, 1);
+    CheckExtent(extents[1], 1024, 3072, 0);
+}
+
+TEST(S3ChunkInfoIndexTest, RebuildAfterListReplaced) {
+    S3ChunkInfoIndex index;
+    S3ChunkInfoList list;
+    AppendS3ChunkInfo(&list, 1, 0, 4096);
+    AppendS3ChunkInfo(&list, 2, 0, 1024);
+    index.Update(list);
+
+    // compaction merges the list into one s3chunkinfo
+    S3ChunkInfoList compacted;
+    AppendS3ChunkInfo(&compacted, 3, 0, 4096);
+    index.Update(compacted);
+
+    std::vector<S3ChunkInfoIndex::Extent> extents;
+    index.Find(0, 4096, &extents);
+    ASSERT_EQ(1, extents.size());
+    CheckExtent(extents[0], 0, 4096, 0);
+
+    // replaced by a longer list with a different prefix
+    S3ChunkInfoList other;
+    AppendS3ChunkInfo(&other, 4, 0, 2048);
+    AppendS3ChunkInfo(&other, 5, 2048, 2048);
+    index.Update(other);
+
+    extents.clear();
+    index.Find(0, 4096, &extents);
+    ASSERT_EQ(2, extents.size());
+    CheckExtent(extents[0], 0, 2048, 0);
+    CheckExtent(extents[1], 2048, 2048, 1);
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -24,6 +24,9 @@
 #include <gmock/gmock.h>
 #include <google/protobuf/util/message_differencer.h>
 
+#include <chrono>
+#include <thread>
+
 #include "curvefs/test/client/mock_metaserver_client.h"
 #include "curvefs/src/client/dentry_cache_manager.h"
 
@@ -114,6 +117,46 @@ TEST_F(TestDentryCacheManager, GetDentry) {
         google::protobuf::util::MessageDifferencer::Equals(dentryExp, out));
 }
 
+TEST_F(TestDentryCacheManager, NegativeCache) {
+    curvefs::client::common::FLAGS_enableCto = false;
+    dCacheManager_->Init(10, true, 10, 100);
+    uint64_t parent = 99;
+    const std::string name = "test";
+    Dentry out;
+
+    // not exist dentry is looked up only once
+    EXPECT_CALL(*metaClient_, GetDentry(fsId_, parent, name, _))
+        .WillOnce(Return(MetaStatusCode::NOT_FOUND));
+    ASSERT_EQ(CURVEFS_ERROR::NOTEXIST,
+              dCacheManager_->GetDentry(parent, name, &out));
+    ASSERT_EQ(CURVEFS_ERROR::NOTEXIST,
+              dCacheManager_->GetDentry(parent, name, &out));
+
+    // creating any dentry in parent invalidates it
+    Dentry dentry;
+    dentry.set_fsid(fsId_);
+    dentry.set_name("other");
+    dentry.set_parentinodeid(parent);
+    dentry.set_inodeid(100);
+    EXPECT_CALL(*metaClient_, CreateDentry(_))
+        .WillOnce(Return(MetaStatusCode::OK));
+    ASSERT_EQ(CURVEFS_ERROR::OK, dCacheManager_->CreateDentry(dentry));
+
+    EXPECT_CALL(*metaClient_, GetDentry(fsId_, parent, name, _))
+        .WillOnce(Return(MetaStatusCode::NOT_FOUND));
+    ASSERT_EQ(CURVEFS_ERROR::NOTEXIST,
+              dCacheManager_->GetDentry(parent, name, &out));
+    ASSERT_EQ(CURVEFS_ERROR::NOTEXIST,
+              dCacheManager_->GetDentry(parent, name, &out));
+
+    // and it expires after timeout
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_CALL(*metaClient_, GetDentry(fsId_, parent, name, _))
+        .WillOnce(Return(MetaStatusCode::NOT_FOUND));
+    ASSERT_EQ(CURVEFS_ERROR::NOTEXIST,
+              dCacheManager_->GetDentry(parent, name, &out));
+}
+
 TEST_F(TestDentryCacheManager, CreateAndGetDentry) {
     curvefs::client::common::FLAGS_enableCto = false;
     uint64_t parent = 99;
@@ -195,6 +238,35 @@ TEST_F(TestDentryCacheManager, ListDentryNomal) {
     ASSERT_EQ(2 * limit - 1, out.size());
 }
 
+TEST_F(TestDentryCacheManager, ListDentryPage) {
+    uint64_t parent = 99;
+
+    std::list<Dentry> part1, part2;
+    uint32_t limit = 100;
+    part1.resize(limit);
+    part2.resize(limit - 1);
+
+    EXPECT_CALL(*metaClient_, ListDentry(fsId_, parent, "", limit, _, _))
+        .WillOnce(DoAll(SetArgPointee<5>(part1),
+                Return(MetaStatusCode::OK)));
+    EXPECT_CALL(*metaClient_, ListDentry(fsId_, parent, "a", limit, _, _))
+        .WillOnce(DoAll(SetArgPointee<5>(part2),
+                Return(MetaStatusCode::OK)));
+
+    std::list<Dentry> out;
+    bool finished = true;
+    CURVEFS_ERROR ret =
+        dCacheManager_->ListDentryPage(parent, "", limit, &out, &finished);
+    ASSERT_EQ(CURVEFS_ERROR::OK, ret);
+    ASSERT_EQ(limit, out.size());
+    ASSERT_FALSE(finished);
+
+    ret = dCacheManager_->ListDentryPage(parent, "a", limit, &out, &finished);
+    ASSERT_EQ(CURVEFS_ERROR::OK, ret);
+    ASSERT_EQ(limit - 1, out.size());
+    ASSERT_TRUE(finished);
+}
+
 TEST_F(TestDentryCacheManager, ListDentryEmpty) {
     uint64_t parent = 99;
 
@@ -37,6 +37,7 @@ using ::testing::DoAll;
 using ::testing::ElementsAre;
 using ::testing::Ge;
 using ::testing::Gt;
+using ::testing::Invoke;
 using ::testing::Mock;
 using ::testing::NotNull;
 using ::testing::Return;
@@ -45,6 +46,7 @@ using ::testing::ReturnNull;
 using ::testing::ReturnPointee;
 using ::testing::ReturnRef;
 using ::testing::SetArgPointee;
+using ::testing::SetErrnoAndReturn;
 using ::testing::StrEq;
 
 using ::curve::common::CacheMetrics;
@@ -193,6 +195,44 @@ TEST_F(TestDiskCacheRead, WriteDiskFile) {
     ASSERT_EQ(length, ret);
 }
 
+TEST_F(TestDiskCacheRead, DirectIO) {
+    diskCacheRead_->SetDirectIO(true);
+    std::string fileName = "test";
+    uint64_t length = 10;
+    char buf[10];
+
+    // read with aligned offset and length, and stops at end of file
+    EXPECT_CALL(*wrapper_, open(_, O_RDONLY | O_DIRECT, _))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*wrapper_, pread(_, _, 8192, 0))
+        .WillOnce(Invoke([](int, void *b, size_t, off_t) {
+            memset(b, 'a', 4096);
+            return 4096;
+        }));
+    EXPECT_CALL(*wrapper_, close(_)).WillOnce(Return(0));
+    int ret = diskCacheRead_->ReadDiskFile(fileName, buf, 4090, length);
+    ASSERT_EQ(6, ret);
+    ASSERT_EQ('a', buf[5]);
+
+    // write is padded and truncated to the length
+    EXPECT_CALL(*wrapper_, open(_, O_RDWR | O_CREAT | O_DIRECT, _))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*wrapper_, pwrite(_, _, 4096, 0)).WillOnce(Return(4096));
+    EXPECT_CALL(*wrapper_, ftruncate(_, length)).WillOnce(Return(0));
+    EXPECT_CALL(*wrapper_, close(_)).WillOnce(Return(0));
+    ret = diskCacheRead_->WriteDiskFile(fileName, buf, length);
+    ASSERT_EQ(length, ret);
+
+    // fall back to buffered io if O_DIRECT is not supported
+    EXPECT_CALL(*wrapper_, open(_, O_RDWR | O_CREAT | O_DIRECT, _))
+        .WillOnce(SetErrnoAndReturn(EINVAL, -1));
+    EXPECT_CALL(*wrapper_, open(_, O_RDWR | O_CREAT, _)).WillOnce(Return(0));
+    EXPECT_CALL(*wrapper_, write(_, _, length)).WillOnce(Return(length));
+    EXPECT_CALL(*wrapper_, close(_)).WillOnce(Return(0));
+    ret = diskCacheRead_->WriteDiskFile(fileName, buf, length);
+    ASSERT_EQ(length, ret);
+}
+
 TEST_F(TestDiskCacheRead, ClearReadCache) {
     std::list<std::string> files{"16777216"};
 
@@ -289,6 +289,56 @@ TEST_F(TestDiskCacheWrite, WriteDiskFile) {
     ASSERT_EQ(length, ret);
 }
 
+TEST_F(TestDiskCacheWrite, WritePackFile) {
+    diskCacheWrite_->InitPack(16, 1000000);
+    std::string buf(16, 'a');
+    uint64_t packId = 0;
+    uint64_t packOffset = 0;
+
+    EXPECT_CALL(*wrapper_, open(_, _, _))
+        .WillOnce(Return(-1));
+    int ret = diskCacheWrite_->WritePackFile(1, 1, 100, buf.c_str(), 10,
+                                             false, &packId, &packOffset);
+    ASSERT_EQ(-1, ret);
+
+    // appended to the open pack of partition
+    EXPECT_CALL(*wrapper_, open(_, _, _))
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(*wrapper_, close(_))
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(*wrapper_, pwrite(_, _, 4, 10))
+        .WillOnce(Return(4));
+    ret = diskCacheWrite_->WritePackFile(1, 1, 101, buf.c_str(), 4,
+                                         false, &packId, &packOffset);
+    ASSERT_EQ(4, ret);
+    ASSERT_EQ(100, packId);
+    ASSERT_EQ(10, packOffset);
+
+    // pack is full, open a new one
+    EXPECT_CALL(*wrapper_, pwrite(_, _, 4, 0))
+        .WillRepeatedly(Return(4));
+    ret = diskCacheWrite_->WritePackFile(1, 1, 102, buf.c_str(), 4,
+                                         false, &packId, &packOffset);
+    ASSERT_EQ(4, ret);
+    ASSERT_EQ(102, packId);
+    ASSERT_EQ(0, packOffset);
+
+    // each partition has its own pack
+    ret = diskCacheWrite_->WritePackFile(1, 2, 103, buf.c_str(), 4,
+                                         false, &packId, &packOffset);
+    ASSERT_EQ(4, ret);
+    ASSERT_EQ(103, packId);
+    ASSERT_EQ(0, packOffset);
+
+    // sealed packs are not appended any more
+    diskCacheWrite_->SealAllPacks();
+    ret = diskCacheWrite_->WritePackFile(1, 1, 104, buf.c_str(), 4,
+                                         false, &packId, &packOffset);
+    ASSERT_EQ(4, ret);
+    ASSERT_EQ(104, packId);
+    ASSERT_EQ(0, packOffset);
+}
+
 TEST_F(TestDiskCacheWrite, UploadAllCacheWriteFile) {
     EXPECT_CALL(*wrapper_, stat(NotNull(), NotNull()))
         .WillOnce(Return(-1));
@@ -57,6 +57,7 @@ using ::testing::_;
 using ::testing::Contains;
 using ::testing::Invoke;
 using ::testing::Return;
+using ::testing::SaveArg;
 using ::testing::SetArgPointee;
 using ::testing::SetArgReferee;
 
@@ -432,6 +433,91 @@ TEST_F(TestFuseVolumeClient, FuseOpCreate) {
     ASSERT_TRUE(inodeWrapper->IsOpen());
 }
 
+TEST_F(TestFuseVolumeClient, FuseOpCreateCompound) {
+    fuseClientOption_.enableCompoundCreate = true;
+    client_ = std::make_shared<FuseVolumeClient>(
+        mdsClient_, metaClient_, inodeManager_, dentryManager_,
+        blockDeviceClient_);
+    client_->Init(fuseClientOption_);
+    PrepareFsInfo();
+
+    fuse_req fakeReq;
+    fuse_ctx fakeCtx;
+    fakeReq.ctx = &fakeCtx;
+    fuse_req_t req = &fakeReq;
+    fuse_ino_t parent = 1;
+    const char *name = "xxx";
+    mode_t mode = 1;
+    struct fuse_file_info fi;
+    fi.flags = 0;
+
+    fuse_ino_t ino = 2;
+    Inode inode;
+    inode.set_fsid(fsId);
+    inode.set_inodeid(ino);
+    inode.set_length(4096);
+    inode.set_type(FsFileType::TYPE_FILE);
+    auto inodeWrapper = std::make_shared<InodeWrapper>(inode, metaClient_);
+
+    Inode parentInode;
+    parentInode.set_fsid(fsId);
+    parentInode.set_inodeid(parent);
+    parentInode.set_type(FsFileType::TYPE_DIRECTORY);
+    parentInode.set_nlink(2);
+    auto parentInodeWrapper =
+        std::make_shared<InodeWrapper>(parentInode, metaClient_);
+    EXPECT_CALL(*inodeManager_, GetInode(_, _))
+        .WillRepeatedly(Invoke([&](uint64_t inodeId,
+                                   std::shared_ptr<InodeWrapper> &out) {
+            out = inodeId == parent ? parentInodeWrapper : inodeWrapper;
+            return CURVEFS_ERROR::OK;
+        }));
+    EXPECT_CALL(*metaClient_, UpdateInode(_, _))
+        .WillRepeatedly(Return(MetaStatusCode::OK));
+
+    // inode and dentry are created in one rpc
+    Dentry dentry;
+    EXPECT_CALL(*inodeManager_, CreateInodeAndDentry(_, name, _))
+        .WillOnce(
+            DoAll(SetArgReferee<2>(inodeWrapper), Return(CURVEFS_ERROR::OK)));
+    EXPECT_CALL(*inodeManager_, CreateInode(_, _)).Times(0);
+    EXPECT_CALL(*dentryManager_, CreateDentry(_)).Times(0);
+    EXPECT_CALL(*dentryManager_, InsertOrReplaceCache(_))
+        .WillOnce(SaveArg<0>(&dentry));
+
+    fuse_entry_param e;
+    CURVEFS_ERROR ret = client_->FuseOpCreate(req, parent, name, mode, &fi, &e);
+    ASSERT_EQ(CURVEFS_ERROR::OK, ret);
+    ASSERT_EQ(ino, dentry.inodeid());
+    ASSERT_EQ(parent, dentry.parentinodeid());
+    ASSERT_EQ(DentryFlag::TYPE_FILE_FLAG, dentry.flag());
+
+    // dentry exist
+    EXPECT_CALL(*inodeManager_, CreateInodeAndDentry(_, name, _))
+        .WillOnce(Return(CURVEFS_ERROR::EXISTS));
+    ret = client_->FuseOpCreate(req, parent, name, mode, &fi, &e);
+    ASSERT_EQ(CURVEFS_ERROR::EXISTS, ret);
+
+    // rpc failed, maybe applied, don't create again separately
+    EXPECT_CALL(*inodeManager_, CreateInodeAndDentry(_, name, _))
+        .WillOnce(Return(CURVEFS_ERROR::INTERNAL));
+    EXPECT_CALL(*inodeManager_, CreateInode(_, _)).Times(0);
+    EXPECT_CALL(*dentryManager_, CreateDentry(_)).Times(0);
+    ret = client_->FuseOpCreate(req, parent, name, mode, &fi, &e);
+    ASSERT_EQ(CURVEFS_ERROR::INTERNAL, ret);
+
+    // fall back to create inode and dentry separately
+    EXPECT_CALL(*inodeManager_, CreateInodeAndDentry(_, name, _))
+        .WillOnce(Return(CURVEFS_ERROR::NO_SPACE));
+    EXPECT_CALL(*inodeManager_, CreateInode(_, _))
+        .WillOnce(
+            DoAll(SetArgReferee<1>(inodeWrapper), Return(CURVEFS_ERROR::OK)));
+    EXPECT_CALL(*dentryManager_, CreateDentry(_))
+        .WillOnce(Return(CURVEFS_ERROR::OK));
+    ret = client_->FuseOpCreate(req, parent, name, mode, &fi, &e);
+    ASSERT_EQ(CURVEFS_ERROR::OK, ret);
+}
+
 TEST_F(TestFuseVolumeClient, FuseOpCreateFailed) {
     fuse_req fakeReq;
     fuse_ctx fakeCtx;
@@ -683,14 +769,79 @@ TEST_F(TestFuseVolumeClient, FuseOpOpenAndFuseOpReadDir) {
     dentry.set_inodeid(2);
     dentryList.push_back(dentry);
 
-    EXPECT_CALL(*dentryManager_, ListDentry(ino, _, listDentryLimit_, _))
-        .WillOnce(
-            DoAll(SetArgPointee<1>(dentryList), Return(CURVEFS_ERROR::OK)));
+    EXPECT_CALL(*dentryManager_,
+                ListDentryPage(ino, "", listDentryLimit_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<3>(dentryList), SetArgPointee<4>(true),
+                        Return(CURVEFS_ERROR::OK)));
 
     ret = client_->FuseOpReadDir(req, ino, size, off, &fi, &buffer, &rSize);
     ASSERT_EQ(CURVEFS_ERROR::OK, ret);
 }
 
+TEST_F(TestFuseVolumeClient, FuseOpReadDirByPage) {
+    fuse_req_t req;
+    fuse_ino_t ino = 1;
+    size_t size = 4096;
+    struct fuse_file_info fi;
+    memset(&fi, 0, sizeof(fi));
+    fi.fh = 0;
+    char *buffer;
+    size_t rSize = 0;
+
+    Inode inode;
+    inode.set_fsid(fsId);
+    inode.set_inodeid(ino);
+    inode.set_length(0);
+    inode.set_type(FsFileType::TYPE_DIRECTORY);
+    auto inodeWrapper = std::make_shared<InodeWrapper>(inode, metaClient_);
+
+    EXPECT_CALL(*inodeManager_, GetInode(ino, _))
+        .WillRepeatedly(
+            DoAll(SetArgReferee<1>(inodeWrapper), Return(CURVEFS_ERROR::OK)));
+
+    CURVEFS_ERROR ret = client_->FuseOpOpenDir(req, ino, &fi);
+    ASSERT_EQ(CURVEFS_ERROR::OK, ret);
+
+    std::list<Dentry> page1, page2;
+    Dentry dentry;
+    dentry.set_fsid(fsId);
+    dentry.set_parentinodeid(ino);
+    dentry.set_name("a");
+    dentry.set_inodeid(2);
+    page1.push_back(dentry);
+    dentry.set_name("b");
+    dentry.set_inodeid(3);
+    page2.push_back(dentry);
+
+    // the second page is listed in background after the first one
+    EXPECT_CALL(*dentryManager_,
+                ListDentryPage(ino, "", listDentryLimit_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<3>(page1), SetArgPointee<4>(false),
+                        Return(CURVEFS_ERROR::OK)));
+    EXPECT_CALL(*dentryManager_,
+                ListDentryPage(ino, "a", listDentryLimit_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<3>(page2), SetArgPointee<4>(true),
+                        Return(CURVEFS_ERROR::OK)));
+
+    ret = client_->FuseOpReadDir(req, ino, size, 0, &fi, &buffer, &rSize);
+    ASSERT_EQ(CURVEFS_ERROR::OK, ret);
+    size_t firstSize = rSize;
+    ASSERT_GT(firstSize, 0);
+
+    ret = client_->FuseOpReadDir(req, ino, size, firstSize, &fi, &buffer,
+                                 &rSize);
+    ASSERT_EQ(CURVEFS_ERROR::OK, ret);
+    ASSERT_GT(rSize, 0);
+
+    ret = client_->FuseOpReadDir(req, ino, size, firstSize + rSize, &fi,
+                                 &buffer, &rSize);
+    ASSERT_EQ(CURVEFS_ERROR::OK, ret);
+    ASSERT_EQ(0, rSize);
+
+    ret = client_->FuseOpReleaseDir(req, ino, &fi);
+    ASSERT_EQ(CURVEFS_ERROR::OK, ret);
+}
+
 TEST_F(TestFuseVolumeClient, FuseOpOpenAndFuseOpReadDirFailed) {
     fuse_req_t req;
     fuse_ino_t ino = 1;
@@ -725,8 +876,9 @@ TEST_F(TestFuseVolumeClient, FuseOpOpenAndFuseOpReadDirFailed) {
     dentry.set_inodeid(2);
     dentryList.push_back(dentry);
 
-    EXPECT_CALL(*dentryManager_, ListDentry(ino, _, listDentryLimit_, _))
-        .WillOnce(DoAll(SetArgPointee<1>(dentryList),
+    EXPECT_CALL(*dentryManager_,
+                ListDentryPage(ino, "", listDentryLimit_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<3>(dentryList),
                         Return(CURVEFS_ERROR::INTERNAL)));
 
     ret = client_->FuseOpReadDir(req, ino, size, off, &fi, &buffer, &rSize);
@@ -47,6 +47,7 @@ using ::testing::SetArgPointee;
 using ::testing::SetArgReferee;
 using ::testing::AnyOf;
 
+using rpcclient::BatchUpdateInodeDone;
 using rpcclient::MetaServerClientDone;
 using rpcclient::MockMetaServerClient;
 
@@ -192,25 +193,45 @@ TEST_F(TestInodeCacheManager, ShipToFlushAndFlushAll) {
     S3ChunkInfo info;
     inodeWrapper->AppendS3ChunkInfo(1, info);
 
-    iCacheManager_->ShipToFlush(inodeWrapper);
+    // only s3chunkinfo need to flush
+    inode.set_inodeid(inodeId + 1);
+    std::shared_ptr<InodeWrapper> inodeWrapper2 =
+        std::make_shared<InodeWrapper>(inode, metaClient_);
+    inodeWrapper2->AppendS3ChunkInfo(2, info);
+
+    // nothing need to flush
+    inode.set_inodeid(inodeId + 2);
+    std::shared_ptr<InodeWrapper> inodeWrapper3 =
+        std::make_shared<InodeWrapper>(inode, metaClient_);
 
-    EXPECT_CALL(*metaClient_, UpdateInodeAsync(_, _, _))
-        .WillOnce(Invoke([](const Inode &inode, MetaServerClientDone *done,
-                            InodeOpenStatusChange statusChange) {
-            done->SetMetaStatusCode(MetaStatusCode::OK);
-            done->Run();
+    iCacheManager_->ShipToFlush(inodeWrapper);
+    iCacheManager_->ShipToFlush(inodeWrapper2);
+    iCacheManager_->ShipToFlush(inodeWrapper3);
+
+    EXPECT_CALL(*metaClient_, BatchUpdateInode(fsId_, _, _, _))
+        .WillOnce(Invoke([&](uint32_t fsId,
+                             const std::vector<UpdateInodeRequest> &updates,
+                             std::vector<MetaStatusCode> *statusCodes,
+                             const BatchUpdateInodeDone &done) {
+            EXPECT_EQ(2, updates.size());
+            EXPECT_EQ(inodeId, updates[0].inodeid());
+            EXPECT_TRUE(updates[0].has_length());
+            EXPECT_EQ(1, updates[0].s3chunkinfomap().size());
+            EXPECT_EQ(inodeId + 1, updates[1].inodeid());
+            EXPECT_FALSE(updates[1].has_length());
+            EXPECT_EQ(1, updates[1].s3chunkinfomap().size());
+            statusCodes->assign(updates.size(), MetaStatusCode::OK);
+            for (size_t i = 0; i < updates.size(); i++) {
+                done(i, MetaStatusCode::OK);
+            }
+            return MetaStatusCode::OK;
         }));
 
-    EXPECT_CALL(*metaClient_, GetOrModifyS3ChunkInfoAsync(_, _, _, _))
-        .WillOnce(
-            Invoke([](uint32_t fsId, uint64_t inodeId,
-                      const google::protobuf::Map<uint64_t, S3ChunkInfoList>
-                          &s3ChunkInfos,
-                      MetaServerClientDone *done) {
-                done->SetMetaStatusCode(MetaStatusCode::OK);
-                done->Run();
-            }));
+    iCacheManager_->FlushAll();
+    ASSERT_FALSE(inodeWrapper->IsDirty());
 
+    // flushed inodes are not flushed again
+    iCacheManager_->ShipToFlush(inodeWrapper);
     iCacheManager_->FlushAll();
 }
 
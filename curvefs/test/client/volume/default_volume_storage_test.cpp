@@ -46,6 +46,20 @@ using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::SetArgPointee;
 
+using ::curvefs::volume::BlockDeviceAioCallback;
+
+// complete asynchronous block device io with `ret`
+struct AioDone {
+    explicit AioDone(ssize_t ret) : ret(ret) {}
+
+    template <typename Parts>
+    void operator()(const Parts&, BlockDeviceAioCallback done) const {
+        done(ret);
+    }
+
+    ssize_t ret;
+};
+
 class DefaultVolumeStorageTest : public ::testing::Test {
  protected:
     DefaultVolumeStorageTest()
@@ -95,8 +109,8 @@ TEST_F(DefaultVolumeStorageTest, ReadTest_BlockDevReadError) {
             return CURVEFS_ERROR::OK;
         }));
 
-    EXPECT_CALL(blockDev_, Readv(_))
-        .WillOnce(Return(-1));
+    EXPECT_CALL(blockDev_, AioReadv(_, _))
+        .WillOnce(Invoke(AioDone(-1)));
 
     uint64_t ino = 1;
     off_t offset = 0;
@@ -132,8 +146,8 @@ TEST_F(DefaultVolumeStorageTest, ReadTest_BlockDevReadSuccess) {
     size_t len = 4096;
     std::unique_ptr<char[]> data(new char[4096]);
 
-    EXPECT_CALL(blockDev_, Readv(_))
-        .WillOnce(Return(len));
+    EXPECT_CALL(blockDev_, AioReadv(_, _))
+        .WillOnce(Invoke(AioDone(len)));
 
     EXPECT_CALL(inodeCacheMgr_, ShipToFlush(inodeWrapper))
         .Times(1);
@@ -169,7 +183,7 @@ TEST_F(DefaultVolumeStorageTest, ReadTest_BlockDevReadHoleSuccess) {
 
     memset(data.get(), 'x', len);
 
-    EXPECT_CALL(blockDev_, Readv(_))
+    EXPECT_CALL(blockDev_, AioReadv(_, _))
         .Times(0);
 
     EXPECT_CALL(inodeCacheMgr_, ShipToFlush(inodeWrapper))
@@ -233,8 +247,8 @@ TEST_F(DefaultVolumeStorageTest, WriteTest_BlockDevWriteError) {
     size_t len = 4096;
     std::unique_ptr<char[]> data(new char[4096]);
 
-    EXPECT_CALL(blockDev_, Writev(_))
-        .WillOnce(Return(-1));
+    EXPECT_CALL(blockDev_, AioWritev(_, _))
+        .WillOnce(Invoke(AioDone(-1)));
 
     ASSERT_GT(0, storage_.Write(ino, offset, len, data.get()));
 }
@@ -267,8 +281,8 @@ TEST_F(DefaultVolumeStorageTest, WriteTest_BlockDevWriteSuccess) {
     size_t len = 4096;
     std::unique_ptr<char[]> data(new char[4096]);
 
-    EXPECT_CALL(blockDev_, Writev(_))
-        .WillOnce(Return(len));
+    EXPECT_CALL(blockDev_, AioWritev(_, _))
+        .WillOnce(Invoke(AioDone(len)));
 
     EXPECT_CALL(inodeCacheMgr_, ShipToFlush(inodeWrapper))
         .Times(1);
@@ -138,6 +138,8 @@ TEST_F(MetaOperatorTest, OperatorTypeTest) {
     TEST_OPERATOR_TYPE(BatchGetXAttr);
     TEST_OPERATOR_TYPE(CreateInode);
     TEST_OPERATOR_TYPE(UpdateInode);
+    TEST_OPERATOR_TYPE(BatchUpdateInode);
+    TEST_OPERATOR_TYPE(CreateInodeAndDentry);
     TEST_OPERATOR_TYPE(GetOrModifyS3ChunkInfo);
     TEST_OPERATOR_TYPE(DeleteInode);
     TEST_OPERATOR_TYPE(CreateRootInode);
@@ -185,6 +187,8 @@ TEST_F(MetaOperatorTest, OnApplyErrorTest) {
     OPERATOR_ON_APPLY_TEST(BatchGetXAttr);
     OPERATOR_ON_APPLY_TEST(CreateInode);
     OPERATOR_ON_APPLY_TEST(UpdateInode);
+    OPERATOR_ON_APPLY_TEST(BatchUpdateInode);
+    OPERATOR_ON_APPLY_TEST(CreateInodeAndDentry);
     OPERATOR_ON_APPLY_TEST(DeleteInode);
     OPERATOR_ON_APPLY_TEST(CreateRootInode);
     OPERATOR_ON_APPLY_TEST(CreatePartition);
@@ -302,6 +306,8 @@ TEST_F(MetaOperatorTest, OnApplyFromLogErrorTest) {
     OPERATOR_ON_APPLY_FROM_LOG_TEST(DeleteDentry);
     OPERATOR_ON_APPLY_FROM_LOG_TEST(CreateInode);
     OPERATOR_ON_APPLY_FROM_LOG_TEST(UpdateInode);
+    OPERATOR_ON_APPLY_FROM_LOG_TEST(BatchUpdateInode);
+    OPERATOR_ON_APPLY_FROM_LOG_TEST(CreateInodeAndDentry);
     OPERATOR_ON_APPLY_FROM_LOG_TEST(DeleteInode);
     OPERATOR_ON_APPLY_FROM_LOG_TEST(CreateRootInode);
     OPERATOR_ON_APPLY_FROM_LOG_TEST(CreatePartition);
@@ -118,6 +118,8 @@ TEST(RaftLogCodecTest, DecodeFailedTest) {
     DECODE_FAILED_TEST(GetInode);
     DECODE_FAILED_TEST(CreateInode);
     DECODE_FAILED_TEST(UpdateInode);
+    DECODE_FAILED_TEST(BatchUpdateInode);
+    DECODE_FAILED_TEST(CreateInodeAndDentry);
     DECODE_FAILED_TEST(DeleteInode);
     DECODE_FAILED_TEST(CreateRootInode);
     DECODE_FAILED_TEST(CreatePartition);
@@ -150,6 +152,8 @@ TEST(RaftLogCodecTest, DecodeSuccessTest) {
     ENCODE_DECODE_TEST(GetInode);
     ENCODE_DECODE_TEST(CreateInode);
     ENCODE_DECODE_TEST(UpdateInode);
+    ENCODE_DECODE_TEST(BatchUpdateInode);
+    ENCODE_DECODE_TEST(CreateInodeAndDentry);
     ENCODE_DECODE_TEST(DeleteInode);
     ENCODE_DECODE_TEST(CreateRootInode);
     ENCODE_DECODE_TEST(CreatePartition);
@@ -24,6 +24,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <condition_variable>  // NOLINT
+#include <string>
+#include <vector>
 #include "curvefs/src/common/process.h"
 #include "curvefs/src/common/define.h"
 #include "curvefs/src/common/rpc_stream.h"
@@ -66,7 +68,8 @@ class MetastoreTest : public ::testing::Test {
     }
 
     void TearDown() override {
-        std::string cmd = "rm -rf " + test_path_;
+        std::string cmd = "rm -rf " + test_path_ + " " + test_path_ +
+                          ".checkpoint";
         system(cmd.c_str());
 
         ASSERT_TRUE(kvStorage_->Close());
@@ -228,10 +231,15 @@ class MetastoreTest : public ::testing::Test {
             std::unique_lock<std::mutex> lk(mtx_);
             condition_.wait(lk, [this]() { return finished_; });
         }
+        void AddFile(const std::string& filename) {
+            files_.push_back(filename);
+        }
         bool IsSuccess() { return ret_; }
+        std::vector<std::string> GetFiles() { return files_; }
 
      private:
         bool ret_;
+        std::vector<std::string> files_;
         bool finished_ = false;
         std::mutex mtx_;
         std::condition_variable condition_;
@@ -917,6 +925,12 @@ TEST_F(MetastoreTest, persist_success) {
     done.Wait();
     ASSERT_TRUE(done.IsSuccess());
 
+    // rocksdb storage is saved as checkpoint
+    ASSERT_FALSE(done.GetFiles().empty());
+    for (const auto& filename : done.GetFiles()) {
+        ASSERT_EQ(filename.find("metastore_test.dat.checkpoint/"), 0);
+    }
+
     // load MetaStoreImpl to new meta
     MetaStoreImpl metastoreNew(nullptr, kvStorage_);
     LOG(INFO) << "MetastoreTest test Load";
@@ -1389,6 +1403,231 @@ TEST_F(MetastoreTest, testBatchGetXAttr) {
     }
 }
 
+TEST_F(MetastoreTest, testBatchUpdateInode) {
+    MetaStoreImpl metastore(nullptr, kvStorage_);
+    uint32_t poolId = 2;
+    uint32_t copysetId = 3;
+    uint32_t partitionId = 1;
+    uint32_t fsId = 1;
+
+    CreatePartitionRequest createPartitionRequest;
+    CreatePartitionResponse createPartitionResponse;
+    PartitionInfo partitionInfo;
+    partitionInfo.set_fsid(fsId);
+    partitionInfo.set_poolid(poolId);
+    partitionInfo.set_copysetid(copysetId);
+    partitionInfo.set_partitionid(partitionId);
+    partitionInfo.set_start(100);
+    partitionInfo.set_end(1000);
+    createPartitionRequest.mutable_partition()->CopyFrom(partitionInfo);
+    ASSERT_EQ(MetaStatusCode::OK, metastore.CreatePartition(
+        &createPartitionRequest, &createPartitionResponse));
+
+    CreateInodeRequest createRequest;
+    CreateInodeResponse createResponse;
+    createRequest.set_poolid(poolId);
+    createRequest.set_copysetid(copysetId);
+    createRequest.set_partitionid(partitionId);
+    createRequest.set_fsid(fsId);
+    createRequest.set_length(0);
+    createRequest.set_uid(0);
+    createRequest.set_gid(0);
+    createRequest.set_mode(777);
+    createRequest.set_type(FsFileType::TYPE_S3);
+    ASSERT_EQ(MetaStatusCode::OK,
+              metastore.CreateInode(&createRequest, &createResponse));
+    uint64_t inodeId1 = createResponse.inode().inodeid();
+    ASSERT_EQ(MetaStatusCode::OK,
+              metastore.CreateInode(&createRequest, &createResponse));
+    uint64_t inodeId2 = createResponse.inode().inodeid();
+
+    // partition not found
+    BatchUpdateInodeRequest request;
+    BatchUpdateInodeResponse response;
+    request.set_poolid(poolId);
+    request.set_copysetid(copysetId);
+    request.set_partitionid(100);
+    request.set_fsid(fsId);
+    ASSERT_EQ(MetaStatusCode::PARTITION_NOT_FOUND,
+              metastore.BatchUpdateInode(&request, &response));
+
+    // update two inodes and a nonexistent inode in one request
+    request.set_partitionid(partitionId);
+    response.Clear();
+    UpdateInodeRequest* update = request.add_update();
+    update->set_poolid(poolId);
+    update->set_copysetid(copysetId);
+    update->set_partitionid(partitionId);
+    update->set_fsid(fsId);
+    update->set_inodeid(inodeId1);
+    update->set_length(4096);
+    update->mutable_s3chunkinfomap()->insert({0, GenS3ChunkInfoList(1, 2)});
+
+    update = request.add_update();
+    update->set_poolid(poolId);
+    update->set_copysetid(copysetId);
+    update->set_partitionid(partitionId);
+    update->set_fsid(fsId);
+    update->set_inodeid(inodeId2);
+    update->set_uid(100);
+
+    update = request.add_update();
+    update->set_poolid(poolId);
+    update->set_copysetid(copysetId);
+    update->set_partitionid(partitionId);
+    update->set_fsid(fsId);
+    update->set_inodeid(999);
+    update->set_uid(100);
+
+    ASSERT_EQ(MetaStatusCode::OK,
+              metastore.BatchUpdateInode(&request, &response));
+    ASSERT_EQ(MetaStatusCode::OK, response.statuscode());
+    ASSERT_EQ(3, response.updatestatuscode_size());
+    ASSERT_EQ(MetaStatusCode::OK, response.updatestatuscode(0));
+    ASSERT_EQ(MetaStatusCode::OK, response.updatestatuscode(1));
+    ASSERT_EQ(MetaStatusCode::NOT_FOUND, response.updatestatuscode(2));
+
+    GetInodeRequest getRequest;
+    GetInodeResponse getResponse;
+    getRequest.set_poolid(poolId);
+    getRequest.set_copysetid(copysetId);
+    getRequest.set_partitionid(partitionId);
+    getRequest.set_fsid(fsId);
+    getRequest.set_inodeid(inodeId1);
+    ASSERT_EQ(MetaStatusCode::OK,
+              metastore.GetInode(&getRequest, &getResponse));
+    ASSERT_EQ(4096, getResponse.inode().length());
+    ASSERT_EQ(1, getResponse.inode().s3chunkinfomap().size());
+    ASSERT_EQ(2, getResponse.inode().s3chunkinfomap().at(0).s3chunks_size());
+
+    getRequest.set_inodeid(inodeId2);
+    getResponse.Clear();
+    ASSERT_EQ(MetaStatusCode::OK,
+              metastore.GetInode(&getRequest, &getResponse));
+    ASSERT_EQ(100, getResponse.inode().uid());
+}
+
+TEST_F(MetastoreTest, testCreateInodeAndDentry) {
+    MetaStoreImpl metastore(nullptr, kvStorage_);
+    uint32_t poolId = 2;
+    uint32_t copysetId = 3;
+    uint32_t partitionId = 1;
+    uint32_t fsId = 1;
+
+    CreatePartitionRequest createPartitionRequest;
+    CreatePartitionResponse createPartitionResponse;
+    PartitionInfo partitionInfo;
+    partitionInfo.set_fsid(fsId);
+    partitionInfo.set_poolid(poolId);
+    partitionInfo.set_copysetid(copysetId);
+    partitionInfo.set_partitionid(partitionId);
+    partitionInfo.set_start(100);
+    partitionInfo.set_end(1000);
+    createPartitionRequest.mutable_partition()->CopyFrom(partitionInfo);
+    ASSERT_EQ(MetaStatusCode::OK, metastore.CreatePartition(
+        &createPartitionRequest, &createPartitionResponse));
+
+    // create parent
+    CreateInodeRequest createInodeRequest;
+    CreateInodeResponse createInodeResponse;
+    createInodeRequest.set_poolid(poolId);
+    createInodeRequest.set_copysetid(copysetId);
+    createInodeRequest.set_partitionid(partitionId);
+    createInodeRequest.set_fsid(fsId);
+    createInodeRequest.set_length(4096);
+    createInodeRequest.set_uid(0);
+    createInodeRequest.set_gid(0);
+    createInodeRequest.set_mode(777);
+    createInodeRequest.set_type(FsFileType::TYPE_DIRECTORY);
+    ASSERT_EQ(MetaStatusCode::OK, metastore.CreateInode(
+        &createInodeRequest, &createInodeResponse));
+    uint64_t parentId = createInodeResponse.inode().inodeid();
+    uint32_t parentNlink = createInodeResponse.inode().nlink();
+
+    CreateInodeAndDentryRequest request;
+    CreateInodeAndDentryResponse response;
+    request.set_poolid(poolId);
+    request.set_copysetid(copysetId);
+    request.set_partitionid(100);
+    request.set_name("file1");
+    request.set_txid(0);
+    *request.mutable_inode() = createInodeRequest;
+    request.mutable_inode()->set_length(0);
+    request.mutable_inode()->set_type(FsFileType::TYPE_S3);
+    request.mutable_inode()->set_parent(parentId);
+
+    // partition not found
+    ASSERT_EQ(MetaStatusCode::PARTITION_NOT_FOUND,
+              metastore.CreateInodeAndDentry(&request, &response));
+
+    // parent not found
+    request.set_partitionid(partitionId);
+    request.mutable_inode()->set_parent(999);
+    ASSERT_EQ(MetaStatusCode::NOT_FOUND,
+              metastore.CreateInodeAndDentry(&request, &response));
+
+    // symlink is empty
+    request.mutable_inode()->set_parent(parentId);
+    request.mutable_inode()->set_type(FsFileType::TYPE_SYM_LINK);
+    ASSERT_EQ(MetaStatusCode::SYM_LINK_EMPTY,
+              metastore.CreateInodeAndDentry(&request, &response));
+
+    // success
+    request.mutable_inode()->set_type(FsFileType::TYPE_S3);
+    request.set_requestid(100);
+    response.Clear();
+    ASSERT_EQ(MetaStatusCode::OK,
+              metastore.CreateInodeAndDentry(&request, &response));
+    ASSERT_EQ(MetaStatusCode::OK, response.statuscode());
+    ASSERT_TRUE(response.has_inode());
+    uint64_t inodeId = response.inode().inodeid();
+    ASSERT_EQ(parentId, response.inode().parent(0));
+
+    GetDentryRequest getDentryRequest;
+    GetDentryResponse getDentryResponse;
+    getDentryRequest.set_poolid(poolId);
+    getDentryRequest.set_copysetid(copysetId);
+    getDentryRequest.set_partitionid(partitionId);
+    getDentryRequest.set_fsid(fsId);
+    getDentryRequest.set_parentinodeid(parentId);
+    getDentryRequest.set_name("file1");
+    getDentryRequest.set_txid(0);
+    ASSERT_EQ(MetaStatusCode::OK,
+              metastore.GetDentry(&getDentryRequest, &getDentryResponse));
+    ASSERT_EQ(inodeId, getDentryResponse.dentry().inodeid());
+    ASSERT_EQ(FsFileType::TYPE_S3, getDentryResponse.dentry().type());
+    ASSERT_TRUE(getDentryResponse.dentry().flag() &
+                DentryFlag::TYPE_FILE_FLAG);
+
+    GetInodeRequest getInodeRequest;
+    GetInodeResponse getInodeResponse;
+    getInodeRequest.set_poolid(poolId);
+    getInodeRequest.set_copysetid(copysetId);
+    getInodeRequest.set_partitionid(partitionId);
+    getInodeRequest.set_fsid(fsId);
+    getInodeRequest.set_inodeid(parentId);
+    ASSERT_EQ(MetaStatusCode::OK,
+              metastore.GetInode(&getInodeRequest, &getInodeResponse));
+    ASSERT_EQ(parentNlink + 1, getInodeResponse.inode().nlink());
+
+    // retry of the same request returns the inode created before
+    response.Clear();
+    ASSERT_EQ(MetaStatusCode::OK,
+              metastore.CreateInodeAndDentry(&request, &response));
+    ASSERT_TRUE(response.has_inode());
+    ASSERT_EQ(inodeId, response.inode().inodeid());
+
+    // dentry exist, no new inode is allocated
+    request.set_requestid(101);
+    response.Clear();
+    ASSERT_EQ(MetaStatusCode::DENTRY_EXIST,
+              metastore.CreateInodeAndDentry(&request, &response));
+    ASSERT_FALSE(response.has_inode());
+    ASSERT_EQ(MetaStatusCode::OK, metastore.CreateInode(
+        &createInodeRequest, &createInodeResponse));
+    ASSERT_EQ(inodeId + 1, createInodeResponse.inode().inodeid());
+}
+
 TEST_F(MetastoreTest, GetOrModifyS3ChunkInfo) {
     MetaStoreImpl metastore(nullptr, kvStorage_);
     uint32_t poolId = 1;
@@ -72,6 +72,12 @@ class MockMetaStore : public curvefs::metaserver::MetaStore {
                                              DeleteInodeResponse*));
     MOCK_METHOD2(UpdateInode, MetaStatusCode(const UpdateInodeRequest*,
                                              UpdateInodeResponse*));
+    MOCK_METHOD2(BatchUpdateInode,
+                 MetaStatusCode(const BatchUpdateInodeRequest*,
+                                BatchUpdateInodeResponse*));
+    MOCK_METHOD2(CreateInodeAndDentry,
+                 MetaStatusCode(const CreateInodeAndDentryRequest*,
+                                CreateInodeAndDentryResponse*));
 
     MOCK_METHOD2(PrepareRenameTx, MetaStatusCode(const PrepareRenameTxRequest*,
                                                  PrepareRenameTxResponse*));
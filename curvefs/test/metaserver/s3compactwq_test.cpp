@@ -263,6 +263,19 @@ TEST_F(S3CompactWorkQueueImplTest, test_GetNeedCompact) {
     }
     ASSERT_EQ(impl_->GetNeedCompact(s3chunkinfoMap, 64 * 19 + 30, 64).size(),
               opts_.maxChunksPerCompact);
+
+    // most fragmented chunk first
+    S3ChunkInfoList l4;
+    for (int i = 0; i < 40; i++) {
+        auto ref = l4.add_s3chunks();
+        ref->set_chunkid(i);
+        ref->set_offset(i + 64 * 19);
+        ref->set_len(1);
+    }
+    s3chunkinfoMap[19] = l4;
+    auto needCompact = impl_->GetNeedCompact(s3chunkinfoMap, 64 * 19 + 40, 64);
+    ASSERT_EQ(needCompact.size(), opts_.maxChunksPerCompact);
+    ASSERT_EQ(needCompact[0], 19);
 }
 
 TEST_F(S3CompactWorkQueueImplTest, test_DeleteObjs) {
@@ -480,6 +493,57 @@ TEST_F(S3CompactWorkQueueImplTest, test_BuildValidList) {
     ASSERT_TRUE(validList.empty());
 }
 
+TEST_F(S3CompactWorkQueueImplTest, test_GenCompactRanges) {
+    struct S3CompactWorkQueueImpl::S3CompactCtx ctx {
+        1, 1, PartitionInfo(), 4, 64, 0, s3adapter_.get()
+    };
+    std::list<struct S3CompactWorkQueueImpl::Node> validList;
+    ASSERT_TRUE(impl_->GenCompactRanges(ctx, validList).empty());
+
+    // block 0: clean
+    validList.emplace_back(0, 3, 1, 0, 0, 8, false);
+    // block 1: overwritten by chunk 2
+    validList.emplace_back(4, 5, 2, 0, 4, 2, false);
+    validList.emplace_back(6, 7, 1, 0, 0, 8, false);
+    // block 2, 3: clean
+    validList.emplace_back(8, 15, 3, 0, 8, 8, false);
+    // block 5: zero
+    validList.emplace_back(20, 23, 4, 0, 20, 4, true);
+
+    auto ranges = impl_->GenCompactRanges(ctx, validList);
+    ASSERT_EQ(ranges.size(), 4);
+    ASSERT_FALSE(ranges[0].rewrite);
+    ASSERT_EQ(ranges[0].begin, 0);
+    ASSERT_EQ(ranges[0].end, 3);
+    ASSERT_TRUE(ranges[1].rewrite);
+    ASSERT_EQ(ranges[1].begin, 4);
+    ASSERT_EQ(ranges[1].end, 7);
+    ASSERT_EQ(ranges[1].blocks.size(), 1);
+    ASSERT_EQ(ranges[1].blocks[0].nodes.size(), 2);
+    ASSERT_FALSE(ranges[2].rewrite);
+    ASSERT_EQ(ranges[2].begin, 8);
+    ASSERT_EQ(ranges[2].end, 15);
+    ASSERT_EQ(ranges[2].blocks.size(), 2);
+    ASSERT_FALSE(ranges[3].rewrite);
+    ASSERT_EQ(ranges[3].begin, 20);
+    ASSERT_EQ(ranges[3].end, 23);
+
+    // too many ranges kept, rewrite all
+    S3CompactWorkQueueOption opts = opts_;
+    opts.fragmentThreshold = 2;
+    S3CompactWorkQueueImpl impl(s3adapterManager_, s3infoCache_, opts,
+                                &copyset::CopysetNodeManager::GetInstance());
+    ranges = impl.GenCompactRanges(ctx, validList);
+    ASSERT_EQ(ranges.size(), 2);
+    ASSERT_TRUE(ranges[0].rewrite);
+    ASSERT_EQ(ranges[0].begin, 0);
+    ASSERT_EQ(ranges[0].end, 15);
+    ASSERT_EQ(ranges[0].blocks.size(), 4);
+    ASSERT_TRUE(ranges[1].rewrite);
+    ASSERT_EQ(ranges[1].begin, 20);
+    ASSERT_EQ(ranges[1].end, 23);
+}
+
 TEST_F(S3CompactWorkQueueImplTest, test_ReadFullChunk) {
     int ret;
     std::list<struct S3CompactWorkQueueImpl::Node> validList;
@@ -663,13 +727,19 @@ TEST_F(S3CompactWorkQueueImplTest, test_CompactChunks) {
     mockImpl_->CompactChunks(t);
     ASSERT_EQ(tmp.s3chunkinfomap().size(), 1);
     const auto& l = tmp.s3chunkinfomap().at(0);
-    ASSERT_EQ(l.s3chunks_size(), 1);
-    const auto& s3chunkinfo = l.s3chunks(0);
+    // block 0-3 and 7-14 are kept, block 4-6 are rewritten
+    ASSERT_EQ(l.s3chunks_size(), 13);
+    const auto& kept = l.s3chunks(0);
+    ASSERT_EQ(kept.chunkid(), 0);
+    ASSERT_EQ(kept.compaction(), 0);
+    ASSERT_EQ(kept.offset(), 0);
+    ASSERT_EQ(kept.len(), 4);
+    const auto& s3chunkinfo = l.s3chunks(12);
     ASSERT_EQ(s3chunkinfo.chunkid(), 21);
     ASSERT_EQ(s3chunkinfo.compaction(), 1);
-    ASSERT_EQ(s3chunkinfo.offset(), 0);
-    ASSERT_EQ(s3chunkinfo.len(), 60);
-    ASSERT_EQ(s3chunkinfo.size(), 60);
+    ASSERT_EQ(s3chunkinfo.offset(), 16);
+    ASSERT_EQ(s3chunkinfo.len(), 12);
+    ASSERT_EQ(s3chunkinfo.size(), 12);
     ASSERT_EQ(s3chunkinfo.zero(), false);
     // inode nlink = 0, deleted
     inode1.set_nlink(0);
@@ -688,5 +758,153 @@ TEST_F(S3CompactWorkQueueImplTest, test_CompactChunks) {
         .WillRepeatedly(Return(true));
     mockImpl_->CompactChunks(t);
 }
+
+TEST_F(S3CompactWorkQueueImplTest, test_ReadPackedData) {
+    struct S3CompactWorkQueueImpl::S3CompactCtx ctx {
+        1, 1, PartitionInfo(), 4, 64, 0, s3adapter_.get()
+    };
+    std::list<struct S3CompactWorkQueueImpl::Node> validList;
+    // data of [0, 3] is at offset 100 of pack 7
+    validList.emplace_back(0, 3, 5, 0, 0, 4, false, 7, 100);
+
+    // packed block is never kept, so the pack can be freed
+    auto ranges = impl_->GenCompactRanges(ctx, validList);
+    ASSERT_EQ(ranges.size(), 1);
+    ASSERT_TRUE(ranges[0].rewrite);
+
+    std::string pack(128, 'a');
+    pack.replace(100, 4, "data");
+    auto mock_getobj = [&](const Aws::String& key, std::string* data) {
+        *data = pack;
+        return 0;
+    };
+    EXPECT_CALL(*s3adapter_, GetObject(Aws::String("1_pack_7"), _))
+        .WillOnce(testing::Invoke(mock_getobj));
+
+    // only part of the packed data is valid
+    validList.clear();
+    validList.emplace_back(1, 2, 5, 0, 0, 4, false, 7, 100);
+    std::string fullChunk;
+    struct S3CompactWorkQueueImpl::S3NewChunkInfo newChunkInfo;
+    ASSERT_EQ(impl_->ReadFullChunk(ctx, validList, &fullChunk, &newChunkInfo),
+              0);
+    ASSERT_EQ(fullChunk, "at");
+    ASSERT_EQ(newChunkInfo.newChunkId, 5);
+    ASSERT_EQ(newChunkInfo.newCompaction, 1);
+}
+
+TEST_F(S3CompactWorkQueueImplTest, test_CollectPacks) {
+    S3CompactWorkQueueOption opts = opts_;
+    opts.packGCGraceSec = 0;
+    S3CompactWorkQueueImpl impl(s3adapterManager_, s3infoCache_, opts,
+                                &copyset::CopysetNodeManager::GetInstance());
+
+    EXPECT_CALL(*mockCopysetNodeWrapper_, IsLeaderTerm())
+        .WillRepeatedly(Return(true));
+    auto pairResult = std::make_pair(0, s3adapter_.get());
+    EXPECT_CALL(*s3adapterManager_, GetS3Adapter())
+        .WillRepeatedly(Return(pairResult));
+    EXPECT_CALL(*s3adapterManager_, ReleaseS3Adapter(_))
+        .WillRepeatedly(Return());
+    auto mock_gets3info_success = [&](uint64_t fsid, S3Info* s3info) {
+        s3info->set_ak("1");
+        s3info->set_sk("2");
+        s3info->set_endpoint("3");
+        s3info->set_bucketname("4");
+        s3info->set_blocksize(4);
+        s3info->set_chunksize(64);
+        return 0;
+    };
+    EXPECT_CALL(*s3infoCache_, GetS3Info(_, _))
+        .WillRepeatedly(testing::Invoke(mock_gets3info_success));
+    std::string v = "5";
+    EXPECT_CALL(*s3adapter_, GetS3Ak()).WillRepeatedly(Return(v));
+    EXPECT_CALL(*s3adapter_, GetS3Sk()).WillRepeatedly(Return(v));
+    EXPECT_CALL(*s3adapter_, GetS3Endpoint()).WillRepeatedly(Return(v));
+    EXPECT_CALL(*s3adapter_, Reinit(_, _, _, _)).WillRepeatedly(Return());
+    EXPECT_CALL(*s3adapter_, GetBucketName()).WillRepeatedly(Return(v));
+
+    Inode inode1;
+    inode1.set_fsid(1);
+    inode1.set_inodeid(1);
+    inode1.set_length(60);
+    inode1.set_nlink(1);
+    inode1.set_ctime(0);
+    inode1.set_ctime_ns(0);
+    inode1.set_mtime(0);
+    inode1.set_mtime_ns(0);
+    inode1.set_atime(0);
+    inode1.set_atime_ns(0);
+    inode1.set_uid(0);
+    inode1.set_gid(0);
+    inode1.set_mode(0);
+    inode1.set_type(FsFileType::TYPE_FILE);
+    ASSERT_EQ(inodeStorage_->Insert(inode1), MetaStatusCode::OK);
+
+    auto addList = [&](uint64_t inodeId, uint64_t chunkId, uint64_t packId) {
+        S3ChunkInfoList list;
+        auto info = list.add_s3chunks();
+        info->set_chunkid(chunkId);
+        info->set_compaction(0);
+        info->set_offset(0);
+        info->set_len(4);
+        info->set_size(4);
+        info->set_zero(false);
+        info->set_packid(packId);
+        info->set_packoffset(0);
+        ASSERT_EQ(inodeStorage_->ModifyInodeS3ChunkInfoList(
+                      1, inodeId, 0, &list, nullptr),
+                  MetaStatusCode::OK);
+    };
+    // pack 10 is referred by inode 1, pack 11 only by deleted inode 2
+    addList(1, 1, 10);
+    addList(2, 2, 11);
+
+    struct S3CompactWorkQueueImpl::S3CompactTask t {
+        inodeManager_, Key4Inode(1, 0), PartitionInfo(),
+            mockCopysetNodeWrapper_
+    };
+    t.pinfo.set_fsid(1);
+    t.pinfo.set_partitionid(1);
+
+    EXPECT_CALL(*s3adapter_, DeleteObject(Aws::String("1_pack_10"))).Times(0);
+    EXPECT_CALL(*s3adapter_, DeleteObject(Aws::String("1_pack_11")))
+        .WillOnce(Return(0));
+    impl.CollectPacks(t);
+
+    // pack 12 is dropped by compaction, and pack 11 is already deleted
+    EXPECT_CALL(*s3adapter_, DeleteObject(Aws::String("1_pack_12")))
+        .WillOnce(Return(0));
+    impl.AddPackCandidates(1, {10, 12});
+    impl.CollectPacks(t);
+
+    // orphaned list of inode 2 is gone, deleted pack 11 is forgotten
+    auto delList = [&](uint64_t inodeId, uint64_t chunkId) {
+        S3ChunkInfoList list;
+        list.add_s3chunks()->set_chunkid(chunkId);
+        ASSERT_EQ(inodeStorage_->ModifyInodeS3ChunkInfoList(
+                      1, inodeId, 0, nullptr, &list),
+                  MetaStatusCode::OK);
+    };
+    ASSERT_EQ(1, impl.packGCStates_[1].deleted.count(11));
+    delList(2, 2);
+    impl.CollectPacks(t);
+    ASSERT_EQ(0, impl.packGCStates_[1].deleted.count(11));
+
+    // no pack left in the partition, its gc state is dropped
+    EXPECT_CALL(*s3adapter_, DeleteObject(Aws::String("1_pack_10")))
+        .WillOnce(Return(0));
+    delList(1, 1);
+    impl.AddPackCandidates(1, {10});
+    impl.CollectPacks(t);
+    impl.CollectPacks(t);
+    ASSERT_EQ(0, impl.packGCStates_.count(1));
+
+    // not leader
+    EXPECT_CALL(*mockCopysetNodeWrapper_, IsLeaderTerm())
+        .WillRepeatedly(Return(false));
+    impl.AddPackCandidates(1, {13});
+    impl.CollectPacks(t);
+}
 }  // namespace metaserver
 }  // namespace curvefs
@@ -23,6 +23,8 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "curvefs/src/metaserver/storage/utils.h"
 #include "curvefs/src/metaserver/storage/storage.h"
@@ -191,6 +193,79 @@ TEST_F(RocksDBStorageTest, MiscTest) {
         IsInternalError());
 }
 
+TEST_F(RocksDBStorageTest, CheckpointTest) {
+    ASSERT_TRUE(kvStorage_->HSet("partition:1", "key1", Value("value1")).ok());
+    ASSERT_TRUE(kvStorage_->SSet("partition:1", "key2", Value("value2")).ok());
+    ASSERT_TRUE(kvStorage_->HSet("partition:2", "key1", Value("value1")).ok());
+
+    // CASE 1: only the given tables are dumped
+    DumpFileClosure done;
+    std::vector<std::string> files;
+    std::string checkpoint = dirname_ + "/checkpoint";
+    ASSERT_TRUE(kvStorage_->Checkpoint(
+        checkpoint, {"partition:1"}, &files, &done));
+    done.WaitRunned();
+    ASSERT_EQ(files.size(), 2);
+
+    // CASE 2: modification after checkpoint created is invisible to it
+    ASSERT_TRUE(kvStorage_->HSet("partition:1", "key3", Value("value3")).ok());
+    ASSERT_TRUE(kvStorage_->SDel("partition:1", "key2").ok());
+
+    auto storage = kvStorage_->OpenCheckpoint(checkpoint);
+    ASSERT_NE(storage, nullptr);
+    // the temporary database is kept out of the checkpoint directory
+    ASSERT_EQ(storage->GetStorageOptions().dataDir.find(checkpoint),
+              std::string::npos);
+    ASSERT_EQ(storage->GetStorageOptions().dataDir.find(dbpath_ + "_"), 0);
+
+    Dentry dentry;
+    auto iterator = storage->HGetAll("partition:1");
+    ASSERT_EQ(iterator->Status(), 0);
+    std::vector<std::string> keys;
+    for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
+        ASSERT_TRUE(iterator->ParseFromValue(&dentry));
+        keys.push_back(iterator->Key());
+    }
+    ASSERT_EQ(keys, std::vector<std::string>{"key1"});
+    ASSERT_EQ(dentry.name(), "value1");
+
+    iterator = storage->SGetAll("partition:1");
+    ASSERT_EQ(iterator->Status(), 0);
+    keys.clear();
+    for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
+        ASSERT_TRUE(iterator->ParseFromValue(&dentry));
+        keys.push_back(iterator->Key());
+    }
+    ASSERT_EQ(keys, std::vector<std::string>{"key2"});
+    ASSERT_EQ(dentry.name(), "value2");
+
+    iterator = storage->HGetAll("partition:2");
+    ASSERT_EQ(iterator->Status(), 0);
+    iterator->SeekToFirst();
+    ASSERT_FALSE(iterator->Valid());
+    ASSERT_TRUE(storage->Close());
+
+    // CASE 3: checkpoint directory already exists
+    DumpFileClosure done2;
+    ASSERT_FALSE(kvStorage_->Checkpoint(
+        checkpoint, {"partition:1"}, &files, &done2));
+    done2.WaitRunned();
+
+    // CASE 4: nothing dumped for the empty tables
+    DumpFileClosure done3;
+    std::string empty = dirname_ + "/empty";
+    ASSERT_TRUE(kvStorage_->Checkpoint(
+        empty, {"partition:3"}, &files, &done3));
+    done3.WaitRunned();
+    ASSERT_TRUE(files.empty());
+    storage = kvStorage_->OpenCheckpoint(empty);
+    ASSERT_NE(storage, nullptr);
+    iterator = storage->HGetAll("partition:3");
+    iterator->SeekToFirst();
+    ASSERT_FALSE(iterator->Valid());
+    ASSERT_TRUE(storage->Close());
+}
+
 TEST_F(RocksDBStorageTest, HGetTest) { TestHGet(kvStorage_); }
 TEST_F(RocksDBStorageTest, HSetTest) { TestHSet(kvStorage_); }
 TEST_F(RocksDBStorageTest, HDelTest) { TestHDel(kvStorage_); }
@@ -0,0 +1,266 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Date: Wednesday Oct 12 16:03:18 CST 2022
+ * Author: wuhanqing
+ */
+
+#include "curvefs/src/volume/alloc_cache.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "curvefs/src/volume/bitmap_allocator.h"
+#include "curvefs/test/volume/common.h"
+
+namespace curvefs {
+namespace volume {
+
+class AllocCacheTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        allocOpt_.startOffset = 0;
+        allocOpt_.length = 10 * kGiB;
+        allocOpt_.sizePerBit = 4 * kMiB;
+        allocOpt_.smallAllocProportion = 0;
+
+        allocator_ = absl::make_unique<BitmapAllocator>(allocOpt_);
+
+        cacheOpt_.shards = 4;
+        cacheOpt_.refillSize = 16 * kMiB;
+
+        refillCount_ = 0;
+    }
+
+    std::unique_ptr<AllocCache> NewCache() {
+        return absl::make_unique<AllocCache>(
+            cacheOpt_, [this](uint64_t size, Extents* exts) {
+                ++refillCount_;
+                Extents reserved;
+                if (allocator_->Alloc(size, AllocateHint(), &reserved) !=
+                    size) {
+                    allocator_->DeAlloc(reserved);
+                    return false;
+                }
+                exts->insert(exts->end(), reserved.begin(), reserved.end());
+                return true;
+            });
+    }
+
+ protected:
+    BitmapAllocatorOption allocOpt_;
+    std::unique_ptr<BitmapAllocator> allocator_;
+    AllocCacheOption cacheOpt_;
+    std::atomic<uint32_t> refillCount_;
+};
+
+TEST_F(AllocCacheTest, AllocFromCache) {
+    auto cache = NewCache();
+
+    Extents exts;
+    ASSERT_TRUE(cache->Alloc(1 * kMiB, AllocateHint(), &exts));
+    ASSERT_EQ(1, refillCount_);
+    ASSERT_EQ(1 * kMiB, TotalLength(exts));
+    ASSERT_EQ(15 * kMiB, cache->CachedSize());
+
+    // served from cache
+    for (int i = 0; i < 15; ++i) {
+        ASSERT_TRUE(cache->Alloc(1 * kMiB, AllocateHint(), &exts));
+    }
+
+    ASSERT_EQ(1, refillCount_);
+    ASSERT_EQ(0, cache->CachedSize());
+    ASSERT_EQ(16 * kMiB, TotalLength(exts));
+    ASSERT_TRUE(ExtentsNotOverlap(exts));
+    ASSERT_TRUE(ExtentsContinuous(exts));
+
+    // cache is empty, refill again
+    ASSERT_TRUE(cache->Alloc(1 * kMiB, AllocateHint(), &exts));
+    ASSERT_EQ(2, refillCount_);
+}
+
+TEST_F(AllocCacheTest, AllocLargerThanRefillSize) {
+    auto cache = NewCache();
+
+    Extents exts;
+    ASSERT_TRUE(cache->Alloc(64 * kMiB, AllocateHint(), &exts));
+    ASSERT_EQ(64 * kMiB, TotalLength(exts));
+    ASSERT_EQ(0, cache->CachedSize());
+}
+
+TEST_F(AllocCacheTest, AllocWithLeftHint) {
+    auto cache = NewCache();
+
+    Extents first;
+    ASSERT_TRUE(cache->Alloc(1 * kMiB, AllocateHint(), &first));
+    ASSERT_EQ(1, first.size());
+
+    AllocateHint hint;
+    hint.leftOffset = first[0].offset + first[0].len;
+
+    Extents second;
+    ASSERT_TRUE(cache->Alloc(1 * kMiB, hint, &second));
+    ASSERT_EQ(1, second.size());
+    ASSERT_EQ(hint.leftOffset, second[0].offset);
+}
+
+TEST_F(AllocCacheTest, RefillFailed) {
+    auto cache = absl::make_unique<AllocCache>(
+        cacheOpt_, [](uint64_t, Extents*) { return false; });
+
+    Extents exts;
+    ASSERT_FALSE(cache->Alloc(1 * kMiB, AllocateHint(), &exts));
+    ASSERT_TRUE(exts.empty());
+}
+
+TEST_F(AllocCacheTest, RefillNotEnoughSpaceForFullRefill) {
+    allocOpt_.length = 20 * kMiB;
+    allocator_ = absl::make_unique<BitmapAllocator>(allocOpt_);
+    auto cache = NewCache();
+
+    Extents exts;
+    ASSERT_TRUE(cache->Alloc(8 * kMiB, AllocateHint(), &exts));
+    ASSERT_EQ(8 * kMiB, cache->CachedSize());
+
+    // 8MiB in cache, 4MiB left in allocator, can't refill 16MiB
+    ASSERT_TRUE(cache->Alloc(12 * kMiB, AllocateHint(), &exts));
+    ASSERT_EQ(20 * kMiB, TotalLength(exts));
+    ASSERT_EQ(0, cache->CachedSize());
+    ASSERT_EQ(0, allocator_->AvailableSize());
+
+    // no space at all, extents taken from cache are given back
+    Extents more;
+    ASSERT_FALSE(cache->Alloc(1 * kMiB, AllocateHint(), &more));
+    ASSERT_TRUE(more.empty());
+}
+
+TEST_F(AllocCacheTest, Drain) {
+    auto cache = NewCache();
+
+    std::vector<std::thread> threads;
+    std::mutex mtx;
+    Extents allocated;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&]() {
+            Extents exts;
+            ASSERT_TRUE(cache->Alloc(1 * kMiB, AllocateHint(), &exts));
+            std::lock_guard<std::mutex> lk(mtx);
+            allocated.insert(allocated.end(), exts.begin(), exts.end());
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    Extents drained;
+    cache->Drain(&drained);
+    ASSERT_EQ(0, cache->CachedSize());
+
+    allocator_->DeAlloc(allocated);
+    allocator_->DeAlloc(drained);
+    ASSERT_EQ(allocOpt_.length, allocator_->AvailableSize());
+}
+
+TEST_F(AllocCacheTest, MultiThreadAlloc) {
+    const int kThreads = 16;
+    const int kAllocPerThread = 2000;
+    const uint64_t kAllocSize = 64 * kKiB;
+
+    cacheOpt_.shards = kThreads;
+    auto cache = NewCache();
+
+    std::vector<Extents> exts(kThreads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&, i]() {
+            for (int j = 0; j < kAllocPerThread; ++j) {
+                ASSERT_TRUE(cache->Alloc(kAllocSize, AllocateHint(), &exts[i]));
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    Extents all;
+    for (auto& e : exts) {
+        all.insert(all.end(), e.begin(), e.end());
+    }
+
+    ASSERT_TRUE(ExtentsNotOverlap(all));
+    ASSERT_EQ(kThreads * kAllocPerThread * kAllocSize, TotalLength(all));
+
+    // every refill reserves a full refill size
+    Extents drained;
+    cache->Drain(&drained);
+    ASSERT_EQ(refillCount_ * cacheOpt_.refillSize,
+              TotalLength(all) + TotalLength(drained));
+
+    allocator_->DeAlloc(all);
+    allocator_->DeAlloc(drained);
+    ASSERT_EQ(allocOpt_.length, allocator_->AvailableSize());
+}
+
+// refill is done without holding shard lock, so draining the cache while
+// refilling, as shutdown may do concurrently, doesn't deadlock
+TEST_F(AllocCacheTest, DrainDuringRefill) {
+    Extents drained;
+    std::unique_ptr<AllocCache> cache;
+    cache = absl::make_unique<AllocCache>(
+        cacheOpt_, [&](uint64_t size, Extents* exts) {
+            ++refillCount_;
+            cache->Drain(&drained);
+            return allocator_->Alloc(size, AllocateHint(), exts) == size;
+        });
+
+    // space reserved by other thread's shard may be drained by the refill
+    // of current thread
+    Extents other;
+    std::thread t([&]() {
+        ASSERT_TRUE(cache->Alloc(1 * kMiB, AllocateHint(), &other));
+    });
+    t.join();
+
+    Extents exts;
+    ASSERT_TRUE(cache->Alloc(1 * kMiB, AllocateHint(), &exts));
+    ASSERT_EQ(1 * kMiB, TotalLength(exts));
+
+    Extents left;
+    cache->Drain(&left);
+    ASSERT_EQ(0, cache->CachedSize());
+    ASSERT_EQ(refillCount_ * cacheOpt_.refillSize,
+              TotalLength(other) + TotalLength(exts) + TotalLength(drained) +
+                  TotalLength(left));
+
+    allocator_->DeAlloc(other);
+    allocator_->DeAlloc(exts);
+    allocator_->DeAlloc(drained);
+    allocator_->DeAlloc(left);
+    ASSERT_EQ(allocOpt_.length, allocator_->AvailableSize());
+}
+
+}  // namespace volume
+}  // namespace curvefs
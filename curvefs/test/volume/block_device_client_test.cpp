@@ -23,6 +23,11 @@
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+
+#include <functional>
+#include <future>
+#include <string>
+
 #include "absl/memory/memory.h"
 
 #include "curvefs/src/volume/block_device_client.h"
@@ -38,6 +43,7 @@ using ::testing::Invoke;
 using ::testing::NiceMock;
 using ::curve::client::UserInfo;
 using ::curve::client::MockFileClient;
+using ::curve::client::UserDataType;
 using AlignRead = std::pair<off_t, size_t>;
 using AlignReads = std::vector<AlignRead>;
 
@@ -538,5 +544,290 @@ TEST_F(BlockDeviceClientTest, WritevTest_AllUnAlignedSuccess) {
     ASSERT_EQ(4 * (2 * kKiB), client_->Writev(iov));
 }
 
+// run libcurve aio callback with offset/length/buf of each issued io
+static int AioCallback(int, CurveAioContext* ctx, UserDataType) {
+    ctx->ret = ctx->length;
+    ctx->cb(ctx);
+    return LIBCURVE_ERROR::OK;
+}
+
+static ssize_t WaitAio(
+    const std::function<void(BlockDeviceAioCallback)>& submit) {
+    std::promise<ssize_t> promise;
+    submit([&promise](ssize_t ret) { promise.set_value(ret); });
+    return promise.get_future().get();
+}
+
+TEST_F(BlockDeviceClientTest, AioReadvTest_NotOpen) {
+    char data[4 * kKiB];
+    std::vector<ReadPart> iov{{0, 4 * kKiB, data}};
+
+    ASSERT_GT(0, WaitAio([&](BlockDeviceAioCallback done) {
+        client_->AioReadv(iov, std::move(done));
+    }));
+}
+
+TEST_F(BlockDeviceClientTest, AioReadvTest_MergeAdjacentParts) {
+    ON_CALL(*fileClient_, Open(_, _, _))
+        .WillByDefault(Return(1));
+
+    char data1[4 * kKiB];
+    char data2[4 * kKiB];
+    char data3[4 * kKiB];
+    memset(data1, '0', sizeof(data1));
+    memset(data2, '0', sizeof(data2));
+    memset(data3, '0', sizeof(data3));
+
+    // first two parts are adjacent, third one is aligned and standalone
+    std::vector<ReadPart> iov{
+        {4 * kKiB, 4 * kKiB, data2},
+        {0, 4 * kKiB, data1},
+        {1 * kMiB, 4 * kKiB, data3},
+    };
+
+    EXPECT_CALL(*fileClient_, AioRead(1, _, _))
+        .Times(2)
+        .WillRepeatedly(Invoke([](int fd, CurveAioContext* ctx,
+                                  UserDataType type) {
+            if (ctx->offset == 0) {
+                EXPECT_EQ(8 * kKiB, ctx->length);
+            } else {
+                EXPECT_EQ(1 * kMiB, ctx->offset);
+                EXPECT_EQ(4 * kKiB, ctx->length);
+            }
+            memset(ctx->buf, '1', ctx->length);
+            return AioCallback(fd, ctx, type);
+        }));
+
+    ASSERT_TRUE(client_->Open({}, {}));
+    ASSERT_EQ(3 * (4 * kKiB), WaitAio([&](BlockDeviceAioCallback done) {
+                  client_->AioReadv(iov, std::move(done));
+              }));
+
+    for (size_t i = 0; i < 4 * kKiB; ++i) {
+        ASSERT_EQ('1', data1[i]);
+        ASSERT_EQ('1', data2[i]);
+        ASSERT_EQ('1', data3[i]);
+    }
+}
+
+TEST_F(BlockDeviceClientTest, AioReadvTest_UnAligned) {
+    ON_CALL(*fileClient_, Open(_, _, _))
+        .WillByDefault(Return(1));
+
+    char data[5000];
+    memset(data, '0', sizeof(data));
+    std::vector<ReadPart> iov{{1000, 5000, data}};
+
+    EXPECT_CALL(*fileClient_, AioRead(1, _, _))
+        .WillOnce(Invoke([](int fd, CurveAioContext* ctx, UserDataType type) {
+            EXPECT_EQ(0, ctx->offset);
+            EXPECT_EQ(8 * kKiB, ctx->length);
+            char* buf = static_cast<char*>(ctx->buf);
+            for (size_t i = 0; i < ctx->length; ++i) {
+                buf[i] = (i >= 1000 && i < 6000) ? '1' : '2';
+            }
+            return AioCallback(fd, ctx, type);
+        }));
+
+    ASSERT_TRUE(client_->Open({}, {}));
+    ASSERT_EQ(5000, WaitAio([&](BlockDeviceAioCallback done) {
+                  client_->AioReadv(iov, std::move(done));
+              }));
+
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        ASSERT_EQ('1', data[i]);
+    }
+}
+
+TEST_F(BlockDeviceClientTest, AioReadvTest_PartialFailed) {
+    ON_CALL(*fileClient_, Open(_, _, _))
+        .WillByDefault(Return(1));
+
+    char data[4 * kKiB];
+    std::vector<ReadPart> iov{
+        {0 * kMiB, 4 * kKiB, data},
+        {4 * kMiB, 4 * kKiB, data},
+        {8 * kMiB, 4 * kKiB, data},
+    };
+
+    EXPECT_CALL(*fileClient_, AioRead(1, _, _))
+        .WillOnce(Invoke(AioCallback))
+        .WillOnce(Return(-LIBCURVE_ERROR::FAILED))
+        .WillOnce(Invoke([](int, CurveAioContext* ctx, UserDataType) {
+            ctx->ret = -LIBCURVE_ERROR::FAILED;
+            ctx->cb(ctx);
+            return LIBCURVE_ERROR::OK;
+        }));
+
+    ASSERT_TRUE(client_->Open({}, {}));
+    ASSERT_GT(0, WaitAio([&](BlockDeviceAioCallback done) {
+                  client_->AioReadv(iov, std::move(done));
+              }));
+}
+
+TEST_F(BlockDeviceClientTest, AioWritevTest_AlignedZeroCopy) {
+    ON_CALL(*fileClient_, Open(_, _, _))
+        .WillByDefault(Return(1));
+
+    char data[4 * kKiB];
+    std::vector<WritePart> iov{
+        {0 * kMiB, 4 * kKiB, data},
+        {4 * kMiB, 4 * kKiB, data},
+    };
+
+    EXPECT_CALL(*fileClient_, AioRead(_, _, _))
+        .Times(0);
+    EXPECT_CALL(*fileClient_, AioWrite(1, _, _))
+        .Times(2)
+        .WillRepeatedly(Invoke([&data](int fd, CurveAioContext* ctx,
+                                       UserDataType type) {
+            EXPECT_EQ(data, ctx->buf);
+            return AioCallback(fd, ctx, type);
+        }));
+
+    ASSERT_TRUE(client_->Open({}, {}));
+    ASSERT_EQ(2 * (4 * kKiB), WaitAio([&](BlockDeviceAioCallback done) {
+                  client_->AioWritev(iov, std::move(done));
+              }));
+}
+
+TEST_F(BlockDeviceClientTest, AioWritevTest_UnAlignedPadding) {
+    ON_CALL(*fileClient_, Open(_, _, _))
+        .WillByDefault(Return(1));
+
+    char data1[2 * kKiB];
+    char data2[4 * kKiB];
+    memset(data1, '2', sizeof(data1));
+    memset(data2, '3', sizeof(data2));
+
+    // [1KiB, 3KiB) and [3KiB, 7KiB) are merged into one write of [0, 8KiB),
+    // leading and trailing blocks are padded by one read
+    std::vector<WritePart> iov{
+        {1 * kKiB, 2 * kKiB, data1},
+        {3 * kKiB, 4 * kKiB, data2},
+    };
+
+    std::string written;
+    EXPECT_CALL(*fileClient_, AioRead(1, _, _))
+        .WillOnce(Invoke([](int fd, CurveAioContext* ctx, UserDataType type) {
+            EXPECT_EQ(0, ctx->offset);
+            EXPECT_EQ(8 * kKiB, ctx->length);
+            memset(ctx->buf, '1', ctx->length);
+            return AioCallback(fd, ctx, type);
+        }));
+    EXPECT_CALL(*fileClient_, AioWrite(1, _, _))
+        .WillOnce(Invoke([&written](int fd, CurveAioContext* ctx,
+                                    UserDataType type) {
+            EXPECT_EQ(0, ctx->offset);
+            EXPECT_EQ(8 * kKiB, ctx->length);
+            written.assign(static_cast<char*>(ctx->buf), ctx->length);
+            return AioCallback(fd, ctx, type);
+        }));
+
+    ASSERT_TRUE(client_->Open({}, {}));
+    ASSERT_EQ(6 * kKiB, WaitAio([&](BlockDeviceAioCallback done) {
+                  client_->AioWritev(iov, std::move(done));
+              }));
+
+    ASSERT_EQ(std::string(1 * kKiB, '1') + std::string(2 * kKiB, '2') +
+                  std::string(4 * kKiB, '3') + std::string(1 * kKiB, '1'),
+              written);
+}
+
+TEST_F(BlockDeviceClientTest, AioWritevTest_PartsInSameBlock) {
+    ON_CALL(*fileClient_, Open(_, _, _))
+        .WillByDefault(Return(1));
+
+    char data[1 * kKiB];
+    memset(data, '2', sizeof(data));
+
+    // two parts share one block, they must be written by one io, otherwise
+    // two read-modify-writes of the same block may overwrite each other
+    std::vector<WritePart> iov{
+        {0, 1 * kKiB, data},
+        {2 * kKiB, 1 * kKiB, data},
+    };
+
+    std::string written;
+    EXPECT_CALL(*fileClient_, AioRead(1, _, _))
+        .WillOnce(Invoke([](int fd, CurveAioContext* ctx, UserDataType type) {
+            EXPECT_EQ(0, ctx->offset);
+            EXPECT_EQ(4 * kKiB, ctx->length);
+            memset(ctx->buf, '1', ctx->length);
+            return AioCallback(fd, ctx, type);
+        }));
+    EXPECT_CALL(*fileClient_, AioWrite(1, _, _))
+        .WillOnce(Invoke([&written](int fd, CurveAioContext* ctx,
+                                    UserDataType type) {
+            written.assign(static_cast<char*>(ctx->buf), ctx->length);
+            return AioCallback(fd, ctx, type);
+        }));
+
+    ASSERT_TRUE(client_->Open({}, {}));
+    ASSERT_EQ(2 * kKiB, WaitAio([&](BlockDeviceAioCallback done) {
+                  client_->AioWritev(iov, std::move(done));
+              }));
+
+    ASSERT_EQ(std::string(1 * kKiB, '2') + std::string(1 * kKiB, '1') +
+                  std::string(1 * kKiB, '2') + std::string(1 * kKiB, '1'),
+              written);
+}
+
+TEST_F(BlockDeviceClientTest, AioWritevTest_OverlappedParts) {
+    ON_CALL(*fileClient_, Open(_, _, _))
+        .WillByDefault(Return(1));
+
+    char data1[2 * kKiB];
+    char data2[4 * kKiB];
+    memset(data1, '1', sizeof(data1));
+    memset(data2, '2', sizeof(data2));
+
+    // the later part overlaps the earlier one, so it wins although it has
+    // a smaller offset, and overlapped bytes are counted once
+    std::vector<WritePart> iov{
+        {1 * kKiB, 2 * kKiB, data1},
+        {0, 4 * kKiB, data2},
+    };
+
+    std::string written;
+    EXPECT_CALL(*fileClient_, AioRead(_, _, _))
+        .Times(0);
+    EXPECT_CALL(*fileClient_, AioWrite(1, _, _))
+        .WillOnce(Invoke([&written](int fd, CurveAioContext* ctx,
+                                    UserDataType type) {
+            EXPECT_EQ(0, ctx->offset);
+            EXPECT_EQ(4 * kKiB, ctx->length);
+            written.assign(static_cast<char*>(ctx->buf), ctx->length);
+            return AioCallback(fd, ctx, type);
+        }));
+
+    ASSERT_TRUE(client_->Open({}, {}));
+    ASSERT_EQ(4 * kKiB, WaitAio([&](BlockDeviceAioCallback done) {
+                  client_->AioWritev(iov, std::move(done));
+              }));
+
+    ASSERT_EQ(std::string(4 * kKiB, '2'), written);
+}
+
+TEST_F(BlockDeviceClientTest, AioWritevTest_PaddingReadFailed) {
+    ON_CALL(*fileClient_, Open(_, _, _))
+        .WillByDefault(Return(1));
+
+    char data[10000];
+    std::vector<WritePart> iov{{1000, 10000, data}};
+
+    EXPECT_CALL(*fileClient_, AioRead(1, _, _))
+        .WillOnce(Invoke(AioCallback))
+        .WillOnce(Return(-LIBCURVE_ERROR::FAILED));
+    EXPECT_CALL(*fileClient_, AioWrite(_, _, _))
+        .Times(0);
+
+    ASSERT_TRUE(client_->Open({}, {}));
+    ASSERT_GT(0, WaitAio([&](BlockDeviceAioCallback done) {
+                  client_->AioWritev(iov, std::move(done));
+              }));
+}
+
 }  // namespace volume
 }  // namespace curvefs
@@ -25,6 +25,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <climits>
+#include <vector>
+
 #include "absl/memory/memory.h"
 #include "curvefs/test/volume/mock/mock_block_device_client.h"
 
@@ -32,12 +35,23 @@ namespace curvefs {
 namespace volume {
 
 using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Invoke;
 using ::testing::Return;
+using ::testing::SaveArg;
 
 static constexpr uint32_t kBlockSize = 4 * kKiB;
-static constexpr uint64_t kBlockGroupSize = 128 * kMiB;   // 128 MiB
+static constexpr uint64_t kBlockGroupSize = 1 * kGiB;      // 1 GiB
 static constexpr uint64_t kBlockGroupOffset = 10 * kGiB;  // 10 GiB
 
+static ssize_t TotalLength(const std::vector<WritePart>& parts) {
+    ssize_t total = 0;
+    for (const auto& part : parts) {
+        total += part.length;
+    }
+    return total;
+}
+
 class BlockGroupBitmapUpdaterTest : public ::testing::Test {
  protected:
     void SetUp() override {
@@ -46,7 +60,8 @@ class BlockGroupBitmapUpdaterTest : public ::testing::Test {
         Bitmap bitmap(kBlockGroupSize / kBlockSize);
         bitmap.Clear();
 
-        BitmapRange range{kBlockGroupOffset, kBlockGroupSize / kBlockSize};
+        BitmapRange range{kBlockGroupOffset,
+                          kBlockGroupSize / kBlockSize / CHAR_BIT};
 
         updater_ = absl::make_unique<BlockGroupBitmapUpdater>(
             std::move(bitmap), kBlockSize, kBlockGroupSize, kBlockGroupOffset,
@@ -59,8 +74,8 @@ class BlockGroupBitmapUpdaterTest : public ::testing::Test {
 };
 
 TEST_F(BlockGroupBitmapUpdaterTest, SyncTest_NoDirty) {
-    EXPECT_CALL(*mockBlockDev_, Write(_, _, _)).
-        Times(0);
+    EXPECT_CALL(*mockBlockDev_, Writev(_))
+        .Times(0);
 
     ASSERT_TRUE(updater_->Sync());
 }
@@ -68,10 +83,10 @@ TEST_F(BlockGroupBitmapUpdaterTest, SyncTest_NoDirty) {
 TEST_F(BlockGroupBitmapUpdaterTest, SyncTest_Dirty) {
     auto start = kBlockGroupOffset;
     auto end = kBlockGroupOffset + kBlockGroupSize;
-    updater_->Update({start, end}, BlockGroupBitmapUpdater::Set);
+    updater_->Update({start, end - start}, BlockGroupBitmapUpdater::Set);
 
-    EXPECT_CALL(*mockBlockDev_, Write(_, _, _))
-        .WillOnce(Return(true));
+    EXPECT_CALL(*mockBlockDev_, Writev(_))
+        .WillOnce(Invoke(TotalLength));
 
     ASSERT_TRUE(updater_->Sync());
 }
@@ -79,27 +94,60 @@ TEST_F(BlockGroupBitmapUpdaterTest, SyncTest_Dirty) {
 TEST_F(BlockGroupBitmapUpdaterTest, SyncTest_OnlySyncOnce) {
     auto start1 = kBlockGroupOffset;
     auto end1 = kBlockGroupOffset + kBlockGroupSize;
-    updater_->Update({start1, end1}, BlockGroupBitmapUpdater::Set);
+    updater_->Update({start1, end1 - start1}, BlockGroupBitmapUpdater::Set);
 
     auto start2 = kBlockGroupOffset;
     auto end2 = kBlockGroupOffset + kBlockGroupSize;
-    updater_->Update({start2, end2}, BlockGroupBitmapUpdater::Clear);
+    updater_->Update({start2, end2 - start2}, BlockGroupBitmapUpdater::Clear);
 
-    EXPECT_CALL(*mockBlockDev_, Write(_, _, _))
-        .WillOnce(Return(true));
+    EXPECT_CALL(*mockBlockDev_, Writev(_))
+        .WillOnce(Invoke(TotalLength));
 
     ASSERT_TRUE(updater_->Sync());
+    ASSERT_TRUE(updater_->Sync());
 }
 
 TEST_F(BlockGroupBitmapUpdaterTest, SyncTest_WriteFailed) {
     auto start = kBlockGroupOffset;
     auto end = kBlockGroupOffset + kBlockGroupSize;
-    updater_->Update({start, end}, BlockGroupBitmapUpdater::Set);
+    updater_->Update({start, end - start}, BlockGroupBitmapUpdater::Set);
 
-    EXPECT_CALL(*mockBlockDev_, Write(_, _, _))
-        .WillOnce(Return(false));
+    EXPECT_CALL(*mockBlockDev_, Writev(_))
+        .WillOnce(Return(-1))
+        .WillOnce(Invoke(TotalLength));
 
     ASSERT_FALSE(updater_->Sync());
+
+    // dirty pages are kept after failure
+    ASSERT_TRUE(updater_->Sync());
+}
+
+TEST_F(BlockGroupBitmapUpdaterTest, SyncTest_OnlySyncDirtyPages) {
+    // blocks covered by one bitmap page
+    const uint64_t blocksPerPage =
+        BlockGroupBitmapUpdater::kBitmapPageSize * CHAR_BIT;
+    const uint64_t pageBytes = blocksPerPage * kBlockSize;
+
+    // page 0 and page 1 are adjacent, page 3 is separated
+    updater_->Update({kBlockGroupOffset, kBlockSize},
+                     BlockGroupBitmapUpdater::Set);
+    updater_->Update({kBlockGroupOffset + pageBytes - kBlockSize,
+                      2 * kBlockSize},
+                     BlockGroupBitmapUpdater::Set);
+    updater_->Update({kBlockGroupOffset + 3 * pageBytes, kBlockSize},
+                     BlockGroupBitmapUpdater::Set);
+
+    std::vector<WritePart> parts;
+    EXPECT_CALL(*mockBlockDev_, Writev(_))
+        .WillOnce(DoAll(SaveArg<0>(&parts), Invoke(TotalLength)));
+
+    ASSERT_TRUE(updater_->Sync());
+    ASSERT_EQ(2, parts.size());
+    ASSERT_EQ(kBlockGroupOffset, parts[0].offset);
+    ASSERT_EQ(2 * BlockGroupBitmapUpdater::kBitmapPageSize, parts[0].length);
+    ASSERT_EQ(kBlockGroupOffset + 3 * BlockGroupBitmapUpdater::kBitmapPageSize,
+              parts[1].offset);
+    ASSERT_EQ(BlockGroupBitmapUpdater::kBitmapPageSize, parts[1].length);
 }
 
 }  // namespace volume
@@ -54,6 +54,11 @@ class MockBlockDeviceClient : public BlockDeviceClient {
 
     MOCK_METHOD1(Readv, ssize_t(const std::vector<ReadPart>&));
     MOCK_METHOD1(Writev, ssize_t(const std::vector<WritePart>&));
+
+    MOCK_METHOD2(AioReadv,
+                 void(const std::vector<ReadPart>&, BlockDeviceAioCallback));
+    MOCK_METHOD2(AioWritev,
+                 void(const std::vector<WritePart>&, BlockDeviceAioCallback));
 };
 
 }  // namespace volume
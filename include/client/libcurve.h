@@ -25,6 +25,7 @@
 
 #include <unistd.h>
 #include <stdint.h>
+#include <sys/uio.h>
 #include <vector>
 #include <map>
 #include <string>
@@ -185,6 +186,43 @@ int AioWrite(int fd, CurveAioContext* aioctx);
  */
 int AioDiscard(int fd, CurveAioContext* aioctx);
 
+/**
+ * @brief Asynchronous vectored read, data is scattered into iov
+ * @param fd file descriptor
+ * @param aioctx async request context, aioctx->buf is ignored and
+ *        aioctx->length must equal the total length of iov
+ * @param iov buffers to read into, the array itself is copied and can be
+ *        released after return, the buffers must live until callback
+ * @param iovcnt number of buffers
+ * @return 0 means success, otherwise it means failure
+ */
+int AioReadv(int fd, CurveAioContext* aioctx, const struct iovec* iov,
+             int iovcnt);
+
+/**
+ * @brief Asynchronous vectored write, data is gathered from iov
+ * @param fd file descriptor
+ * @param aioctx async request context, aioctx->buf is ignored and
+ *        aioctx->length must equal the total length of iov
+ * @param iov buffers to write, the array itself is copied and can be
+ *        released after return, the buffers must live until callback
+ * @param iovcnt number of buffers
+ * @return 0 means success, otherwise it means failure
+ */
+int AioWritev(int fd, CurveAioContext* aioctx, const struct iovec* iov,
+              int iovcnt);
+
+/**
+ * @brief Submit a batch of asynchronous requests at once,
+ *        the type of each request is decided by aioctx->op
+ * @param fd file descriptor
+ * @param aioctxs async request contexts
+ * @param num number of requests
+ * @return number of requests submitted, a negative error code if none
+ *         is submitted
+ */
+int AioSubmit(int fd, CurveAioContext* aioctxs[], int num);
+
 /**
  * 重命名文件
  * @param: userinfo是用户信息
@@ -463,6 +501,40 @@ class CurveClient {
      */
     virtual int AioDiscard(int fd, CurveAioContext* aioctx);
 
+    /**
+     * @brief Async vectored read
+     * @param fd file descriptor
+     * @param aioctx async request context, aioctx->buf is ignored
+     * @param iov buffers to read into
+     * @param iovcnt number of buffers
+     * @return return error code, 0(LIBCURVE_ERROR::OK) means success
+     */
+    virtual int AioReadv(int fd, CurveAioContext* aioctx,
+                         const struct iovec* iov, int iovcnt);
+
+    /**
+     * @brief Async vectored write
+     * @param fd file descriptor
+     * @param aioctx async request context, aioctx->buf is ignored
+     * @param iov buffers to write
+     * @param iovcnt number of buffers
+     * @return return error code, 0(LIBCURVE_ERROR::OK) means success
+     */
+    virtual int AioWritev(int fd, CurveAioContext* aioctx,
+                          const struct iovec* iov, int iovcnt);
+
+    /**
+     * @brief Submit a batch of async requests
+     * @param fd file descriptor
+     * @param aioctxs async request contexts
+     * @param num number of requests
+     * @param dataType type of user buffer of read and write requests
+     * @return number of requests submitted, a negative error code if none
+     *         is submitted
+     */
+    virtual int AioSubmit(int fd, CurveAioContext* aioctxs[], int num,
+                          UserDataType dataType);
+
     /**
      * 测试使用，设置fileclient
      * @param client 需要设置的fileclient
@@ -145,6 +145,73 @@ void ChunkServiceImpl::WriteChunk(RpcController *controller,
     req->Process();
 }
 
+void ChunkServiceImpl::WriteChunkBatch(RpcController *controller,
+                                       const ChunkRequest *request,
+                                       ChunkResponse *response,
+                                       Closure *done) {
+    ChunkServiceClosure* closure =
+        new (std::nothrow) ChunkServiceClosure(inflightThrottle_,
+                                               request,
+                                               response,
+                                               done);
+    CHECK(nullptr != closure) << "new chunk service closure failed";
+
+    brpc::ClosureGuard doneGuard(closure);
+
+    if (inflightThrottle_->IsOverLoad()) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD);
+        LOG_EVERY_N(WARNING, 100)
+            << "WriteChunkBatch: "
+            << "too many inflight requests to process in chunkserver";
+        return;
+    }
+
+    brpc::Controller *cntl = dynamic_cast<brpc::Controller *>(controller);
+
+    // 判断request参数是否合法, 所有子请求都必须是同一copyset上的写请求
+    uint64_t totalSize = 0;
+    bool valid = request->optype() == CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH &&
+                 request->subrequests_size() > 0;
+    for (int i = 0; valid && i < request->subrequests_size(); ++i) {
+        const ChunkRequest& sub = request->subrequests(i);
+        valid = sub.optype() == CHUNK_OP_TYPE::CHUNK_OP_WRITE &&
+                sub.logicpoolid() == request->logicpoolid() &&
+                sub.copysetid() == request->copysetid() &&
+                CheckRequestOffsetAndLength(sub.offset(), sub.size());
+        totalSize += sub.size();
+    }
+    if (!valid || totalSize != request->size() ||
+        totalSize != cntl->request_attachment().size()) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_INVALID_REQUEST);
+        LOG(WARNING) << "write chunk batch failed, invalid request: "
+                     << request->logicpoolid() << ","
+                     << request->copysetid()
+                     << ", sub request num: " << request->subrequests_size()
+                     << ", size: " << request->size()
+                     << ", attachment size: "
+                     << cntl->request_attachment().size();
+        return;
+    }
+
+    // 判断copyset是否存在
+    auto nodePtr = copysetNodeManager_->GetCopysetNode(request->logicpoolid(),
+                                                       request->copysetid());
+    if (nullptr == nodePtr) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_COPYSET_NOTEXIST);
+        LOG(WARNING) << "write chunk batch failed, copyset node is not found:"
+                     << request->logicpoolid() << "," << request->copysetid();
+        return;
+    }
+
+    std::shared_ptr<BatchWriteChunkRequest>
+        req = std::make_shared<BatchWriteChunkRequest>(nodePtr,
+                                                       controller,
+                                                       request,
+                                                       response,
+                                                       doneGuard.release());
+    req->Process();
+}
+
 void ChunkServiceImpl::CreateCloneChunk(RpcController *controller,
                                         const ChunkRequest *request,
                                         ChunkResponse *response,
@@ -58,6 +58,11 @@ class ChunkServiceImpl : public ChunkService {
                     ChunkResponse *response,
                     Closure *done);
 
+    void WriteChunkBatch(RpcController *controller,
+                         const ChunkRequest *request,
+                         ChunkResponse *response,
+                         Closure *done);
+
     void ReadChunkSnapshot(RpcController *controller,
                            const ChunkRequest *request,
                            ChunkResponse *response,
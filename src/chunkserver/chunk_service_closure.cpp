@@ -64,7 +64,8 @@ void ChunkServiceClosure::OnRequest() {
                               CSIOMetricType::READ_CHUNK);
             break;
         }
-        case CHUNK_OP_TYPE::CHUNK_OP_WRITE: {
+        case CHUNK_OP_TYPE::CHUNK_OP_WRITE:
+        case CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH: {
             metric->OnRequest(request_->logicpoolid(),
                               request_->copysetid(),
                               CSIOMetricType::WRITE_CHUNK);
@@ -113,7 +114,8 @@ void ChunkServiceClosure::OnResonse() {
                                hasError);
             break;
         }
-        case CHUNK_OP_TYPE::CHUNK_OP_WRITE: {
+        case CHUNK_OP_TYPE::CHUNK_OP_WRITE:
+        case CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH: {
             hasError = response_->status()
                        != CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS;
             metric->OnResponse(request_->logicpoolid(),
@@ -171,6 +171,7 @@ int ChunkServer::Run(int argc, char** argv) {
     // 远端拷贝管理模块选项
     CopyerOptions copyerOptions;
     InitCopyerOptions(&conf, &copyerOptions);
+    copyerOptions.localFs = fs;
     auto copyer = std::make_shared<OriginCopyer>();
     LOG_IF(FATAL, copyer->Init(copyerOptions) != 0)
         << "Failed to initialize clone copyer.";
@@ -589,6 +590,10 @@ void ChunkServer::InitCopysetNodeOptions(
         LOG_IF(FATAL, !conf->GetUInt32Value("copyset.check_syncing_interval_ms",
             &copysetNodeOptions->checkSyncingIntervalMs));
     }
+    LOG_IF(WARNING, !conf->GetUInt32Value("copyset.follower_read_wait_ms",
+        &copysetNodeOptions->followerReadWaitMs))
+        << "config no copyset.follower_read_wait_ms info, using default value "
+        << copysetNodeOptions->followerReadWaitMs;
 }
 
 void ChunkServer::InitCopyerOptions(
@@ -610,6 +615,32 @@ void ChunkServer::InitCopyerOptions(
     LOG_IF(FATAL, !conf->GetUInt64Value("curve.curve_file_timeout_s",
         &copyerOptions->curveFileTimeoutSec));
 
+    CloneSourceCacheOptions* cacheOptions = &copyerOptions->sourceCacheOptions;
+    LOG_IF(WARNING, !conf->GetBoolValue("clone.source_cache.enable",
+        &cacheOptions->enable))
+        << "config no clone.source_cache.enable info, using default value "
+        << cacheOptions->enable;
+    LOG_IF(WARNING, !conf->GetUInt32Value("clone.source_cache.block_size",
+        &cacheOptions->blockSize))
+        << "config no clone.source_cache.block_size info, using default value "
+        << cacheOptions->blockSize;
+    LOG_IF(WARNING, !conf->GetUInt64Value(
+        "clone.source_cache.memory_capacity_mb",
+        &cacheOptions->memoryCapacityMB))
+        << "config no clone.source_cache.memory_capacity_mb info, "
+        << "using default value " << cacheOptions->memoryCapacityMB;
+    LOG_IF(WARNING, !conf->GetStringValue("clone.source_cache.disk_path",
+        &cacheOptions->diskCachePath))
+        << "config no clone.source_cache.disk_path info, "
+        << "disk cache is disabled";
+    LOG_IF(WARNING, !conf->GetUInt64Value(
+        "clone.source_cache.disk_capacity_mb",
+        &cacheOptions->diskCapacityMB))
+        << "config no clone.source_cache.disk_capacity_mb info, "
+        << "using default value " << cacheOptions->diskCapacityMB;
+    LOG_IF(FATAL, cacheOptions->enable && cacheOptions->blockSize == 0)
+        << "clone.source_cache.block_size must be greater than 0";
+
     if (disableCurveClient) {
         copyerOptions->curveClient = nullptr;
     } else {
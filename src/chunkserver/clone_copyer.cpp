@@ -21,6 +21,10 @@
  */
 
 #include "src/chunkserver/clone_copyer.h"
+
+#include <cstring>
+#include <memory>
+
 #include "src/chunkserver/clone_core.h"
 #include "src/common/timeutility.h"
 
@@ -40,6 +44,44 @@ struct CurveAioCombineContext {
     CurveAioContext curveCtx;
 };
 
+/**
+ * 缓存未命中时，下载覆盖原始请求的按块对齐的数据，
+ * 下载完成后填充源端数据缓存，并将原始请求的数据拷贝给原始请求
+ */
+class SourceCacheFillClosure : public DownloadClosure {
+ public:
+    SourceCacheFillClosure(std::shared_ptr<CloneSourceCache> cache,
+                           AsyncDownloadContext* alignedCtx,
+                           DownloadClosure* done)
+        : DownloadClosure(nullptr, nullptr, alignedCtx, done)
+        , cache_(cache)
+        , origin_(done) {}
+
+    void Run() override {
+        std::unique_ptr<SourceCacheFillClosure> selfGuard(this);
+        std::unique_ptr<AsyncDownloadContext> contextGuard(downloadCtx_);
+        std::unique_ptr<char[]> bufGuard(downloadCtx_->buf);
+        brpc::ClosureGuard doneGuard(origin_);
+
+        if (isFailed_) {
+            origin_->SetFailed();
+            return;
+        }
+
+        cache_->Write(downloadCtx_->location, downloadCtx_->offset,
+                      downloadCtx_->size, downloadCtx_->buf);
+
+        AsyncDownloadContext* originCtx = origin_->GetDownloadContext();
+        memcpy(originCtx->buf,
+               downloadCtx_->buf + (originCtx->offset - downloadCtx_->offset),
+               originCtx->size);
+    }
+
+ private:
+    std::shared_ptr<CloneSourceCache> cache_;
+    DownloadClosure* origin_;
+};
+
 void CurveAioCallback(struct CurveAioContext* context) {
     auto curveCombineCtx = reinterpret_cast<CurveAioCombineContext *>(
         reinterpret_cast<char *>(context) -
@@ -106,6 +148,14 @@ int OriginCopyer::Init(const CopyerOptions& options) {
     } else {
         LOG(WARNING) << "s3 adapter is disabled.";
     }
+    if (options.sourceCacheOptions.enable) {
+        sourceCache_ = std::make_shared<CloneSourceCache>(
+            options.sourceCacheOptions, options.localFs);
+        if (sourceCache_->Init() != 0) {
+            LOG(ERROR) << "Init clone source cache failed.";
+            return -1;
+        }
+    }
     bthread::TimerThreadOptions timerOptions;
     timerOptions.bvar_prefix = "curve file lastUsedSec";
     int rc = timer_.start(&timerOptions);
@@ -138,6 +188,15 @@ int OriginCopyer::Fini() {
 }
 
 void OriginCopyer::DownloadAsync(DownloadClosure* done) {
+    if (sourceCache_ != nullptr) {
+        DownloadClosure* downloadDone = nullptr;
+        if (ReadFromSourceCache(done, &downloadDone)) {
+            brpc::ClosureGuard doneGuard(done);
+            return;
+        }
+        done = downloadDone;
+    }
+
     brpc::ClosureGuard doneGuard(done);
     AsyncDownloadContext* context = done->GetDownloadContext();
     std::string originPath;
@@ -170,6 +229,29 @@ void OriginCopyer::DownloadAsync(DownloadClosure* done) {
     }
 }
 
+bool OriginCopyer::ReadFromSourceCache(DownloadClosure* done,
+                                       DownloadClosure** downloadDone) {
+    AsyncDownloadContext* context = done->GetDownloadContext();
+    if (sourceCache_->Read(context->location, context->offset,
+                           context->size, context->buf)) {
+        return true;
+    }
+
+    const uint64_t blockSize = sourceCache_->GetBlockSize();
+    const uint64_t start = context->offset / blockSize * blockSize;
+    const uint64_t end =
+        (context->offset + context->size + blockSize - 1) / blockSize *
+        blockSize;
+
+    AsyncDownloadContext* alignedCtx = new AsyncDownloadContext();
+    alignedCtx->location = context->location;
+    alignedCtx->offset = start;
+    alignedCtx->size = end - start;
+    alignedCtx->buf = new char[alignedCtx->size];
+    *downloadDone = new SourceCacheFillClosure(sourceCache_, alignedCtx, done);
+    return false;
+}
+
 void OriginCopyer::DownloadFromS3(const string& objectName,
                                  off_t off,
                                  size_t size,
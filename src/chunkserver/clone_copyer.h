@@ -30,6 +30,7 @@
 #include <list>
 
 #include "include/chunkserver/chunkserver_common.h"
+#include "src/chunkserver/clone_source_cache.h"
 #include "src/common/location_operator.h"
 #include "src/client/config_info.h"
 #include "src/client/libcurve_file.h"
@@ -64,6 +65,10 @@ struct CopyerOptions {
     std::shared_ptr<S3Adapter> s3Client;
     // curve file's time to live
     uint64_t curveFileTimeoutSec;
+    // 源端数据缓存的配置
+    CloneSourceCacheOptions sourceCacheOptions;
+    // 源端数据磁盘缓存使用的本地文件系统
+    std::shared_ptr<LocalFileSystem> localFs;
 };
 
 struct AsyncDownloadContext {
@@ -130,6 +135,15 @@ class OriginCopyer {
                           DownloadClosure* done);
     static void DeleteExpiredCurveCache(void* arg);
 
+    /**
+     * 从源端数据缓存中读取，并为缓存未命中的请求生成下载对齐数据的closure
+     * @param done: 原始的下载请求
+     * @param[out] downloadDone: 实际下载使用的closure
+     * @return: 缓存命中返回true，此时数据已拷贝到done的缓冲区中
+     */
+    bool ReadFromSourceCache(DownloadClosure* done,
+                             DownloadClosure** downloadDone);
+
  private:
     // curvefs上的root用户信息
     UserInfo curveUser_;
@@ -151,6 +165,8 @@ class OriginCopyer {
     bthread::TimerThread timer_;
     // timer's task id
     bthread::TimerThread::TaskId timerId_;
+    // 源端数据缓存，未开启时为nullptr
+    std::shared_ptr<CloneSourceCache> sourceCache_;
 };
 
 }  // namespace chunkserver
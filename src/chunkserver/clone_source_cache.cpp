@@ -0,0 +1,241 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#include "src/chunkserver/clone_source_cache.h"
+
+#include <fcntl.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace curve {
+namespace chunkserver {
+
+namespace {
+
+// the memory cache is accessed by all clone threads and download callbacks
+const uint32_t kMemoryCacheShardBits = 4;
+
+const uint64_t kMiB = 1024ull * 1024;
+
+}  // namespace
+
+CloneSourceCache::CloneSourceCache(const CloneSourceCacheOptions& options,
+                                   std::shared_ptr<LocalFileSystem> fs)
+    : blockSize_(options.blockSize),
+      diskCachePath_(options.diskCachePath),
+      fs_(fs),
+      memoryMetrics_(
+          std::make_shared<CacheMetrics>("clone_source_cache_memory")),
+      memoryCache_(new MemoryCache(kMemoryCacheShardBits, 0,
+                                   options.memoryCapacityMB * kMiB,
+                                   memoryMetrics_)),
+      diskMetrics_(std::make_shared<CacheMetrics>("clone_source_cache_disk")) {
+    CHECK(blockSize_ > 0) << "clone source cache block size must be positive";
+    if (!diskCachePath_.empty()) {
+        uint64_t maxCount =
+            std::max<uint64_t>(1, options.diskCapacityMB * kMiB / blockSize_);
+        diskCache_.reset(new DiskCache(maxCount, diskMetrics_));
+    }
+}
+
+int CloneSourceCache::Init() {
+    if (diskCache_ == nullptr) {
+        return 0;
+    }
+
+    if (!fs_->DirExists(diskCachePath_)) {
+        int ret = fs_->Mkdir(diskCachePath_);
+        if (ret != 0) {
+            LOG(ERROR) << "Failed to create clone source cache dir: "
+                       << diskCachePath_ << ", ret: " << ret;
+            return -1;
+        }
+        return 0;
+    }
+
+    // the index of the disk cache is not persisted, drop the stale blocks
+    std::vector<std::string> names;
+    int ret = fs_->List(diskCachePath_, &names);
+    if (ret != 0) {
+        LOG(ERROR) << "Failed to list clone source cache dir: "
+                   << diskCachePath_ << ", ret: " << ret;
+        return -1;
+    }
+    for (const auto& name : names) {
+        fs_->Delete(diskCachePath_ + "/" + name);
+    }
+    LOG(INFO) << "Removed " << names.size()
+              << " stale blocks from clone source cache dir: "
+              << diskCachePath_;
+    return 0;
+}
+
+bool CloneSourceCache::Read(const std::string& location, off_t offset,
+                            size_t size, char* buf) {
+    if (size == 0) {
+        return false;
+    }
+
+    const uint64_t first = offset / blockSize_;
+    const uint64_t last = (offset + size - 1) / blockSize_;
+
+    std::vector<BlockPtr> blocks;
+    blocks.reserve(last - first + 1);
+    for (uint64_t index = first; index <= last; ++index) {
+        BlockPtr block = GetBlock(BlockKey(location, index));
+        if (block == nullptr) {
+            return false;
+        }
+        blocks.emplace_back(std::move(block));
+    }
+
+    uint64_t pos = offset;
+    const uint64_t end = offset + size;
+    for (uint64_t index = first; index <= last; ++index) {
+        uint64_t blockStart = index * blockSize_;
+        uint64_t inBlock = pos - blockStart;
+        uint64_t length = std::min<uint64_t>(blockSize_ - inBlock, end - pos);
+        memcpy(buf + (pos - offset),
+               blocks[index - first]->data() + inBlock, length);
+        pos += length;
+    }
+    return true;
+}
+
+void CloneSourceCache::Write(const std::string& location, off_t offset,
+                             size_t size, const char* buf) {
+    if (offset % blockSize_ != 0 || size % blockSize_ != 0) {
+        LOG(WARNING) << "Unaligned clone source data is not cached"
+                     << ", location: " << location
+                     << ", offset: " << offset << ", size: " << size;
+        return;
+    }
+
+    const uint64_t first = offset / blockSize_;
+    for (uint64_t i = 0; i < size / blockSize_; ++i) {
+        std::string key = BlockKey(location, first + i);
+        auto block = std::make_shared<const std::string>(
+            buf + i * blockSize_, blockSize_);
+        memoryCache_->Put(key, block);
+        if (diskCache_ != nullptr) {
+            WriteToDisk(key, *block);
+        }
+    }
+}
+
+std::string CloneSourceCache::BlockKey(const std::string& location,
+                                       uint64_t index) {
+    return location + ":" + std::to_string(index);
+}
+
+CloneSourceCache::BlockPtr CloneSourceCache::GetBlock(
+    const std::string& key) {
+    BlockPtr block;
+    if (memoryCache_->Get(key, &block)) {
+        return block;
+    }
+
+    if (diskCache_ == nullptr) {
+        return nullptr;
+    }
+
+    block = ReadFromDisk(key);
+    if (block != nullptr) {
+        memoryCache_->Put(key, block);
+    }
+    return block;
+}
+
+// layout of a block file: key length (uint32_t) | key | block data
+CloneSourceCache::BlockPtr CloneSourceCache::ReadFromDisk(
+    const std::string& key) {
+    std::string path;
+    if (!diskCache_->Get(key, &path)) {
+        return nullptr;
+    }
+
+    int fd = fs_->Open(path, O_RDONLY);
+    if (fd < 0) {
+        diskCache_->Remove(key);
+        return nullptr;
+    }
+
+    const size_t headerSize = sizeof(uint32_t) + key.size();
+    std::string content(headerSize + blockSize_, '\0');
+    int ret = fs_->Read(fd, &content[0], 0, content.size());
+    fs_->Close(fd);
+
+    uint32_t keyLength = 0;
+    memcpy(&keyLength, content.data(), sizeof(keyLength));
+    // the file may be overwritten by another block with the same file name
+    if (ret != static_cast<int>(content.size()) ||
+        keyLength != key.size() ||
+        content.compare(sizeof(uint32_t), keyLength, key) != 0) {
+        diskCache_->Remove(key);
+        return nullptr;
+    }
+
+    return std::make_shared<const std::string>(content, headerSize);
+}
+
+void CloneSourceCache::WriteToDisk(const std::string& key,
+                                   const std::string& block) {
+    char name[32];
+    snprintf(name, sizeof(name), "%016zx", std::hash<std::string>()(key));
+    std::string path = diskCachePath_ + "/" + name;
+
+    uint32_t keyLength = key.size();
+    std::string content;
+    content.reserve(sizeof(keyLength) + key.size() + block.size());
+    content.append(reinterpret_cast<const char*>(&keyLength),
+                   sizeof(keyLength));
+    content.append(key);
+    content.append(block);
+
+    int fd = fs_->Open(path, O_WRONLY | O_CREAT | O_TRUNC);
+    if (fd < 0) {
+        LOG(WARNING) << "Failed to open clone source cache file: " << path
+                     << ", ret: " << fd;
+        return;
+    }
+    int ret = fs_->Write(fd, content.data(), 0, content.size());
+    fs_->Close(fd);
+    if (ret != static_cast<int>(content.size())) {
+        LOG(WARNING) << "Failed to write clone source cache file: " << path
+                     << ", ret: " << ret;
+        fs_->Delete(path);
+        return;
+    }
+
+    std::string eliminated;
+    if (diskCache_->Put(key, path, &eliminated) && eliminated != path) {
+        fs_->Delete(eliminated);
+    }
+}
+
+}  // namespace chunkserver
+}  // namespace curve
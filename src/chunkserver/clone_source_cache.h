@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#ifndef SRC_CHUNKSERVER_CLONE_SOURCE_CACHE_H_
+#define SRC_CHUNKSERVER_CLONE_SOURCE_CACHE_H_
+
+#include <sys/types.h>
+
+#include <memory>
+#include <string>
+
+#include "src/common/lru_cache.h"
+#include "src/fs/local_filesystem.h"
+
+namespace curve {
+namespace chunkserver {
+
+using curve::common::CacheMetrics;
+using curve::fs::LocalFileSystem;
+
+struct CloneSourceCacheOptions {
+    // 是否开启源端数据缓存
+    bool enable = false;
+    // 缓存块的大小，需要能整除chunk的大小
+    uint32_t blockSize = 64 * 1024;
+    // 内存缓存的容量
+    uint64_t memoryCapacityMB = 512;
+    // 本地磁盘缓存的目录，为空时不使用磁盘缓存
+    std::string diskCachePath;
+    // 本地磁盘缓存的容量
+    uint64_t diskCapacityMB = 10240;
+};
+
+/**
+ * CloneSourceCache caches data of clone sources (s3 objects and curve
+ * files) on the chunkserver, so that lazily cloned chunks which share the
+ * same source don't download the same data again and again.
+ *
+ * Data is cached in blocks of blockSize bytes keyed by the source location
+ * and the block index. Blocks are kept in a sharded in-memory LRU cache and,
+ * when a disk cache path is configured, also written to local files managed
+ * by a second LRU. A block found only on disk is promoted to memory.
+ *
+ * Clone sources are read only, so cached blocks never need invalidation.
+ */
+class CloneSourceCache {
+ public:
+    /**
+     * @param options cache options
+     * @param fs local filesystem used by the disk tier
+     */
+    CloneSourceCache(const CloneSourceCacheOptions& options,
+                     std::shared_ptr<LocalFileSystem> fs);
+
+    /**
+     * @brief Prepare the disk cache directory, stale files left by the
+     *        previous run are removed
+     * @return 0 on success, -1 on failure
+     */
+    int Init();
+
+    uint32_t GetBlockSize() const {
+        return blockSize_;
+    }
+
+    /**
+     * @brief Read a range of the source from the cache
+     * @param location location of the source
+     * @param offset offset in the source
+     * @param size length to read
+     * @param[out] buf buffer of at least size bytes
+     * @return true if all blocks of the range are cached, otherwise false
+     */
+    bool Read(const std::string& location, off_t offset, size_t size,
+              char* buf);
+
+    /**
+     * @brief Put data downloaded from the source into the cache
+     * @param location location of the source
+     * @param offset offset in the source, aligned to blockSize
+     * @param size length of the data, aligned to blockSize
+     * @param buf the data
+     */
+    void Write(const std::string& location, off_t offset, size_t size,
+               const char* buf);
+
+    std::shared_ptr<CacheMetrics> GetMemoryCacheMetrics() const {
+        return memoryMetrics_;
+    }
+
+    std::shared_ptr<CacheMetrics> GetDiskCacheMetrics() const {
+        return diskMetrics_;
+    }
+
+ private:
+    using BlockPtr = std::shared_ptr<const std::string>;
+
+    struct BlockTraits {
+        static uint64_t CountBytes(const BlockPtr& block) {
+            return block->size();
+        }
+    };
+
+    using MemoryCache = curve::common::ShardedLRUCache<
+        std::string, BlockPtr, curve::common::CacheTraits<std::string>,
+        BlockTraits>;
+
+    // key -> path of the file which holds the block
+    using DiskCache = curve::common::LRUCache<std::string, std::string>;
+
+    static std::string BlockKey(const std::string& location, uint64_t index);
+
+    BlockPtr GetBlock(const std::string& key);
+
+    BlockPtr ReadFromDisk(const std::string& key);
+
+    void WriteToDisk(const std::string& key, const std::string& block);
+
+ private:
+    const uint32_t blockSize_;
+    const std::string diskCachePath_;
+
+    std::shared_ptr<LocalFileSystem> fs_;
+
+    std::shared_ptr<CacheMetrics> memoryMetrics_;
+    std::unique_ptr<MemoryCache> memoryCache_;
+
+    std::shared_ptr<CacheMetrics> diskMetrics_;
+    // nullptr if the disk tier is disabled
+    std::unique_ptr<DiskCache> diskCache_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_CLONE_SOURCE_CACHE_H_
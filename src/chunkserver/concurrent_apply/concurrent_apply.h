@@ -82,8 +82,21 @@ class CURVE_CACHELINE_ALIGNMENT ConcurrentApplyModule {
      */
     template<class F, class... Args>
     bool Push(uint64_t key, CHUNK_OP_TYPE optype, F&& f, Args&&... args) {
+        return Push(key, Schedule(optype),
+                    std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    /**
+     * Push: apply task will be push to specified thread pool
+     * @param[in] key: used to hash task to specified queue
+     * @param[in] type: thread pool which the task will be pushed to
+     * @param[in] f: task
+     * @param[in] args: param to excute task
+     */
+    template<class F, class... Args>
+    bool Push(uint64_t key, ThreadPoolType type, F&& f, Args&&... args) {
         auto task = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
-        switch (Schedule(optype)) {
+        switch (type) {
             case ThreadPoolType::READ:
                 rapplyMap_[Hash(key, rconcurrentsize_)]->tq.Push(task);
                 break;
@@ -127,6 +127,9 @@ struct CopysetNodeOptions {
     uint32_t syncTimerIntervalMs = 30000u;
     // check syncing interval
     uint32_t checkSyncingIntervalMs = 500u;
+    // follower读时等待本地applied index追上请求的最长时间, 超时则重定向到leader,
+    // 0表示不等待
+    uint32_t followerReadWaitMs = 0u;
 
     CopysetNodeOptions();
 };
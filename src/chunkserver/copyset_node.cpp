@@ -25,9 +25,11 @@
 #include <glog/logging.h>
 #include <brpc/controller.h>
 #include <butil/sys_byteorder.h>
+#include <butil/time.h>
 #include <braft/closure_helper.h>
 #include <braft/snapshot.h>
 #include <braft/protobuf_file.h>
+#include <bthread/bthread.h>
 #include <utility>
 #include <memory>
 #include <algorithm>
@@ -67,6 +69,7 @@ CopysetNode::CopysetNode(const LogicPoolID &logicPoolId,
     chunkDataApath_(),
     chunkDataRpath_(),
     appliedIndex_(0),
+    appliedIndexWaiters_(0),
     leaderTerm_(-1),
     scaning_(false),
     lastScanSec_(0),
@@ -75,7 +78,8 @@ CopysetNode::CopysetNode(const LogicPoolID &logicPoolId,
     enableOdsyncWhenOpenChunkFile_(false),
     syncTimerIntervalMs_(30000),
     isSyncing_(false),
-    checkSyncingIntervalMs_(500) {
+    checkSyncingIntervalMs_(500),
+    followerReadWaitMs_(0) {
 }
 
 CopysetNode::~CopysetNode() {
@@ -182,6 +186,7 @@ int CopysetNode::Init(const CopysetNodeOptions &options) {
 
     syncTimerIntervalMs_ = options.syncTimerIntervalMs;
     checkSyncingIntervalMs_ = options.checkSyncingIntervalMs;
+    followerReadWaitMs_ = options.followerReadWaitMs;
     enableOdsyncWhenOpenChunkFile_ = options.enableOdsyncWhenOpenChunkFile;
 
     return 0;
@@ -282,6 +287,11 @@ void CopysetNode::on_apply(::braft::Iterator &iter) {
             CHECK(nullptr != chunkClosure)
                 << "ChunkClosure dynamic cast failed";
             std::shared_ptr<ChunkOpRequest> opRequest = chunkClosure->request_;
+            if (CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH == opRequest->OpType()) {
+                // 批量写在apply线程里把子请求按chunk分发到并发层
+                opRequest->OnApply(iter.index(), doneGuard.release());
+                continue;
+            }
             auto task = std::bind(&ChunkOpRequest::OnApply,
                                   opRequest,
                                   iter.index(),
@@ -301,17 +311,57 @@ void CopysetNode::on_apply(::braft::Iterator &iter) {
             butil::IOBuf data;
             auto opReq = ChunkOpRequest::Decode(log, &request, &data,
                                                 iter.index(), GetLeaderId());
+            if (CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH == request.optype()) {
+                ApplyWriteBatchFromLog(request, data, iter.index());
+                continue;
+            }
             auto chunkId = request.chunkid();
-            auto task = std::bind(&ChunkOpRequest::OnApplyFromLog,
+            auto optype = request.optype();
+            auto task = std::bind(&CopysetNode::ApplyFromLog,
+                                  this,
                                   opReq,
-                                  dataStore_,
                                   std::move(request),
-                                  data);
-            concurrentapply_->Push(chunkId, request.optype(), task);
+                                  data,
+                                  iter.index());
+            concurrentapply_->Push(chunkId, optype, task);
         }
     }
 }
 
+void CopysetNode::ApplyWriteBatchFromLog(const ChunkRequest &request,
+                                         const butil::IOBuf &data,
+                                         uint64_t index) {
+    std::vector<butil::IOBuf> datas;
+    CHECK_EQ(0, BatchWriteChunkRequest::Split(request, data, &datas))
+        << "split write batch failed, " << GroupIdString();
+
+    // 每个子请求和单个写请求一样放到对应chunk的队列中, 保证同一chunk上op的顺序,
+    // 所有子请求都apply之后才更新applied index
+    auto pending = std::make_shared<std::atomic<int>>(
+        request.subrequests_size());
+    for (int i = 0; i < request.subrequests_size(); ++i) {
+        const ChunkRequest &subRequest = request.subrequests(i);
+        auto opReq = std::make_shared<WriteChunkRequest>();
+        butil::IOBuf subData = datas[i];
+        auto task = [this, opReq, subRequest, subData, pending, index]() {
+            opReq->OnApplyFromLog(dataStore_, subRequest, subData);
+            if (pending->fetch_sub(1) == 1) {
+                UpdateAppliedIndex(index);
+            }
+        };
+        concurrentapply_->Push(subRequest.chunkid(), subRequest.optype(),
+                               task);
+    }
+}
+
+void CopysetNode::ApplyFromLog(std::shared_ptr<ChunkOpRequest> opReq,
+                               const ChunkRequest &request,
+                               const butil::IOBuf &data,
+                               uint64_t index) {
+    opReq->OnApplyFromLog(dataStore_, request, data);
+    UpdateAppliedIndex(index);
+}
+
 void CopysetNode::on_shutdown() {
     LOG(INFO) << GroupIdString() << " is shutdown";
 }
@@ -803,6 +853,12 @@ void CopysetNode::UpdateAppliedIndex(uint64_t index) {
                 break;
             }
         }
+        // 唤醒等待applied index的follower读
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (appliedIndexWaiters_.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<bthread::Mutex> lock(appliedIndexMutex_);
+            appliedIndexCond_.notify_all();
+        }
     }
 }
 
@@ -810,6 +866,26 @@ uint64_t CopysetNode::GetAppliedIndex() const {
     return appliedIndex_.load(std::memory_order_acquire);
 }
 
+bool CopysetNode::WaitAppliedIndex(uint64_t index, uint32_t timeoutMs) const {
+    if (GetAppliedIndex() >= index) {
+        return true;
+    }
+    const int64_t deadlineUs = butil::gettimeofday_us() + timeoutMs * 1000ll;
+    std::unique_lock<bthread::Mutex> lock(appliedIndexMutex_);
+    appliedIndexWaiters_.fetch_add(1, std::memory_order_seq_cst);
+    bool ok = true;
+    while (GetAppliedIndex() < index) {
+        int64_t remainUs = deadlineUs - butil::gettimeofday_us();
+        if (remainUs <= 0) {
+            ok = false;
+            break;
+        }
+        appliedIndexCond_.wait_for(lock, remainUs);
+    }
+    appliedIndexWaiters_.fetch_sub(1, std::memory_order_relaxed);
+    return ok;
+}
+
 std::shared_ptr<CSDataStore> CopysetNode::GetDataStore() const {
     return dataStore_;
 }
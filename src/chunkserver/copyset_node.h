@@ -25,6 +25,8 @@
 
 #include <butil/memory/ref_counted.h>
 #include <braft/repeated_timer_task.h>
+#include <bthread/condition_variable.h>
+#include <bthread/mutex.h>
 
 #include <string>
 #include <vector>
@@ -243,6 +245,21 @@ class CopysetNode : public braft::StateMachine,
      */
     virtual uint64_t GetAppliedIndex() const;
 
+    /**
+     * 等待applied index追上指定的index, 用于follower读
+     * @param index: 需要达到的applied index
+     * @param timeoutMs: 最长等待时间
+     * @return 在超时前applied index不小于index返回true, 否则返回false
+     */
+    virtual bool WaitAppliedIndex(uint64_t index, uint32_t timeoutMs) const;
+
+    /**
+     * 返回follower读时等待applied index的最长时间
+     */
+    uint32_t GetFollowerReadWaitMs() const {
+        return followerReadWaitMs_;
+    }
+
     /**
      * @brief: 查询配置变更的状态
      * @param type[out]: 配置变更类型
@@ -446,6 +463,28 @@ class CopysetNode : public braft::StateMachine,
         return ToGroupIdString(logicPoolId_, copysetId_);
     }
 
+    /**
+     * 回放或者follower apply批量写日志, 子请求按chunk放入并发层
+     * @param request: 反序列化后的批量写请求
+     * @param data: 批量写请求的数据
+     */
+    void ApplyWriteBatchFromLog(const ChunkRequest &request,
+                                const butil::IOBuf &data,
+                                uint64_t index);
+
+    /**
+     * 回放或者follower apply一条日志, 完成后更新applied index,
+     * 使follower上的applied index也能反映已经apply的日志
+     * @param opReq: 日志对应的op
+     * @param request: 反序列化后的请求
+     * @param data: 请求的数据
+     * @param index: 日志的index
+     */
+    void ApplyFromLog(std::shared_ptr<ChunkOpRequest> opReq,
+                      const ChunkRequest &request,
+                      const butil::IOBuf &data,
+                      uint64_t index);
+
  private:
     // 逻辑池 id
     LogicPoolID logicPoolId_;
@@ -481,6 +520,10 @@ class CopysetNode : public braft::StateMachine,
     std::unique_ptr<ConfEpochFile> epochFile_;
     // 复制组的apply index
     std::atomic<uint64_t> appliedIndex_;
+    // follower读等待applied index时使用
+    mutable bthread::Mutex appliedIndexMutex_;
+    mutable bthread::ConditionVariable appliedIndexCond_;
+    mutable std::atomic<int> appliedIndexWaiters_;
     // 复制组当前任期，如果<=0表明不是leader
     std::atomic<int64_t> leaderTerm_;
     // 复制组数据回收站目录
@@ -513,6 +556,8 @@ class CopysetNode : public braft::StateMachine,
     std::atomic<bool> isSyncing_;
     // do snapshot check syncing interval
     uint32_t checkSyncingIntervalMs_;
+    // follower读时等待applied index的最长时间
+    uint32_t followerReadWaitMs_;
     // async snapshot future object
     std::future<void> snapshotFuture_;
 };
@@ -156,6 +156,8 @@ std::shared_ptr<ChunkOpRequest> ChunkOpRequest::Decode(butil::IOBuf log,
             return std::make_shared<ReadChunkRequest>();
         case CHUNK_OP_TYPE::CHUNK_OP_WRITE:
             return std::make_shared<WriteChunkRequest>();
+        case CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH:
+            return std::make_shared<BatchWriteChunkRequest>();
         case CHUNK_OP_TYPE::CHUNK_OP_DELETE:
             return std::make_shared<DeleteChunkRequest>();
         case CHUNK_OP_TYPE::CHUNK_OP_READ_SNAP:
@@ -235,14 +237,40 @@ ReadChunkRequest::ReadChunkRequest(std::shared_ptr<CopysetNode> nodePtr,
     ChunkOpRequest(nodePtr, cntl, request, response, done),
     cloneMgr_(cloneMgr),
     concurrentApplyModule_(nodePtr->GetConcurrentApplyModule()),
-    applyIndex(0) {
+    applyIndex(0),
+    followerRead_(false) {
 }
 
 void ReadChunkRequest::Process() {
     brpc::ClosureGuard doneGuard(done_);
 
     if (!node_->IsLeaderTerm()) {
-        RedirectChunkRequest();
+        /**
+         * follower读：请求携带了applied index，并且在等待时间内本地的
+         * applied index追上了它，那么本地已经apply了client之前写下的数据,
+         * 可以和leader上携带applied index的读一样放入并发层直接读；
+         * 否则重定向到leader
+         */
+        if (!CanServeFollowerRead()) {
+            RedirectChunkRequest();
+            return;
+        }
+        followerRead_ = true;
+        auto thisPtr
+            = std::dynamic_pointer_cast<ReadChunkRequest>(shared_from_this());
+        auto task = std::bind(&ReadChunkRequest::OnApply,
+                              thisPtr,
+                              node_->GetAppliedIndex(),
+                              doneGuard.release());
+        /**
+         * follower上各条日志是按chunk并发apply的, applied index是取最大值,
+         * 追上了请求的index并不代表本chunk之前的写都已经落盘。但是on_apply
+         * 是按index顺序把日志分发到并发层的, applied index达到之后, 本chunk
+         * 上不大于该index的写一定已经在它的写队列里了, 所以把读放到同一个
+         * 写队列的后面, 保证读到client已经写成功的数据
+         */
+        concurrentApplyModule_->Push(
+            request_->chunkid(), ThreadPoolType::WRITE, task);
         return;
     }
 
@@ -325,7 +353,12 @@ void ReadChunkRequest::OnApply(uint64_t index,
                 CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN);
             break;
         }
-        // 如果需要从源端拷贝数据，需要将请求转发给clone manager处理
+        // 如果需要从源端拷贝数据，需要将请求转发给clone manager处理,
+        // follower不能写chunk, 需要拷贝数据的读请求重定向到leader
+        if ((needLazyClone || NeedClone(chunkInfo)) && followerRead_) {
+            RedirectChunkRequest();
+            break;
+        }
         if ( needLazyClone || NeedClone(chunkInfo) ) {
             applyIndex = index;
             std::shared_ptr<CloneTask> cloneTask =
@@ -366,6 +399,16 @@ void ReadChunkRequest::OnApply(uint64_t index,
     response_->set_appliedindex(maxIndex);
 }
 
+bool ReadChunkRequest::CanServeFollowerRead() const {
+    if (request_->optype() != CHUNK_OP_TYPE::CHUNK_OP_READ
+        || !request_->followerread()
+        || !request_->has_appliedindex()) {
+        return false;
+    }
+    return node_->WaitAppliedIndex(request_->appliedindex(),
+                                   node_->GetFollowerReadWaitMs());
+}
+
 void ReadChunkRequest::OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
                                       const ChunkRequest &request,
                                       const butil::IOBuf &data) {
@@ -439,60 +482,12 @@ void ReadChunkRequest::ReadChunk() {
 void WriteChunkRequest::OnApply(uint64_t index,
                                 ::google::protobuf::Closure *done) {
     brpc::ClosureGuard doneGuard(done);
-    uint32_t cost;
 
-    std::string  cloneSourceLocation;
-    if (existCloneInfo(request_)) {
-        auto func = ::curve::common::LocationOperator::GenerateCurveLocation;
-        cloneSourceLocation =  func(request_->clonefilesource(),
-                            request_->clonefileoffset());
-    }
-
-    auto ret = datastore_->WriteChunk(request_->chunkid(),
-                                      request_->sn(),
-                                      cntl_->request_attachment(),
-                                      request_->offset(),
-                                      request_->size(),
-                                      &cost,
-                                      cloneSourceLocation);
-
-    if (CSErrorCode::Success == ret) {
-        response_->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+    CHUNK_OP_STATUS status =
+        ApplyWrite(datastore_, *request_, cntl_->request_attachment());
+    response_->set_status(status);
+    if (CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS == status) {
         node_->UpdateAppliedIndex(index);
-    } else if (CSErrorCode::BackwardRequestError == ret) {
-        // 打快照那一刻是有可能出现旧版本的请求
-        // 返回错误给客户端，让客户端带新版本来重试
-        LOG(WARNING) << "write failed: "
-                     << " logic pool id: " << request_->logicpoolid()
-                     << " copyset id: " << request_->copysetid()
-                     << " chunkid: " << request_->chunkid()
-                     << " data size: " << request_->size()
-                     << " data store return: " << ret;
-        response_->set_status(
-            CHUNK_OP_STATUS::CHUNK_OP_STATUS_BACKWARD);
-    } else if (CSErrorCode::InternalError == ret ||
-               CSErrorCode::CrcCheckError == ret ||
-               CSErrorCode::FileFormatError == ret) {
-        /**
-         * internalerror一般是磁盘错误,为了防止副本不一致,让进程退出
-         * TODO(yyk): 当前遇到write错误直接fatal退出整个
-         * ChunkServer后期考虑仅仅标坏这个copyset，保证较好的可用性
-        */
-        LOG(FATAL) << "write failed: "
-                   << " logic pool id: " << request_->logicpoolid()
-                   << " copyset id: " << request_->copysetid()
-                   << " chunkid: " << request_->chunkid()
-                   << " data size: " << request_->size()
-                   << " data store return: " << ret;
-    } else {
-        LOG(ERROR) << "write failed: "
-                   << " logic pool id: " << request_->logicpoolid()
-                   << " copyset id: " << request_->copysetid()
-                   << " chunkid: " << request_->chunkid()
-                   << " data size: " << request_->size()
-                   << " data store return: " << ret;
-        response_->set_status(
-            CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN);
     }
     auto maxIndex =
         (index > node_->GetAppliedIndex() ? index : node_->GetAppliedIndex());
@@ -504,15 +499,21 @@ void WriteChunkRequest::OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
                                        const ChunkRequest &request,
                                        const butil::IOBuf &data) {
     // NOTE: 处理过程中优先使用参数传入的datastore/request
+    ApplyWrite(datastore, request, data);
+}
+
+CHUNK_OP_STATUS WriteChunkRequest::ApplyWrite(
+    std::shared_ptr<CSDataStore> datastore,
+    const ChunkRequest &request,
+    const butil::IOBuf &data) {
     uint32_t cost;
-    std::string  cloneSourceLocation;
+    std::string cloneSourceLocation;
     if (existCloneInfo(&request)) {
         auto func = ::curve::common::LocationOperator::GenerateCurveLocation;
-        cloneSourceLocation =  func(request.clonefilesource(),
-                            request.clonefileoffset());
+        cloneSourceLocation = func(request.clonefilesource(),
+                                   request.clonefileoffset());
     }
 
-
     auto ret = datastore->WriteChunk(request.chunkid(),
                                      request.sn(),
                                      data,
@@ -520,18 +521,26 @@ void WriteChunkRequest::OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
                                      request.size(),
                                      &cost,
                                      cloneSourceLocation);
-     if (CSErrorCode::Success == ret) {
-         return;
-     } else if (CSErrorCode::BackwardRequestError == ret) {
+    if (CSErrorCode::Success == ret) {
+        return CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS;
+    } else if (CSErrorCode::BackwardRequestError == ret) {
+        // 打快照那一刻是有可能出现旧版本的请求
+        // 返回错误给客户端，让客户端带新版本来重试
         LOG(WARNING) << "write failed: "
                      << " logic pool id: " << request.logicpoolid()
                      << " copyset id: " << request.copysetid()
                      << " chunkid: " << request.chunkid()
                      << " data size: " << request.size()
                      << " data store return: " << ret;
+        return CHUNK_OP_STATUS::CHUNK_OP_STATUS_BACKWARD;
     } else if (CSErrorCode::InternalError == ret ||
                CSErrorCode::CrcCheckError == ret ||
                CSErrorCode::FileFormatError == ret) {
+        /**
+         * internalerror一般是磁盘错误,为了防止副本不一致,让进程退出
+         * TODO(yyk): 当前遇到write错误直接fatal退出整个
+         * ChunkServer后期考虑仅仅标坏这个copyset，保证较好的可用性
+        */
         LOG(FATAL) << "write failed: "
                    << " logic pool id: " << request.logicpoolid()
                    << " copyset id: " << request.copysetid()
@@ -546,6 +555,115 @@ void WriteChunkRequest::OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
                    << " data size: " << request.size()
                    << " data store return: " << ret;
     }
+    return CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN;
+}
+
+BatchWriteChunkRequest::BatchWriteChunkRequest(
+    std::shared_ptr<CopysetNode> nodePtr,
+    RpcController *cntl,
+    const ChunkRequest *request,
+    ChunkResponse *response,
+    ::google::protobuf::Closure *done) :
+    ChunkOpRequest(nodePtr, cntl, request, response, done),
+    concurrentApplyModule_(nodePtr->GetConcurrentApplyModule()),
+    applyIndex_(0),
+    applyDone_(nullptr),
+    pending_(0) {
+}
+
+void BatchWriteChunkRequest::OnApply(uint64_t index,
+                                     ::google::protobuf::Closure *done) {
+    std::vector<butil::IOBuf> datas;
+    // chunk service在propose之前已经检查过数据长度
+    CHECK_EQ(0, Split(*request_, cntl_->request_attachment(), &datas))
+        << "split write batch failed: "
+        << " logic pool id: " << request_->logicpoolid()
+        << " copyset id: " << request_->copysetid();
+
+    applyIndex_ = index;
+    applyDone_ = done;
+    // 先准备好所有子请求的response, 子请求并发执行时只修改各自的response
+    response_->clear_subresponses();
+    for (int i = 0; i < request_->subrequests_size(); ++i) {
+        response_->add_subresponses();
+    }
+    pending_.store(request_->subrequests_size(), std::memory_order_release);
+
+    auto thisPtr =
+        std::dynamic_pointer_cast<BatchWriteChunkRequest>(shared_from_this());
+    for (int i = 0; i < request_->subrequests_size(); ++i) {
+        concurrentApplyModule_->Push(request_->subrequests(i).chunkid(),
+                                     CHUNK_OP_TYPE::CHUNK_OP_WRITE,
+                                     &BatchWriteChunkRequest::ApplySubWrite,
+                                     thisPtr, i, datas[i]);
+    }
+}
+
+void BatchWriteChunkRequest::ApplySubWrite(int subIndex,
+                                           const butil::IOBuf &data) {
+    const ChunkRequest &subRequest = request_->subrequests(subIndex);
+    response_->mutable_subresponses(subIndex)->set_status(
+        WriteChunkRequest::ApplyWrite(datastore_, subRequest, data));
+    node_->ShipToSync(subRequest.chunkid());
+
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        OnSubWritesDone();
+    }
+}
+
+void BatchWriteChunkRequest::OnSubWritesDone() {
+    brpc::ClosureGuard doneGuard(applyDone_);
+
+    // 返回第一个失败的子请求的状态, 全部成功才更新applied index
+    CHUNK_OP_STATUS status = CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS;
+    for (const auto &subResponse : response_->subresponses()) {
+        if (subResponse.status() != CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+            status = subResponse.status();
+            break;
+        }
+    }
+    response_->set_status(status);
+    if (CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS == status) {
+        node_->UpdateAppliedIndex(applyIndex_);
+    }
+
+    auto maxIndex = (applyIndex_ > node_->GetAppliedIndex()
+                         ? applyIndex_
+                         : node_->GetAppliedIndex());
+    response_->set_appliedindex(maxIndex);
+}
+
+void BatchWriteChunkRequest::OnApplyFromLog(
+    std::shared_ptr<CSDataStore> datastore,
+    const ChunkRequest &request,
+    const butil::IOBuf &data) {
+    // NOTE: 处理过程中优先使用参数传入的datastore/request
+    std::vector<butil::IOBuf> datas;
+    if (0 != Split(request, data, &datas)) {
+        LOG(ERROR) << "split write batch failed: "
+                   << " logic pool id: " << request.logicpoolid()
+                   << " copyset id: " << request.copysetid();
+        return;
+    }
+
+    for (int i = 0; i < request.subrequests_size(); ++i) {
+        WriteChunkRequest::ApplyWrite(datastore, request.subrequests(i),
+                                      datas[i]);
+    }
+}
+
+int BatchWriteChunkRequest::Split(const ChunkRequest &request,
+                                  butil::IOBuf data,
+                                  std::vector<butil::IOBuf> *datas) {
+    datas->clear();
+    datas->resize(request.subrequests_size());
+    for (int i = 0; i < request.subrequests_size(); ++i) {
+        uint32_t size = request.subrequests(i).size();
+        if (data.cutn(&(*datas)[i], size) != size) {
+            return -1;
+        }
+    }
+    return data.empty() ? 0 : -1;
 }
 
 void ReadSnapshotRequest::OnApply(uint64_t index,
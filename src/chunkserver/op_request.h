@@ -27,7 +27,9 @@
 #include <butil/iobuf.h>
 #include <brpc/controller.h>
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include "proto/chunk.pb.h"
 #include "include/chunkserver/chunkserver_common.h"
@@ -37,6 +39,7 @@
 
 using ::google::protobuf::RpcController;
 using ::curve::chunkserver::concurrent::ConcurrentApplyModule;
+using ::curve::chunkserver::concurrent::ThreadPoolType;
 
 namespace curve {
 namespace chunkserver {
@@ -209,7 +212,8 @@ class ReadChunkRequest : public ChunkOpRequest {
 
  public:
     ReadChunkRequest() :
-        ChunkOpRequest() {}
+        ChunkOpRequest(),
+        followerRead_(false) {}
     ReadChunkRequest(std::shared_ptr<CopysetNode> nodePtr,
                      CloneManager* cloneMgr,
                      RpcController *cntl,
@@ -234,6 +238,8 @@ class ReadChunkRequest : public ChunkOpRequest {
     bool NeedClone(const CSChunkInfo& chunkInfo);
     // 从chunk文件中读数据
     void ReadChunk();
+    // 判断当前follower是否可以处理该读请求
+    bool CanServeFollowerRead() const;
 
  private:
     CloneManager* cloneMgr_;
@@ -241,6 +247,8 @@ class ReadChunkRequest : public ChunkOpRequest {
     ConcurrentApplyModule* concurrentApplyModule_;
     // 保存 apply index
     uint64_t applyIndex;
+    // 是否是在follower上处理的读请求
+    bool followerRead_;
 };
 
 class WriteChunkRequest : public ChunkOpRequest {
@@ -263,6 +271,73 @@ class WriteChunkRequest : public ChunkOpRequest {
     void OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
                         const ChunkRequest &request,
                         const butil::IOBuf &data) override;
+
+    /**
+     * 执行一个写请求, 返回对应的状态码, 单个写和批量写的子请求共用
+     */
+    static CHUNK_OP_STATUS ApplyWrite(std::shared_ptr<CSDataStore> datastore,
+                                      const ChunkRequest &request,
+                                      const butil::IOBuf &data);
+};
+
+/**
+ * 批量写请求, 多个写同一copyset的子请求作为一条op log entry propose,
+ * apply的时候每个子请求按chunk放入并发层各自的队列中执行
+ */
+class BatchWriteChunkRequest : public ChunkOpRequest {
+ public:
+    BatchWriteChunkRequest() :
+        ChunkOpRequest(),
+        concurrentApplyModule_(nullptr),
+        applyIndex_(0),
+        applyDone_(nullptr),
+        pending_(0) {}
+    BatchWriteChunkRequest(std::shared_ptr<CopysetNode> nodePtr,
+                           RpcController *cntl,
+                           const ChunkRequest *request,
+                           ChunkResponse *response,
+                           ::google::protobuf::Closure *done);
+    virtual ~BatchWriteChunkRequest() = default;
+
+    /**
+     * NOTE: 需要在apply线程中调用, 保证子请求与其他op在同一chunk上的顺序
+     */
+    void OnApply(uint64_t index, ::google::protobuf::Closure *done) override;
+
+    /**
+     * 依次apply所有子请求, copyset node回放日志时会把子请求
+     * 按chunk分发到并发层, 不会调用这个接口
+     */
+    void OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
+                        const ChunkRequest &request,
+                        const butil::IOBuf &data) override;
+
+    /**
+     * 按子请求的size切分批量写请求的数据
+     * @param request: 批量写请求
+     * @param data: 批量写请求的数据
+     * @param datas: 出参, 各个子请求的数据
+     * @return 0成功, -1数据长度和子请求不匹配
+     */
+    static int Split(const ChunkRequest &request,
+                     butil::IOBuf data,
+                     std::vector<butil::IOBuf> *datas);
+
+ private:
+    void ApplySubWrite(int subIndex, const butil::IOBuf &data);
+
+    // 所有子请求完成后设置返回并调用done
+    void OnSubWritesDone();
+
+ private:
+    // 并发模块
+    ConcurrentApplyModule* concurrentApplyModule_;
+    // 保存 apply index
+    uint64_t applyIndex_;
+    // OnApply传入的done, 所有子请求完成后调用
+    ::google::protobuf::Closure *applyDone_;
+    // 未完成的子请求数量
+    std::atomic<int> pending_;
 };
 
 class ReadSnapshotRequest : public ChunkOpRequest {
@@ -162,6 +162,11 @@ void ClientClosure::Run() {
     std::unique_ptr<brpc::Controller> cntlGuard(cntl_);
     brpc::ClosureGuard doneGuard(done_);
 
+    if (connectionInflight_ != nullptr) {
+        connectionInflight_->fetch_sub(1, std::memory_order_relaxed);
+        connectionInflight_.reset();
+    }
+
     metaCache_ = client_->GetMetaCache();
     reqDone_ = static_cast<RequestClosure*>(done_);
     fileMetric_ = reqDone_->GetMetric();
@@ -256,7 +261,7 @@ void ClientClosure::Run() {
 }
 
 void ClientClosure::OnRpcFailed() {
-    client_->ResetSenderIfNotHealth(chunkserverID_);
+    client_->ResetSenderIfNotHealth(chunkserverID_, connectionIndex_);
 
     status_ = cntl_->ErrorCode();
 
@@ -485,6 +490,70 @@ void WriteChunkClosure::OnSuccess() {
         response_->appliedindex());
 }
 
+void WriteChunkBatchClosure::Run() {
+    std::unique_ptr<WriteChunkBatchClosure> selfGuard(this);
+    std::unique_ptr<brpc::Controller> cntlGuard(cntl_);
+
+    if (connectionInflight_ != nullptr) {
+        connectionInflight_->fetch_sub(1, std::memory_order_relaxed);
+        connectionInflight_.reset();
+    }
+
+    MetaCache* metaCache = client_->GetMetaCache();
+    // 请求返回给上层之后可能被释放, 这里拷贝一份
+    const ChunkIDInfo idinfo = requests_.front()->idinfo_;
+    bool hasSubResponses = false;
+    if (cntl_->Failed()) {
+        client_->ResetSenderIfNotHealth(chunkserverID_, connectionIndex_);
+        // 和单个写一样, 写是否成功未知, 之后的读不能再走applied index读
+        metaCache->UpdateAppliedIndex(idinfo.lpid_, idinfo.cpid_, 0);
+        LOG_EVERY_SECOND(WARNING) << "write batch failed, error code: "
+            << cntl_->ErrorCode() << ", error: " << cntl_->ErrorText()
+            << ", logicpool id = " << idinfo.lpid_
+            << ", copyset id = " << idinfo.cpid_
+            << ", request num = " << requests_.size()
+            << ", remote side = "
+            << butil::endpoint2str(cntl_->remote_side()).c_str();
+    } else {
+        metaCache->GetUnstableHelper().ClearTimeout(
+            chunkserverID_, cntl_->remote_side());
+        hasSubResponses = response_->subresponses_size() ==
+                          static_cast<int>(requests_.size());
+        if (response_->status() != CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+            LOG_EVERY_SECOND(WARNING) << "write batch failed, status = "
+                << curve::chunkserver::CHUNK_OP_STATUS_Name(
+                       response_->status())
+                << ", logicpool id = " << idinfo.lpid_
+                << ", copyset id = " << idinfo.cpid_
+                << ", request num = " << requests_.size()
+                << ", remote side = "
+                << butil::endpoint2str(cntl_->remote_side()).c_str();
+        }
+    }
+
+    for (size_t i = 0; i < requests_.size(); ++i) {
+        RequestContext* ctx = requests_[i];
+        RequestClosure* done = ctx->done_;
+        if (hasSubResponses && response_->subresponses(i).status() ==
+                                   CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+            done->SetFailed(0);
+            MetricHelper::LatencyRecord(done->GetMetric(),
+                                        cntl_->latency_us(), ctx->optype_);
+            MetricHelper::IncremRPCQPSCount(done->GetMetric(),
+                                            ctx->rawlength_, ctx->optype_);
+            metaCache->UpdateAppliedIndex(idinfo.lpid_, idinfo.cpid_,
+                                          response_->appliedindex());
+            done->Run();
+            continue;
+        }
+
+        // 失败的请求单独重试, 由单个写的流程处理重定向、过载等各种错误
+        client_->WriteChunk(ctx->idinfo_, ctx->seq_, ctx->writeData_,
+                            ctx->offset_, ctx->rawlength_, ctx->sourceInfo_,
+                            done);
+    }
+}
+
 void ReadChunkClosure::SendRetryRequest() {
     client_->ReadChunk(reqCtx_->idinfo_, reqCtx_->seq_,
                        reqCtx_->offset_,
@@ -494,6 +563,22 @@ void ReadChunkClosure::SendRetryRequest() {
                        done_);
 }
 
+void ReadChunkClosure::OnRedirected() {
+    // follower读被重定向说明该副本的applied index没有追上，
+    // 并不代表leader发生了变化，不需要刷新leader
+    if (followerRead_) {
+        LOG(INFO) << OpTypeToString(reqCtx_->optype_)
+            << " follower read redirected, " << *reqCtx_
+            << ", IO id = " << reqDone_->GetIOTracker()->GetID()
+            << ", request id = " << reqCtx_->id_
+            << ", remote side = "
+            << butil::endpoint2str(cntl_->remote_side()).c_str();
+        return;
+    }
+
+    ClientClosure::OnRedirected();
+}
+
 void ReadChunkClosure::OnSuccess() {
     ClientClosure::OnSuccess();
 
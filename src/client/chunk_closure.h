@@ -26,8 +26,11 @@
 #include <google/protobuf/stubs/callback.h>
 #include <brpc/controller.h>
 #include <brpc/errno.pb.h>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "proto/chunk.pb.h"
 #include "src/client/client_config.h"
@@ -83,6 +86,21 @@ class ClientClosure : public Closure {
         return chunkserverEndPoint_;
     }
 
+    /**
+     * @brief 记录rpc所使用的connection
+     * @param index connection在该chunkserver所有connection中的序号
+     * @param inflight connection上未返回的rpc数量，rpc返回时递减
+     */
+    void SetConnection(uint32_t index,
+                       std::shared_ptr<std::atomic<uint64_t>> inflight) {
+        connectionIndex_ = index;
+        connectionInflight_ = std::move(inflight);
+    }
+
+    uint32_t GetConnectionIndex() const {
+        return connectionIndex_;
+    }
+
     // 统一Run函数入口
     void Run() override;
 
@@ -214,6 +232,9 @@ class ClientClosure : public Closure {
     // 这样方便在rpc closure里直接找到，当前是哪个chunkserver返回的失败
     ChunkServerID                       chunkserverID_;
     butil::EndPoint                     chunkserverEndPoint_;
+    // rpc所使用的connection
+    uint32_t                            connectionIndex_ = 0;
+    std::shared_ptr<std::atomic<uint64_t>> connectionInflight_;
 
     // 记录当前请求的相关信息
     MetaCache*                          metaCache_;
@@ -241,14 +262,67 @@ class WriteChunkClosure : public ClientClosure {
     void SendRetryRequest() override;
 };
 
+/**
+ * 批量写rpc的回调, 子请求成功的直接返回给上层,
+ * 失败的子请求或者整个rpc失败时, 各个请求走单个写的流程重试
+ */
+class WriteChunkBatchClosure : public Closure {
+ public:
+    WriteChunkBatchClosure(CopysetClient* client,
+                           const std::vector<RequestContext*>& requests)
+        : client_(client), requests_(requests) {}
+
+    void SetCntl(brpc::Controller* cntl) {
+        cntl_ = cntl;
+    }
+
+    void SetResponse(ChunkResponse* response) {
+        response_.reset(response);
+    }
+
+    void SetChunkServerID(ChunkServerID csid) {
+        chunkserverID_ = csid;
+    }
+
+    void SetConnection(uint32_t index,
+                       std::shared_ptr<std::atomic<uint64_t>> inflight) {
+        connectionIndex_ = index;
+        connectionInflight_ = std::move(inflight);
+    }
+
+    const std::vector<RequestContext*>& GetRequests() const {
+        return requests_;
+    }
+
+    void Run() override;
+
+ private:
+    CopysetClient*                      client_;
+    std::vector<RequestContext*>        requests_;
+    brpc::Controller*                   cntl_ = nullptr;
+    std::unique_ptr<ChunkResponse>      response_;
+    ChunkServerID                       chunkserverID_ = 0;
+    uint32_t                            connectionIndex_ = 0;
+    std::shared_ptr<std::atomic<uint64_t>> connectionInflight_;
+};
+
 class ReadChunkClosure : public ClientClosure {
  public:
     ReadChunkClosure(CopysetClient* client, Closure* done)
-        : ClientClosure(client, done) {}
+        : ClientClosure(client, done), followerRead_(false) {}
 
     void OnSuccess() override;
     void OnChunkNotExist() override;
+    void OnRedirected() override;
     void SendRetryRequest() override;
+
+    void SetFollowerRead(bool followerRead) {
+        followerRead_ = followerRead;
+    }
+
+ private:
+    // 请求是否发给了任意副本而不一定是leader
+    bool followerRead_;
 };
 
 class ReadChunkSnapClosure : public ClientClosure {
@@ -75,6 +75,40 @@ int ClientConfig::Init(const std::string& configpath) {
     LOG_IF(ERROR, ret == false) << "config no chunkserver.enableAppliedIndexRead info";     // NOLINT
     RETURN_IF_FALSE(ret);
 
+    ret = conf_.GetBoolValue("chunkserver.enableFollowerRead",
+          &fileServiceOption_.ioOpt.ioSenderOpt.chunkserverEnableFollowerRead);     // NOLINT
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.enableFollowerRead info, using default value "
+        << fileServiceOption_.ioOpt.ioSenderOpt.chunkserverEnableFollowerRead;
+
+    ret = conf_.GetUInt32Value("chunkserver.connectionNum",
+          &fileServiceOption_.ioOpt.ioSenderOpt.chunkserverConnectionNum);
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.connectionNum info, using default value "
+        << fileServiceOption_.ioOpt.ioSenderOpt.chunkserverConnectionNum;
+    if (fileServiceOption_.ioOpt.ioSenderOpt.chunkserverConnectionNum == 0) {
+        LOG(ERROR) << "chunkserver.connectionNum must be greater than 0";
+        return -1;
+    }
+
+    std::string connectionSelectPolicy;
+    ret = conf_.GetStringValue("chunkserver.connectionSelectPolicy",
+                               &connectionSelectPolicy);
+    if (ret == false) {
+        LOG(WARNING) << "config no chunkserver.connectionSelectPolicy info, "
+                        "using default value copyset";
+    } else if (connectionSelectPolicy == "copyset") {
+        fileServiceOption_.ioOpt.ioSenderOpt.chunkserverConnectionSelectPolicy =
+            ConnectionSelectPolicy::CopysetHash;
+    } else if (connectionSelectPolicy == "inflight") {
+        fileServiceOption_.ioOpt.ioSenderOpt.chunkserverConnectionSelectPolicy =
+            ConnectionSelectPolicy::LeastInflight;
+    } else {
+        LOG(ERROR) << "unknown chunkserver.connectionSelectPolicy: "
+                   << connectionSelectPolicy;
+        return -1;
+    }
+
     ret = conf_.GetUInt32Value("chunkserver.opMaxRetry",
           &fileServiceOption_.ioOpt.ioSenderOpt.failRequestOpt.chunkserverOPMaxRetry);    // NOLINT
     LOG_IF(ERROR, ret == false) << "config no chunkserver.opMaxRetry info";
@@ -144,6 +178,25 @@ int ClientConfig::Init(const std::string& configpath) {
     LOG_IF(ERROR, ret == false) << "config no metacache.rpcRetryIntervalUS info";   // NOLINT
     RETURN_IF_FALSE(ret);
 
+    ret = conf_.GetUInt32Value("chunkserver.writeBatchMaxNum",
+          &fileServiceOption_.ioOpt.ioSenderOpt.chunkserverWriteBatchMaxNum);
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.writeBatchMaxNum info, using default value "
+        << fileServiceOption_.ioOpt.ioSenderOpt.chunkserverWriteBatchMaxNum;
+
+    ret = conf_.GetUInt32Value("chunkserver.writeBatchMaxBytes",
+          &fileServiceOption_.ioOpt.ioSenderOpt.chunkserverWriteBatchMaxBytes);
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.writeBatchMaxBytes info, using default value "
+        << fileServiceOption_.ioOpt.ioSenderOpt.chunkserverWriteBatchMaxBytes;
+
+    ret = fileServiceOption_.ioOpt.ioSenderOpt.chunkserverWriteBatchMaxNum <=
+          fileServiceOption_.ioOpt.ioSenderOpt.inflightOpt.fileMaxInFlightRPCNum;   // NOLINT
+    LOG_IF(ERROR, ret == false)
+        << "chunkserver.writeBatchMaxNum must not be larger than "
+        << "global.fileMaxInFlightRPCNum";
+    RETURN_IF_FALSE(ret);
+
     ret = conf_.GetUInt32Value("metacache.getLeaderTimeOutMS",
         &fileServiceOption_.ioOpt.metaCacheOpt.metacacheGetLeaderRPCTimeOutMS);
     LOG_IF(ERROR, ret == false) << "config no metacache.getLeaderTimeOutMS info";   // NOLINT
@@ -249,6 +302,13 @@ int ClientConfig::Init(const std::string& configpath) {
         << "config no closefd.timeInterval info, using default value "
         << fileServiceOption_.ioOpt.closeFdThreadOption.fdCloseTimeInterval;
 
+    ret = conf_.GetUInt32Value(
+        "global.segmentPreallocNum",
+        &fileServiceOption_.ioOpt.ioSplitOpt.segmentPreallocNum);
+    LOG_IF(WARNING, ret == false)
+        << "config no global.segmentPreallocNum info, using default value "
+        << fileServiceOption_.ioOpt.ioSplitOpt.segmentPreallocNum;
+
     ret = conf_.GetBoolValue(
         "throttle.enable",
         &fileServiceOption_.ioOpt.throttleOption.enable);
@@ -273,6 +333,30 @@ int ClientConfig::Init(const std::string& configpath) {
     LOG_IF(ERROR, ret == false) << "config no discard.taskDelayMs info";
     RETURN_IF_FALSE(ret);
 
+    ret = conf_.GetBoolValue("readCache.enable",
+                             &fileServiceOption_.ioOpt.readCacheOpt.enable);
+    LOG_IF(WARNING, ret == false)
+        << "config no readCache.enable info, using default value "
+        << fileServiceOption_.ioOpt.readCacheOpt.enable;
+
+    ret = conf_.GetUInt64Value(
+        "readCache.capacityMB",
+        &fileServiceOption_.ioOpt.readCacheOpt.capacityMB);
+    LOG_IF(WARNING, ret == false)
+        << "config no readCache.capacityMB info, using default value "
+        << fileServiceOption_.ioOpt.readCacheOpt.capacityMB;
+
+    ret = conf_.GetUInt32Value(
+        "readCache.blockSize",
+        &fileServiceOption_.ioOpt.readCacheOpt.blockSize);
+    LOG_IF(WARNING, ret == false)
+        << "config no readCache.blockSize info, using default value "
+        << fileServiceOption_.ioOpt.readCacheOpt.blockSize;
+    if (fileServiceOption_.ioOpt.readCacheOpt.blockSize == 0) {
+        LOG(ERROR) << "readCache.blockSize must be positive";
+        return -1;
+    }
+
     ret = conf_.GetUInt32Value(
         "global.alignment.commonVolume",
         &fileServiceOption_.ioOpt.ioSplitOpt.alignment.commonVolume);
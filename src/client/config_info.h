@@ -154,14 +154,36 @@ struct FailureRequestOption {
     uint64_t chunkserverMaxRetryTimesBeforeConsiderSuspend = 20;
 };
 
+/**
+ * 一个chunkserver有多个链接时，选择链接的策略
+ * CopysetHash: 按copyset id选择，同一个copyset的请求走同一个链接
+ * LeastInflight: 选择未返回rpc最少的链接
+ */
+enum class ConnectionSelectPolicy {
+    CopysetHash = 0,
+    LeastInflight = 1,
+};
+
 /**
  * 发送rpc给chunkserver的配置
  * @chunkserverEnableAppliedIndexRead: 是否开启使用appliedindex read
+ * @chunkserverEnableFollowerRead: 是否允许携带appliedindex的读请求发往follower
+ * @chunkserverConnectionNum: 与每个chunkserver建立的链接数
+ * @chunkserverConnectionSelectPolicy: 多个链接时选择链接的策略
+ * @chunkserverWriteBatchMaxNum: 一个用户IO中写同一copyset的请求合并成一个
+ *                               批量写rpc时最多合并的请求数, 不大于1表示不合并
+ * @chunkserverWriteBatchMaxBytes: 一个批量写rpc最多携带的数据量
  * @inflightOpt: 一个文件向chunkserver发送请求时的inflight 请求控制配置
  * @failRequestOpt: rpc发送失败之后，需要进行rpc重试的相关配置
  */
 struct IOSenderOption {
     bool chunkserverEnableAppliedIndexRead;
+    bool chunkserverEnableFollowerRead = false;
+    uint32_t chunkserverConnectionNum = 1;
+    ConnectionSelectPolicy chunkserverConnectionSelectPolicy =
+        ConnectionSelectPolicy::CopysetHash;
+    uint32_t chunkserverWriteBatchMaxNum = 1;
+    uint32_t chunkserverWriteBatchMaxBytes = 4 * 1024 * 1024;
     InFlightIOCntlInfo inflightOpt;
     FailureRequestOption failRequestOpt;
 };
@@ -220,9 +242,12 @@ struct AlignmentOption {
  * @fileIOSplitMaxSizeKB:
  * 用户下发IO大小client没有限制，但是client会将用户的IO进行拆分，
  *                        发向同一个chunkserver的请求锁携带的数据大小不能超过该值。
+ * @segmentPreallocNum: 顺序首次写入时，一次向mds申请分配的segment数量，
+ *                      为1时不预分配
  */
 struct IOSplitOption {
     uint64_t fileIOSplitMaxSizeKB = 64;
+    uint32_t segmentPreallocNum = 1;
     AlignmentOption alignment;
 };
 
@@ -244,6 +269,18 @@ struct DiscardOption {
     uint32_t taskDelayMs = 1000 * 60;  // 1 min
 };
 
+/**
+ * read cache config
+ * @enable: cache data read from chunkservers in memory or not
+ * @capacityMB: capacity of the read cache of each file
+ * @blockSize: data is cached in blocks of blockSize bytes
+ */
+struct ReadCacheOption {
+    bool enable = false;
+    uint64_t capacityMB = 256;
+    uint32_t blockSize = 4096;
+};
+
 /**
  * timed close fd thread in SourceReader config
  * @fdTimeout: sourcereader fd timeout
@@ -270,6 +307,7 @@ struct IOOption {
     CloseFdThreadOption closeFdThreadOption;
     ThrottleOption throttleOption;
     DiscardOption discardOption;
+    ReadCacheOption readCacheOpt;
 };
 
 /**
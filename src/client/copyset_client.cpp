@@ -24,8 +24,10 @@
 
 #include <glog/logging.h>
 #include <unistd.h>
+#include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "src/client/request_sender.h"
 #include "src/client/metacache.h"
@@ -122,6 +124,28 @@ int CopysetClient::ReadChunk(const ChunkIDInfo& idinfo, uint64_t sn,
         }
     }
 
+    // 开启follower读时，第一次发送在各个副本之间轮流选择，分担leader的读压力；
+    // follower的applied index没有追上时会返回重定向，重试按原有逻辑发给leader
+    if (iosenderopt_.chunkserverEnableFollowerRead &&
+        iosenderopt_.chunkserverEnableAppliedIndexRead &&
+        appliedindex > 0 && reqclosure->GetRetriedTimes() == 0) {
+        ChunkServerID peerId;
+        butil::EndPoint peerAddr;
+        if (PickReadPeer(idinfo, &peerId, &peerAddr)) {
+            auto senderPtr = senderManager_->GetOrCreateSender(peerId,
+                                            peerAddr, iosenderopt_, idinfo.cpid_);
+            if (nullptr != senderPtr) {
+                reqclosure->IncremRetriedTimes();
+                ReadChunkClosure *readDone =
+                    new ReadChunkClosure(this, doneGuard.release());
+                readDone->SetFollowerRead(true);
+                senderPtr->ReadChunk(idinfo, sn, offset, length,
+                                     appliedindex, sourceInfo, readDone, true);
+                return 0;
+            }
+        }
+    }
+
     auto task = [&](Closure* done, std::shared_ptr<RequestSender> senderPtr) {
         ReadChunkClosure *readDone = new ReadChunkClosure(this, done);
         senderPtr->ReadChunk(idinfo, sn, offset, length,
@@ -180,6 +204,35 @@ int CopysetClient::WriteChunk(const ChunkIDInfo& idinfo, uint64_t sn,
     return DoRPCTask(idinfo, task, doneGuard.release());
 }
 
+int CopysetClient::WriteChunkBatch(
+    const std::vector<RequestContext*>& requests) {
+    const ChunkIDInfo& idinfo = requests.front()->idinfo_;
+    ChunkServerID leaderId;
+    butil::EndPoint leaderAddr;
+    std::shared_ptr<RequestSender> senderPtr = nullptr;
+
+    // session失效或者获取leader失败时交给单个写的流程处理
+    if (!sessionNotValid_ &&
+        FetchLeader(idinfo.lpid_, idinfo.cpid_, &leaderId, &leaderAddr)) {
+        senderPtr = senderManager_->GetOrCreateSender(leaderId, leaderAddr,
+                                                      iosenderopt_,
+                                                      idinfo.cpid_);
+    }
+
+    if (nullptr != senderPtr) {
+        WriteChunkBatchClosure* batchDone =
+            new WriteChunkBatchClosure(this, requests);
+        senderPtr->WriteChunkBatch(requests, batchDone);
+        return 0;
+    }
+
+    for (auto ctx : requests) {
+        WriteChunk(ctx->idinfo_, ctx->seq_, ctx->writeData_, ctx->offset_,
+                   ctx->rawlength_, ctx->sourceInfo_, ctx->done_);
+    }
+    return 0;
+}
+
 int CopysetClient::ReadChunkSnapshot(const ChunkIDInfo& idinfo,
     uint64_t sn, off_t offset, size_t length, Closure *done) {
 
@@ -260,7 +313,7 @@ int CopysetClient::DoRPCTask(const ChunkIDInfo& idinfo,
         }
 
         auto senderPtr = senderManager_->GetOrCreateSender(leaderId,
-                                        leaderAddr, iosenderopt_);
+                                        leaderAddr, iosenderopt_, idinfo.cpid_);
         if (nullptr != senderPtr) {
             task(doneGuard.release(), senderPtr);
             break;
@@ -275,5 +328,35 @@ int CopysetClient::DoRPCTask(const ChunkIDInfo& idinfo,
 
     return 0;
 }
+
+bool CopysetClient::PickReadPeer(const ChunkIDInfo& idinfo,
+    ChunkServerID* peerid, butil::EndPoint* peeraddr) {
+    CopysetInfo<ChunkServerID> cpinfo =
+        metaCache_->GetCopysetinfo(idinfo.lpid_, idinfo.cpid_);
+    if (cpinfo.csinfos_.empty()) {
+        return false;
+    }
+
+    // 选择未返回rpc最少的副本，从轮转的位置开始比较，
+    // 负载相同时请求依然均匀分散到各个副本上
+    const size_t peerNum = cpinfo.csinfos_.size();
+    const uint64_t start =
+        followerReadIndex_.fetch_add(1, std::memory_order_relaxed);
+    size_t index = start % peerNum;
+    uint64_t minInflight = std::numeric_limits<uint64_t>::max();
+    for (size_t i = 0; i < peerNum; ++i) {
+        size_t cur = (start + i) % peerNum;
+        uint64_t inflight =
+            senderManager_->GetInflightNum(cpinfo.csinfos_[cur].peerID);
+        if (inflight < minInflight) {
+            minInflight = inflight;
+            index = cur;
+        }
+    }
+
+    *peerid = cpinfo.csinfos_[index].peerID;
+    *peeraddr = cpinfo.csinfos_[index].externalAddr.addr_;
+    return true;
+}
 }   // namespace client
 }   // namespace curve
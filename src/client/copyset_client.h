@@ -26,8 +26,10 @@
 #include <google/protobuf/stubs/callback.h>
 #include <butil/iobuf.h>
 
+#include <atomic>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "include/curve_compiler_specific.h"
 #include "src/client/client_common.h"
@@ -58,7 +60,8 @@ class CopysetClient {
           sessionNotValid_(false),
           scheduler_(nullptr),
           fileMetric_(nullptr),
-          exitFlag_(false) {}
+          exitFlag_(false),
+          followerReadIndex_(0) {}
 
     CopysetClient(const CopysetClient&) = delete;
     CopysetClient& operator=(const CopysetClient&) = delete;
@@ -115,6 +118,13 @@ class CopysetClient {
                   const RequestSourceInfo& sourceInfo,
                   Closure *done);
 
+    /**
+     * 把写同一copyset的多个请求作为一个批量写rpc发送给leader,
+     * 无法发送或者rpc失败时各个请求走单个写的流程
+     * @param requests: 写请求, 都属于同一个copyset, 已经获取了inflight token
+     */
+    int WriteChunkBatch(const std::vector<RequestContext*>& requests);
+
     /**
      * 读Chunk快照文件
      * @param idinfo为chunk相关的id信息
@@ -181,9 +191,11 @@ class CopysetClient {
     /**
      * @brief 如果csId对应的RequestSender不健康，就进行重置
      * @param csId chunkserver id
+     * @param connectionIndex 出错rpc所使用的connection序号
      */
-    void ResetSenderIfNotHealth(const ChunkServerID& csId) {
-        senderManager_->ResetSenderIfNotHealth(csId);
+    void ResetSenderIfNotHealth(const ChunkServerID& csId,
+                                uint32_t connectionIndex = 0) {
+        senderManager_->ResetSenderIfNotHealth(csId, connectionIndex);
     }
 
     /**
@@ -233,6 +245,17 @@ class CopysetClient {
         std::function<void(Closure*, std::shared_ptr<RequestSender>)> task,
         Closure *done);
 
+    /**
+     * 为follower读选择一个副本，选择未返回rpc最少的副本，
+     * 负载相同时在copyset的所有副本之间轮流选择
+     * @param[in]: idinfo为当前rpc task的id信息
+     * @param[out]: peerid为选中副本的id
+     * @param[out]: peeraddr为选中副本的地址
+     * @return: metacache中有copyset的副本信息返回true，否则返回false
+     */
+    bool PickReadPeer(const ChunkIDInfo& idinfo, ChunkServerID* peerid,
+                      butil::EndPoint* peeraddr);
+
  private:
     // 元数据缓存
     MetaCache            *metaCache_;
@@ -254,6 +277,9 @@ class CopysetClient {
 
     // 是否在停止状态中，如果是在关闭过程中且session失效，需要将rpc直接返回不下发
     bool exitFlag_;
+
+    // follower读选择副本时轮转起始位置的计数
+    std::atomic<uint64_t> followerReadIndex_;
 };
 
 }   // namespace client
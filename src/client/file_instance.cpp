@@ -141,6 +141,45 @@ int FileInstance::AioWrite(CurveAioContext* aioctx, UserDataType dataType) {
     return iomanager4file_.AioWrite(aioctx, mdsclient_.get(), dataType);
 }
 
+int FileInstance::AioReadv(CurveAioContext* aioctx, const struct iovec* iov,
+                           int iovcnt) {
+    DLOG_EVERY_SECOND(INFO) << "begin AioReadv " << finfo_.fullPathName
+                            << ", offset = " << aioctx->offset
+                            << ", len = " << aioctx->length
+                            << ", iovcnt = " << iovcnt;
+    return iomanager4file_.AioReadv(aioctx, iov, iovcnt, mdsclient_.get());
+}
+
+int FileInstance::AioWritev(CurveAioContext* aioctx, const struct iovec* iov,
+                            int iovcnt) {
+    if (readonly_) {
+        DVLOG(9) << "open with read only, do not support write!";
+        return -1;
+    }
+    DLOG_EVERY_SECOND(INFO) << "begin AioWritev " << finfo_.fullPathName
+                            << ", offset = " << aioctx->offset
+                            << ", len = " << aioctx->length
+                            << ", iovcnt = " << iovcnt;
+    return iomanager4file_.AioWritev(aioctx, iov, iovcnt, mdsclient_.get());
+}
+
+int FileInstance::AioSubmit(CurveAioContext* aioctxs[], int num,
+                            UserDataType dataType) {
+    if (readonly_) {
+        for (int i = 0; i < num; ++i) {
+            if (aioctxs[i]->op != LIBCURVE_OP_READ) {
+                LOG(ERROR) << "Open with read only, only read is supported";
+                return -1;
+            }
+        }
+    }
+
+    DLOG_EVERY_SECOND(INFO) << "begin AioSubmit " << finfo_.fullPathName
+                            << ", num = " << num;
+    return iomanager4file_.AioSubmit(aioctxs, num, mdsclient_.get(),
+                                     dataType);
+}
+
 int FileInstance::Discard(off_t offset, size_t length) {
     if (!readonly_) {
         return iomanager4file_.Discard(offset, length, mdsclient_.get());
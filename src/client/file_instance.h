@@ -110,6 +110,35 @@ class CURVE_CACHELINE_ALIGNMENT FileInstance {
      */
     int AioWrite(CurveAioContext* aioctx, UserDataType dataType);
 
+    /**
+     * @brief Asynchronous vectored read
+     * @param aioctx async request context, aioctx->buf is ignored
+     * @param iov user buffers to read into
+     * @param iovcnt number of user buffers
+     * @return 0 means success, otherwise it means failure
+     */
+    int AioReadv(CurveAioContext* aioctx, const struct iovec* iov,
+                 int iovcnt);
+
+    /**
+     * @brief Asynchronous vectored write
+     * @param aioctx async request context, aioctx->buf is ignored
+     * @param iov user buffers to write
+     * @param iovcnt number of user buffers
+     * @return 0 means success, otherwise it means failure
+     */
+    int AioWritev(CurveAioContext* aioctx, const struct iovec* iov,
+                  int iovcnt);
+
+    /**
+     * @brief Submit a batch of asynchronous requests
+     * @param aioctxs async request contexts, aioctx->op decides the type
+     * @param num number of requests
+     * @param dataType type of user buffer
+     * @return number of requests submitted, less than 0 means failure
+     */
+    int AioSubmit(CurveAioContext* aioctxs[], int num, UserDataType dataType);
+
     /**
      * @param offset discard offset
      * @param length discard length
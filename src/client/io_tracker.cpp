@@ -35,6 +35,7 @@
 #include "src/client/source_reader.h"
 #include "src/client/metacache_struct.h"
 #include "src/client/discard_task.h"
+#include "src/client/read_cache.h"
 
 namespace curve {
 namespace client {
@@ -65,6 +66,10 @@ IOTracker::IOTracker(IOManager* iomanager,
     reqlist_.clear();
     reqcount_.store(0, std::memory_order_release);
     opStartTimePoint_ = curve::common::TimeUtility::GetTimeofDayUs();
+    readCache_ = iomanager != nullptr ? iomanager->GetReadCache() : nullptr;
+    readCacheSeq_ = 0;
+    readCacheEpoch_ = 0;
+    readCacheHit_ = false;
 }
 
 void IOTracker::ReleaseAllSegmentLocks() {
@@ -102,6 +107,10 @@ void IOTracker::StartAioRead(CurveAioContext* ctx, MDSClient* mdsclient,
 
 void IOTracker::DoRead(MDSClient* mdsclient, const FInfo_t* fileInfo,
                        Throttle* throttle) {
+    if (readCache_ != nullptr && ReadFromCache()) {
+        return;
+    }
+
     if (throttle) {
         throttle->Add(true, length_);
     }
@@ -150,6 +159,24 @@ void IOTracker::DoRead(MDSClient* mdsclient, const FInfo_t* fileInfo,
     }
 }
 
+bool IOTracker::ReadFromCache() {
+    // save epoch before looking up, so that a write during the read from
+    // chunkservers prevents the data from being cached
+    readCacheEpoch_ = readCache_->GetEpoch();
+    readCacheSeq_ = mc_->GetLatestFileSn();
+
+    butil::IOBuf data;
+    if (!readCache_->Get(offset_, length_, readCacheSeq_, &data)) {
+        return false;
+    }
+
+    readCacheHit_ = true;
+    PrepareReadIOBuffers(1);
+    SetReadData(0, data);
+    Done();
+    return true;
+}
+
 int IOTracker::ReadFromSource(const std::vector<RequestContext*>& reqCtxVec,
                               const UserInfo_t& userInfo,
                               MDSClient* mdsClient) {
@@ -189,25 +216,37 @@ void IOTracker::StartAioWrite(CurveAioContext* ctx, MDSClient* mdsclient,
 
 void IOTracker::DoWrite(MDSClient* mdsclient, const FInfo_t* fileInfo,
                         Throttle* throttle) {
-    if (nullptr == data_) {
+    if (!userIOV_.empty()) {
+        // reference user buffers one by one, they are never flattened
+        for (const auto& vec : userIOV_) {
+            if (vec.iov_len > 0) {
+                writeData_.append_user_data(vec.iov_base, vec.iov_len,
+                                            TrivialDeleter);
+            }
+        }
+    } else if (nullptr == data_) {
         ReturnOnFail();
         return;
-    }
-
-    switch (userDataType_) {
-        case UserDataType::RawBuffer:
-            writeData_.append_user_data(data_, length_,
-                                        TrivialDeleter);
-            break;
-        case UserDataType::IOBuffer:
-            writeData_ = *reinterpret_cast<const butil::IOBuf*>(data_);
-            break;
+    } else {
+        switch (userDataType_) {
+            case UserDataType::RawBuffer:
+                writeData_.append_user_data(data_, length_,
+                                            TrivialDeleter);
+                break;
+            case UserDataType::IOBuffer:
+                writeData_ = *reinterpret_cast<const butil::IOBuf*>(data_);
+                break;
+        }
     }
 
     if (throttle) {
         throttle->Add(false, length_);
     }
 
+    if (readCache_ != nullptr) {
+        readCache_->Invalidate(offset_, length_);
+    }
+
     int ret = Splitor::IO2ChunkRequests(this, mc_, &reqlist_, &writeData_,
                                         offset_, length_, mdsclient, fileInfo);
     if (ret == 0) {
@@ -254,6 +293,10 @@ void IOTracker::StartAioDiscard(CurveAioContext* ctx, MDSClient* mdsclient,
 
 void IOTracker::DoDiscard(MDSClient* mdsClient, const FInfo* fileInfo,
                           DiscardTaskManager* taskManager) {
+    if (readCache_ != nullptr) {
+        readCache_->Invalidate(offset_, length_);
+    }
+
     int ret = Splitor::IO2ChunkRequests(this, mc_, &reqlist_, nullptr, offset_,
                                         length_, mdsClient, fileInfo);
 
@@ -464,6 +507,13 @@ void IOTracker::Done() {
         ReleaseAllSegmentLocks();
     }
 
+    // invalidate again after the write finished, reads started during the
+    // write may get old data
+    if (readCache_ != nullptr &&
+        (type_ == OpType::WRITE || type_ == OpType::DISCARD)) {
+        readCache_->Invalidate(offset_, length_);
+    }
+
     if (errcode_ == LIBCURVE_ERROR::OK) {
         uint64_t duration = TimeUtility::GetTimeofDayUs() - opStartTimePoint_;
         MetricHelper::UserLatencyRecord(fileMetric_, duration, type_);
@@ -476,22 +526,38 @@ void IOTracker::Done() {
                 readData.append(buf);
             }
 
-            switch (userDataType_) {
-                case UserDataType::RawBuffer: {
-                    size_t nc = readData.copy_to(data_, readData.size());
-                    if (nc != length_) {
-                        errcode_ = LIBCURVE_ERROR::FAILED;
-                    }
-                    break;
+            if (readCache_ != nullptr && OpType::READ == type_ &&
+                !readCacheHit_ && readData.size() == length_) {
+                readCache_->Put(offset_, readData, readCacheSeq_,
+                                readCacheEpoch_);
+            }
+
+            if (!userIOV_.empty()) {
+                size_t nc = 0;
+                for (const auto& vec : userIOV_) {
+                    nc += readData.cutn(vec.iov_base, vec.iov_len);
                 }
-                case UserDataType::IOBuffer: {
-                    butil::IOBuf* userData =
-                        reinterpret_cast<butil::IOBuf*>(data_);
-                    *userData = readData;
-                    if (userData->size() != length_) {
-                        errcode_ = LIBCURVE_ERROR::FAILED;
+                if (nc != length_) {
+                    errcode_ = LIBCURVE_ERROR::FAILED;
+                }
+            } else {
+                switch (userDataType_) {
+                    case UserDataType::RawBuffer: {
+                        size_t nc = readData.copy_to(data_, readData.size());
+                        if (nc != length_) {
+                            errcode_ = LIBCURVE_ERROR::FAILED;
+                        }
+                        break;
+                    }
+                    case UserDataType::IOBuffer: {
+                        butil::IOBuf* userData =
+                            reinterpret_cast<butil::IOBuf*>(data_);
+                        *userData = readData;
+                        if (userData->size() != length_) {
+                            errcode_ = LIBCURVE_ERROR::FAILED;
+                        }
+                        break;
                     }
-                    break;
                 }
             }
 
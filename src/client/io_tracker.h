@@ -48,6 +48,7 @@ using curve::common::Throttle;
 class IOManager;
 class FileSegment;
 class DiscardTaskManager;
+class ReadCache;
 
 // IOTracker用于跟踪一个用户IO，因为一个用户IO可能会跨chunkserver，
 // 因此在真正下发的时候会被拆分成多个小IO并发的向下发送，因此我们需要
@@ -207,6 +208,14 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
         userDataType_ = dataType;
     }
 
+    /**
+     * @brief set user buffers of vectored read and write, they are used
+     *        instead of the user data pointer, the array is copied
+     */
+    void SetUserIOVector(const struct iovec* iov, int iovcnt) {
+        userIOV_.assign(iov, iov + iovcnt);
+    }
+
     /**
      * @brief prepare space to store read data
      * @param subIoCount #space to store read data
@@ -268,6 +277,12 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
     void DoRead(MDSClient* mdsclient, const FInfo_t* fileInfo,
                 Throttle* throttle);
 
+    /**
+     * @brief Read from read cache
+     * @return true if all data is read from cache and the io is done
+     */
+    bool ReadFromCache();
+
     /**
      * @brief read from the source
      * @param reqCtxVec the read request context vector
@@ -305,6 +320,9 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
     // user data type
     UserDataType userDataType_;
 
+    // user buffers of vectored read and write
+    std::vector<struct iovec> userIOV_;
+
     // save write data
     butil::IOBuf writeData_;
 
@@ -361,6 +379,14 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
     // so store corresponding segment lock and release after operations finished
     std::vector<FileSegment*> segmentLocks_;
 
+    // read cache of the file, nullptr if it's disabled
+    ReadCache* readCache_;
+    // file sequence and cache epoch when the read started
+    uint64_t readCacheSeq_;
+    uint64_t readCacheEpoch_;
+    // whether the read is served by read cache
+    bool readCacheHit_;
+
     // id生成器
     static std::atomic<uint64_t> tracekerID_;
 
@@ -32,6 +32,8 @@ namespace client {
 
 using curve::common::Atomic;
 
+class ReadCache;
+
 class IOManager {
  public:
     IOManager() {
@@ -66,6 +68,13 @@ class IOManager {
      */
     virtual void HandleAsyncIOResponse(IOTracker* iotracker) = 0;
 
+    /**
+     * @brief 获取读缓存，没有开启读缓存时返回nullptr
+     */
+    virtual ReadCache* GetReadCache() {
+        return nullptr;
+    }
+
  protected:
     // iomanager id目的是为了让底层RPC知道自己归属于哪个iomanager
     IOManagerID id_;
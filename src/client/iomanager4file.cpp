@@ -23,6 +23,8 @@
 #include <glog/logging.h>
 
 #include <chrono>   // NOLINT
+#include <utility>
+#include <vector>
 
 #include "src/client/metacache.h"
 #include "src/client/iomanager4file.h"
@@ -87,6 +89,12 @@ bool IOManager4File::Initialize(const std::string& filename,
     discardTaskManager_.reset(
         new DiscardTaskManager(&(fileMetric_->discardMetric)));
 
+    if (ioopt_.readCacheOpt.enable) {
+        readCache_.reset(new ReadCache(ioopt_.readCacheOpt,
+                                       fileMetric_->prefix + filename +
+                                           "_read"));
+    }
+
     LOG(INFO) << "iomanager init success, conf info: "
               << "isolationTaskThreadPoolSize = "
               << ioopt_.taskThreadOpt.isolationTaskThreadPoolSize
@@ -229,6 +237,110 @@ int IOManager4File::AioWrite(CurveAioContext* ctx, MDSClient* mdsclient,
     return LIBCURVE_ERROR::OK;
 }
 
+int IOManager4File::AioReadv(CurveAioContext* ctx, const struct iovec* iov,
+                             int iovcnt, MDSClient* mdsclient) {
+    MetricHelper::IncremUserRPSCount(fileMetric_, OpType::READ);
+
+    IOTracker* temp = new (std::nothrow)
+        IOTracker(this, &mc_, scheduler_, fileMetric_, disableStripe_);
+    if (temp == nullptr) {
+        ctx->ret = -LIBCURVE_ERROR::FAILED;
+        ctx->cb(ctx);
+        LOG(ERROR) << "allocate tracker failed!";
+        return LIBCURVE_ERROR::OK;
+    }
+
+    temp->SetUserIOVector(iov, iovcnt);
+    inflightCntl_.IncremInflightNum();
+    auto task = [this, ctx, mdsclient, temp]() {
+        temp->StartAioRead(ctx, mdsclient, this->GetFileInfo(),
+                           throttle_.get());
+    };
+
+    taskPool_.Enqueue(task);
+    return LIBCURVE_ERROR::OK;
+}
+
+int IOManager4File::AioWritev(CurveAioContext* ctx, const struct iovec* iov,
+                              int iovcnt, MDSClient* mdsclient) {
+    MetricHelper::IncremUserRPSCount(fileMetric_, OpType::WRITE);
+
+    IOTracker* temp = new (std::nothrow)
+        IOTracker(this, &mc_, scheduler_, fileMetric_, disableStripe_);
+    if (temp == nullptr) {
+        ctx->ret = -LIBCURVE_ERROR::FAILED;
+        ctx->cb(ctx);
+        LOG(ERROR) << "allocate tracker failed!";
+        return LIBCURVE_ERROR::OK;
+    }
+
+    temp->SetUserIOVector(iov, iovcnt);
+    inflightCntl_.IncremInflightNum();
+    auto task = [this, ctx, mdsclient, temp]() {
+        temp->StartAioWrite(ctx, mdsclient, this->GetFileInfo(),
+                            throttle_.get());
+    };
+
+    taskPool_.Enqueue(task);
+    return LIBCURVE_ERROR::OK;
+}
+
+int IOManager4File::AioSubmit(CurveAioContext* aioctxs[], int num,
+                              MDSClient* mdsclient, UserDataType dataType) {
+    std::vector<std::pair<CurveAioContext*, IOTracker*>> ios;
+    ios.reserve(num);
+
+    for (int i = 0; i < num; ++i) {
+        CurveAioContext* ctx = aioctxs[i];
+        if (ctx->op == LIBCURVE_OP_DISCARD) {
+            AioDiscard(ctx, mdsclient);
+            continue;
+        }
+
+        MetricHelper::IncremUserRPSCount(fileMetric_,
+                                         ctx->op == LIBCURVE_OP_READ
+                                             ? OpType::READ
+                                             : OpType::WRITE);
+        if (ctx->length == 0) {
+            ctx->ret = 0;
+            ctx->cb(ctx);
+            continue;
+        }
+
+        IOTracker* temp = new (std::nothrow)
+            IOTracker(this, &mc_, scheduler_, fileMetric_, disableStripe_);
+        if (temp == nullptr) {
+            ctx->ret = -LIBCURVE_ERROR::FAILED;
+            ctx->cb(ctx);
+            LOG(ERROR) << "allocate tracker failed!";
+            continue;
+        }
+
+        temp->SetUserDataType(dataType);
+        inflightCntl_.IncremInflightNum();
+        ios.emplace_back(ctx, temp);
+    }
+
+    if (ios.empty()) {
+        return num;
+    }
+
+    auto task = [this, ios, mdsclient]() {
+        for (const auto& io : ios) {
+            if (io.first->op == LIBCURVE_OP_READ) {
+                io.second->StartAioRead(io.first, mdsclient,
+                                        this->GetFileInfo(), throttle_.get());
+            } else {
+                io.second->StartAioWrite(io.first, mdsclient,
+                                         this->GetFileInfo(), throttle_.get());
+            }
+        }
+    };
+
+    taskPool_.Enqueue(task);
+    return num;
+}
+
 int IOManager4File::Discard(off_t offset, size_t length, MDSClient* mdsclient) {
     MetricHelper::IncremUserRPSCount(fileMetric_, OpType::DISCARD);
 
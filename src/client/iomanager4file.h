@@ -26,6 +26,8 @@
 #include <bthread/condition_variable.h>
 #include <bthread/mutex.h>
 
+#include <sys/uio.h>
+
 #include <atomic>
 #include <condition_variable>  // NOLINT
 #include <mutex>               // NOLINT
@@ -43,6 +45,7 @@
 #include "src/common/concurrent/task_thread_pool.h"
 #include "src/common/throttle.h"
 #include "src/client/discard_task.h"
+#include "src/client/read_cache.h"
 
 namespace curve {
 namespace client {
@@ -110,6 +113,40 @@ class IOManager4File : public IOManager {
     int AioWrite(CurveAioContext* aioctx, MDSClient* mdsclient,
                  UserDataType dataType);
 
+    /**
+     * @brief Asynchronous vectored read
+     * @param aioctx async request context, aioctx->buf is ignored
+     * @param iov user buffers to read into
+     * @param iovcnt number of user buffers
+     * @param mdsclient for communicate with MDS
+     * @return 0 means success, otherwise it means failure
+     */
+    int AioReadv(CurveAioContext* aioctx, const struct iovec* iov, int iovcnt,
+                 MDSClient* mdsclient);
+
+    /**
+     * @brief Asynchronous vectored write
+     * @param aioctx async request context, aioctx->buf is ignored
+     * @param iov user buffers to write
+     * @param iovcnt number of user buffers
+     * @param mdsclient for communicate with MDS
+     * @return 0 means success, otherwise it means failure
+     */
+    int AioWritev(CurveAioContext* aioctx, const struct iovec* iov,
+                  int iovcnt, MDSClient* mdsclient);
+
+    /**
+     * @brief Submit a batch of asynchronous requests, reads and writes are
+     *        started by one task instead of one task per request
+     * @param aioctxs async request contexts, aioctx->op decides the type
+     * @param num number of requests
+     * @param mdsclient for communicate with MDS
+     * @param dataType type of aioctx->buf
+     * @return number of requests submitted
+     */
+    int AioSubmit(CurveAioContext* aioctxs[], int num, MDSClient* mdsclient,
+                  UserDataType dataType);
+
     /**
      * @brief Synchronous discard operation
      * @param offset discard offset
@@ -208,6 +245,10 @@ class IOManager4File : public IOManager {
 
     void SetDisableStripe();
 
+    ReadCache* GetReadCache() override {
+        return readCache_.get();
+    }
+
  private:
     friend class LeaseExecutor;
     friend class FlightIOGuard;
@@ -298,6 +339,9 @@ class IOManager4File : public IOManager {
     bool disableStripe_;
 
     std::unique_ptr<DiscardTaskManager> discardTaskManager_;
+
+    // in-memory read cache, nullptr if it's disabled
+    std::unique_ptr<ReadCache> readCache_;
 };
 
 }  // namespace client
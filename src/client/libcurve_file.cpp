@@ -130,6 +130,19 @@ void InitLogging(const std::string& confPath) {
     static LoggerGuard guard(confPath);
 }
 
+// check that iov is not empty and covers exactly `length` bytes
+bool CheckIOVector(const struct iovec* iov, int iovcnt, size_t length) {
+    if (iov == nullptr || iovcnt <= 0) {
+        return false;
+    }
+
+    size_t total = 0;
+    for (int i = 0; i < iovcnt; ++i) {
+        total += iov[i].iov_len;
+    }
+    return total == length;
+}
+
 }  // namespace
 
 FileClient::FileClient()
@@ -408,6 +421,109 @@ int FileClient::AioDiscard(int fd, CurveAioContext* aioctx) {
     }
 }
 
+int FileClient::AioReadv(int fd, CurveAioContext* aioctx,
+                         const struct iovec* iov, int iovcnt) {
+    // 长度为0，直接返回，不做任何操作
+    if (aioctx->length == 0) {
+        return -LIBCURVE_ERROR::OK;
+    }
+
+    if (CheckIOVector(iov, iovcnt, aioctx->length) == false) {
+        LOG(ERROR) << "AioReadv iov doesn't match request length, length = "
+                   << aioctx->length << ", iovcnt = " << iovcnt
+                   << ", fd = " << fd;
+        return -LIBCURVE_ERROR::PARAM_ERROR;
+    }
+
+    if (CheckAligned(aioctx->offset, aioctx->length) == false) {
+        LOG(ERROR) << "AioReadv request not aligned, length = "
+                   << aioctx->length << ", offset = " << aioctx->offset
+                   << ", fd = " << fd;
+        return -LIBCURVE_ERROR::NOT_ALIGNED;
+    }
+
+    ReadLockGuard lk(rwlock_);
+    auto iter = fileserviceMap_.find(fd);
+    if (CURVE_UNLIKELY(iter == fileserviceMap_.end())) {
+        LOG(ERROR) << "invalid fd!";
+        return -LIBCURVE_ERROR::BAD_FD;
+    }
+
+    return iter->second->AioReadv(aioctx, iov, iovcnt);
+}
+
+int FileClient::AioWritev(int fd, CurveAioContext* aioctx,
+                          const struct iovec* iov, int iovcnt) {
+    // 长度为0，直接返回，不做任何操作
+    if (aioctx->length == 0) {
+        return -LIBCURVE_ERROR::OK;
+    }
+
+    if (CheckIOVector(iov, iovcnt, aioctx->length) == false) {
+        LOG(ERROR) << "AioWritev iov doesn't match request length, length = "
+                   << aioctx->length << ", iovcnt = " << iovcnt
+                   << ", fd = " << fd;
+        return -LIBCURVE_ERROR::PARAM_ERROR;
+    }
+
+    if (CheckAligned(aioctx->offset, aioctx->length) == false) {
+        LOG(ERROR) << "AioWritev request not aligned, length = "
+                   << aioctx->length << ", offset = " << aioctx->offset
+                   << ", fd = " << fd;
+        return -LIBCURVE_ERROR::NOT_ALIGNED;
+    }
+
+    ReadLockGuard lk(rwlock_);
+    auto iter = fileserviceMap_.find(fd);
+    if (CURVE_UNLIKELY(iter == fileserviceMap_.end())) {
+        LOG(ERROR) << "invalid fd!";
+        return -LIBCURVE_ERROR::BAD_FD;
+    }
+
+    return iter->second->AioWritev(aioctx, iov, iovcnt);
+}
+
+int FileClient::AioSubmit(int fd, CurveAioContext* aioctxs[], int num,
+                          UserDataType dataType) {
+    if (aioctxs == nullptr || num <= 0) {
+        LOG(ERROR) << "AioSubmit invalid request number, num = " << num
+                   << ", fd = " << fd;
+        return -LIBCURVE_ERROR::PARAM_ERROR;
+    }
+
+    // check all requests first, so a batch is submitted entirely or not
+    for (int i = 0; i < num; ++i) {
+        const CurveAioContext* aioctx = aioctxs[i];
+        switch (aioctx->op) {
+            case LIBCURVE_OP_READ:
+            case LIBCURVE_OP_WRITE:
+                if (CheckAligned(aioctx->offset, aioctx->length) == false) {
+                    LOG(ERROR) << "AioSubmit request not aligned, length = "
+                               << aioctx->length
+                               << ", offset = " << aioctx->offset
+                               << ", fd = " << fd;
+                    return -LIBCURVE_ERROR::NOT_ALIGNED;
+                }
+                break;
+            case LIBCURVE_OP_DISCARD:
+                break;
+            default:
+                LOG(ERROR) << "AioSubmit unknown op " << aioctx->op
+                           << ", fd = " << fd;
+                return -LIBCURVE_ERROR::PARAM_ERROR;
+        }
+    }
+
+    ReadLockGuard lk(rwlock_);
+    auto iter = fileserviceMap_.find(fd);
+    if (CURVE_UNLIKELY(iter == fileserviceMap_.end())) {
+        LOG(ERROR) << "invalid fd!";
+        return -LIBCURVE_ERROR::BAD_FD;
+    }
+
+    return iter->second->AioSubmit(aioctxs, num, dataType);
+}
+
 int FileClient::Rename(const UserInfo_t& userinfo,
     const std::string& oldpath, const std::string& newpath) {
     LIBCURVE_ERROR ret;
@@ -812,6 +928,35 @@ int AioDiscard(int fd, CurveAioContext* aioctx) {
     return globalclient->AioDiscard(fd, aioctx);
 }
 
+int AioReadv(int fd, CurveAioContext* aioctx, const struct iovec* iov,
+             int iovcnt) {
+    if (globalclient == nullptr) {
+        LOG(ERROR) << "not inited!";
+        return -LIBCURVE_ERROR::FAILED;
+    }
+
+    return globalclient->AioReadv(fd, aioctx, iov, iovcnt);
+}
+
+int AioWritev(int fd, CurveAioContext* aioctx, const struct iovec* iov,
+              int iovcnt) {
+    if (globalclient == nullptr) {
+        LOG(ERROR) << "not inited!";
+        return -LIBCURVE_ERROR::FAILED;
+    }
+
+    return globalclient->AioWritev(fd, aioctx, iov, iovcnt);
+}
+
+int AioSubmit(int fd, CurveAioContext* aioctxs[], int num) {
+    if (globalclient == nullptr) {
+        LOG(ERROR) << "not inited!";
+        return -LIBCURVE_ERROR::FAILED;
+    }
+
+    return globalclient->AioSubmit(fd, aioctxs, num);
+}
+
 int Create(const char* filename, const C_UserInfo_t* userinfo, size_t size) {
     if (globalclient == nullptr) {
         LOG(ERROR) << "not inited!";
@@ -159,6 +159,43 @@ class FileClient {
      */
     virtual int AioDiscard(int fd, CurveAioContext* aioctx);
 
+    /**
+     * @brief Asynchronous vectored read
+     * @param fd file descriptor
+     * @param aioctx async request context, aioctx->length must equal the
+     *        total length of iov
+     * @param iov buffers to read into
+     * @param iovcnt number of buffers
+     * @return 0 means success, otherwise it means failure
+     */
+    virtual int AioReadv(int fd, CurveAioContext* aioctx,
+                         const struct iovec* iov, int iovcnt);
+
+    /**
+     * @brief Asynchronous vectored write
+     * @param fd file descriptor
+     * @param aioctx async request context, aioctx->length must equal the
+     *        total length of iov
+     * @param iov buffers to write
+     * @param iovcnt number of buffers
+     * @return 0 means success, otherwise it means failure
+     */
+    virtual int AioWritev(int fd, CurveAioContext* aioctx,
+                          const struct iovec* iov, int iovcnt);
+
+    /**
+     * @brief Submit a batch of asynchronous requests, all requests are
+     *        checked before any of them is submitted
+     * @param fd file descriptor
+     * @param aioctxs async request contexts, aioctx->op decides the type
+     * @param num number of requests
+     * @param dataType type of aioctx->buf of read and write requests
+     * @return number of requests submitted, a negative error code if none
+     *         is submitted
+     */
+    virtual int AioSubmit(int fd, CurveAioContext* aioctxs[], int num,
+                          UserDataType dataType = UserDataType::RawBuffer);
+
     /**
      * 重命名文件
      * @param: userinfo是用户信息
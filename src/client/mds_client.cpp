@@ -888,12 +888,24 @@ LIBCURVE_ERROR MDSClient::SetCloneFileStatus(const std::string &filename,
 LIBCURVE_ERROR MDSClient::GetOrAllocateSegment(bool allocate, uint64_t offset,
                                                const FInfo_t *fi,
                                                SegmentInfo *segInfo) {
+    std::vector<SegmentInfo> segInfos;
+    LIBCURVE_ERROR ret =
+        GetOrAllocateSegments(allocate, offset, fi, 1, &segInfos);
+    if (ret == LIBCURVE_ERROR::OK) {
+        *segInfo = std::move(segInfos[0]);
+    }
+    return ret;
+}
+
+LIBCURVE_ERROR MDSClient::GetOrAllocateSegments(
+    bool allocate, uint64_t offset, const FInfo_t *fi, uint32_t segmentNum,
+    std::vector<SegmentInfo> *segInfos) {
     auto task = RPCTaskDefine {
         GetOrAllocateSegmentResponse response;
         mdsClientMetric_.getOrAllocateSegment.qps.count << 1;
         LatencyGuard lg(&mdsClientMetric_.getOrAllocateSegment.latency);
-        MDSClientBase::GetOrAllocateSegment(allocate, offset, fi, &response,
-                                            cntl, channel);
+        MDSClientBase::GetOrAllocateSegment(allocate, offset, fi, segmentNum,
+                                            &response, cntl, channel);
         if (cntl->Failed()) {
             mdsClientMetric_.getOrAllocateSegment.eps.count << 1;
             LOG(WARNING) << "allocate segment failed, error code = "
@@ -921,25 +933,34 @@ LIBCURVE_ERROR MDSClient::GetOrAllocateSegment(bool allocate, uint64_t offset,
             break;
         }
 
-        PageFileSegment pfs = response.pagefilesegment();
-        segInfo->chunksize = pfs.chunksize();
-        segInfo->segmentsize = pfs.segmentsize();
-        segInfo->startoffset = pfs.startoffset();
-        LogicPoolID logicpoolid = pfs.logicalpoolid();
-        segInfo->lpcpIDInfo.lpid = pfs.logicalpoolid();
-
-        int chunksNum = pfs.chunks_size();
-        if (allocate && chunksNum <= 0) {
-            LOG(WARNING) << "MDS allocate segment, but no chunkinfo!";
-            // Now, we will retry until allocate segment success
-            return -LIBCURVE_ERROR::RETRY_UNTIL_SUCCESS;
-        }
+        segInfos->clear();
+        segInfos->reserve(1 + response.followingsegments_size());
+        for (int i = -1; i < response.followingsegments_size(); ++i) {
+            const PageFileSegment& pfs = i < 0
+                                             ? response.pagefilesegment()
+                                             : response.followingsegments(i);
+            segInfos->emplace_back();
+            SegmentInfo* segInfo = &segInfos->back();
+            segInfo->chunksize = pfs.chunksize();
+            segInfo->segmentsize = pfs.segmentsize();
+            segInfo->startoffset = pfs.startoffset();
+            LogicPoolID logicpoolid = pfs.logicalpoolid();
+            segInfo->lpcpIDInfo.lpid = pfs.logicalpoolid();
+
+            int chunksNum = pfs.chunks_size();
+            if (allocate && chunksNum <= 0) {
+                LOG(WARNING) << "MDS allocate segment, but no chunkinfo!";
+                // Now, we will retry until allocate segment success
+                return -LIBCURVE_ERROR::RETRY_UNTIL_SUCCESS;
+            }
 
-        for (int i = 0; i < chunksNum; i++) {
-            ChunkID chunkid = pfs.chunks(i).chunkid();
-            CopysetID copysetid = pfs.chunks(i).copysetid();
-            segInfo->lpcpIDInfo.cpidVec.push_back(copysetid);
-            segInfo->chunkvec.emplace_back(chunkid, logicpoolid, copysetid);
+            for (int j = 0; j < chunksNum; j++) {
+                ChunkID chunkid = pfs.chunks(j).chunkid();
+                CopysetID copysetid = pfs.chunks(j).copysetid();
+                segInfo->lpcpIDInfo.cpidVec.push_back(copysetid);
+                segInfo->chunkvec.emplace_back(chunkid, logicpoolid,
+                                               copysetid);
+            }
         }
         return LIBCURVE_ERROR::OK;
     };
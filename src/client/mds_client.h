@@ -230,6 +230,24 @@ class MDSClient : public MDSClientBase,
                                         const FInfo_t *fi,
                                         SegmentInfo *segInfo);
 
+    /**
+     * @brief Get or allocate segmentNum consecutive segments starting at the
+     *        segment which contains offset, new segments are allocated by mds
+     *        in one transaction
+     * @param allocate allocate the segments if not exist
+     * @param offset offset in file
+     * @param fi file info
+     * @param segmentNum number of segments wanted, mds may return less
+     *        segments if the file ends or allocation of a later segment fails
+     * @param[out] segInfos segments info, at least one on success
+     * @return LIBCURVE_ERROR::OK on success, otherwise same as
+     *         GetOrAllocateSegment
+     */
+    LIBCURVE_ERROR GetOrAllocateSegments(bool allocate, uint64_t offset,
+                                         const FInfo_t *fi,
+                                         uint32_t segmentNum,
+                                         std::vector<SegmentInfo> *segInfos);
+
     /**
      * @brief Send DeAllocateSegment request to current working MDS
      * @param fileInfo current file info
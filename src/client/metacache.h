@@ -22,6 +22,8 @@
 #ifndef SRC_CLIENT_METACACHE_H_
 #define SRC_CLIENT_METACACHE_H_
 
+#include <atomic>
+#include <limits>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -247,6 +249,20 @@ class MetaCache {
      */
     virtual void CleanChunksInSegment(SegmentIndex segmentIndex);
 
+    /**
+     * @brief Record the last segment allocated by this client, a first write
+     *        right after it is treated as sequential
+     */
+    void SetLastAllocatedSegment(SegmentIndex segmentIndex) {
+        lastAllocatedSegment_.store(segmentIndex, std::memory_order_relaxed);
+    }
+
+    bool IsSequentialAllocation(SegmentIndex segmentIndex) const {
+        SegmentIndex last =
+            lastAllocatedSegment_.load(std::memory_order_relaxed);
+        return last != kInvalidSegmentIndex && segmentIndex == last + 1;
+    }
+
  private:
     /**
      * @brief 从mds更新copyset复制组信息
@@ -314,6 +330,10 @@ class MetaCache {
     FInfo fileInfo_;
 
     UnstableHelper unstableHelper_;
+
+    static constexpr SegmentIndex kInvalidSegmentIndex =
+        std::numeric_limits<SegmentIndex>::max();
+    std::atomic<SegmentIndex> lastAllocatedSegment_{kInvalidSegmentIndex};
 };
 
 }  // namespace client
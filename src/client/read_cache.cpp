@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#include "src/client/read_cache.h"
+
+#include <glog/logging.h>
+
+#include <utility>
+#include <vector>
+
+namespace curve {
+namespace client {
+
+namespace {
+
+// split the cache into 16 shards to reduce lock contention between the
+// task threads and the brpc threads which complete reads
+const uint32_t kReadCacheShardBits = 4;
+
+const uint64_t kMiB = 1024ull * 1024;
+
+}  // namespace
+
+ReadCache::ReadCache(const ReadCacheOption& option,
+                     const std::string& metricPrefix)
+    : blockSize_(option.blockSize),
+      metrics_(std::make_shared<CacheMetrics>(metricPrefix)),
+      cache_(new BlockCache(kReadCacheShardBits, 0,
+                            option.capacityMB * kMiB, metrics_)),
+      epoch_(0) {
+    CHECK(blockSize_ > 0) << "read cache block size must be positive";
+}
+
+bool ReadCache::Get(off_t offset, size_t length, uint64_t seq,
+                    butil::IOBuf* data) {
+    if (length == 0) {
+        return false;
+    }
+
+    const uint64_t first = offset / blockSize_;
+    const uint64_t last = (offset + length - 1) / blockSize_;
+
+    butil::IOBuf blocks;
+    Block block;
+    for (uint64_t index = first; index <= last; ++index) {
+        if (!cache_->Get(index, &block)) {
+            return false;
+        }
+        if (block.seq != seq) {
+            // cached before the sequence of the file changed
+            cache_->Remove(index);
+            return false;
+        }
+        blocks.append(block.data);
+    }
+
+    blocks.pop_front(offset - first * blockSize_);
+    blocks.cutn(data, length);
+    return true;
+}
+
+void ReadCache::Put(off_t offset, const butil::IOBuf& data, uint64_t seq,
+                    uint64_t epoch) {
+    const uint64_t begin = offset;
+    const uint64_t end = offset + data.size();
+    // only blocks fully covered by the data are cached
+    const uint64_t first = (begin + blockSize_ - 1) / blockSize_;
+    const uint64_t last = end / blockSize_;
+    if (first >= last) {
+        return;
+    }
+
+    butil::IOBuf remain(data);
+    remain.pop_front(first * blockSize_ - begin);
+
+    std::vector<std::pair<uint64_t, Block>> blocks;
+    blocks.reserve(last - first);
+    for (uint64_t index = first; index < last; ++index) {
+        Block block;
+        block.seq = seq;
+        remain.cutn(&block.data, blockSize_);
+        blocks.emplace_back(index, std::move(block));
+    }
+
+    curve::common::LockGuard lk(mtx_);
+    if (epoch != epoch_.load(std::memory_order_acquire)) {
+        // the file is written during the read, the data may be stale
+        return;
+    }
+
+    for (const auto& block : blocks) {
+        cache_->Put(block.first, block.second);
+    }
+}
+
+void ReadCache::Invalidate(off_t offset, size_t length) {
+    if (length == 0) {
+        return;
+    }
+
+    const uint64_t first = offset / blockSize_;
+    const uint64_t last = (offset + length - 1) / blockSize_;
+
+    curve::common::LockGuard lk(mtx_);
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+    for (uint64_t index = first; index <= last; ++index) {
+        cache_->Remove(index);
+    }
+}
+
+}  // namespace client
+}  // namespace curve
@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#ifndef SRC_CLIENT_READ_CACHE_H_
+#define SRC_CLIENT_READ_CACHE_H_
+
+#include <butil/iobuf.h>
+#include <sys/types.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "src/client/config_info.h"
+#include "src/common/concurrent/concurrent.h"
+#include "src/common/lru_cache.h"
+
+namespace curve {
+namespace client {
+
+using curve::common::CacheMetrics;
+
+/**
+ * ReadCache is an in-memory cache of file data read from chunkservers,
+ * the data is cached in blocks of blockSize bytes.
+ *
+ * Only whole blocks are cached, and a read is served from the cache only if
+ * all blocks it covers are cached. Each block records the file sequence
+ * number when it was read, it is treated as a miss after the sequence
+ * changes.
+ *
+ * Writes and discards invalidate the blocks they cover before they are sent
+ * and again after they are finished. They also bump an epoch, reads which
+ * started before the epoch changed don't fill the cache, so data read
+ * concurrently with a write never stays in the cache.
+ */
+class ReadCache {
+ public:
+    /**
+     * @param option read cache option
+     * @param metricPrefix prefix of the hit/miss and size metrics
+     */
+    ReadCache(const ReadCacheOption& option, const std::string& metricPrefix);
+
+    /**
+     * @brief Get current epoch, callers save it before reading from
+     *        chunkservers and pass it to Put
+     */
+    uint64_t GetEpoch() const {
+        return epoch_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Read data from the cache
+     * @param offset offset in the file
+     * @param length length to read
+     * @param seq current sequence number of the file
+     * @param[out] data data read from the cache
+     * @return true if all blocks are cached, otherwise false
+     */
+    bool Get(off_t offset, size_t length, uint64_t seq, butil::IOBuf* data);
+
+    /**
+     * @brief Put data read from chunkservers into the cache, blocks partially
+     *        covered by the data are ignored
+     * @param offset offset of the data in the file
+     * @param data data read from chunkservers
+     * @param seq sequence number of the file when the read started
+     * @param epoch epoch when the read started
+     */
+    void Put(off_t offset, const butil::IOBuf& data, uint64_t seq,
+             uint64_t epoch);
+
+    /**
+     * @brief Invalidate blocks overlapped with [offset, offset + length)
+     */
+    void Invalidate(off_t offset, size_t length);
+
+    std::shared_ptr<CacheMetrics> GetCacheMetrics() const {
+        return metrics_;
+    }
+
+ private:
+    struct Block {
+        uint64_t seq = 0;
+        butil::IOBuf data;
+    };
+
+    struct BlockTraits {
+        static uint64_t CountBytes(const Block& block) {
+            return block.data.size();
+        }
+    };
+
+    using BlockCache = curve::common::ShardedLRUCache<
+        uint64_t, Block, curve::common::CacheTraits<uint64_t>, BlockTraits>;
+
+ private:
+    const uint64_t blockSize_;
+
+    std::shared_ptr<CacheMetrics> metrics_;
+
+    std::unique_ptr<BlockCache> cache_;
+
+    // serialize Put and Invalidate, so that a block can't be put after the
+    // epoch is changed by a write
+    curve::common::Mutex mtx_;
+
+    std::atomic<uint64_t> epoch_;
+};
+
+}  // namespace client
+}  // namespace curve
+
+#endif  // SRC_CLIENT_READ_CACHE_H_
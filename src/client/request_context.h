@@ -27,6 +27,7 @@
 
 #include <atomic>
 #include <string>
+#include <vector>
 
 #include "src/client/client_common.h"
 #include "src/client/request_closure.h"
@@ -127,6 +128,10 @@ struct CURVE_CACHELINE_ALIGNMENT RequestContext {
     // 当前request context id
     uint64_t            id_ = 0;
 
+    // 和当前request合并成一个批量写rpc发送的其他写请求，
+    // 只有放入调度队列的第一个request会设置
+    std::vector<RequestContext*> batchRequests_;
+
     Padding padding;
 
     static RequestContext* NewInitedRequestContext() {
@@ -25,6 +25,9 @@
 #include <brpc/closure_guard.h>
 #include <glog/logging.h>
 
+#include <unordered_map>
+#include <utility>
+
 #include "src/client/request_context.h"
 #include "src/client/request_closure.h"
 #include "src/client/chunk_closure.h"
@@ -90,6 +93,8 @@ int RequestScheduler::ScheduleRequest(
     const std::vector<RequestContext*>& requests) {
     if (running_.load(std::memory_order_acquire)) {
         /* TODO(wudemiao): 后期考虑 qos */
+        std::vector<RequestContext*> scheduled;
+        scheduled.reserve(requests.size());
         for (auto it : requests) {
             // skip the fake request
             if (!it->idinfo_.chunkExist) {
@@ -99,6 +104,11 @@ int RequestScheduler::ScheduleRequest(
                 continue;
             }
 
+            scheduled.push_back(it);
+        }
+
+        MergeWriteRequests(&scheduled);
+        for (auto it : scheduled) {
             BBQItem<RequestContext *> req(it);
             queue_.PutBack(req);
         }
@@ -107,6 +117,47 @@ int RequestScheduler::ScheduleRequest(
     return -1;
 }
 
+void RequestScheduler::MergeWriteRequests(
+    std::vector<RequestContext*>* requests) const {
+    const IOSenderOption& opt = reqschopt_.ioSenderOpt;
+    if (opt.chunkserverWriteBatchMaxNum <= 1 || requests->size() <= 1) {
+        return;
+    }
+
+    // 同一个copyset上正在合并的批量写的第一个请求及其数据量
+    std::unordered_map<uint64_t, std::pair<RequestContext*, uint64_t>> heads;
+    std::vector<RequestContext*> merged;
+    merged.reserve(requests->size());
+    for (auto req : *requests) {
+        if (req->optype_ != OpType::WRITE || !req->padding.aligned ||
+            req->sourceInfo_.IsValid()) {
+            merged.push_back(req);
+            continue;
+        }
+
+        uint64_t key =
+            (static_cast<uint64_t>(req->idinfo_.lpid_) << 32) |
+            req->idinfo_.cpid_;
+        auto iter = heads.find(key);
+        if (iter != heads.end()) {
+            RequestContext* head = iter->second.first;
+            uint64_t bytes = iter->second.second + req->rawlength_;
+            if (head->batchRequests_.size() + 1 <
+                    opt.chunkserverWriteBatchMaxNum &&
+                bytes <= opt.chunkserverWriteBatchMaxBytes) {
+                head->batchRequests_.push_back(req);
+                iter->second.second = bytes;
+                continue;
+            }
+        }
+
+        heads[key] = std::make_pair(req, req->rawlength_);
+        merged.push_back(req);
+    }
+
+    requests->swap(merged);
+}
+
 int RequestScheduler::ScheduleRequest(RequestContext *request) {
     if (running_.load(std::memory_order_acquire)) {
         BBQItem<RequestContext *> req(request);
@@ -174,6 +225,11 @@ void RequestScheduler::ProcessAligned(RequestContext* ctx) {
                               ctx->sourceInfo_, guard.release());
             break;
         case OpType::WRITE:
+            if (!ctx->batchRequests_.empty()) {
+                guard.release();
+                ProcessWriteBatch(ctx);
+                break;
+            }
             ctx->done_->GetInflightRPCToken();
             client_.WriteChunk(ctx->idinfo_, ctx->seq_, ctx->writeData_,
                                ctx->offset_, ctx->rawlength_, ctx->sourceInfo_,
@@ -206,6 +262,21 @@ void RequestScheduler::ProcessAligned(RequestContext* ctx) {
     }
 }
 
+void RequestScheduler::ProcessWriteBatch(RequestContext* ctx) {
+    std::vector<RequestContext*> requests;
+    requests.reserve(ctx->batchRequests_.size() + 1);
+    requests.push_back(ctx);
+    requests.insert(requests.end(), ctx->batchRequests_.begin(),
+                    ctx->batchRequests_.end());
+    // 批量写失败后各个请求单独重试, 不再合并
+    ctx->batchRequests_.clear();
+
+    // 一批请求作为一个rpc下发, 只由第一个请求持有inflight token,
+    // 避免多个调度线程各自持有部分token后互相等待
+    ctx->done_->GetInflightRPCToken();
+    client_.WriteChunkBatch(requests);
+}
+
 void RequestScheduler::ProcessUnaligned(RequestContext* ctx) {
     brpc::ClosureGuard doneGuard(ctx->done_);
     if (ctx->optype_ != OpType::READ && ctx->optype_ != OpType::WRITE) {
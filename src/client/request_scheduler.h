@@ -142,6 +142,18 @@ class RequestScheduler : public Uncopyable {
 
     void ProcessUnaligned(RequestContext* ctx);
 
+    /**
+     * 发送合并后的批量写请求, ctx为放入队列的第一个请求
+     */
+    void ProcessWriteBatch(RequestContext* ctx);
+
+    /**
+     * 把写同一copyset的请求合并, 合并后只有第一个请求放入调度队列,
+     * 其他请求记录在它的batchRequests_中
+     * @param[in,out] requests: 待调度的请求, 返回需要放入队列的请求
+     */
+    void MergeWriteRequests(std::vector<RequestContext*>* requests) const;
+
     void WaitValidSession() {
         // lease续约失败的时候需要阻塞IO直到续约成功
         if (blockIO_.load(std::memory_order_acquire) && blockingQueue_) {
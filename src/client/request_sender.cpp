@@ -59,12 +59,24 @@ inline void RequestSender::SetRpcStuff(
     done->SetResponse(rpcResponse);
     done->SetChunkServerID(chunkServerId_);
     done->SetChunkServerEndPoint(serverEndPoint_);
+
+    inflight_->fetch_add(1, std::memory_order_relaxed);
+    done->SetConnection(connectionIndex_, inflight_);
 }
 
 int RequestSender::Init(const IOSenderOption& ioSenderOpt) {
-    if (0 != channel_.Init(serverEndPoint_, NULL)) {
+    brpc::ChannelOptions options;
+    // channels in the same connection group share one connection to the
+    // chunkserver, so each extra connection uses its own group
+    if (connectionIndex_ > 0) {
+        options.connection_group =
+            "curve_client_conn_" + std::to_string(connectionIndex_);
+    }
+
+    if (0 != channel_.Init(serverEndPoint_, &options)) {
         LOG(ERROR) << "failed to init channel to server, id: " << chunkServerId_
-                   << ", "<< serverEndPoint_.ip << ":" << serverEndPoint_.port;
+                   << ", "<< serverEndPoint_.ip << ":" << serverEndPoint_.port
+                   << ", connection index: " << connectionIndex_;
         return -1;
     }
     iosenderopt_ = ioSenderOpt;
@@ -79,7 +91,8 @@ int RequestSender::ReadChunk(const ChunkIDInfo& idinfo,
                              size_t length,
                              uint64_t appliedindex,
                              const RequestSourceInfo& sourceInfo,
-                             ClientClosure *done) {
+                             ClientClosure *done,
+                             bool followerRead) {
     brpc::ClosureGuard doneGuard(done);
     brpc::Controller *cntl = new brpc::Controller();
     ChunkResponse *response = new ChunkResponse();
@@ -102,6 +115,9 @@ int RequestSender::ReadChunk(const ChunkIDInfo& idinfo,
 
     if (iosenderopt_.chunkserverEnableAppliedIndexRead && appliedindex > 0) {
         request.set_appliedindex(appliedindex);
+        if (followerRead) {
+            request.set_followerread(true);
+        }
     }
 
     ChunkService_Stub stub(&channel_);
@@ -148,6 +164,55 @@ int RequestSender::WriteChunk(const ChunkIDInfo& idinfo,
     return 0;
 }
 
+int RequestSender::WriteChunkBatch(
+    const std::vector<RequestContext*>& requests,
+    WriteChunkBatchClosure *done) {
+    brpc::ClosureGuard doneGuard(done);
+    brpc::Controller *cntl = new brpc::Controller();
+    ChunkResponse *response = new ChunkResponse();
+
+    uint64_t timeoutMs = iosenderopt_.failRequestOpt.chunkserverRPCTimeoutMS;
+    for (auto req : requests) {
+        timeoutMs = std::max(timeoutMs, req->done_->GetNextTimeoutMS());
+        MetricHelper::IncremRPCRPSCount(req->done_->GetMetric(),
+                                        OpType::WRITE);
+    }
+    cntl->set_timeout_ms(timeoutMs);
+    done->SetCntl(cntl);
+    done->SetResponse(response);
+    done->SetChunkServerID(chunkServerId_);
+    inflight_->fetch_add(1, std::memory_order_relaxed);
+    done->SetConnection(connectionIndex_, inflight_);
+
+    const ChunkIDInfo& idinfo = requests.front()->idinfo_;
+    ChunkRequest request;
+    request.set_optype(
+        curve::chunkserver::CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH);
+    request.set_logicpoolid(idinfo.lpid_);
+    request.set_copysetid(idinfo.cpid_);
+    request.set_chunkid(idinfo.cid_);
+
+    uint64_t size = 0;
+    for (auto req : requests) {
+        ChunkRequest* sub = request.add_subrequests();
+        sub->set_optype(curve::chunkserver::CHUNK_OP_TYPE::CHUNK_OP_WRITE);
+        sub->set_logicpoolid(req->idinfo_.lpid_);
+        sub->set_copysetid(req->idinfo_.cpid_);
+        sub->set_chunkid(req->idinfo_.cid_);
+        sub->set_sn(req->seq_);
+        sub->set_offset(req->offset_);
+        sub->set_size(req->rawlength_);
+        size += req->rawlength_;
+        cntl->request_attachment().append(req->writeData_);
+    }
+    request.set_size(size);
+
+    ChunkService_Stub stub(&channel_);
+    stub.WriteChunkBatch(cntl, &request, response, doneGuard.release());
+
+    return 0;
+}
+
 int RequestSender::ReadChunkSnapshot(const ChunkIDInfo& idinfo,
                                      uint64_t sn,
                                      off_t offset,
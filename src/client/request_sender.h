@@ -27,7 +27,10 @@
 #include <butil/endpoint.h>
 #include <butil/iobuf.h>
 
+#include <atomic>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "src/client/client_config.h"
 #include "src/client/client_common.h"
@@ -39,15 +42,18 @@ namespace curve {
 namespace client {
 
 /**
- * 一个RequestSender负责管理一个ChunkServer的所有
- * connection，目前一个ChunkServer仅有一个connection
+ * 一个RequestSender负责管理到ChunkServer的一个connection，
+ * 一个ChunkServer可以有多个RequestSender，通过connectionIndex区分
  */
 class RequestSender {
  public:
     RequestSender(ChunkServerID chunkServerId,
-                  butil::EndPoint serverEndPoint)
+                  butil::EndPoint serverEndPoint,
+                  uint32_t connectionIndex = 0)
         : chunkServerId_(chunkServerId),
           serverEndPoint_(serverEndPoint),
+          connectionIndex_(connectionIndex),
+          inflight_(std::make_shared<std::atomic<uint64_t>>(0)),
           channel_() {}
     virtual ~RequestSender() {}
 
@@ -62,6 +68,7 @@ class RequestSender {
      * @param appliedindex:需要读到>=appliedIndex的数据
      * @param sourceInfo 数据源信息
      * @param done:上一层异步回调的closure
+     * @param followerRead:是否允许follower处理该读请求
      */
     int ReadChunk(const ChunkIDInfo& idinfo,
                   uint64_t sn,
@@ -69,7 +76,8 @@ class RequestSender {
                   size_t length,
                   uint64_t appliedindex,
                   const RequestSourceInfo& sourceInfo,
-                  ClientClosure *done);
+                  ClientClosure *done,
+                  bool followerRead = false);
 
     /**
    * 写Chunk
@@ -89,6 +97,14 @@ class RequestSender {
                    const RequestSourceInfo& sourceInfo,
                    ClientClosure *done);
 
+    /**
+     * 批量写同一copyset上的多个chunk, 作为一个rpc发送
+     * @param requests: 写请求, 都属于同一个copyset
+     * @param done: 批量写rpc的回调
+     */
+    int WriteChunkBatch(const std::vector<RequestContext*>& requests,
+                        WriteChunkBatchClosure *done);
+
     /**
      * 读Chunk快照文件
      * @param idinfo为chunk相关的id信息
@@ -172,6 +188,17 @@ class RequestSender {
        return channel_.CheckHealth() == 0;
     }
 
+    uint32_t GetConnectionIndex() const {
+        return connectionIndex_;
+    }
+
+    /**
+     * @brief 获取当前connection上已发出但还未返回的rpc数量
+     */
+    uint64_t GetInflightNum() const {
+        return inflight_->load(std::memory_order_relaxed);
+    }
+
  private:
     void UpdateRpcRPS(ClientClosure* done, OpType type) const;
 
@@ -185,7 +212,11 @@ class RequestSender {
     ChunkServerID chunkServerId_;
     // ChunkServer 的地址
     butil::EndPoint serverEndPoint_;
-    brpc::Channel channel_; /* TODO(wudemiao): 后期会维护多个 channel */
+    // 当前connection在该ChunkServer所有connection中的序号
+    uint32_t connectionIndex_;
+    // 当前connection上未返回的rpc数量，rpc返回时由closure递减
+    std::shared_ptr<std::atomic<uint64_t>> inflight_;
+    brpc::Channel channel_;
 };
 
 }   // namespace client
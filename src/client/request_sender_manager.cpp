@@ -22,6 +22,8 @@
 
 #include "src/client/request_sender_manager.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "src/client/request_sender.h"
@@ -32,33 +34,52 @@ namespace client {
 RequestSenderManager::SenderPtr RequestSenderManager::GetOrCreateSender(
     const ChunkServerID& leaderId,
     const butil::EndPoint& leaderAddr,
-    const IOSenderOption& senderopt) {
+    const IOSenderOption& senderopt,
+    CopysetID copysetId) {
+    const uint32_t connectionNum =
+        std::max(1u, senderopt.chunkserverConnectionNum);
+    const ConnectionSelectPolicy policy =
+        senderopt.chunkserverConnectionSelectPolicy;
+
     {
         curve::common::ReadLockGuard guard(rwlock_);
         auto iter = senderPool_.find(leaderId);
-        if (senderPool_.end() != iter) {
-            return iter->second;
+        if (senderPool_.end() != iter &&
+            iter->second.size() == connectionNum) {
+            const auto& senders = iter->second;
+            const auto& sender =
+                senders[SelectConnection(senders, policy, copysetId)];
+            if (nullptr != sender) {
+                return sender;
+            }
         }
     }
 
     curve::common::WriteLockGuard guard(rwlock_);
-    auto iter = senderPool_.find(leaderId);
-    if (senderPool_.end() != iter) {
-        return iter->second;
+    auto& senders = senderPool_[leaderId];
+    if (senders.size() != connectionNum) {
+        senders.resize(connectionNum);
+    }
+
+    uint32_t index = SelectConnection(senders, policy, copysetId);
+    if (nullptr != senders[index]) {
+        return senders[index];
     }
 
-    SenderPtr sender = std::make_shared<RequestSender>(leaderId, leaderAddr);
+    SenderPtr sender =
+        std::make_shared<RequestSender>(leaderId, leaderAddr, index);
     int rc = sender->Init(senderopt);
     if (rc != 0) {
         return nullptr;
     }
 
-    senderPool_.emplace(leaderId, sender);
+    senders[index] = sender;
 
     return sender;
 }
 
-void RequestSenderManager::ResetSenderIfNotHealth(const ChunkServerID& csId) {
+void RequestSenderManager::ResetSenderIfNotHealth(const ChunkServerID& csId,
+                                                  uint32_t connectionIndex) {
     curve::common::WriteLockGuard guard(rwlock_);
     auto iter = senderPool_.find(csId);
 
@@ -66,12 +87,67 @@ void RequestSenderManager::ResetSenderIfNotHealth(const ChunkServerID& csId) {
         return;
     }
 
+    auto& senders = iter->second;
+    if (connectionIndex >= senders.size() ||
+        nullptr == senders[connectionIndex]) {
+        return;
+    }
+
     // 检查是否健康
-    if (iter->second->IsSocketHealth()) {
+    if (senders[connectionIndex]->IsSocketHealth()) {
         return;
     }
 
-    senderPool_.erase(iter);
+    // 只重置出错的链接，其他链接上的请求不受影响
+    senders[connectionIndex].reset();
+}
+
+uint64_t RequestSenderManager::GetInflightNum(const ChunkServerID& csId) {
+    curve::common::ReadLockGuard guard(rwlock_);
+    auto iter = senderPool_.find(csId);
+    if (iter == senderPool_.end()) {
+        return 0;
+    }
+
+    uint64_t inflight = 0;
+    for (const auto& sender : iter->second) {
+        if (nullptr != sender) {
+            inflight += sender->GetInflightNum();
+        }
+    }
+
+    return inflight;
+}
+
+uint32_t RequestSenderManager::SelectConnection(
+    const std::vector<SenderPtr>& senders,
+    ConnectionSelectPolicy policy,
+    CopysetID copysetId) {
+    if (senders.size() <= 1) {
+        return 0;
+    }
+
+    if (policy == ConnectionSelectPolicy::CopysetHash) {
+        // 同一个copyset的请求总是走同一个链接，保持请求的发送顺序
+        return copysetId % senders.size();
+    }
+
+    // 选择未返回rpc最少的链接，还未创建的链接上没有rpc
+    uint32_t index = 0;
+    uint64_t minInflight = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < senders.size(); ++i) {
+        if (nullptr == senders[i]) {
+            return i;
+        }
+
+        uint64_t inflight = senders[i]->GetInflightNum();
+        if (inflight < minInflight) {
+            minInflight = inflight;
+            index = i;
+        }
+    }
+
+    return index;
 }
 
 }   // namespace client
@@ -25,6 +25,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "src/client/client_common.h"
 #include "src/client/config_info.h"
@@ -39,7 +40,9 @@ using curve::common::Uncopyable;
 class RequestSender;
 /**
  * 所有Chunk Server的request sender管理者，
- * 可以理解为Chunk Server的链接管理者
+ * 可以理解为Chunk Server的链接管理者。
+ * 每个Chunk Server可以建立多个链接，每个链接对应一个request sender，
+ * 请求按照配置的策略分散到不同的链接上
  */
 class RequestSenderManager : public Uncopyable {
  public:
@@ -51,23 +54,44 @@ class RequestSenderManager : public Uncopyable {
      * 地址，创建新的 sender并返回
      * @param leaderId:leader的id
      * @param leaderAddr:leader的地址
+     * @param copysetId:请求所属的copyset，按copyset选择链接时使用
      * @return nullptr:get或者create失败，否则成功
      */
     SenderPtr GetOrCreateSender(const ChunkServerID& leaderId,
                                 const butil::EndPoint& leaderAddr,
-                                const IOSenderOption& senderopt);
+                                const IOSenderOption& senderopt,
+                                CopysetID copysetId = 0);
 
     /**
      * @brief 如果csId对应的RequestSender不健康，就进行重置
      * @param csId chunkserver id
+     * @param connectionIndex 链接序号，只重置该链接
      */
-    void ResetSenderIfNotHealth(const ChunkServerID& csId);
+    void ResetSenderIfNotHealth(const ChunkServerID& csId,
+                                uint32_t connectionIndex = 0);
+
+    /**
+     * @brief 获取发往chunkserver且还未返回的rpc数量，所有链接的总和
+     * @param csId chunkserver id
+     * @return 还没有建立链接时返回0
+     */
+    uint64_t GetInflightNum(const ChunkServerID& csId);
+
+ private:
+    /**
+     * @brief 从chunkserver的所有链接中选择一个
+     * @return 选中链接的序号，对应的sender可能还未创建
+     */
+    static uint32_t SelectConnection(const std::vector<SenderPtr>& senders,
+                                     ConnectionSelectPolicy policy,
+                                     CopysetID copysetId);
 
  private:
     // 读写锁，保护senderPool_
     curve::common::BthreadRWLock rwlock_;
-    // 请求发送链接的map，以ChunkServer ID为key
-    std::unordered_map<ChunkServerID, SenderPtr> senderPool_;
+    // 请求发送链接的map，以ChunkServer ID为key，
+    // value为该ChunkServer的所有链接，按链接序号索引
+    std::unordered_map<ChunkServerID, std::vector<SenderPtr>> senderPool_;
 };
 
 }   // namespace client
@@ -225,9 +225,19 @@ bool Splitor::GetOrAllocateSegment(bool allocateIfNotExist,
                                    MetaCache* metaCache,
                                    const FInfo* fileInfo,
                                    ChunkIndex chunkidx) {
-    SegmentInfo segmentInfo;
-    LIBCURVE_ERROR errCode = mdsClient->GetOrAllocateSegment(
-        allocateIfNotExist, offset, fileInfo, &segmentInfo);
+    // allocate several segments ahead if the previous segment was just
+    // allocated by this client, which is the common case of filling a new
+    // volume sequentially
+    const SegmentIndex segmentIndex = offset / fileInfo->segmentsize;
+    uint32_t segmentNum = 1;
+    if (allocateIfNotExist && iosplitopt_.segmentPreallocNum > 1 &&
+        metaCache->IsSequentialAllocation(segmentIndex)) {
+        segmentNum = iosplitopt_.segmentPreallocNum;
+    }
+
+    std::vector<SegmentInfo> segmentInfos;
+    LIBCURVE_ERROR errCode = mdsClient->GetOrAllocateSegments(
+        allocateIfNotExist, offset, fileInfo, segmentNum, &segmentInfos);
 
     if (errCode == LIBCURVE_ERROR::FAILED ||
         errCode == LIBCURVE_ERROR::AUTHFAIL) {
@@ -242,6 +252,25 @@ bool Splitor::GetOrAllocateSegment(bool allocateIfNotExist,
         return true;
     }
 
+    for (const auto& segmentInfo : segmentInfos) {
+        if (!UpdateSegmentInfo(segmentInfo, mdsClient, metaCache,
+                               fileInfo)) {
+            return false;
+        }
+    }
+
+    if (allocateIfNotExist) {
+        metaCache->SetLastAllocatedSegment(
+            segmentIndex + segmentInfos.size() - 1);
+    }
+
+    return true;
+}
+
+bool Splitor::UpdateSegmentInfo(const SegmentInfo& segmentInfo,
+                                MDSClient* mdsClient,
+                                MetaCache* metaCache,
+                                const FInfo* fileInfo) {
     const auto chunksize = fileInfo->chunksize;
     uint32_t count = 0;
     for (const auto& chunkIdInfo : segmentInfo.chunkvec) {
@@ -252,9 +281,9 @@ bool Splitor::GetOrAllocateSegment(bool allocateIfNotExist,
     }
 
     std::vector<CopysetInfo<ChunkServerID>> copysetInfos;
-    errCode = mdsClient->GetServerList(segmentInfo.lpcpIDInfo.lpid,
-                                       segmentInfo.lpcpIDInfo.cpidVec,
-                                       &copysetInfos);
+    LIBCURVE_ERROR errCode = mdsClient->GetServerList(
+        segmentInfo.lpcpIDInfo.lpid, segmentInfo.lpcpIDInfo.cpidVec,
+        &copysetInfos);
 
     if (errCode == LIBCURVE_ERROR::FAILED) {
         std::string failedCopysets;
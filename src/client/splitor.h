@@ -129,6 +129,15 @@ class Splitor {
                                      const FInfo* fileInfo,
                                      ChunkIndex chunkidx);
 
+    /**
+     * @brief Update chunk and copyset info of a segment got from mds into
+     *        metacache
+     */
+    static bool UpdateSegmentInfo(const SegmentInfo& segmentInfo,
+                                  MDSClient* mdsClient,
+                                  MetaCache* metaCache,
+                                  const FInfo* fileInfo);
+
     static int SplitForNormal(IOTracker* iotracker, MetaCache* metaCache,
                               std::vector<RequestContext*>* targetlist,
                               butil::IOBuf* data, off_t offset, size_t length,
@@ -26,10 +26,13 @@
 #include <bvar/bvar.h>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <list>
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include "src/common/concurrent/concurrent.h"
 
 namespace curve {
@@ -399,6 +402,287 @@ std::shared_ptr<CacheMetrics>
     return  cacheMetrics_;
 }
 
+/**
+ * @brief ShardedLRUCache is a concurrent variant of LRUCache
+ *
+ * Keys are spread over 2^shardBits independent shards by hash, each shard
+ * has its own lock, list and map, so operations on different shards never
+ * contend. Within a shard hits are promoted lazily (CLOCK / second chance):
+ * Get only takes the read lock and sets a reference bit on the item, and
+ * eviction moves referenced items from the tail back to the head instead
+ * of dropping them. Capacity can be limited by item count, by bytes counted
+ * with KeyTraits/ValueTraits, or both; the limits are split evenly among
+ * shards.
+ */
+template <typename K,  typename V,
+    typename KeyTraits = CacheTraits<K>,
+    typename ValueTraits = CacheTraits<V>,
+    typename Hash = std::hash<K>>
+class ShardedLRUCache : public LRUCacheInterface<K, V> {
+ public:
+    /**
+     * @param[in] shardBits the cache is split into 2^shardBits shards
+     * @param[in] maxCount the maximum number of items, 0 indicates unlimited
+     * @param[in] maxBytes the maximum bytes of items, 0 indicates unlimited
+     * @param[in] cacheMetrics metrics shared by all shards
+     */
+    ShardedLRUCache(uint32_t shardBits, uint64_t maxCount, uint64_t maxBytes,
+        std::shared_ptr<CacheMetrics> cacheMetrics = nullptr);
+
+    ShardedLRUCache(uint32_t shardBits, uint64_t maxCount,
+        std::shared_ptr<CacheMetrics> cacheMetrics = nullptr)
+      : ShardedLRUCache(shardBits, maxCount, 0, cacheMetrics) {}
+
+    void Put(const K &key, const V &value) override;
+
+    /**
+     * @brief Store key-value to the cache, and return the eliminated one
+     *
+     * @param[out] eliminated The first value eliminated by the cache, more
+     *             than one item may be eliminated under byte-based capacity
+     *
+     * @return true if have eliminated item, false if not have
+     */
+    bool Put(const K &key, const V &value, V *eliminated) override;
+
+    bool Get(const K &key, V *value) override;
+
+    void Remove(const K &key) override;
+
+    uint64_t Size() override;
+
+    std::shared_ptr<CacheMetrics> GetCacheMetrics() const;
+
+ private:
+    struct Item {
+        Item(const K &k, const V &v) : key(k), value(v), referenced(false) {}
+
+        K key;
+        V value;
+        // set by Get() under read lock, cleared by eviction
+        std::atomic<bool> referenced;
+    };
+
+    using ItemIter = typename std::list<Item>::iterator;
+
+    struct Shard {
+        ::curve::common::RWLock lock;
+        std::list<Item> ll;
+        std::unordered_map<K, ItemIter, Hash> cache;
+        uint64_t bytes = 0;
+    };
+
+    Shard *GetShard(const K &key);
+
+    static uint64_t CountBytes(const K &key, const V &value) {
+        return KeyTraits::CountBytes(key) + ValueTraits::CountBytes(value);
+    }
+
+    bool OverCapacity(const Shard &shard) const {
+        return (maxCountPerShard_ != 0 &&
+                shard.ll.size() > maxCountPerShard_) ||
+               (maxBytesPerShard_ != 0 && shard.bytes > maxBytesPerShard_);
+    }
+
+    bool PutLocked(Shard *shard, const K &key, const V &value,
+        V *eliminated);
+
+    /*
+    * @brief EvictLocked Evict items until the shard fits its capacity,
+    *        referenced items at the tail get a second chance
+    *
+    * @return true if have eliminated item, false if not have
+    */
+    bool EvictLocked(Shard *shard, V *eliminated);
+
+    void RemoveElement(Shard *shard, const ItemIter &elem);
+
+ private:
+    uint32_t shardBits_;
+    uint64_t maxCountPerShard_;
+    uint64_t maxBytesPerShard_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    // cache related metric data
+    std::shared_ptr<CacheMetrics> cacheMetrics_;
+};
+
+template <typename K,  typename V, typename KeyTraits, typename ValueTraits,
+    typename Hash>
+ShardedLRUCache<K, V, KeyTraits, ValueTraits, Hash>::ShardedLRUCache(
+    uint32_t shardBits, uint64_t maxCount, uint64_t maxBytes,
+    std::shared_ptr<CacheMetrics> cacheMetrics)
+  : shardBits_(std::min<uint32_t>(shardBits, 16)),
+    cacheMetrics_(cacheMetrics) {
+    const uint64_t shardCount = 1ULL << shardBits_;
+    maxCountPerShard_ = (maxCount + shardCount - 1) / shardCount;
+    maxBytesPerShard_ = (maxBytes + shardCount - 1) / shardCount;
+    shards_.reserve(shardCount);
+    for (uint64_t i = 0; i < shardCount; ++i) {
+        shards_.emplace_back(new Shard());
+    }
+}
+
+template <typename K,  typename V, typename KeyTraits, typename ValueTraits,
+    typename Hash>
+typename ShardedLRUCache<K, V, KeyTraits, ValueTraits, Hash>::Shard *
+ShardedLRUCache<K, V, KeyTraits, ValueTraits, Hash>::GetShard(const K &key) {
+    if (shardBits_ == 0) {
+        return shards_[0].get();
+    }
+    // std::hash of integers is identity, mix it before taking high bits
+    uint64_t h = static_cast<uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ULL;
+    return shards_[h >> (64 - shardBits_)].get();
+}
+
+template <typename K,  typename V, typename KeyTraits, typename ValueTraits,
+    typename Hash>
+uint64_t ShardedLRUCache<K, V, KeyTraits, ValueTraits, Hash>::Size() {
+    uint64_t size = 0;
+    for (auto &shard : shards_) {
+        ::curve::common::ReadLockGuard guard(shard->lock);
+        size += shard->ll.size();
+    }
+    return size;
+}
+
+template <typename K,  typename V, typename KeyTraits, typename ValueTraits,
+    typename Hash>
+void ShardedLRUCache<K, V, KeyTraits, ValueTraits, Hash>::Put(
+    const K &key, const V &value) {
+    V eliminated;
+    Shard *shard = GetShard(key);
+    ::curve::common::WriteLockGuard guard(shard->lock);
+    PutLocked(shard, key, value, &eliminated);
+}
+
+template <typename K,  typename V, typename KeyTraits, typename ValueTraits,
+    typename Hash>
+bool ShardedLRUCache<K, V, KeyTraits, ValueTraits, Hash>::Put(
+    const K &key, const V &value, V *eliminated) {
+    Shard *shard = GetShard(key);
+    ::curve::common::WriteLockGuard guard(shard->lock);
+    return PutLocked(shard, key, value, eliminated);
+}
+
+template <typename K,  typename V, typename KeyTraits, typename ValueTraits,
+    typename Hash>
+bool ShardedLRUCache<K, V, KeyTraits, ValueTraits, Hash>::Get(
+    const K &key, V *value) {
+    Shard *shard = GetShard(key);
+    ::curve::common::ReadLockGuard guard(shard->lock);
+    auto iter = shard->cache.find(key);
+    if (iter == shard->cache.end()) {
+        if (cacheMetrics_ != nullptr) {
+            cacheMetrics_->OnCacheMiss();
+        }
+        return false;
+    }
+
+    if (cacheMetrics_ != nullptr) {
+        cacheMetrics_->OnCacheHit();
+    }
+
+    // lazy promotion, avoid dirtying the cacheline if already referenced
+    Item &item = *iter->second;
+    if (!item.referenced.load(std::memory_order_relaxed)) {
+        item.referenced.store(true, std::memory_order_relaxed);
+    }
+    *value = item.value;
+    return true;
+}
+
+template <typename K,  typename V, typename KeyTraits, typename ValueTraits,
+    typename Hash>
+void ShardedLRUCache<K, V, KeyTraits, ValueTraits, Hash>::Remove(
+    const K &key) {
+    Shard *shard = GetShard(key);
+    ::curve::common::WriteLockGuard guard(shard->lock);
+    auto iter = shard->cache.find(key);
+    if (iter != shard->cache.end()) {
+        RemoveElement(shard, iter->second);
+    }
+}
+
+template <typename K,  typename V, typename KeyTraits, typename ValueTraits,
+    typename Hash>
+bool ShardedLRUCache<K, V, KeyTraits, ValueTraits, Hash>::PutLocked(
+    Shard *shard, const K &key, const V &value, V *eliminated) {
+    auto iter = shard->cache.find(key);
+
+    // update in place if already exist, and treat it as a hit
+    if (iter != shard->cache.end()) {
+        Item &item = *iter->second;
+        uint64_t oldBytes = CountBytes(item.key, item.value);
+        uint64_t newBytes = CountBytes(key, value);
+        item.value = value;
+        item.referenced.store(true, std::memory_order_relaxed);
+        shard->bytes = shard->bytes - oldBytes + newBytes;
+        if (cacheMetrics_ != nullptr) {
+            cacheMetrics_->UpdateRemoveFromCacheBytes(oldBytes);
+            cacheMetrics_->UpdateAddToCacheBytes(newBytes);
+        }
+        return EvictLocked(shard, eliminated);
+    }
+
+    // put new value
+    shard->ll.emplace_front(key, value);
+    shard->cache.emplace(key, shard->ll.begin());
+    uint64_t bytes = CountBytes(key, value);
+    shard->bytes += bytes;
+    if (cacheMetrics_ != nullptr) {
+        cacheMetrics_->UpdateAddToCacheCount();
+        cacheMetrics_->UpdateAddToCacheBytes(bytes);
+    }
+    return EvictLocked(shard, eliminated);
+}
+
+template <typename K,  typename V, typename KeyTraits, typename ValueTraits,
+    typename Hash>
+bool ShardedLRUCache<K, V, KeyTraits, ValueTraits, Hash>::EvictLocked(
+    Shard *shard, V *eliminated) {
+    bool evicted = false;
+    while (!shard->ll.empty() && OverCapacity(*shard)) {
+        auto last = --shard->ll.end();
+        // every referenced item is skipped at most once, so this terminates
+        if (last->referenced.load(std::memory_order_relaxed) &&
+            shard->ll.size() > 1) {
+            last->referenced.store(false, std::memory_order_relaxed);
+            shard->ll.splice(shard->ll.begin(), shard->ll, last);
+            continue;
+        }
+
+        if (!evicted) {
+            *eliminated = last->value;
+            evicted = true;
+        }
+        RemoveElement(shard, last);
+    }
+    return evicted;
+}
+
+template <typename K,  typename V, typename KeyTraits, typename ValueTraits,
+    typename Hash>
+void ShardedLRUCache<K, V, KeyTraits, ValueTraits, Hash>::RemoveElement(
+    Shard *shard, const ItemIter &elem) {
+    uint64_t bytes = CountBytes(elem->key, elem->value);
+    if (cacheMetrics_ != nullptr) {
+        cacheMetrics_->UpdateRemoveFromCacheCount();
+        cacheMetrics_->UpdateRemoveFromCacheBytes(bytes);
+    }
+    shard->bytes -= bytes;
+    shard->cache.erase(elem->key);
+    shard->ll.erase(elem);
+}
+
+template <typename K,  typename V, typename KeyTraits, typename ValueTraits,
+    typename Hash>
+std::shared_ptr<CacheMetrics>
+    ShardedLRUCache<K, V, KeyTraits, ValueTraits, Hash>::GetCacheMetrics()
+    const {
+    return  cacheMetrics_;
+}
+
 template <typename K>
 class SglLRUCacheInterface {
  public:
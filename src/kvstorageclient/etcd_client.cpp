@@ -190,14 +190,31 @@ int EtcdClientImp::DeleteRewithRevision(
 }
 
 int EtcdClientImp::TxnN(const std::vector<Operation> &ops) {
+    int64_t revision;
+    return TxnNWithRevision(ops, &revision);
+}
+
+int EtcdClientImp::TxnNWithRevision(
+    const std::vector<Operation> &ops, int64_t *revision) {
     bool needRetry = false;
     int retry = 0;
     int errCode;
     do {
         if (ops.size() == 2) {
-            errCode = EtcdClientTxn2(timeout_, ops[0], ops[1]);
+            EtcdClientTxn2_return res =
+                EtcdClientTxn2(timeout_, ops[0], ops[1]);
+            errCode = res.r0;
+            *revision = res.r1;
         } else if (ops.size() == 3) {
-            errCode = EtcdClientTxn3(timeout_, ops[0], ops[1], ops[2]);
+            EtcdClientTxn3_return res =
+                EtcdClientTxn3(timeout_, ops[0], ops[1], ops[2]);
+            errCode = res.r0;
+            *revision = res.r1;
+        } else if (ops.size() > 3 && ops.size() <= kMaxTxnOps) {
+            EtcdClientTxnN_return res = EtcdClientTxnN(
+                timeout_, const_cast<Operation*>(ops.data()), ops.size());
+            errCode = res.r0;
+            *revision = res.r1;
         } else {
             LOG(ERROR) << "do not support Txn " << ops.size();
             return EtcdErrCode::EtcdInvalidArgument;
@@ -30,6 +30,11 @@
 
 namespace curve {
 namespace kvstorage {
+
+// etcd limits the number of operations in a txn by --max-txn-ops,
+// which is 128 by default
+const size_t kMaxTxnOps = 128;
+
 class KVStorageClient {
  public:
     KVStorageClient() {}
@@ -120,6 +125,18 @@ class KVStorageClient {
     */
     virtual int TxnN(const std::vector<Operation> &ops) = 0;
 
+    /*
+    * @brief TxnNWithRevision Same as TxnN, and return the revision of the txn,
+    *        besides 2 and 3, up to kMaxTxnOps operations are supported
+    *
+    * @param[in] ops Operation set
+    * @param[out] revision Version number returned
+    *
+    * @return error code
+    */
+    virtual int TxnNWithRevision(
+        const std::vector<Operation> &ops, int64_t *revision) = 0;
+
     /**
      * @brief CompareAndSwap Transaction, to achieve CAS
      *
@@ -174,6 +191,9 @@ class EtcdClientImp : public KVStorageClient {
 
     int TxnN(const std::vector<Operation> &ops) override;
 
+    int TxnNWithRevision(
+        const std::vector<Operation> &ops, int64_t *revision) override;
+
     int CompareAndSwap(const std::string &key, const std::string &preV,
         const std::string &target) override;
 
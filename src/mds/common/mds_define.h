@@ -51,6 +51,10 @@ const int kCsClientCSOffline = -6;
 // to prevent the request from being intercepted and played back
 const uint64_t kStaledRequestTimeIntervalUs = 15 * 1000 * 1000u;
 
+// max number of segments allocated in one GetOrAllocateSegment request,
+// all of them and the file info are persisted in one etcd transaction
+const uint32_t kMaxSegmentAllocBatch = 64;
+
 }  // namespace mds
 }  // namespace curve
 
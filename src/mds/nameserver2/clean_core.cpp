@@ -146,6 +146,9 @@ StatusCode CleanCore::CleanFile(const FileInfo & commonFile,
         }
         allocStatistic_->DeAllocSpace(segment.logicalpoolid(),
             segment.segmentsize(), revision);
+        if (copysetFileIndex_ != nullptr) {
+            copysetFileIndex_->RemoveSegment(commonFile.id(), segment);
+        }
         progress->SetProgress(100 * (i + 1) / segmentNum);
     }
 
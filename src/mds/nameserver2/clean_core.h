@@ -31,6 +31,7 @@
 #include "src/mds/chunkserverclient/copyset_client.h"
 #include "src/mds/topology/topology.h"
 #include "src/mds/nameserver2/allocstatistic/alloc_statistic.h"
+#include "src/mds/nameserver2/copyset_file_index.h"
 
 using ::curve::mds::chunkserverclient::CopysetClient;
 using ::curve::mds::topology::Topology;
@@ -42,10 +43,12 @@ class CleanCore {
  public:
     CleanCore(std::shared_ptr<NameServerStorage> storage,
         std::shared_ptr<CopysetClient> copysetClient,
-        std::shared_ptr<AllocStatistic> allocStatistic)
+        std::shared_ptr<AllocStatistic> allocStatistic,
+        std::shared_ptr<CopysetFileIndex> copysetFileIndex = nullptr)
         : storage_(storage),
           copysetClient_(copysetClient),
-          allocStatistic_(allocStatistic) {}
+          allocStatistic_(allocStatistic),
+          copysetFileIndex_(copysetFileIndex) {}
 
     /**
      * @brief 删除快照文件，更新task状态
@@ -80,6 +83,7 @@ class CleanCore {
     std::shared_ptr<NameServerStorage> storage_;
     std::shared_ptr<CopysetClient> copysetClient_;
     std::shared_ptr<AllocStatistic> allocStatistic_;
+    std::shared_ptr<CopysetFileIndex> copysetFileIndex_;
 };
 
 }  // namespace mds
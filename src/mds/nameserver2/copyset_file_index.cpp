@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#include "src/mds/nameserver2/copyset_file_index.h"
+
+#include <glog/logging.h>
+
+#include <set>
+
+namespace curve {
+namespace mds {
+
+using ::curve::common::ReadLockGuard;
+using ::curve::common::WriteLockGuard;
+
+void CopysetFileIndex::AddSegment(InodeID fileId, const std::string& fileName,
+                                  const PageFileSegment& segment) {
+    WriteLockGuard guard(lock_);
+    FileEntry& file = files_[fileId];
+    file.fileName = fileName;
+    for (int i = 0; i < segment.chunks_size(); ++i) {
+        CopysetKey key(segment.logicalpoolid(), segment.chunks(i).copysetid());
+        ++copysets_[key][fileId];
+    }
+    file.chunkNum += segment.chunks_size();
+}
+
+void CopysetFileIndex::RemoveSegment(InodeID fileId,
+                                     const PageFileSegment& segment) {
+    WriteLockGuard guard(lock_);
+    auto fileIter = files_.find(fileId);
+    if (fileIter == files_.end()) {
+        return;
+    }
+
+    uint64_t removed = 0;
+    for (int i = 0; i < segment.chunks_size(); ++i) {
+        CopysetKey key(segment.logicalpoolid(), segment.chunks(i).copysetid());
+        auto copysetIter = copysets_.find(key);
+        if (copysetIter == copysets_.end()) {
+            continue;
+        }
+        auto& files = copysetIter->second;
+        auto iter = files.find(fileId);
+        if (iter == files.end()) {
+            continue;
+        }
+        ++removed;
+        if (--iter->second == 0) {
+            files.erase(iter);
+            if (files.empty()) {
+                copysets_.erase(copysetIter);
+            }
+        }
+    }
+
+    if (removed != static_cast<uint64_t>(segment.chunks_size())) {
+        LOG(WARNING) << "CopysetFileIndex remove segment of file " << fileId
+                     << " at offset " << segment.startoffset()
+                     << ", expect " << segment.chunks_size()
+                     << " chunks, but only " << removed << " are indexed";
+    }
+
+    FileEntry& file = fileIter->second;
+    file.chunkNum = file.chunkNum > removed ? file.chunkNum - removed : 0;
+    if (file.chunkNum == 0) {
+        files_.erase(fileIter);
+    }
+}
+
+void CopysetFileIndex::RenameFile(InodeID fileId, const std::string& newName) {
+    WriteLockGuard guard(lock_);
+    auto iter = files_.find(fileId);
+    if (iter != files_.end()) {
+        iter->second.fileName = newName;
+    }
+}
+
+void CopysetFileIndex::ListFiles(
+    const std::vector<common::CopysetInfo>& copysets,
+    std::vector<std::string>* fileNames) const {
+    std::set<InodeID> fileIds;
+    ReadLockGuard guard(lock_);
+    for (const auto& copyset : copysets) {
+        auto iter = copysets_.find(
+            CopysetKey(copyset.logicalpoolid(), copyset.copysetid()));
+        if (iter == copysets_.end()) {
+            continue;
+        }
+        for (const auto& file : iter->second) {
+            fileIds.insert(file.first);
+        }
+    }
+
+    for (const auto& id : fileIds) {
+        auto iter = files_.find(id);
+        if (iter != files_.end()) {
+            fileNames->emplace_back(iter->second.fileName);
+        }
+    }
+}
+
+uint64_t CopysetFileIndex::GetChunkNum(LogicalPoolID logicalPoolId,
+                                       CopysetID copysetId,
+                                       InodeID fileId) const {
+    ReadLockGuard guard(lock_);
+    auto iter = copysets_.find(CopysetKey(logicalPoolId, copysetId));
+    if (iter == copysets_.end()) {
+        return 0;
+    }
+    auto fileIter = iter->second.find(fileId);
+    return fileIter == iter->second.end() ? 0 : fileIter->second;
+}
+
+void CopysetFileIndex::Clear() {
+    WriteLockGuard guard(lock_);
+    copysets_.clear();
+    files_.clear();
+}
+
+}  // namespace mds
+}  // namespace curve
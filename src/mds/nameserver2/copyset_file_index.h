@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#ifndef SRC_MDS_NAMESERVER2_COPYSET_FILE_INDEX_H_
+#define SRC_MDS_NAMESERVER2_COPYSET_FILE_INDEX_H_
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "proto/common.pb.h"
+#include "proto/nameserver2.pb.h"
+#include "src/common/concurrent/rw_lock.h"
+#include "src/mds/common/mds_define.h"
+
+namespace curve {
+namespace mds {
+
+/**
+ * CopysetFileIndex is an in-memory reverse index from copyset to the files
+ * which have chunks on it, together with the chunk number of each file.
+ *
+ * It is updated when segments are allocated, deallocated and cleaned, and
+ * rebuilt from etcd when mds starts. Before the rebuild finishes the index is
+ * not ready and callers should fall back to scanning the namespace.
+ */
+class CopysetFileIndex {
+ public:
+    CopysetFileIndex() : ready_(false) {}
+
+    /**
+     * @brief Add chunks of a segment to the index
+     * @param fileId id of the file which owns the segment
+     * @param fileName name of the file
+     * @param segment the segment
+     */
+    void AddSegment(InodeID fileId, const std::string& fileName,
+                    const PageFileSegment& segment);
+
+    /**
+     * @brief Remove chunks of a segment from the index, the file is removed
+     *        when it has no chunk left
+     * @param fileId id of the file which owns the segment
+     * @param segment the segment
+     */
+    void RemoveSegment(InodeID fileId, const PageFileSegment& segment);
+
+    /**
+     * @brief Update the name of a file, do nothing if file is not indexed
+     */
+    void RenameFile(InodeID fileId, const std::string& newName);
+
+    /**
+     * @brief List files which have chunks on any of the copysets
+     * @param copysets copysets to query
+     * @param[out] fileNames names of the files, each file appears once
+     */
+    void ListFiles(const std::vector<common::CopysetInfo>& copysets,
+                   std::vector<std::string>* fileNames) const;
+
+    /**
+     * @brief Get the chunk number of a file on a copyset
+     * @return chunk number, 0 if the file has no chunk on the copyset
+     */
+    uint64_t GetChunkNum(LogicalPoolID logicalPoolId, CopysetID copysetId,
+                         InodeID fileId) const;
+
+    /**
+     * @brief Drop all entries, used before rebuilding
+     */
+    void Clear();
+
+    void SetReady(bool ready) { ready_.store(ready); }
+
+    bool IsReady() const { return ready_.load(); }
+
+ private:
+    using CopysetKey = std::pair<LogicalPoolID, CopysetID>;
+
+    struct FileEntry {
+        std::string fileName;
+        uint64_t chunkNum = 0;
+    };
+
+    mutable ::curve::common::RWLock lock_;
+    // copyset -> (file id -> chunk number of the file on the copyset)
+    std::map<CopysetKey, std::unordered_map<InodeID, uint64_t>> copysets_;
+    // file id -> name and total chunk number of the file in the index
+    std::unordered_map<InodeID, FileEntry> files_;
+    std::atomic<bool> ready_;
+};
+
+}  // namespace mds
+}  // namespace curve
+
+#endif  // SRC_MDS_NAMESERVER2_COPYSET_FILE_INDEX_H_
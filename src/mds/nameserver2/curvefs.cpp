@@ -23,6 +23,7 @@
 #include "src/mds/nameserver2/curvefs.h"
 #include <glog/logging.h>
 #include <google/protobuf/util/message_differencer.h>
+#include <algorithm>
 #include <memory>
 #include <chrono>    //NOLINT
 #include <set>
@@ -119,13 +120,15 @@ bool CurveFS::Init(std::shared_ptr<NameServerStorage> storage,
                 std::shared_ptr<AllocStatistic> allocStatistic,
                 const struct CurveFSOption &curveFSOptions,
                 std::shared_ptr<Topology> topology,
-                std::shared_ptr<SnapshotCloneClient> snapshotCloneClient) {
+                std::shared_ptr<SnapshotCloneClient> snapshotCloneClient,
+                std::shared_ptr<CopysetFileIndex> copysetFileIndex) {
     startTime_ = std::chrono::steady_clock::now();
     storage_ = storage;
     InodeIDGenerator_ = InodeIDGenerator;
     chunkSegAllocator_ = chunkSegAllocator;
     cleanManager_ = cleanManager;
     allocStatistic_ = allocStatistic;
+    copysetFileIndex_ = copysetFileIndex;
     fileRecordManager_ = fileRecordManager;
     rootAuthOptions_ = curveFSOptions.authOptions;
     throttleOption_ = curveFSOptions.throttleOption;
@@ -159,6 +162,7 @@ void CurveFS::Uninit() {
     chunkSegAllocator_ = nullptr;
     cleanManager_ = nullptr;
     allocStatistic_ = nullptr;
+    copysetFileIndex_ = nullptr;
     fileRecordManager_ = nullptr;
     snapshotCloneClient_ = nullptr;
 }
@@ -319,6 +323,7 @@ StatusCode CurveFS::CreateFile(const std::string & fileName,
         fileInfo.set_stripecount(stripeCount);
 
         if (filetype == FileType::INODE_PAGEFILE) {
+            fileInfo.set_allocatedsize(0);
             fileInfo.set_allocated_throttleparams(
                 new FileThrottleParams(GenerateDefaultThrottleParams(length)));
         }
@@ -431,6 +436,15 @@ StatusCode CurveFS::GetAllocatedSize(const std::string& fileName,
 StatusCode CurveFS::GetFileAllocSize(const std::string& fileName,
                                      const FileInfo& fileInfo,
                                      AllocatedSize* allocSize) {
+    // served from the counters maintained on segment allocation and discard
+    if (fileInfo.has_allocatedsize()) {
+        for (const auto& item : fileInfo.allocatedsizeinpool()) {
+            allocSize->allocSizeMap[item.first] += item.second;
+        }
+        allocSize->total = fileInfo.allocatedsize();
+        return StatusCode::kOK;
+    }
+
     std::vector<PageFileSegment> segments;
     auto listSegmentRet = storage_->ListSegment(fileInfo.id(), &segments);
 
@@ -445,6 +459,26 @@ StatusCode CurveFS::GetFileAllocSize(const std::string& fileName,
     return StatusCode::kOK;
 }
 
+StatusCode CurveFS::InitAllocatedSize(FileInfo* fileInfo) {
+    if (fileInfo->has_allocatedsize()) {
+        return StatusCode::kOK;
+    }
+
+    AllocatedSize allocSize;
+    auto ret = GetFileAllocSize(fileInfo->filename(), *fileInfo, &allocSize);
+    if (ret != StatusCode::kOK) {
+        LOG(ERROR) << "InitAllocatedSize fail, fileName = "
+                   << fileInfo->filename() << ", ret = " << ret;
+        return ret;
+    }
+
+    fileInfo->set_allocatedsize(allocSize.total);
+    for (const auto& item : allocSize.allocSizeMap) {
+        (*fileInfo->mutable_allocatedsizeinpool())[item.first] = item.second;
+    }
+    return StatusCode::kOK;
+}
+
 StatusCode CurveFS::GetDirAllocSize(const std::string& fileName,
                                     const FileInfo& fileInfo,
                                     AllocatedSize* allocSize) {
@@ -692,6 +726,10 @@ StatusCode CurveFS::DeleteFile(const std::string & filename, uint64_t fileId,
                         << ", ret = " << ret1;
                 return StatusCode::kStorageError;
             }
+            if (copysetFileIndex_ != nullptr) {
+                copysetFileIndex_->RenameFile(fileInfo.id(),
+                                              recycleFileInfo.filename());
+            }
             LOG(INFO) << "file delete to recyclebin, fileName = " << filename
                       << ", recycle filename = " << recycleFileInfo.filename();
             return StatusCode::kOK;
@@ -818,6 +856,9 @@ StatusCode CurveFS::RecoverFile(const std::string & originFileName,
         LOG(ERROR) << "storage_ recoverfile error, error = " << ret1;
         return StatusCode::kStorageError;
     }
+    if (copysetFileIndex_ != nullptr) {
+        copysetFileIndex_->RenameFile(recoverFileInfo.id(), lastEntry);
+    }
     return StatusCode::kOK;
 }
 
@@ -1008,6 +1049,11 @@ StatusCode CurveFS::RenameFile(const std::string & sourceFileName,
 
             return StatusCode::kStorageError;
         }
+        if (copysetFileIndex_ != nullptr) {
+            copysetFileIndex_->RenameFile(destFileInfo.id(), lastEntry);
+            copysetFileIndex_->RenameFile(recycleFileInfo.id(),
+                                          recycleFileInfo.filename());
+        }
         return StatusCode::kOK;
     } else if (ret3 == StatusCode::kFileNotExists) {
         // destFileName does not exist, rename directly
@@ -1021,6 +1067,9 @@ StatusCode CurveFS::RenameFile(const std::string & sourceFileName,
             LOG(ERROR) << "storage_ renamefile error, error = " << ret;
             return StatusCode::kStorageError;
         }
+        if (copysetFileIndex_ != nullptr) {
+            copysetFileIndex_->RenameFile(destFileInfo.id(), lastEntry);
+        }
         return StatusCode::kOK;
     } else {
         LOG(INFO) << "dest file LookUpFile return: " << ret3;
@@ -1172,6 +1221,11 @@ StatusCode CurveFS::GetOrAllocateSegment(const std::string & filename,
             return  StatusCode::kSegmentNotAllocated;
         } else {
             // TODO(hzsunjianliang): check the user and define the logical pool
+            ret = InitAllocatedSize(&fileInfo);
+            if (ret != StatusCode::kOK) {
+                return ret;
+            }
+
             auto ifok = chunkSegAllocator_->AllocateChunkSegment(
                             fileInfo.filetype(), fileInfo.segmentsize(),
                             fileInfo.chunksize(), offset, segment);
@@ -1179,9 +1233,15 @@ StatusCode CurveFS::GetOrAllocateSegment(const std::string & filename,
                 LOG(ERROR) << "AllocateChunkSegment error";
                 return StatusCode::kSegmentAllocateError;
             }
+
+            fileInfo.set_allocatedsize(
+                fileInfo.allocatedsize() + fileInfo.segmentsize());
+            (*fileInfo.mutable_allocatedsizeinpool())[
+                segment->logicalpoolid()] += fileInfo.segmentsize();
+
             int64_t revision;
-            if (storage_->PutSegment(fileInfo.id(), offset, segment, &revision)
-                != StoreStatus::OK) {
+            if (storage_->PutSegmentWithFile(fileInfo, offset, segment,
+                                             &revision) != StoreStatus::OK) {
                 LOG(ERROR) << "PutSegment fail, fileInfo.id() = "
                            << fileInfo.id()
                            << ", offset = "
@@ -1191,6 +1251,10 @@ StatusCode CurveFS::GetOrAllocateSegment(const std::string & filename,
             allocStatistic_->AllocSpace(segment->logicalpoolid(),
                     segment->segmentsize(),
                     revision);
+            if (copysetFileIndex_ != nullptr) {
+                copysetFileIndex_->AddSegment(fileInfo.id(),
+                                              fileInfo.filename(), *segment);
+            }
 
             LOG(INFO) << "alloc segment success, fileInfo.id() = "
                       << fileInfo.id()
@@ -1202,6 +1266,111 @@ StatusCode CurveFS::GetOrAllocateSegment(const std::string & filename,
     }
 }
 
+StatusCode CurveFS::GetOrAllocateSegments(const std::string & filename,
+        offset_t offset, uint32_t segmentNum,
+        std::vector<PageFileSegment> *segments) {
+    assert(segments != nullptr);
+    segments->clear();
+
+    FileInfo  fileInfo;
+    auto ret = GetFileInfo(filename, &fileInfo);
+    if (ret != StatusCode::kOK) {
+        LOG(INFO) << "get source file error, errCode = " << ret;
+        return  ret;
+    }
+
+    if (fileInfo.filetype() != FileType::INODE_PAGEFILE) {
+        LOG(INFO) << "not pageFile, can't do this";
+        return StatusCode::kParaError;
+    }
+
+    if (offset % fileInfo.segmentsize() != 0) {
+        LOG(INFO) << "offset not align with segment";
+        return StatusCode::kParaError;
+    }
+
+    if (offset + fileInfo.segmentsize() > fileInfo.length()) {
+        LOG(INFO) << "bigger than file length, first extentFile";
+        return StatusCode::kParaError;
+    }
+
+    uint64_t num = std::min<uint64_t>(
+        std::min(segmentNum, kMaxSegmentAllocBatch),
+        (fileInfo.length() - offset) / fileInfo.segmentsize());
+    num = std::max<uint64_t>(num, 1);
+
+    std::vector<PageFileSegment> allocated;
+    for (uint64_t i = 0; i < num; ++i) {
+        uint64_t segOffset = offset + i * fileInfo.segmentsize();
+        PageFileSegment segment;
+        auto storeRet = storage_->GetSegment(fileInfo.id(), segOffset,
+                                             &segment);
+        if (storeRet == StoreStatus::OK) {
+            segments->emplace_back(std::move(segment));
+            continue;
+        } else if (storeRet != StoreStatus::KeyNotExist) {
+            if (segments->empty()) {
+                return StatusCode::KInternalError;
+            }
+            break;
+        }
+
+        if (allocated.empty()) {
+            ret = InitAllocatedSize(&fileInfo);
+            if (ret != StatusCode::kOK) {
+                return ret;
+            }
+        }
+
+        // later segments are only allocated ahead, stop at the first failure
+        if (!chunkSegAllocator_->AllocateChunkSegment(
+                fileInfo.filetype(), fileInfo.segmentsize(),
+                fileInfo.chunksize(), segOffset, &segment)) {
+            LOG(ERROR) << "AllocateChunkSegment error, filename = "
+                       << filename << ", offset = " << segOffset;
+            if (segments->empty()) {
+                return StatusCode::kSegmentAllocateError;
+            }
+            break;
+        }
+
+        fileInfo.set_allocatedsize(
+            fileInfo.allocatedsize() + fileInfo.segmentsize());
+        (*fileInfo.mutable_allocatedsizeinpool())[
+            segment.logicalpoolid()] += fileInfo.segmentsize();
+        allocated.push_back(segment);
+        segments->emplace_back(std::move(segment));
+    }
+
+    if (allocated.empty()) {
+        return StatusCode::kOK;
+    }
+
+    int64_t revision;
+    if (storage_->PutSegmentsWithFile(fileInfo, allocated, &revision)
+        != StoreStatus::OK) {
+        LOG(ERROR) << "PutSegmentsWithFile fail, fileInfo.id() = "
+                   << fileInfo.id() << ", offset = " << offset
+                   << ", segment num = " << allocated.size();
+        segments->clear();
+        return StatusCode::kStorageError;
+    }
+
+    for (const auto& segment : allocated) {
+        allocStatistic_->AllocSpace(segment.logicalpoolid(),
+                                    segment.segmentsize(), revision);
+        if (copysetFileIndex_ != nullptr) {
+            copysetFileIndex_->AddSegment(fileInfo.id(), fileInfo.filename(),
+                                          segment);
+        }
+    }
+
+    LOG(INFO) << "alloc segments success, fileInfo.id() = " << fileInfo.id()
+              << ", offset = " << offset << ", allocated = "
+              << allocated.size() << ", total = " << segments->size();
+    return StatusCode::kOK;
+}
+
 StatusCode CurveFS::DeAllocateSegment(const std::string& fileName,
                                       uint64_t offset) {
     FileInfo fileInfo;
@@ -1259,6 +1428,23 @@ StatusCode CurveFS::DeAllocateSegment(const std::string& fileName,
         return StatusCode::kFileUnderSnapShot;
     }
 
+    ret = InitAllocatedSize(&fileInfo);
+    if (ret != StatusCode::kOK) {
+        return ret;
+    }
+
+    // the segment is being discarded, remove it from the counters
+    auto& poolSize =
+        (*fileInfo.mutable_allocatedsizeinpool())[segment.logicalpoolid()];
+    poolSize -= std::min<uint64_t>(poolSize, fileInfo.segmentsize());
+    if (poolSize == 0) {
+        fileInfo.mutable_allocatedsizeinpool()->erase(
+            segment.logicalpoolid());
+    }
+    fileInfo.set_allocatedsize(
+        fileInfo.allocatedsize() -
+        std::min<uint64_t>(fileInfo.allocatedsize(), fileInfo.segmentsize()));
+
     storeRet = storage_->DiscardSegment(fileInfo, segment);
     if (storeRet != StoreStatus::OK) {
         LOG(WARNING) << "Storage CleanSegment return error, filename = "
@@ -1267,6 +1453,10 @@ StatusCode CurveFS::DeAllocateSegment(const std::string& fileName,
         return StatusCode::kStorageError;
     }
 
+    if (copysetFileIndex_ != nullptr) {
+        copysetFileIndex_->RemoveSegment(fileInfo.id(), segment);
+    }
+
     return StatusCode::kOK;
 }
 
@@ -1774,6 +1964,7 @@ StatusCode CurveFS::CreateCloneFile(const std::string &fileName,
         fileInfo.set_filestatus(FileStatus::kFileCloning);
         fileInfo.set_stripeunit(stripeUnit);
         fileInfo.set_stripecount(stripeCount);
+        fileInfo.set_allocatedsize(0);
 
         fileInfo.set_allocated_throttleparams(
             new FileThrottleParams(GenerateDefaultThrottleParams(length)));
@@ -2277,6 +2468,11 @@ StatusCode CurveFS::FindFileMountPoint(const std::string& fileName,
 StatusCode CurveFS::ListVolumesOnCopyset(
                         const std::vector<common::CopysetInfo>& copysets,
                         std::vector<std::string>* fileNames) {
+    if (copysetFileIndex_ != nullptr && copysetFileIndex_->IsReady()) {
+        copysetFileIndex_->ListFiles(copysets, fileNames);
+        return StatusCode::kOK;
+    }
+
     std::vector<FileInfo> files;
     StatusCode ret = ListAllFiles(ROOTINODEID, &files);
     if (ret != StatusCode::kOK) {
@@ -2315,6 +2511,47 @@ StatusCode CurveFS::ListVolumesOnCopyset(
     return StatusCode::kOK;
 }
 
+StatusCode CurveFS::BuildCopysetFileIndex() {
+    if (copysetFileIndex_ == nullptr) {
+        return StatusCode::kOK;
+    }
+
+    uint64_t startTime = ::curve::common::TimeUtility::GetTimeofDayMs();
+    copysetFileIndex_->SetReady(false);
+    copysetFileIndex_->Clear();
+
+    std::vector<FileInfo> files;
+    StatusCode ret = ListAllFiles(ROOTINODEID, &files);
+    if (ret != StatusCode::kOK) {
+        LOG(ERROR) << "Build copyset file index fail, list all files fail";
+        return ret;
+    }
+
+    uint64_t segmentNum = 0;
+    for (const auto& file : files) {
+        std::vector<PageFileSegment> segments;
+        StoreStatus storeRet = storage_->ListSegment(file.id(), &segments);
+        if (storeRet != StoreStatus::OK) {
+            LOG(ERROR) << "Build copyset file index fail, list segments of "
+                       << file.filename() << " fail";
+            copysetFileIndex_->Clear();
+            return StatusCode::kStorageError;
+        }
+        for (const auto& segment : segments) {
+            copysetFileIndex_->AddSegment(file.id(), file.filename(), segment);
+        }
+        segmentNum += segments.size();
+    }
+
+    copysetFileIndex_->SetReady(true);
+    LOG(INFO) << "Build copyset file index success, file num = "
+              << files.size() << ", segment num = " << segmentNum
+              << ", cost "
+              << ::curve::common::TimeUtility::GetTimeofDayMs() - startTime
+              << " ms";
+    return StatusCode::kOK;
+}
+
 StatusCode CurveFS::ListAllFiles(uint64_t inodeId,
                                  std::vector<FileInfo>* files) {
     std::vector<FileInfo> tempFiles;
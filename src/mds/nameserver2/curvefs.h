@@ -35,6 +35,7 @@
 #include "src/mds/common/mds_define.h"
 #include "src/mds/nameserver2/chunk_allocator.h"
 #include "src/mds/nameserver2/clean_manager.h"
+#include "src/mds/nameserver2/copyset_file_index.h"
 #include "src/mds/nameserver2/async_delete_snapshot_entity.h"
 #include "src/mds/nameserver2/file_record.h"
 #include "src/mds/nameserver2/idgenerator/inode_id_generator.h"
@@ -100,6 +101,9 @@ class CurveFS {
      *         fileRecordManager
      *         allocStatistic: alloc statistic module
      *         CurveFSOption : Initialization parameters
+     *         copysetFileIndex: copyset to file reverse index, optional,
+     *                           ListVolumesOnCopyset scans the namespace
+     *                           if not set
      *  @return whether the initialization was successful
      */
     bool Init(std::shared_ptr<NameServerStorage>,
@@ -110,7 +114,15 @@ class CurveFS {
               std::shared_ptr<AllocStatistic> allocStatistic,
               const struct CurveFSOption &curveFSOptions,
               std::shared_ptr<Topology> topology,
-              std::shared_ptr<SnapshotCloneClient> snapshotCloneClient);
+              std::shared_ptr<SnapshotCloneClient> snapshotCloneClient,
+              std::shared_ptr<CopysetFileIndex> copysetFileIndex = nullptr);
+
+    /**
+     *  @brief Build the copyset to file reverse index from all segments in
+     *         storage, must be called before serving requests
+     *  @return StatusCode::kOK if succeeded
+     */
+    StatusCode BuildCopysetFileIndex();
 
     /**
      *  @brief Run session manager
@@ -273,6 +285,22 @@ class CurveFS {
         offset_t offset,
         bool allocateIfNoExist, PageFileSegment *segment);
 
+    /**
+     *  @brief Get or allocate consecutive segments of a file, the newly
+     *         allocated segments are persisted in one transaction
+     *  @param filename
+     *  @param offset: start offset of the first segment
+     *  @param segmentNum: number of segments wanted, it is truncated by the
+     *         file length and kMaxSegmentAllocBatch
+     *  @param[out] segments: segments start from offset, at least one
+     *  @return StatusCode::kOK if succeeded
+     */
+    StatusCode GetOrAllocateSegments(
+        const std::string & filename,
+        offset_t offset,
+        uint32_t segmentNum,
+        std::vector<PageFileSegment> *segments);
+
     /**
      * @brief deallocate file segment start at offset
      * @param filename
@@ -530,7 +558,8 @@ class CurveFS {
                                   std::vector<ClientInfo>* clientInfos);
 
     /**
-     * @brief List volumes on copysets
+     * @brief List volumes on copysets, use the copyset to file index if it
+     *        is ready, otherwise scan all segments of all files
      * @param copysets
      * @param[fileNames] volumes on copysets
      * @return StatusCode::kOK if succeeded, StatusCode::kFileNotExists if failed //NOLINT
@@ -693,6 +722,14 @@ class CurveFS {
                                 const FileInfo& fileInfo,
                                 AllocatedSize* allocSize);
 
+    /**
+     *  @brief Fill the allocated size counters of a file created before the
+     *         counters were introduced, by scanning its segments
+     *  @param[in|out] fileInfo
+     *  @return StatusCode::kOK if succeeded
+     */
+    StatusCode InitAllocatedSize(FileInfo* fileInfo);
+
     /**
      *  @brief Get allocated size for a directory
      *  @param dirName: directory name
@@ -773,6 +810,7 @@ class CurveFS {
     std::shared_ptr<FileRecordManager> fileRecordManager_;
     std::shared_ptr<CleanManagerInterface> cleanManager_;
     std::shared_ptr<AllocStatistic> allocStatistic_;
+    std::shared_ptr<CopysetFileIndex> copysetFileIndex_;
     std::shared_ptr<Topology> topology_;
     std::shared_ptr<SnapshotCloneClient> snapshotCloneClient_;
     struct RootAuthOption       rootAuthOptions_;
@@ -30,6 +30,7 @@ using ::curve::common::SNAPSHOTFILEINFOKEYPREFIX;
 using ::curve::common::SNAPSHOTFILEINFOKEYEND;
 using ::curve::common::DISCARDSEGMENTKEYPREFIX;
 using ::curve::common::DISCARDSEGMENTKEYEND;
+using ::curve::kvstorage::kMaxTxnOps;
 
 namespace curve {
 namespace mds {
@@ -40,8 +41,10 @@ std::ostream& operator << (std::ostream & os, StoreStatus &s) {
 }
 
 NameServerStorageImp::NameServerStorageImp(
-    std::shared_ptr<KVStorageClient> client, std::shared_ptr<Cache> cache)
-    : client_(client), cache_(cache), discardMetric_() {}
+    std::shared_ptr<KVStorageClient> client, std::shared_ptr<Cache> cache,
+    std::shared_ptr<FileInfoCache> fileInfoCache)
+    : client_(client), cache_(cache), fileInfoCache_(fileInfoCache),
+      fileInfoGens_(), discardMetric_() {}
 
 StoreStatus NameServerStorageImp::PutFile(const FileInfo &fileInfo) {
     std::string storeKey;
@@ -65,7 +68,7 @@ StoreStatus NameServerStorageImp::PutFile(const FileInfo &fileInfo) {
                     << errCode;
     } else {
         // update to cache
-        cache_->Put(storeKey, encodeFileInfo);
+        CachePut(storeKey, encodeFileInfo);
     }
 
     return getErrorCode(errCode);
@@ -81,11 +84,21 @@ StoreStatus NameServerStorageImp::GetFile(InodeID parentid,
         return StoreStatus::InternalError;
     }
 
+    std::shared_ptr<FileInfo> decoded;
+    if (fileInfoCache_ != nullptr && fileInfoCache_->Get(storeKey, &decoded)) {
+        fileInfo->CopyFrom(*decoded);
+        return StoreStatus::OK;
+    }
+
+    std::atomic<uint64_t>& generation = FileInfoGeneration(storeKey);
+    const uint64_t gen = generation.load(std::memory_order_acquire);
+
     int errCode = EtcdErrCode::EtcdOK;
     std::string out;
     if (!cache_->Get(storeKey, &out)) {
         errCode = client_->Get(storeKey, &out);
 
+        // fill encoded value only, decoded one is filled below
         if (errCode == EtcdErrCode::EtcdOK) {
             cache_->Put(storeKey, out);
         }
@@ -94,6 +107,16 @@ StoreStatus NameServerStorageImp::GetFile(InodeID parentid,
     if (errCode == EtcdErrCode::EtcdOK) {
         bool decodeOK = NameSpaceStorageCodec::DecodeFileInfo(out, fileInfo);
         if (decodeOK) {
+            if (fileInfoCache_ != nullptr) {
+                fileInfoCache_->Put(storeKey,
+                                    std::make_shared<FileInfo>(*fileInfo));
+                // the key is updated since |out| is read, the value put may
+                // be stale. updater removes the decoded value after bumping
+                // the generation, so either it or we remove the stale one
+                if (generation.load(std::memory_order_acquire) != gen) {
+                    fileInfoCache_->Remove(storeKey);
+                }
+            }
             return StoreStatus::OK;
         } else {
             LOG(ERROR) << "decode info error. parentid: " << parentid
@@ -121,7 +144,7 @@ StoreStatus NameServerStorageImp::DeleteFile(InodeID id,
     }
 
     // delete cache first, then Etcd
-    cache_->Remove(storeKey);
+    CacheRemove(storeKey);
     int resCode = client_->Delete(storeKey);
 
     if (resCode != EtcdErrCode::EtcdOK) {
@@ -141,7 +164,7 @@ StoreStatus NameServerStorageImp::DeleteSnapshotFile(InodeID id,
     }
 
     // delete cache first, then Etcd
-    cache_->Remove(storeKey);
+    CacheRemove(storeKey);
     int resCode = client_->Delete(storeKey);
 
     if (resCode != EtcdErrCode::EtcdOK) {
@@ -187,7 +210,7 @@ StoreStatus NameServerStorageImp::RenameFile(const FileInfo &oldFInfo,
     }
 
     // delete the data in the cache first
-    cache_->Remove(oldStoreKey);
+    CacheRemove(oldStoreKey);
 
     // update Etcd
     Operation op1{
@@ -208,7 +231,7 @@ StoreStatus NameServerStorageImp::RenameFile(const FileInfo &oldFInfo,
                    << errCode;
     } else {
         // update to cache at last
-        cache_->Put(newStoreKey, encodeNewFileInfo);
+        CachePut(newStoreKey, encodeNewFileInfo);
     }
     return getErrorCode(errCode);
 }
@@ -272,8 +295,8 @@ StoreStatus NameServerStorageImp::ReplaceFileAndRecycleOldFile(
     }
 
     // delete data in cache
-    cache_->Remove(conflictStoreKey);
-    cache_->Remove(oldStoreKey);
+    CacheRemove(conflictStoreKey);
+    CacheRemove(oldStoreKey);
 
     // put recycleFInfo; delete oldFInfo; put newFInfo
     Operation op1{
@@ -299,8 +322,8 @@ StoreStatus NameServerStorageImp::ReplaceFileAndRecycleOldFile(
                    << errCode;
     } else {
         // update to cache
-        cache_->Put(recycleStoreKey, encodeRecycleFInfo);
-        cache_->Put(newStoreKey, encodeNewFInfo);
+        CachePut(recycleStoreKey, encodeRecycleFInfo);
+        CachePut(newStoreKey, encodeNewFInfo);
     }
     return getErrorCode(errCode);
 }
@@ -334,7 +357,7 @@ StoreStatus NameServerStorageImp::MoveFileToRecycle(
     }
 
     // delete data in cache
-    cache_->Remove(originFileInfoKey);
+    CacheRemove(originFileInfoKey);
 
     // remove originFileInfo from Etcd, and put recycleFileInfo
     Operation op1{
@@ -356,7 +379,7 @@ StoreStatus NameServerStorageImp::MoveFileToRecycle(
                    << errCode;
     } else {
         // update to cache
-        cache_->Put(recycleFileInfoKey, encodeRecycleFInfo);
+        CachePut(recycleFileInfoKey, encodeRecycleFInfo);
     }
     return getErrorCode(errCode);
 }
@@ -477,7 +500,124 @@ StoreStatus NameServerStorageImp::PutSegment(InodeID id,
         LOG(ERROR) << "put segment of logicalPoolId:"
                    << segment->logicalpoolid() << "err:" << errCode;
     } else {
-        cache_->Put(storeKey, encodeSegment);
+        CachePut(storeKey, encodeSegment);
+    }
+    return getErrorCode(errCode);
+}
+
+StoreStatus NameServerStorageImp::PutSegmentWithFile(
+    const FileInfo &fileInfo, uint64_t off, const PageFileSegment *segment,
+    int64_t *revision) {
+    std::string fileKey;
+    if (GetStoreKey(fileInfo.filetype(), fileInfo.parentid(),
+                    fileInfo.filename(), &fileKey) != StoreStatus::OK) {
+        LOG(ERROR) << "get store key failed, filename = "
+                   << fileInfo.filename();
+        return StoreStatus::InternalError;
+    }
+    std::string segmentKey =
+        NameSpaceStorageCodec::EncodeSegmentStoreKey(fileInfo.id(), off);
+
+    std::string encodeFileInfo;
+    std::string encodeSegment;
+    if (!NameSpaceStorageCodec::EncodeFileInfo(fileInfo, &encodeFileInfo) ||
+        !NameSpaceStorageCodec::EncodeSegment(*segment, &encodeSegment)) {
+        LOG(ERROR) << "encode file: " << fileInfo.filename()
+                   << " or segment of offset: " << off << " err";
+        return StoreStatus::InternalError;
+    }
+
+    // delete the information in cache first
+    CacheRemove(fileKey);
+
+    Operation op1{
+        OpType::OpPut,
+        const_cast<char*>(segmentKey.c_str()),
+        const_cast<char*>(encodeSegment.c_str()),
+        segmentKey.size(), encodeSegment.size()};
+    Operation op2{
+        OpType::OpPut,
+        const_cast<char*>(fileKey.c_str()),
+        const_cast<char*>(encodeFileInfo.c_str()),
+        fileKey.size(), encodeFileInfo.size()};
+
+    std::vector<Operation> ops{op1, op2};
+    int errCode = client_->TxnNWithRevision(ops, revision);
+    if (errCode != EtcdErrCode::EtcdOK) {
+        LOG(ERROR) << "put segment of file: " << fileInfo.filename()
+                   << ", inodeid: " << fileInfo.id() << ", offset: " << off
+                   << ", logicalPoolId: " << segment->logicalpoolid()
+                   << " err: " << errCode;
+    } else {
+        CachePut(segmentKey, encodeSegment);
+        CachePut(fileKey, encodeFileInfo);
+    }
+    return getErrorCode(errCode);
+}
+
+StoreStatus NameServerStorageImp::PutSegmentsWithFile(
+    const FileInfo &fileInfo, const std::vector<PageFileSegment> &segments,
+    int64_t *revision) {
+    if (segments.empty() || segments.size() + 1 > kMaxTxnOps) {
+        LOG(ERROR) << "put segments of file: " << fileInfo.filename()
+                   << " with invalid segment number: " << segments.size();
+        return StoreStatus::InternalError;
+    }
+
+    std::string fileKey;
+    if (GetStoreKey(fileInfo.filetype(), fileInfo.parentid(),
+                    fileInfo.filename(), &fileKey) != StoreStatus::OK) {
+        LOG(ERROR) << "get store key failed, filename = "
+                   << fileInfo.filename();
+        return StoreStatus::InternalError;
+    }
+    std::string encodeFileInfo;
+    if (!NameSpaceStorageCodec::EncodeFileInfo(fileInfo, &encodeFileInfo)) {
+        LOG(ERROR) << "encode file: " << fileInfo.filename() << " err";
+        return StoreStatus::InternalError;
+    }
+
+    std::vector<std::string> segmentKeys(segments.size());
+    std::vector<std::string> encodeSegments(segments.size());
+    std::vector<Operation> ops;
+    ops.reserve(segments.size() + 1);
+    for (size_t i = 0; i < segments.size(); ++i) {
+        segmentKeys[i] = NameSpaceStorageCodec::EncodeSegmentStoreKey(
+            fileInfo.id(), segments[i].startoffset());
+        if (!NameSpaceStorageCodec::EncodeSegment(segments[i],
+                                                  &encodeSegments[i])) {
+            LOG(ERROR) << "encode segment of file: " << fileInfo.filename()
+                       << ", offset: " << segments[i].startoffset() << " err";
+            return StoreStatus::InternalError;
+        }
+        ops.emplace_back(Operation{
+            OpType::OpPut,
+            const_cast<char*>(segmentKeys[i].c_str()),
+            const_cast<char*>(encodeSegments[i].c_str()),
+            static_cast<int>(segmentKeys[i].size()),
+            static_cast<int>(encodeSegments[i].size())});
+    }
+    ops.emplace_back(Operation{
+        OpType::OpPut,
+        const_cast<char*>(fileKey.c_str()),
+        const_cast<char*>(encodeFileInfo.c_str()),
+        static_cast<int>(fileKey.size()),
+        static_cast<int>(encodeFileInfo.size())});
+
+    // delete the information in cache first
+    CacheRemove(fileKey);
+
+    int errCode = client_->TxnNWithRevision(ops, revision);
+    if (errCode != EtcdErrCode::EtcdOK) {
+        LOG(ERROR) << "put " << segments.size() << " segments of file: "
+                   << fileInfo.filename() << ", inodeid: " << fileInfo.id()
+                   << ", start offset: " << segments.front().startoffset()
+                   << " err: " << errCode;
+    } else {
+        for (size_t i = 0; i < segments.size(); ++i) {
+            CachePut(segmentKeys[i], encodeSegments[i]);
+        }
+        CachePut(fileKey, encodeFileInfo);
     }
     return getErrorCode(errCode);
 }
@@ -518,7 +658,7 @@ StoreStatus NameServerStorageImp::DeleteSegment(
     int errCode = client_->DeleteRewithRevision(storeKey, revision);
 
     // update the cache first, then update Etcd
-    cache_->Remove(storeKey);
+    CacheRemove(storeKey);
     if (errCode != EtcdErrCode::EtcdOK) {
         LOG(ERROR) << "delete segment of inodeid: " << id
                    << "off: " << off << ", err:" << errCode;
@@ -559,12 +699,24 @@ StoreStatus NameServerStorageImp::DiscardSegment(
         NameSpaceStorageCodec::EncodeSegmentStoreKey(inodeId, offset);
     const std::string cleanSegmentKey =
         NameSpaceStorageCodec::EncodeDiscardSegmentStoreKey(inodeId, offset);
+    std::string fileKey;
+    if (GetStoreKey(fileInfo.filetype(), fileInfo.parentid(),
+                    fileInfo.filename(), &fileKey) != StoreStatus::OK) {
+        LOG(ERROR) << "get store key failed, filename = "
+                   << fileInfo.filename();
+        return StoreStatus::InternalError;
+    }
 
     std::string encodeSegment;
     if (!NameSpaceStorageCodec::EncodeSegment(segment, &encodeSegment)) {
         return StoreStatus::InternalError;
     }
 
+    std::string encodeFileInfo;
+    if (!NameSpaceStorageCodec::EncodeFileInfo(fileInfo, &encodeFileInfo)) {
+        return StoreStatus::InternalError;
+    }
+
     std::string encodeDiscardSegment;
     DiscardSegmentInfo discardInfo;
     discardInfo.set_allocated_fileinfo(new FileInfo(fileInfo));
@@ -584,15 +736,24 @@ StoreStatus NameServerStorageImp::DiscardSegment(
         const_cast<char*>(cleanSegmentKey.c_str()),
         const_cast<char*>(encodeDiscardSegment.c_str()),
         cleanSegmentKey.size(), encodeDiscardSegment.size()};
+    Operation op3{
+        OpType::OpPut,
+        const_cast<char*>(fileKey.c_str()),
+        const_cast<char*>(encodeFileInfo.c_str()),
+        fileKey.size(), encodeFileInfo.size()};
 
-    std::vector<Operation> ops{op1, op2};
+    // delete the information in cache first
+    CacheRemove(fileKey);
+
+    std::vector<Operation> ops{op1, op2, op3};
     auto errCode = client_->TxnN(ops);
     if (errCode != EtcdErrCode::EtcdOK) {
         LOG(ERROR) << "Discard segment failed, filename: "
                    << fileInfo.filename() << ", inodeid = " << inodeId
                    << ", offset: " << offset << ", errCode: " << errCode;
     } else {
-        cache_->Remove(segmentKey);
+        CacheRemove(segmentKey);
+        CachePut(fileKey, encodeFileInfo);
         discardMetric_.OnReceiveDiscardRequest(segment.segmentsize());
     }
 
@@ -649,7 +810,7 @@ StoreStatus NameServerStorageImp::SnapShotFile(const FileInfo *originFInfo,
     }
 
     // delete the information in cache first
-    cache_->Remove(originFileKey);
+    CacheRemove(originFileKey);
 
     // then update Etcd
     Operation op1{
@@ -672,8 +833,8 @@ StoreStatus NameServerStorageImp::SnapShotFile(const FileInfo *originFInfo,
                    << ", fileinfo: " << originFInfo->filename() << "err";
     } else {
         // update cache at last
-        cache_->Put(originFileKey, encodeFileInfo);
-        cache_->Put(snapshotFileKey, encodeSnapshot);
+        CachePut(originFileKey, encodeFileInfo);
+        CachePut(snapshotFileKey, encodeSnapshot);
     }
     return getErrorCode(errCode);
 }
@@ -718,6 +879,24 @@ StoreStatus NameServerStorageImp::getErrorCode(int errCode) {
     }
 }
 
+void NameServerStorageImp::CachePut(const std::string& key,
+                                    const std::string& value) {
+    cache_->Put(key, value);
+    // decoded value is filled by the next GetFile
+    if (fileInfoCache_ != nullptr) {
+        FileInfoGeneration(key).fetch_add(1, std::memory_order_acq_rel);
+        fileInfoCache_->Remove(key);
+    }
+}
+
+void NameServerStorageImp::CacheRemove(const std::string& key) {
+    cache_->Remove(key);
+    if (fileInfoCache_ != nullptr) {
+        FileInfoGeneration(key).fetch_add(1, std::memory_order_acq_rel);
+        fileInfoCache_->Remove(key);
+    }
+}
+
 StoreStatus NameServerStorageImp::GetStoreKey(FileType filetype,
                                               InodeID id,
                                               const std::string& filename,
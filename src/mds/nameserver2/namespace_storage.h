@@ -22,6 +22,8 @@
 #ifndef SRC_MDS_NAMESERVER2_NAMESPACE_STORAGE_H_
 #define SRC_MDS_NAMESERVER2_NAMESPACE_STORAGE_H_
 
+#include <array>
+#include <atomic>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -43,6 +45,10 @@ using ::curve::kvstorage::EtcdClientImp;
 using ::curve::kvstorage::KVStorageClient;
 using Cache =
     ::curve::common::LRUCacheInterface<std::string, std::string>;
+// decoded file infos keyed by file store key, which is made of the parent
+// inode id and the file name
+using FileInfoCache = ::curve::common::LRUCacheInterface<
+    std::string, std::shared_ptr<FileInfo>>;
 
 enum class StoreStatus {
     OK = 0,
@@ -211,6 +217,37 @@ class NameServerStorage {
                                     const PageFileSegment * segment,
                                     int64_t *revision) = 0;
 
+    /**
+     * @brief PutSegmentWithFile: Transaction for storing specified segment
+     *                            information and the metadata of its file
+     *
+     * @param[in] fileInfo: Metadata of the file the segment belongs to
+     * @param[in] off: Offset of the target segment
+     * @param[in] segment: Segment info
+     * @param[out] revision: The version number of this operation
+     *
+     * @return StoreStatus: error code
+     */
+    virtual StoreStatus PutSegmentWithFile(const FileInfo &fileInfo,
+                                           uint64_t off,
+                                           const PageFileSegment *segment,
+                                           int64_t *revision) = 0;
+
+    /**
+     * @brief PutSegmentsWithFile: Transaction for storing a batch of segments
+     *                             and the metadata of their file
+     *
+     * @param[in] fileInfo: Metadata of the file the segments belong to
+     * @param[in] segments: Segments info, keyed by their start offset
+     * @param[out] revision: The version number of this operation
+     *
+     * @return StoreStatus: error code
+     */
+    virtual StoreStatus PutSegmentsWithFile(
+        const FileInfo &fileInfo,
+        const std::vector<PageFileSegment> &segments,
+        int64_t *revision) = 0;
+
     /**
      * @brief DeleteSegment: Delete the specified segment metadata
      *
@@ -226,9 +263,10 @@ class NameServerStorage {
     /**
      * @brief Move segment metadata from SegmentTable to DiscardSegmentTable,
      *        another background task will delete all chunks and delete segment
-     *        in DiscardSegmentTable
-     * @param[in] id: Inode ID of the target file
-     * @param[in] off: Offset of the target segment
+     *        in DiscardSegmentTable, the file metadata is updated in the
+     *        same transaction
+     * @param[in] fileInfo: Metadata of the file the segment belongs to
+     * @param[in] segment: The target segment
      *
      * @return StoreStatus: error code
      */
@@ -279,8 +317,17 @@ class NameServerStorage {
 
 class NameServerStorageImp : public NameServerStorage {
  public:
-    explicit NameServerStorageImp(
-        std::shared_ptr<KVStorageClient> client, std::shared_ptr<Cache> cache);
+    /**
+     * @param client underlying kv storage
+     * @param cache cache of encoded values
+     * @param fileInfoCache optional cache of decoded file infos, it is
+     *        used by GetFile so that resolving a path does not decode every
+     *        component again, and invalidated whenever cache changes
+     */
+    NameServerStorageImp(std::shared_ptr<KVStorageClient> client,
+                         std::shared_ptr<Cache> cache,
+                         std::shared_ptr<FileInfoCache> fileInfoCache =
+                             nullptr);
     ~NameServerStorageImp() {}
 
     StoreStatus PutFile(const FileInfo & fileInfo) override;
@@ -326,6 +373,16 @@ class NameServerStorageImp : public NameServerStorage {
                             const PageFileSegment * segment,
                             int64_t *revision) override;
 
+    StoreStatus PutSegmentWithFile(const FileInfo &fileInfo,
+                                   uint64_t off,
+                                   const PageFileSegment *segment,
+                                   int64_t *revision) override;
+
+    StoreStatus PutSegmentsWithFile(
+        const FileInfo &fileInfo,
+        const std::vector<PageFileSegment> &segments,
+        int64_t *revision) override;
+
     StoreStatus DeleteSegment(
         InodeID id, uint64_t off, int64_t *revision) override;
 
@@ -354,10 +411,24 @@ class NameServerStorageImp : public NameServerStorage {
                             std::string* storekey);
     StoreStatus getErrorCode(int errCode);
 
+    void CachePut(const std::string& key, const std::string& value);
+    void CacheRemove(const std::string& key);
+
+    // generation of keys hashed to the same slot, bumped by every update of
+    // these keys, so decoded value filled by GetFile can be checked stale
+    std::atomic<uint64_t>& FileInfoGeneration(const std::string& key) {
+        return fileInfoGens_[std::hash<std::string>()(key) %
+                             fileInfoGens_.size()];
+    }
+
  private:
     // namespace-meta cache
     std::shared_ptr<Cache> cache_;
 
+    // decoded file info cache
+    std::shared_ptr<FileInfoCache> fileInfoCache_;
+    std::array<std::atomic<uint64_t>, 256> fileInfoGens_;
+
     // underlying storage
     std::shared_ptr<KVStorageClient> client_;
 
@@ -33,7 +33,15 @@ namespace curve {
 namespace mds {
 
 using LRUCache = ::curve::common::LRUCache<std::string, std::string>;
+using ShardedLRUCache =
+    ::curve::common::ShardedLRUCache<std::string, std::string>;
+using LRUCacheInterface =
+    ::curve::common::LRUCacheInterface<std::string, std::string>;
 using CacheMetrics = ::curve::common::CacheMetrics;
+using FileInfoLRUCache =
+    ::curve::common::LRUCache<std::string, std::shared_ptr<FileInfo>>;
+using ShardedFileInfoLRUCache =
+    ::curve::common::ShardedLRUCache<std::string, std::shared_ptr<FileInfo>>;
 
 MDS::~MDS() {
     if (etcdEndpoints_) {
@@ -64,6 +72,14 @@ void MDS::InitMdsOptions(std::shared_ptr<Configuration> conf) {
 
     // cache size of namestorage
     conf_->GetValueFatalIfFail("mds.cache.count", &options_.mdsCacheCount);
+    if (!conf_->GetUInt32Value("mds.cache.shardBits",
+                               &options_.mdsCacheShardBits)) {
+        options_.mdsCacheShardBits = 0;
+    }
+    if (!conf_->GetIntValue("mds.cache.fileInfoCount",
+                            &options_.mdsFileInfoCacheCount)) {
+        options_.mdsFileInfoCacheCount = options_.mdsCacheCount;
+    }
 
     conf_->GetValueFatalIfFail("mds.listen.addr", &options_.mdsListenAddr);
 
@@ -120,7 +136,9 @@ void MDS::StartCompaginLeader() {
 void MDS::Init() {
     InitSegmentAllocStatistic(options_.retryInterTimes,
                               options_.periodicPersistInterMs);
-    InitNameServerStorage(options_.mdsCacheCount);
+    InitNameServerStorage(options_.mdsCacheCount,
+                          options_.mdsCacheShardBits,
+                          options_.mdsFileInfoCacheCount);
     InitTopology(options_.topologyOption);
     InitTopologyStat();
     InitTopologyChunkAllocator(options_.topologyOption);
@@ -391,16 +409,39 @@ void MDS::InitTopologyChunkAllocator(const TopologyOption& option) {
     LOG(INFO) << "init topologyChunkAllocator success.";
 }
 
-void MDS::InitNameServerStorage(int mdsCacheCount) {
+void MDS::InitNameServerStorage(int mdsCacheCount, uint32_t shardBits,
+                                int fileInfoCacheCount) {
     // init LRUCache
-
-    auto cache = std::make_shared<LRUCache>(mdsCacheCount,
-        std::make_shared<CacheMetrics>("mds_nameserver_cache_metric"));
-    LOG(INFO) << "init LRUCache success.";
+    std::shared_ptr<LRUCacheInterface> cache;
+    auto metrics =
+        std::make_shared<CacheMetrics>("mds_nameserver_cache_metric");
+    if (shardBits > 0) {
+        cache = std::make_shared<ShardedLRUCache>(shardBits, mdsCacheCount,
+                                                  metrics);
+    } else {
+        cache = std::make_shared<LRUCache>(mdsCacheCount, metrics);
+    }
+    LOG(INFO) << "init LRUCache success, shard bits: " << shardBits;
+
+    // init decoded file info cache
+    std::shared_ptr<FileInfoCache> fileInfoCache;
+    if (fileInfoCacheCount > 0) {
+        auto fileInfoMetrics = std::make_shared<CacheMetrics>(
+            "mds_nameserver_fileinfo_cache_metric");
+        if (shardBits > 0) {
+            fileInfoCache = std::make_shared<ShardedFileInfoLRUCache>(
+                shardBits, fileInfoCacheCount, fileInfoMetrics);
+        } else {
+            fileInfoCache = std::make_shared<FileInfoLRUCache>(
+                fileInfoCacheCount, fileInfoMetrics);
+        }
+        LOG(INFO) << "init file info cache success, count: "
+                  << fileInfoCacheCount;
+    }
 
     // init NameServerStorage
-    nameServerStorage_ = std::make_shared<NameServerStorageImp>(etcdClient_,
-                                                                cache);
+    nameServerStorage_ = std::make_shared<NameServerStorageImp>(
+        etcdClient_, cache, fileInfoCache);
     LOG(INFO) << "init NameServerStorage success.";
 }
 
@@ -431,6 +472,9 @@ void MDS::InitCurveFS(const CurveFSOption& curveFSOptions) {
                         topologyChunkAllocator_, chunkIdGenerator);
     LOG(INFO) << "init ChunkSegmentAllocator success.";
 
+    // init copyset to file reverse index, it is shared with clean manager
+    copysetFileIndex_ = std::make_shared<CopysetFileIndex>();
+
     // init clean manager
     InitCleanManager();
 
@@ -456,10 +500,14 @@ void MDS::InitCurveFS(const CurveFSOption& curveFSOptions) {
                   fileRecordManager,
                   segmentAllocStatistic_,
                   curveFSOptions, topology_,
-                  snapshotCloneClient_))
+                  snapshotCloneClient_, copysetFileIndex_))
         << "init FileRecordManager fail";
     LOG(INFO) << "init FileRecordManager success.";
 
+    LOG_IF(ERROR, kCurveFS.BuildCopysetFileIndex() != StatusCode::kOK)
+        << "build copyset file index fail, ListVolumesOnCopysets will "
+           "scan the namespace";
+
     LOG(INFO) << "RecoverCleanTasks success.";
 }
 
@@ -531,7 +579,8 @@ void MDS::InitCleanManager() {
 
     auto cleanCore = std::make_shared<CleanCore>(nameServerStorage_,
                                                  copysetClient,
-                                                 segmentAllocStatistic_);
+                                                 segmentAllocStatistic_,
+                                                 copysetFileIndex_);
 
     // init dlock options
     auto dlockOpts = std::make_shared<DLockOpts>();
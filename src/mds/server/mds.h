@@ -96,6 +96,11 @@ struct MDSOptions {
     uint64_t periodicPersistInterMs;
     // cache size of namestorage
     int mdsCacheCount;
+    // namestorage cache is split into 2^mdsCacheShardBits shards,
+    // 0 means using a single lru list
+    uint32_t mdsCacheShardBits;
+    // count of decoded file infos cached for path resolution, 0 to disable
+    int mdsFileInfoCacheCount;
     int mdsFilelockBucketNum;
 
     FileRecordOptions fileRecordOptions;
@@ -179,7 +184,8 @@ class MDS {
     void InitSegmentAllocStatistic(uint64_t retryInterTimes,
                                    uint64_t periodicPersistInterMs);
 
-    void InitNameServerStorage(int mdsCacheCount);
+    void InitNameServerStorage(int mdsCacheCount, uint32_t shardBits,
+                               int fileInfoCacheCount);
 
     void StartServer();
 
@@ -223,6 +229,7 @@ class MDS {
     std::shared_ptr<EtcdClientImp> etcdClient_;
     std::shared_ptr<LeaderElection> leaderElection_;
     std::shared_ptr<AllocStatistic> segmentAllocStatistic_;
+    std::shared_ptr<CopysetFileIndex> copysetFileIndex_;
     std::shared_ptr<NameServerStorage> nameServerStorage_;
     std::shared_ptr<TopologyImpl> topology_;
     std::shared_ptr<TopologyStatImpl> topologyStat_;
@@ -26,6 +26,8 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <map>
+#include <utility>
 
 #include "src/snapshotcloneserver/clone/clone_task.h"
 #include "src/common/location_operator.h"
@@ -904,12 +906,6 @@ int CloneCoreImpl::RecoverChunk(
     int ret = kErrCodeSuccess;
     uint32_t chunkSize = fInfo.chunksize;
 
-    uint32_t totalProgress =
-        kProgressRecoverChunkEnd - kProgressRecoverChunkBegin;
-    uint32_t segNum = segInfos.size();
-    double progressPerData = static_cast<double>(totalProgress) / segNum;
-    uint32_t index = 0;
-
     if (0 == cloneChunkSplitSize_ ||
         chunkSize % cloneChunkSplitSize_ != 0) {
         LOG(ERROR) << "chunk is not align to cloneChunkSplitSize"
@@ -917,65 +913,93 @@ int CloneCoreImpl::RecoverChunk(
         return kErrCodeChunkSizeNotAligned;
     }
 
-    auto tracker = std::make_shared<RecoverChunkTaskTracker>();
-    uint64_t workingChunkNum = 0;
-    // 为避免发往同一个chunk碰撞，异步请求不同的chunk
+    // 按copyset轮流排列需要recover的chunk，使并发的请求分散到不同的copyset
+    std::map<std::pair<LogicPoolID, CopysetID>, std::list<ChunkIDInfo>>
+        copysetChunks;
+    uint64_t totalChunkNum = 0;
     for (auto & cloneSegmentInfo : segInfos) {
         for (auto & cloneChunkInfo : cloneSegmentInfo.second) {
             if (!cloneChunkInfo.second.needRecover) {
                 continue;
             }
-            // 当前并发工作的chunk数已大于要求的并发数时，先消化一部分
-            while (workingChunkNum >= recoverChunkConcurrency_) {
-                uint64_t completeChunkNum = 0;
-                ret = ContinueAsyncRecoverChunkPartAndWaitSomeChunkEnd(task,
-                    tracker,
-                    &completeChunkNum);
-                if (ret < 0) {
-                    return kErrCodeInternalError;
-                }
-                workingChunkNum -= completeChunkNum;
+            const ChunkIDInfo &cidInfo = cloneChunkInfo.second.chunkIdInfo;
+            copysetChunks[std::make_pair(cidInfo.lpid_, cidInfo.cpid_)]
+                .push_back(cidInfo);
+            totalChunkNum++;
+        }
+    }
+    std::vector<ChunkIDInfo> chunks;
+    chunks.reserve(totalChunkNum);
+    while (!copysetChunks.empty()) {
+        for (auto it = copysetChunks.begin(); it != copysetChunks.end();) {
+            chunks.push_back(it->second.front());
+            it->second.pop_front();
+            if (it->second.empty()) {
+                it = copysetChunks.erase(it);
+            } else {
+                ++it;
             }
-            // 加入新的工作的chunk
-            workingChunkNum++;
-            auto context = std::make_shared<RecoverChunkContext>();
-            context->cidInfo = cloneChunkInfo.second.chunkIdInfo;
-            context->totalPartNum = chunkSize / cloneChunkSplitSize_;
-            context->partIndex = 0;
-            context->partSize = cloneChunkSplitSize_;
-            context->taskid = task->GetTaskId();
-            context->startTime = TimeUtility::GetTimeofDaySec();
-            context->clientAsyncMethodRetryTimeSec =
-                clientAsyncMethodRetryTimeSec_;
-
-            LOG(INFO) << "RecoverChunk start"
-                       << ", logicalPoolId = "
-                       << context->cidInfo.lpid_
-                       << ", copysetId = " << context->cidInfo.cpid_
-                       << ", chunkId = " << context->cidInfo.cid_
-                       << ", len = " << context->partSize
-                       << ", taskid = " << task->GetTaskId();
+        }
+    }
 
-            ret = StartAsyncRecoverChunkPart(task, tracker, context);
+    auto tracker = std::make_shared<RecoverChunkTaskTracker>();
+    uint64_t workingChunkNum = 0;
+    uint64_t completeChunkNum = 0;
+    uint64_t startTime = TimeUtility::GetTimeofDaySec();
+    // 为避免发往同一个chunk碰撞，异步请求不同的chunk
+    for (auto & cidInfo : chunks) {
+        // 当前并发工作的chunk数已大于要求的并发数时，先消化一部分
+        while (workingChunkNum >= recoverChunkConcurrency_) {
+            uint64_t completeNum = 0;
+            ret = ContinueAsyncRecoverChunkPartAndWaitSomeChunkEnd(task,
+                tracker,
+                &completeNum);
             if (ret < 0) {
                 return kErrCodeInternalError;
             }
+            workingChunkNum -= completeNum;
+            completeChunkNum += completeNum;
+            UpdateRecoverChunkProgress(task, completeChunkNum,
+                totalChunkNum, startTime);
+        }
+        // 加入新的工作的chunk
+        workingChunkNum++;
+        auto context = std::make_shared<RecoverChunkContext>();
+        context->cidInfo = cidInfo;
+        context->totalPartNum = chunkSize / cloneChunkSplitSize_;
+        context->partIndex = 0;
+        context->partSize = cloneChunkSplitSize_;
+        context->taskid = task->GetTaskId();
+        context->startTime = TimeUtility::GetTimeofDaySec();
+        context->clientAsyncMethodRetryTimeSec =
+            clientAsyncMethodRetryTimeSec_;
+
+        LOG(INFO) << "RecoverChunk start"
+                   << ", logicalPoolId = "
+                   << context->cidInfo.lpid_
+                   << ", copysetId = " << context->cidInfo.cpid_
+                   << ", chunkId = " << context->cidInfo.cid_
+                   << ", len = " << context->partSize
+                   << ", taskid = " << task->GetTaskId();
+
+        ret = StartAsyncRecoverChunkPart(task, tracker, context);
+        if (ret < 0) {
+            return kErrCodeInternalError;
         }
-        task->SetProgress(static_cast<uint32_t>(
-            kProgressRecoverChunkBegin + index * progressPerData));
-        task->UpdateMetric();
-        index++;
     }
 
     while (workingChunkNum > 0) {
-        uint64_t completeChunkNum = 0;
+        uint64_t completeNum = 0;
         ret = ContinueAsyncRecoverChunkPartAndWaitSomeChunkEnd(task,
             tracker,
-            &completeChunkNum);
+            &completeNum);
         if (ret < 0) {
             return kErrCodeInternalError;
         }
-        workingChunkNum -= completeChunkNum;
+        workingChunkNum -= completeNum;
+        completeChunkNum += completeNum;
+        UpdateRecoverChunkProgress(task, completeChunkNum,
+            totalChunkNum, startTime);
     }
 
     task->GetCloneInfo().SetNextStep(CloneStep::kCompleteCloneFile);
@@ -989,11 +1013,37 @@ int CloneCoreImpl::RecoverChunk(
     return kErrCodeSuccess;
 }
 
+void CloneCoreImpl::UpdateRecoverChunkProgress(
+    std::shared_ptr<CloneTaskInfo> task,
+    uint64_t completeChunkNum,
+    uint64_t totalChunkNum,
+    uint64_t startTime) {
+    if (totalChunkNum == 0) {
+        return;
+    }
+    uint32_t totalProgress =
+        kProgressRecoverChunkEnd - kProgressRecoverChunkBegin;
+    task->SetProgress(static_cast<uint32_t>(kProgressRecoverChunkBegin +
+        totalProgress * completeChunkNum / totalChunkNum));
+
+    // 按已完成chunk的平均耗时估计剩余时间
+    if (completeChunkNum > 0) {
+        uint64_t elapsed = TimeUtility::GetTimeofDaySec() - startTime;
+        task->SetEstimatedRemainingSec(elapsed *
+            (totalChunkNum - completeChunkNum) / completeChunkNum);
+    }
+    task->UpdateMetric();
+}
+
 int CloneCoreImpl::StartAsyncRecoverChunkPart(
     std::shared_ptr<CloneTaskInfo> task,
     std::shared_ptr<RecoverChunkTaskTracker> tracker,
     std::shared_ptr<RecoverChunkContext> context) {
-    RecoverChunkClosure *cb = new RecoverChunkClosure(tracker, context);
+    // 等待全局和copyset的并发额度，额度在closure中释放，
+    // client在请求失败时也会调用closure
+    recoverChunkScheduler_->Acquire(context->cidInfo);
+    RecoverChunkClosure *cb = new RecoverChunkClosure(tracker, context,
+        recoverChunkScheduler_);
     tracker->AddOneTrace();
     uint64_t offset = context->partIndex * context->partSize;
     LOG_EVERY_SECOND(INFO) << "Doing RecoverChunk"
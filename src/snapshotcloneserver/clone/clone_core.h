@@ -35,6 +35,7 @@
 #include "src/snapshotcloneserver/snapshot/snapshot_data_store.h"
 #include "src/snapshotcloneserver/common/snapshot_reference.h"
 #include "src/snapshotcloneserver/clone/clone_reference.h"
+#include "src/snapshotcloneserver/clone/recover_chunk_scheduler.h"
 #include "src/snapshotcloneserver/common/thread_pool.h"
 #include "src/common/concurrent/name_lock.h"
 
@@ -237,7 +238,11 @@ class CloneCoreImpl : public CloneCore {
         recoverChunkConcurrency_(option.recoverChunkConcurrency),
         clientAsyncMethodRetryTimeSec_(option.clientAsyncMethodRetryTimeSec),
         clientAsyncMethodRetryIntervalMs_(
-            option.clientAsyncMethodRetryIntervalMs) {}
+            option.clientAsyncMethodRetryIntervalMs),
+        recoverChunkScheduler_(std::make_shared<RecoverChunkScheduler>(
+            option.recoverChunkGlobalConcurrency,
+            option.recoverChunkCopysetConcurrency,
+            option.recoverChunkLatencyThresholdMs)) {}
 
     ~CloneCoreImpl() {
     }
@@ -449,6 +454,20 @@ class CloneCoreImpl : public CloneCore {
         const FInfo &fInfo,
         const CloneSegmentMap &segInfos);
 
+    /**
+     * @brief 更新RecoverChunk阶段的进度和预计剩余时间
+     *
+     * @param task 任务信息
+     * @param completeChunkNum 已完成的chunk数
+     * @param totalChunkNum 需要recover的chunk总数
+     * @param startTime RecoverChunk阶段开始的时间(s)
+     */
+    void UpdateRecoverChunkProgress(
+        std::shared_ptr<CloneTaskInfo> task,
+        uint64_t completeChunkNum,
+        uint64_t totalChunkNum,
+        uint64_t startTime);
+
     /**
      * @brief 开始RecoverChunk的异步请求
      *
@@ -598,6 +617,8 @@ class CloneCoreImpl : public CloneCore {
     uint64_t clientAsyncMethodRetryTimeSec_;
     // 调用client异步方法重试时间间隔
     uint64_t clientAsyncMethodRetryIntervalMs_;
+    // 协调所有任务的RecoverChunk请求
+    std::shared_ptr<RecoverChunkScheduler> recoverChunkScheduler_;
 };
 
 }  // namespace snapshotcloneserver
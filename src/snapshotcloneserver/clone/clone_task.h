@@ -23,6 +23,7 @@
 #ifndef SRC_SNAPSHOTCLONESERVER_CLONE_CLONE_TASK_H_
 #define SRC_SNAPSHOTCLONESERVER_CLONE_CLONE_TASK_H_
 
+#include <atomic>
 #include <string>
 #include <memory>
 
@@ -33,6 +34,8 @@
 #include "src/snapshotcloneserver/common/snapshotclone_metric.h"
 #include "src/snapshotcloneserver/common/curvefs_client.h"
 #include "src/snapshotcloneserver/clone/clone_closure.h"
+#include "src/snapshotcloneserver/clone/recover_chunk_scheduler.h"
+#include "src/common/timeutility.h"
 #include "src/common/concurrent/dlock.h"
 
 using ::curve::common::DLock;
@@ -48,7 +51,8 @@ class CloneTaskInfo : public TaskInfo {
         : TaskInfo(),
           cloneInfo_(cloneInfo),
           metric_(metric),
-          closure_(closure) {}
+          closure_(closure),
+          estimatedRemainingSec_(0) {}
 
     CloneInfo& GetCloneInfo() {
         return cloneInfo_;
@@ -70,10 +74,20 @@ class CloneTaskInfo : public TaskInfo {
         return closure_;
     }
 
+    void SetEstimatedRemainingSec(uint64_t sec) {
+        estimatedRemainingSec_ = sec;
+    }
+
+    uint64_t GetEstimatedRemainingSec() const {
+        return estimatedRemainingSec_;
+    }
+
  private:
     CloneInfo cloneInfo_;
     std::shared_ptr<CloneInfoMetric> metric_;
     std::shared_ptr<CloneClosure> closure_;
+    // RecoverChunk阶段预计剩余时间(s)
+    std::atomic<uint64_t> estimatedRemainingSec_;
 };
 
 std::ostream& operator<<(std::ostream& os, const CloneTaskInfo &taskInfo);
@@ -219,12 +233,20 @@ using RecoverChunkContextPtr = std::shared_ptr<RecoverChunkContext>;
 
 struct RecoverChunkClosure : public SnapCloneClosure {
     RecoverChunkClosure(std::shared_ptr<RecoverChunkTaskTracker> tracker,
-        RecoverChunkContextPtr context)
+        RecoverChunkContextPtr context,
+        std::shared_ptr<RecoverChunkScheduler> scheduler = nullptr)
         : tracker_(tracker),
-          context_(context) {}
+          context_(context),
+          scheduler_(scheduler),
+          startUs_(::curve::common::TimeUtility::GetTimeofDayUs()) {}
     void Run() {
         std::unique_ptr<RecoverChunkClosure> self_guard(this);
         context_->retCode = GetRetCode();
+        if (scheduler_ != nullptr) {
+            scheduler_->Release(context_->cidInfo,
+                ::curve::common::TimeUtility::GetTimeofDayUs() - startUs_,
+                context_->retCode >= 0);
+        }
         if (context_->retCode < 0) {
             LOG(WARNING) << "RecoverChunkClosure return fail"
                          << ", ret = " << context_->retCode
@@ -241,6 +263,10 @@ struct RecoverChunkClosure : public SnapCloneClosure {
     }
     std::shared_ptr<RecoverChunkTaskTracker> tracker_;
     RecoverChunkContextPtr context_;
+    // 协调所有任务RecoverChunk请求的调度器
+    std::shared_ptr<RecoverChunkScheduler> scheduler_;
+    // 请求开始的时间
+    uint64_t startUs_;
 };
 
 }  // namespace snapshotcloneserver
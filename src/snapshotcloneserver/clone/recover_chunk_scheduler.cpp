@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#include "src/snapshotcloneserver/clone/recover_chunk_scheduler.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+
+namespace curve {
+namespace snapshotcloneserver {
+
+namespace {
+
+// weight of the latest sample in the smoothed latency
+const double kLatencySmoothFactor = 0.2;
+
+}  // namespace
+
+RecoverChunkScheduler::RecoverChunkScheduler(uint32_t globalConcurrency,
+                                             uint32_t copysetConcurrency,
+                                             uint32_t latencyThresholdMs)
+    : globalConcurrency_(std::max(1u, globalConcurrency)),
+      copysetConcurrency_(std::max(1u, copysetConcurrency)),
+      latencyThresholdUs_(latencyThresholdMs * 1000ull),
+      inflight_(0) {}
+
+RecoverChunkScheduler::CopysetState *RecoverChunkScheduler::GetState(
+    const CopysetKey &key) {
+    auto iter = copysets_.find(key);
+    if (iter == copysets_.end()) {
+        CopysetState state;
+        state.window = copysetConcurrency_;
+        iter = copysets_.emplace(key, state).first;
+    }
+    return &iter->second;
+}
+
+void RecoverChunkScheduler::Acquire(const ChunkIDInfo &cidInfo) {
+    ::curve::common::UniqueLock lk(mutex_);
+    CopysetState *state = GetState(CopysetKey(cidInfo.lpid_, cidInfo.cpid_));
+    cv_.wait(lk, [&] {
+        return inflight_ < globalConcurrency_ &&
+               state->inflight < state->window;
+    });
+    inflight_++;
+    state->inflight++;
+}
+
+void RecoverChunkScheduler::Release(const ChunkIDInfo &cidInfo,
+                                    uint64_t latencyUs, bool success) {
+    {
+        ::curve::common::LockGuard lk(mutex_);
+        CopysetState *state =
+            GetState(CopysetKey(cidInfo.lpid_, cidInfo.cpid_));
+        CHECK(inflight_ > 0 && state->inflight > 0)
+            << "release recover chunk without acquire";
+        inflight_--;
+        state->inflight--;
+
+        if (state->avgLatencyUs == 0) {
+            state->avgLatencyUs = latencyUs;
+        } else {
+            state->avgLatencyUs = kLatencySmoothFactor * latencyUs +
+                (1 - kLatencySmoothFactor) * state->avgLatencyUs;
+        }
+
+        bool overloaded = !success || (latencyThresholdUs_ != 0 &&
+            state->avgLatencyUs > latencyThresholdUs_);
+        if (overloaded) {
+            if (state->window > 1) {
+                state->window--;
+                LOG(INFO) << "RecoverChunk shrink copyset window"
+                          << ", logicalPoolId = " << cidInfo.lpid_
+                          << ", copysetId = " << cidInfo.cpid_
+                          << ", window = " << state->window
+                          << ", avgLatencyUs = " << state->avgLatencyUs;
+            }
+            state->completedSinceGrow = 0;
+        } else if (state->window < copysetConcurrency_ &&
+                   ++state->completedSinceGrow >= state->window) {
+            state->window++;
+            state->completedSinceGrow = 0;
+        }
+    }
+    cv_.notify_all();
+}
+
+uint32_t RecoverChunkScheduler::GetInflightNum() const {
+    ::curve::common::LockGuard lk(mutex_);
+    return inflight_;
+}
+
+uint32_t RecoverChunkScheduler::GetCopysetWindow(
+    const ChunkIDInfo &cidInfo) const {
+    ::curve::common::LockGuard lk(mutex_);
+    auto iter = copysets_.find(CopysetKey(cidInfo.lpid_, cidInfo.cpid_));
+    if (iter == copysets_.end()) {
+        return copysetConcurrency_;
+    }
+    return iter->second.window;
+}
+
+}  // namespace snapshotcloneserver
+}  // namespace curve
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#ifndef SRC_SNAPSHOTCLONESERVER_CLONE_RECOVER_CHUNK_SCHEDULER_H_
+#define SRC_SNAPSHOTCLONESERVER_CLONE_RECOVER_CHUNK_SCHEDULER_H_
+
+#include <map>
+#include <utility>
+
+#include "src/client/client_common.h"
+#include "src/common/concurrent/concurrent.h"
+
+namespace curve {
+namespace snapshotcloneserver {
+
+using ::curve::client::ChunkIDInfo;
+using ::curve::client::CopysetID;
+using ::curve::client::LogicPoolID;
+
+/**
+ * RecoverChunkScheduler 协调所有克隆/恢复任务的RecoverChunk请求
+ *
+ * - 全局限制同时进行的RecoverChunk请求数量，多个任务共享
+ * - 每个copyset有一个并发窗口，请求发往copyset的leader，
+ *   窗口随该copyset上RecoverChunk的平滑延迟调整：
+ *   延迟超过阈值时窗口减一，否则每完成一个窗口的请求窗口加一，
+ *   从而在前台IO繁忙的chunkserver上自动降低flatten的压力
+ */
+class RecoverChunkScheduler {
+ public:
+    /**
+     * @param globalConcurrency 全局最大并发请求数
+     * @param copysetConcurrency 每个copyset最大并发请求数
+     * @param latencyThresholdMs 延迟阈值，为0时不根据延迟调整窗口
+     */
+    RecoverChunkScheduler(uint32_t globalConcurrency,
+                          uint32_t copysetConcurrency,
+                          uint32_t latencyThresholdMs);
+
+    /**
+     * @brief 等待直到可以向chunk所在的copyset发送一个RecoverChunk请求
+     */
+    void Acquire(const ChunkIDInfo &cidInfo);
+
+    /**
+     * @brief RecoverChunk请求返回时调用，释放并发额度并更新copyset的窗口
+     *
+     * @param cidInfo chunk信息
+     * @param latencyUs 请求延迟
+     * @param success 请求是否成功
+     */
+    void Release(const ChunkIDInfo &cidInfo, uint64_t latencyUs,
+                 bool success);
+
+    uint32_t GetInflightNum() const;
+
+    uint32_t GetCopysetWindow(const ChunkIDInfo &cidInfo) const;
+
+ private:
+    using CopysetKey = std::pair<LogicPoolID, CopysetID>;
+
+    struct CopysetState {
+        uint32_t inflight = 0;
+        uint32_t window = 0;
+        // 上次调整窗口后成功完成的请求数
+        uint32_t completedSinceGrow = 0;
+        double avgLatencyUs = 0;
+    };
+
+    CopysetState *GetState(const CopysetKey &key);
+
+ private:
+    const uint32_t globalConcurrency_;
+    const uint32_t copysetConcurrency_;
+    const uint64_t latencyThresholdUs_;
+
+    mutable ::curve::common::Mutex mutex_;
+    ::curve::common::ConditionVariable cv_;
+    uint32_t inflight_;
+    std::map<CopysetKey, CopysetState> copysets_;
+};
+
+}  // namespace snapshotcloneserver
+}  // namespace curve
+
+#endif  // SRC_SNAPSHOTCLONESERVER_CLONE_RECOVER_CHUNK_SCHEDULER_H_
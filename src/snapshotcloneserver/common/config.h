@@ -90,6 +90,12 @@ struct SnapshotCloneServerOptions {
     uint32_t createCloneChunkConcurrency;
     // RecoverChunk同时进行的异步请求数量
     uint32_t recoverChunkConcurrency;
+    // 所有任务的RecoverChunk同时进行的异步请求总数
+    uint32_t recoverChunkGlobalConcurrency = 256;
+    // 每个copyset上RecoverChunk同时进行的异步请求数量上限
+    uint32_t recoverChunkCopysetConcurrency = 4;
+    // RecoverChunk平滑延迟超过该值时减小copyset的并发窗口，0表示不调整
+    uint32_t recoverChunkLatencyThresholdMs = 500;
     // 引用计数后台扫描每条记录间隔
     uint32_t backEndReferenceRecordScanIntervalMs;
     // 引用计数后台扫描每轮间隔
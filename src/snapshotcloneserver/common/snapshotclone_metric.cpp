@@ -124,6 +124,8 @@ void CloneInfoMetric::Update(CloneTaskInfo *taskInfo) {
         static_cast<int>(cloneInfo.GetStatus())));
 
     metric.Set("Progress", std::to_string(taskInfo->GetProgress()));
+    metric.Set("EstimatedRemainingSec",
+        std::to_string(taskInfo->GetEstimatedRemainingSec()));
 
     metric.Update();
 }
@@ -102,6 +102,24 @@ void InitSnapshotCloneServerOptions(std::shared_ptr<Configuration> conf,
                             &serverOption->createCloneChunkConcurrency);
     conf->GetValueFatalIfFail("server.recoverChunkConcurrency",
                             &serverOption->recoverChunkConcurrency);
+    LOG_IF(WARNING, !conf->GetUInt32Value(
+        "server.recoverChunkGlobalConcurrency",
+        &serverOption->recoverChunkGlobalConcurrency))
+        << "config no server.recoverChunkGlobalConcurrency info, "
+        << "using default value "
+        << serverOption->recoverChunkGlobalConcurrency;
+    LOG_IF(WARNING, !conf->GetUInt32Value(
+        "server.recoverChunkCopysetConcurrency",
+        &serverOption->recoverChunkCopysetConcurrency))
+        << "config no server.recoverChunkCopysetConcurrency info, "
+        << "using default value "
+        << serverOption->recoverChunkCopysetConcurrency;
+    LOG_IF(WARNING, !conf->GetUInt32Value(
+        "server.recoverChunkLatencyThresholdMs",
+        &serverOption->recoverChunkLatencyThresholdMs))
+        << "config no server.recoverChunkLatencyThresholdMs info, "
+        << "using default value "
+        << serverOption->recoverChunkLatencyThresholdMs;
     conf->GetValueFatalIfFail("server.backEndReferenceRecordScanIntervalMs",
                         &serverOption->backEndReferenceRecordScanIntervalMs);
     conf->GetValueFatalIfFail("server.backEndReferenceFuncScanIntervalMs",
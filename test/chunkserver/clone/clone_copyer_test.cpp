@@ -295,6 +295,83 @@ TEST_F(CloneCopyerTest, DisableTest) {
     ASSERT_EQ(0, copyer.Fini());
 }
 
+TEST_F(CloneCopyerTest, SourceCacheTest) {
+    OriginCopyer copyer;
+    CopyerOptions options;
+    options.s3Conf = S3_CONF;
+    options.curveFileTimeoutSec = EXPIRED_USE;
+    options.curveClient = nullptr;
+    options.s3Client = s3Client_;
+    options.sourceCacheOptions.enable = true;
+    options.sourceCacheOptions.blockSize = 4096;
+    options.sourceCacheOptions.memoryCapacityMB = 1;
+    ASSERT_EQ(0, copyer.Init(options));
+
+    char* buf = new char[4096];
+    AsyncDownloadContext context;
+    context.location = "test@s3";
+    context.buf = buf;
+    MockDownloadClosure closure(&context);
+
+    /* 用例:缓存未命中，按块对齐从s3下载
+     * 预期:下载[0, 4096)，返回请求的数据
+     */
+    context.offset = 1024;
+    context.size = 2048;
+    EXPECT_CALL(*s3Client_, GetObjectAsync(_))
+        .WillOnce(Invoke(
+            [&] (const std::shared_ptr<GetObjectAsyncContext>& context) {
+                ASSERT_EQ(0, context->offset);
+                ASSERT_EQ(4096, context->len);
+                memset(context->buf, 'a', context->len);
+                context->retCode = 0;
+                context->cb(s3Client_.get(), context);
+            }));
+    copyer.DownloadAsync(&closure);
+    ASSERT_TRUE(closure.IsRun());
+    ASSERT_FALSE(closure.IsFailed());
+    ASSERT_EQ(std::string(2048, 'a'), std::string(buf, 2048));
+    closure.Reset();
+
+    /* 用例:缓存命中
+     * 预期:不访问s3
+     */
+    context.offset = 0;
+    context.size = 4096;
+    EXPECT_CALL(*s3Client_, GetObjectAsync(_))
+        .Times(0);
+    copyer.DownloadAsync(&closure);
+    ASSERT_TRUE(closure.IsRun());
+    ASSERT_FALSE(closure.IsFailed());
+    ASSERT_EQ(std::string(4096, 'a'), std::string(buf, 4096));
+    closure.Reset();
+
+    /* 用例:下载失败
+     * 预期:返回失败，数据不会被缓存
+     */
+    context.location = "test2@s3";
+    EXPECT_CALL(*s3Client_, GetObjectAsync(_))
+        .Times(2)
+        .WillRepeatedly(Invoke(
+            [&] (const std::shared_ptr<GetObjectAsyncContext>& context) {
+                context->retCode = -1;
+                context->cb(s3Client_.get(), context);
+            }));
+    copyer.DownloadAsync(&closure);
+    ASSERT_TRUE(closure.IsRun());
+    ASSERT_TRUE(closure.IsFailed());
+    closure.Reset();
+    copyer.DownloadAsync(&closure);
+    ASSERT_TRUE(closure.IsRun());
+    ASSERT_TRUE(closure.IsFailed());
+    closure.Reset();
+
+    delete [] buf;
+    EXPECT_CALL(*s3Client_, Deinit())
+        .Times(1);
+    ASSERT_EQ(0, copyer.Fini());
+}
+
 TEST_F(CloneCopyerTest, ExpiredTest) {
     OriginCopyer copyer;
     CopyerOptions options;
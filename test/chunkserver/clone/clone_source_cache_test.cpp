@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "src/chunkserver/clone_source_cache.h"
+
+namespace curve {
+namespace chunkserver {
+
+using curve::fs::FileSystemType;
+using curve::fs::LocalFileSystemOption;
+using curve::fs::LocalFsFactory;
+
+namespace {
+
+const char kCacheDir[] = "./clone_source_cache_test";
+const char kLocation[] = "test@s3";
+
+}  // namespace
+
+class CloneSourceCacheTest : public testing::Test {
+ public:
+    void SetUp() {
+        fs_ = LocalFsFactory::CreateFs(FileSystemType::EXT4, "");
+        ASSERT_EQ(0, fs_->Init(LocalFileSystemOption()));
+        ::system((std::string("rm -rf ") + kCacheDir).c_str());
+    }
+
+    void TearDown() {
+        ::system((std::string("rm -rf ") + kCacheDir).c_str());
+    }
+
+ protected:
+    std::shared_ptr<LocalFileSystem> fs_;
+};
+
+TEST_F(CloneSourceCacheTest, MemoryTest) {
+    CloneSourceCacheOptions options;
+    options.enable = true;
+    options.blockSize = 4096;
+    options.memoryCapacityMB = 1;
+    CloneSourceCache cache(options, fs_);
+    ASSERT_EQ(0, cache.Init());
+
+    std::string data(2 * 4096, 'a');
+    data.replace(4096, 4096, std::string(4096, 'b'));
+    std::vector<char> buf(4096);
+
+    ASSERT_FALSE(cache.Read(kLocation, 0, 4096, buf.data()));
+
+    // unaligned data is not cached
+    cache.Write(kLocation, 512, 4096, data.data());
+    ASSERT_FALSE(cache.Read(kLocation, 512, 4096, buf.data()));
+
+    cache.Write(kLocation, 4096, data.size(), data.data());
+    ASSERT_TRUE(cache.Read(kLocation, 4096 + 2048, 4096, buf.data()));
+    ASSERT_EQ(std::string(2048, 'a') + std::string(2048, 'b'),
+              std::string(buf.data(), buf.size()));
+
+    // partially cached
+    ASSERT_FALSE(cache.Read(kLocation, 0, 4096 + 512, buf.data()));
+    // different sources don't share blocks
+    ASSERT_FALSE(cache.Read("test@cs", 4096, 4096, buf.data()));
+
+    ASSERT_GT(cache.GetMemoryCacheMetrics()->cacheHit.get_value(), 0);
+    ASSERT_GT(cache.GetMemoryCacheMetrics()->cacheMiss.get_value(), 0);
+}
+
+TEST_F(CloneSourceCacheTest, DiskTest) {
+    CloneSourceCacheOptions options;
+    options.enable = true;
+    // blocks are larger than a shard of the memory cache, so they are only
+    // kept on disk
+    options.blockSize = 128 * 1024;
+    options.memoryCapacityMB = 1;
+    options.diskCachePath = kCacheDir;
+    options.diskCapacityMB = 1;
+    CloneSourceCache cache(options, fs_);
+    ASSERT_EQ(0, cache.Init());
+    ASSERT_TRUE(fs_->DirExists(kCacheDir));
+
+    const uint64_t blockSize = options.blockSize;
+    std::vector<char> buf(blockSize);
+    for (uint64_t i = 0; i < 16; ++i) {
+        std::string data(blockSize, 'a' + i);
+        cache.Write(kLocation, i * blockSize, blockSize, data.data());
+    }
+
+    // the disk cache holds at most 8 blocks
+    std::vector<std::string> names;
+    ASSERT_EQ(0, fs_->List(kCacheDir, &names));
+    ASSERT_EQ(8, names.size());
+    ASSERT_FALSE(cache.Read(kLocation, 0, blockSize, buf.data()));
+
+    ASSERT_TRUE(cache.Read(kLocation, 15 * blockSize, blockSize, buf.data()));
+    ASSERT_EQ(std::string(blockSize, 'a' + 15),
+              std::string(buf.data(), buf.size()));
+    ASSERT_GT(cache.GetDiskCacheMetrics()->cacheHit.get_value(), 0);
+
+    // stale blocks are removed when the cache is initialized again
+    CloneSourceCache cache2(options, fs_);
+    ASSERT_EQ(0, cache2.Init());
+    names.clear();
+    ASSERT_EQ(0, fs_->List(kCacheDir, &names));
+    ASSERT_TRUE(names.empty());
+    ASSERT_FALSE(cache2.Read(kLocation, 15 * blockSize, blockSize,
+                             buf.data()));
+}
+
+}  // namespace chunkserver
+}  // namespace curve
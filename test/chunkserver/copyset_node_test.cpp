@@ -31,6 +31,8 @@
 #include <vector>
 #include <string>
 #include <cstdlib>
+#include <thread>
+#include <chrono>
 
 #include "test/fs/mock_local_filesystem.h"
 #include "src/chunkserver/copyset_node_manager.h"
@@ -1078,5 +1080,29 @@ TEST_F(CopysetNodeTest, get_leader_status) {
     }
 }
 
+TEST_F(CopysetNodeTest, wait_applied_index) {
+    LogicPoolID logicPoolID = 1;
+    CopysetID copysetID = 1;
+    Configuration conf;
+    CopysetNode copysetNode(logicPoolID, copysetID, conf);
+    copysetNode.UpdateAppliedIndex(10);
+
+    // applied index已经追上
+    ASSERT_TRUE(copysetNode.WaitAppliedIndex(5, 0));
+    ASSERT_TRUE(copysetNode.WaitAppliedIndex(10, 0));
+    // 未追上且不等待
+    ASSERT_FALSE(copysetNode.WaitAppliedIndex(11, 0));
+    // 等待超时
+    ASSERT_FALSE(copysetNode.WaitAppliedIndex(11, 5));
+
+    // 等待过程中applied index追上
+    std::thread applyThread([&copysetNode]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        copysetNode.UpdateAppliedIndex(12);
+    });
+    ASSERT_TRUE(copysetNode.WaitAppliedIndex(12, 5000));
+    applyThread.join();
+}
+
 }  // namespace chunkserver
 }  // namespace curve
@@ -48,6 +48,7 @@ class MockCopysetNode : public CopysetNode {
     MOCK_CONST_METHOD0(GetConfEpoch, uint64_t());
     MOCK_METHOD1(UpdateAppliedIndex, void(uint64_t));
     MOCK_CONST_METHOD0(GetAppliedIndex, uint64_t());
+    MOCK_CONST_METHOD2(WaitAppliedIndex, bool(uint64_t, uint32_t));
     MOCK_METHOD3(GetConfChange, int(ConfigChangeType*, Configuration*, Peer*));
     MOCK_METHOD1(GetHash, int(std::string*));
     MOCK_METHOD1(GetStatus, void(NodeStatus*));
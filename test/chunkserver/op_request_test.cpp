@@ -27,6 +27,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "proto/chunk.pb.h"
 #include "src/chunkserver/copyset_node.h"
@@ -835,5 +836,83 @@ TEST(ChunkOpRequestTest, OnApplyFromLogTest) {
     }
 }
 
+TEST(ChunkOpRequestTest, WriteBatchTest) {
+    LogicPoolID logicPoolId = 1;
+    CopysetID copysetId = 10001;
+    uint32_t size = 16;
+    uint64_t sn = 1;
+
+    Configuration conf;
+    std::shared_ptr<CopysetNode> nodePtr =
+        std::make_shared<CopysetNode>(logicPoolId, copysetId, conf);
+    std::shared_ptr<LocalFileSystem> fs(LocalFsFactory::CreateFs(FileSystemType::EXT4, ""));    //NOLINT
+    DataStoreOptions options;
+    options.baseDir = "./test-temp";
+    options.chunkSize = 16 * 1024 * 1024;
+    options.pageSize = 4 * 1024;
+    std::shared_ptr<FakeCSDataStore> dataStore =
+        std::make_shared<FakeCSDataStore>(options, fs);
+    nodePtr->SetCSDateStore(dataStore);
+
+    ChunkRequest request;
+    request.set_optype(CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH);
+    request.set_logicpoolid(logicPoolId);
+    request.set_copysetid(copysetId);
+    request.set_chunkid(1);
+    request.set_size(2 * size);
+    for (int i = 0; i < 2; ++i) {
+        ChunkRequest* sub = request.add_subrequests();
+        sub->set_optype(CHUNK_OP_TYPE::CHUNK_OP_WRITE);
+        sub->set_logicpoolid(logicPoolId);
+        sub->set_copysetid(copysetId);
+        sub->set_chunkid(i + 1);
+        sub->set_sn(sn);
+        sub->set_offset(i * size);
+        sub->set_size(size);
+    }
+    butil::IOBuf attachment;
+    attachment.append(std::string(size, 'a'));
+    attachment.append(std::string(size, 'b'));
+
+    // encode and decode as one log entry
+    butil::IOBuf log;
+    ASSERT_EQ(0, ChunkOpRequest::Encode(&request, &attachment, &log));
+    ChunkRequest decoded;
+    butil::IOBuf data;
+    auto req = ChunkOpRequest::Decode(log, &decoded, &data, 0,
+                                      PeerId("127.0.0.1:9010:0"));
+    ASSERT_TRUE(dynamic_cast<BatchWriteChunkRequest*>(req.get()) != nullptr);
+    ASSERT_EQ(CHUNK_OP_TYPE::CHUNK_OP_WRITE_BATCH, decoded.optype());
+    ASSERT_EQ(2, decoded.subrequests_size());
+    ASSERT_EQ(2, decoded.subrequests(1).chunkid());
+    ASSERT_EQ(attachment.to_string(), data.to_string());
+
+    // split
+    std::vector<butil::IOBuf> datas;
+    ASSERT_EQ(0, BatchWriteChunkRequest::Split(decoded, data, &datas));
+    ASSERT_EQ(2, datas.size());
+    ASSERT_EQ(std::string(size, 'a'), datas[0].to_string());
+    ASSERT_EQ(std::string(size, 'b'), datas[1].to_string());
+    ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+              WriteChunkRequest::ApplyWrite(dataStore,
+                                            decoded.subrequests(0),
+                                            datas[0]));
+
+    butil::IOBuf shortData;
+    shortData.append(std::string(size, 'a'));
+    ASSERT_EQ(-1, BatchWriteChunkRequest::Split(decoded, shortData, &datas));
+    butil::IOBuf longData = data;
+    longData.append("c");
+    ASSERT_EQ(-1, BatchWriteChunkRequest::Split(decoded, longData, &datas));
+
+    // apply from log
+    req->OnApplyFromLog(dataStore, decoded, data);
+    char buf[32];
+    ASSERT_EQ(CSErrorCode::Success,
+              dataStore->ReadChunk(2, sn, buf, 0, 2 * size));
+    ASSERT_EQ(std::string(size, 'a') + std::string(size, 'b'),
+              std::string(buf, 2 * size));
+}
+
 }  // namespace chunkserver
 }  // namespace curve
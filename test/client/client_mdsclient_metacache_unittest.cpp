@@ -1093,6 +1093,52 @@ TEST_F(MDSClientTest, GetOrAllocateSegment) {
     delete faktopologyeret;
 }
 
+TEST_F(MDSClientTest, GetOrAllocateSegments) {
+    curve::client::FInfo_t fi;
+    fi.userinfo = userinfo;
+    fi.chunksize = 4 * 1024 * 1024;
+    fi.segmentsize = 1 * 1024 * 1024 * 1024ul;
+
+    curve::mds::GetOrAllocateSegmentResponse response;
+    response.set_statuscode(::curve::mds::StatusCode::kOK);
+    for (int i = 0; i < 3; i++) {
+        curve::mds::PageFileSegment *pfs =
+            i == 0 ? response.mutable_pagefilesegment()
+                   : response.add_followingsegments();
+        pfs->set_logicalpoolid(1234);
+        pfs->set_segmentsize(fi.segmentsize);
+        pfs->set_chunksize(fi.chunksize);
+        pfs->set_startoffset(i * fi.segmentsize);
+        for (int j = 0; j < 4; j++) {
+            auto chunk = pfs->add_chunks();
+            chunk->set_copysetid(j);
+            chunk->set_chunkid(i * 4 + j);
+        }
+    }
+    FakeReturn *fakeret =
+        new FakeReturn(nullptr, static_cast<void *>(&response));
+    curvefsservice.SetGetOrAllocateSegmentFakeReturn(fakeret);
+
+    std::vector<SegmentInfo> segInfos;
+    ASSERT_EQ(LIBCURVE_ERROR::OK,
+              mdsclient_.GetOrAllocateSegments(true, 0, &fi, 3, &segInfos));
+    ASSERT_EQ(3, segInfos.size());
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(i * fi.segmentsize, segInfos[i].startoffset);
+        ASSERT_EQ(1234, segInfos[i].lpcpIDInfo.lpid);
+        ASSERT_EQ(4, segInfos[i].chunkvec.size());
+        ASSERT_EQ(i * 4, segInfos[i].chunkvec[0].cid_);
+    }
+
+    // single segment interface only returns the first one
+    SegmentInfo segInfo;
+    ASSERT_EQ(LIBCURVE_ERROR::OK,
+              mdsclient_.GetOrAllocateSegment(true, 0, &fi, &segInfo));
+    ASSERT_EQ(0, segInfo.startoffset);
+    ASSERT_EQ(4, segInfo.chunkvec.size());
+    delete fakeret;
+}
+
 TEST_F(MDSClientTest, GetServerList) {
     brpc::Server server;
 
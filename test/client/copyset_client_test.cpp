@@ -1664,6 +1664,133 @@ TEST_F(CopysetClientTest, read_error_test) {
     scheduler.Fini();
 }
 
+/**
+ * follower read testing
+ */
+TEST_F(CopysetClientTest, follower_read_test) {
+    MockChunkServiceImpl mockChunkService;
+    ASSERT_EQ(server_->AddService(&mockChunkService,
+                                  brpc::SERVER_DOESNT_OWN_SERVICE), 0);
+    ASSERT_EQ(server_->Start(listenAddr_.c_str(), nullptr), 0);
+
+    IOSenderOption ioSenderOpt;
+    ioSenderOpt.failRequestOpt.chunkserverRPCTimeoutMS = 1000;
+    ioSenderOpt.failRequestOpt.chunkserverOPMaxRetry = 3;
+    ioSenderOpt.failRequestOpt.chunkserverOPRetryIntervalUS = 500;
+    ioSenderOpt.failRequestOpt.chunkserverMaxRPCTimeoutMS = 3500;
+    ioSenderOpt.failRequestOpt.chunkserverMaxRetrySleepIntervalUS = 3500000;
+    ioSenderOpt.chunkserverEnableAppliedIndexRead = 1;
+    ioSenderOpt.chunkserverEnableFollowerRead = true;
+
+    RequestScheduleOption reqopt;
+    reqopt.ioSenderOpt = ioSenderOpt;
+
+    CopysetClient copysetClient;
+    MockMetaCache mockMetaCache;
+    mockMetaCache.DelegateToFake();
+
+    RequestScheduler scheduler;
+    scheduler.Init(reqopt, &mockMetaCache);
+    scheduler.Run();
+
+    copysetClient.Init(&mockMetaCache, ioSenderOpt, &scheduler);
+
+    LogicPoolID logicPoolId = 1;
+    CopysetID copysetId = 100001;
+    ChunkID chunkId = 1;
+    uint64_t sn = 1;
+    size_t len = 8;
+    off_t offset = 0;
+    uint64_t appliedIndex = 5;
+    ChunkRequest readRequest;
+
+    ChunkServerID leaderId = 10000;
+    ChunkServerID followerId = 10001;
+    butil::EndPoint leaderAddr;
+    std::string leaderStr = "127.0.0.1:9109";
+    butil::str2endpoint(leaderStr.c_str(), &leaderAddr);
+
+    // copyset中只有一个follower副本，第一次发送一定会选中它
+    CopysetInfo<ChunkServerID> cpinfo;
+    cpinfo.AddCopysetPeerInfo(CopysetPeerInfo<ChunkServerID>(
+        followerId, PeerAddr(leaderAddr), PeerAddr(leaderAddr)));
+    mockMetaCache.UpdateCopysetInfo(logicPoolId, copysetId, cpinfo);
+
+    FileMetric fm("test");
+    IOTracker iot(nullptr, nullptr, nullptr, &fm);
+    iot.PrepareReadIOBuffers(1);
+
+    /* follower读成功，不需要获取leader */
+    {
+        RequestContext *reqCtx = new FakeRequestContext();
+        reqCtx->optype_ = OpType::READ;
+        reqCtx->idinfo_ = ChunkIDInfo(chunkId, logicPoolId, copysetId);
+
+        reqCtx->subIoIndex_ = 0;
+        reqCtx->offset_ = 0;
+        reqCtx->rawlength_ = len;
+
+        curve::common::CountDownEvent cond(1);
+        RequestClosure *reqDone = new FakeRequestClosure(&cond, reqCtx);
+        reqDone->SetFileMetric(&fm);
+        reqDone->SetIOTracker(&iot);
+
+        reqCtx->done_ = reqDone;
+        ChunkResponse response;
+        response.set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+        EXPECT_CALL(mockMetaCache, GetLeader(_, _, _, _, _, _)).Times(0);
+        EXPECT_CALL(mockChunkService, ReadChunk(_, _, _, _)).Times(1)
+            .WillOnce(DoAll(SaveArgPointee<1>(&readRequest),
+                            SetArgPointee<2>(response),
+                            Invoke(ReadChunkFunc)));
+        copysetClient.ReadChunk(reqCtx->idinfo_, sn,
+                                offset, len, appliedIndex, {}, reqDone);
+        cond.Wait();
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  reqDone->GetErrorCode());
+        ASSERT_TRUE(readRequest.followerread());
+        ASSERT_EQ(appliedIndex, readRequest.appliedindex());
+    }
+    /* follower返回重定向，重试发给leader */
+    {
+        RequestContext *reqCtx = new FakeRequestContext();
+        reqCtx->optype_ = OpType::READ;
+        reqCtx->idinfo_ = ChunkIDInfo(chunkId, logicPoolId, copysetId);
+
+        reqCtx->subIoIndex_ = 0;
+        reqCtx->offset_ = 0;
+        reqCtx->rawlength_ = len;
+
+        curve::common::CountDownEvent cond(1);
+        RequestClosure *reqDone = new FakeRequestClosure(&cond, reqCtx);
+        reqDone->SetFileMetric(&fm);
+        reqDone->SetIOTracker(&iot);
+
+        reqCtx->done_ = reqDone;
+        ChunkResponse response1;
+        response1.set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED);
+        ChunkResponse response2;
+        response2.set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+        EXPECT_CALL(mockMetaCache, GetLeader(_, _, _, _, _, _)).Times(1)
+            .WillOnce(DoAll(SetArgPointee<2>(leaderId),
+                            SetArgPointee<3>(leaderAddr),
+                            Return(0)));
+        EXPECT_CALL(mockChunkService, ReadChunk(_, _, _, _)).Times(2)
+            .WillOnce(DoAll(SetArgPointee<2>(response1),
+                            Invoke(ReadChunkFunc)))
+            .WillOnce(DoAll(SaveArgPointee<1>(&readRequest),
+                            SetArgPointee<2>(response2),
+                            Invoke(ReadChunkFunc)));
+        copysetClient.ReadChunk(reqCtx->idinfo_, sn,
+                                offset, len, appliedIndex, {}, reqDone);
+        cond.Wait();
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  reqDone->GetErrorCode());
+        ASSERT_FALSE(readRequest.followerread());
+    }
+    scheduler.Fini();
+}
+
 /**
  * read snapshot error testing
  */
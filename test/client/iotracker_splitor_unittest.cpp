@@ -555,6 +555,148 @@ TEST_F(IOTrackerSplitorTest, ManagerAsyncStartWrite) {
     ASSERT_EQ('c', writebuffer[aioctx->length - 1]);
 }
 
+TEST_F(IOTrackerSplitorTest, ManagerAsyncStartReadv) {
+    MockRequestScheduler* mockschuler = new MockRequestScheduler;
+    mockschuler->DelegateToFake();
+
+    auto ioctxmana = fileinstance_->GetIOManager4File();
+    ioctxmana->SetRequestScheduler(mockschuler);
+    CurveAioContext* aioctx = new CurveAioContext;
+    aioctx->offset = 4 * 1024 * 1024 - 4 * 1024;
+    aioctx->length = 4 * 1024 * 1024 + 8 * 1024;
+    aioctx->ret = LIBCURVE_ERROR::OK;
+    aioctx->cb = readcallback;
+    aioctx->buf = nullptr;
+    aioctx->op = LIBCURVE_OP::LIBCURVE_OP_READ;
+
+    // buffers don't align with chunk boundary
+    std::unique_ptr<char[]> buf1(new char[2 * 1024]);
+    std::unique_ptr<char[]> buf2(new char[aioctx->length - 4 * 1024]);
+    std::unique_ptr<char[]> buf3(new char[2 * 1024]);
+    struct iovec iov[3];
+    iov[0].iov_base = buf1.get();
+    iov[0].iov_len = 2 * 1024;
+    iov[1].iov_base = buf2.get();
+    iov[1].iov_len = aioctx->length - 4 * 1024;
+    iov[2].iov_base = buf3.get();
+    iov[2].iov_len = 2 * 1024;
+
+    ioreadflag = false;
+    ioctxmana->AioReadv(aioctx, iov, 3, mdsclient_.get());
+
+    {
+        std::unique_lock<std::mutex> lk(readmtx);
+        readcv.wait(lk, []()->bool{return ioreadflag;});
+    }
+    ASSERT_EQ(static_cast<int>(aioctx->length), aioctx->ret);
+    ASSERT_EQ('a', buf1[0]);
+    ASSERT_EQ('a', buf1[2 * 1024 - 1]);
+    ASSERT_EQ('a', buf2[0]);
+    ASSERT_EQ('a', buf2[2 * 1024 - 1]);
+    ASSERT_EQ('b', buf2[2 * 1024]);
+    ASSERT_EQ('e', buf2[2 * 1024 + chunk_size - 1]);
+    ASSERT_EQ('f', buf2[2 * 1024 + chunk_size]);
+    ASSERT_EQ('f', buf3[0]);
+    ASSERT_EQ('f', buf3[2 * 1024 - 1]);
+}
+
+TEST_F(IOTrackerSplitorTest, ManagerAsyncStartWritev) {
+    MockRequestScheduler* mockschuler = new MockRequestScheduler;
+    mockschuler->DelegateToFake();
+
+    auto ioctxmana = fileinstance_->GetIOManager4File();
+    ioctxmana->SetRequestScheduler(mockschuler);
+
+    CurveAioContext* aioctx = new CurveAioContext;
+    aioctx->offset = 4 * 1024 * 1024 - 4 * 1024;
+    aioctx->length = 4 * 1024 * 1024 + 8 * 1024;
+    aioctx->ret = LIBCURVE_ERROR::OK;
+    aioctx->cb = writecallback;
+    aioctx->buf = nullptr;
+    aioctx->op = LIBCURVE_OP::LIBCURVE_OP_WRITE;
+
+    std::unique_ptr<char[]> buf1(new char[4 * 1024]);
+    std::unique_ptr<char[]> buf2(new char[chunk_size]);
+    std::unique_ptr<char[]> buf3(new char[4 * 1024]);
+    memset(buf1.get(), 'a', 4 * 1024);
+    memset(buf2.get(), 'b', chunk_size);
+    memset(buf3.get(), 'c', 4 * 1024);
+    struct iovec iov[4];
+    iov[0].iov_base = buf1.get();
+    iov[0].iov_len = 4 * 1024;
+    iov[1].iov_base = buf2.get();
+    iov[1].iov_len = chunk_size;
+    // empty buffer is skipped
+    iov[2].iov_base = nullptr;
+    iov[2].iov_len = 0;
+    iov[3].iov_base = buf3.get();
+    iov[3].iov_len = 4 * 1024;
+
+    iowriteflag = false;
+    ioctxmana->AioWritev(aioctx, iov, 4, mdsclient_.get());
+
+    {
+        std::unique_lock<std::mutex> lk(writemtx);
+        writecv.wait(lk, []()->bool{return iowriteflag;});
+    }
+
+    ASSERT_EQ(static_cast<int>(aioctx->length), aioctx->ret);
+    std::string writebuffer = writeData.to_string();
+    ASSERT_EQ('a', writebuffer[0]);
+    ASSERT_EQ('a', writebuffer[4 * 1024 - 1]);
+    ASSERT_EQ('b', writebuffer[4 * 1024]);
+    ASSERT_EQ('b', writebuffer[4 * 1024 + chunk_size - 1]);
+    ASSERT_EQ('c', writebuffer[4 * 1024 + chunk_size]);
+    ASSERT_EQ('c', writebuffer[aioctx->length - 1]);
+}
+
+TEST_F(IOTrackerSplitorTest, ManagerAioSubmit) {
+    MockRequestScheduler* mockschuler = new MockRequestScheduler;
+    mockschuler->DelegateToFake();
+
+    auto ioctxmana = fileinstance_->GetIOManager4File();
+    ioctxmana->SetRequestScheduler(mockschuler);
+
+    CurveAioContext writectx;
+    writectx.offset = 4 * 1024 * 1024 - 4 * 1024;
+    writectx.length = 8 * 1024;
+    writectx.ret = LIBCURVE_ERROR::OK;
+    writectx.cb = writecallback;
+    writectx.op = LIBCURVE_OP::LIBCURVE_OP_WRITE;
+    std::unique_ptr<char[]> writebuf(new char[writectx.length]);
+    memset(writebuf.get(), 'a', writectx.length);
+    writectx.buf = writebuf.get();
+
+    CurveAioContext readctx;
+    readctx.offset = 4 * 1024 * 1024 - 4 * 1024;
+    readctx.length = 8 * 1024;
+    readctx.ret = LIBCURVE_ERROR::OK;
+    readctx.cb = readcallback;
+    readctx.op = LIBCURVE_OP::LIBCURVE_OP_READ;
+    std::unique_ptr<char[]> readbuf(new char[readctx.length]);
+    readctx.buf = readbuf.get();
+
+    CurveAioContext* aioctxs[] = {&writectx, &readctx};
+    ioreadflag = false;
+    iowriteflag = false;
+    ASSERT_EQ(2, ioctxmana->AioSubmit(aioctxs, 2, mdsclient_.get(),
+                                      UserDataType::RawBuffer));
+
+    {
+        std::unique_lock<std::mutex> lk(writemtx);
+        writecv.wait(lk, []()->bool{return iowriteflag;});
+    }
+    {
+        std::unique_lock<std::mutex> lk(readmtx);
+        readcv.wait(lk, []()->bool{return ioreadflag;});
+    }
+
+    ASSERT_EQ(static_cast<int>(writectx.length), writectx.ret);
+    ASSERT_EQ(static_cast<int>(readctx.length), readctx.ret);
+    ASSERT_EQ('a', readbuf[0]);
+    ASSERT_EQ('b', readbuf[4 * 1024]);
+}
+
 /*
 TEST_F(IOTrackerSplitorTest, ManagerAsyncStartWriteReadGetSegmentFail) {
     MockRequestScheduler* mockschuler = new MockRequestScheduler;
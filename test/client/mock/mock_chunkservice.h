@@ -28,7 +28,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <atomic>
 #include <set>
+#include <string>
 
 #include "proto/chunk.pb.h"
 #include "src/client/client_common.h"
@@ -53,6 +55,7 @@ class FakeChunkServiceImpl : public ChunkService {
                     google::protobuf::Closure *done) {
         brpc::ClosureGuard doneGuard(done);
 
+        writeNum_.fetch_add(1);
         chunkIds_.insert(request->chunkid());
         brpc::Controller *cntl = dynamic_cast<brpc::Controller *>(controller);
         ::memcpy(chunk_ + request->offset(),
@@ -61,6 +64,27 @@ class FakeChunkServiceImpl : public ChunkService {
         response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
     }
 
+    void WriteChunkBatch(::google::protobuf::RpcController *controller,
+                         const ::curve::chunkserver::ChunkRequest *request,
+                         ::curve::chunkserver::ChunkResponse *response,
+                         google::protobuf::Closure *done) {
+        brpc::ClosureGuard doneGuard(done);
+
+        writeBatchNum_.fetch_add(1);
+        brpc::Controller *cntl = dynamic_cast<brpc::Controller *>(controller);
+        butil::IOBuf data = cntl->request_attachment();
+        for (const auto &sub : request->subrequests()) {
+            chunkIds_.insert(sub.chunkid());
+            butil::IOBuf subData;
+            data.cutn(&subData, sub.size());
+            ::memcpy(chunk_ + sub.offset(), subData.to_string().c_str(),
+                     sub.size());
+            response->add_subresponses()->set_status(
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+        }
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+    }
+
     void ReadChunk(::google::protobuf::RpcController *controller,
                    const ::curve::chunkserver::ChunkRequest *request,
                    ::curve::chunkserver::ChunkResponse *response,
@@ -130,7 +154,21 @@ class FakeChunkServiceImpl : public ChunkService {
         response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
     }
 
+    uint64_t GetWriteNum() const {
+        return writeNum_.load();
+    }
+
+    uint64_t GetWriteBatchNum() const {
+        return writeBatchNum_.load();
+    }
+
+    std::string GetData(off_t offset, size_t length) const {
+        return std::string(chunk_ + offset, length);
+    }
+
  private:
+    std::atomic<uint64_t> writeNum_{0};
+    std::atomic<uint64_t> writeBatchNum_{0};
     std::set<ChunkID> chunkIds_;
     /* 由于 bthread 栈空间的限制，这里不会开很大的空间，如果测试需要更大的空间
      * 请在堆上申请 */
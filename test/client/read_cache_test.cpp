@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "src/client/read_cache.h"
+
+namespace curve {
+namespace client {
+
+namespace {
+
+const uint32_t kBlockSize = 4096;
+
+butil::IOBuf MakeData(char c, size_t length) {
+    butil::IOBuf data;
+    data.append(std::string(length, c));
+    return data;
+}
+
+ReadCacheOption DefaultOption() {
+    ReadCacheOption option;
+    option.enable = true;
+    option.capacityMB = 1;
+    option.blockSize = kBlockSize;
+    return option;
+}
+
+}  // namespace
+
+TEST(ReadCacheTest, TestPutAndGet) {
+    ReadCache cache(DefaultOption(), "read_cache_test_put_get");
+    butil::IOBuf out;
+
+    ASSERT_FALSE(cache.Get(0, kBlockSize, 1, &out));
+
+    // only the two blocks fully covered are cached
+    butil::IOBuf data = MakeData('a', 3 * kBlockSize);
+    cache.Put(kBlockSize / 2, data, 1, cache.GetEpoch());
+    ASSERT_FALSE(cache.Get(0, kBlockSize, 1, &out));
+    ASSERT_FALSE(cache.Get(3 * kBlockSize, kBlockSize, 1, &out));
+
+    ASSERT_TRUE(cache.Get(kBlockSize, 2 * kBlockSize, 1, &out));
+    ASSERT_EQ(std::string(2 * kBlockSize, 'a'), out.to_string());
+
+    // unaligned read inside cached blocks
+    out.clear();
+    ASSERT_TRUE(cache.Get(kBlockSize + 512, kBlockSize, 1, &out));
+    ASSERT_EQ(std::string(kBlockSize, 'a'), out.to_string());
+
+    // partially cached
+    out.clear();
+    ASSERT_FALSE(cache.Get(kBlockSize, 3 * kBlockSize, 1, &out));
+
+    ASSERT_GT(cache.GetCacheMetrics()->cacheHit.get_value(), 0);
+    ASSERT_GT(cache.GetCacheMetrics()->cacheMiss.get_value(), 0);
+}
+
+TEST(ReadCacheTest, TestSequenceChanged) {
+    ReadCache cache(DefaultOption(), "read_cache_test_seq");
+    butil::IOBuf out;
+
+    cache.Put(0, MakeData('a', kBlockSize), 1, cache.GetEpoch());
+    ASSERT_TRUE(cache.Get(0, kBlockSize, 1, &out));
+
+    // the block is dropped after the file sequence changed
+    ASSERT_FALSE(cache.Get(0, kBlockSize, 2, &out));
+    ASSERT_FALSE(cache.Get(0, kBlockSize, 1, &out));
+}
+
+TEST(ReadCacheTest, TestInvalidate) {
+    ReadCache cache(DefaultOption(), "read_cache_test_invalidate");
+    butil::IOBuf out;
+
+    cache.Put(0, MakeData('a', 4 * kBlockSize), 1, cache.GetEpoch());
+    cache.Invalidate(kBlockSize + 512, 512);
+    ASSERT_TRUE(cache.Get(0, kBlockSize, 1, &out));
+    ASSERT_FALSE(cache.Get(kBlockSize, kBlockSize, 1, &out));
+    ASSERT_TRUE(cache.Get(2 * kBlockSize, 2 * kBlockSize, 1, &out));
+
+    // data read before a write is not cached
+    uint64_t epoch = cache.GetEpoch();
+    cache.Invalidate(8 * kBlockSize, kBlockSize);
+    cache.Put(kBlockSize, MakeData('b', kBlockSize), 1, epoch);
+    ASSERT_FALSE(cache.Get(kBlockSize, kBlockSize, 1, &out));
+
+    cache.Put(kBlockSize, MakeData('b', kBlockSize), 1, cache.GetEpoch());
+    out.clear();
+    ASSERT_TRUE(cache.Get(kBlockSize, kBlockSize, 1, &out));
+    ASSERT_EQ(std::string(kBlockSize, 'b'), out.to_string());
+}
+
+TEST(ReadCacheTest, TestCapacity) {
+    ReadCache cache(DefaultOption(), "read_cache_test_capacity");
+    butil::IOBuf out;
+
+    // 1MiB capacity holds at most 256 blocks
+    const uint64_t blocks = 1024;
+    for (uint64_t i = 0; i < blocks; ++i) {
+        cache.Put(i * kBlockSize, MakeData('a', kBlockSize), 1,
+                  cache.GetEpoch());
+    }
+    ASSERT_LE(cache.GetCacheMetrics()->cacheBytes.get_value(),
+              1024 * 1024 + 16 * kBlockSize);
+    ASSERT_TRUE(cache.Get((blocks - 1) * kBlockSize, kBlockSize, 1, &out));
+}
+
+}  // namespace client
+}  // namespace curve
@@ -567,6 +567,74 @@ TEST(RequestSchedulerTest, fake_server_test) {
     ASSERT_EQ(0, server.Join());
 }
 
+TEST(RequestSchedulerTest, write_batch_test) {
+    RequestScheduleOption opt;
+    opt.scheduleQueueCapacity = 4096;
+    opt.scheduleThreadpoolSize = 2;
+    opt.ioSenderOpt.failRequestOpt.chunkserverRPCTimeoutMS = 200;
+    opt.ioSenderOpt.failRequestOpt.chunkserverOPMaxRetry = 5;
+    opt.ioSenderOpt.failRequestOpt.chunkserverOPRetryIntervalUS = 5000;
+    opt.ioSenderOpt.chunkserverEnableAppliedIndexRead = 1;
+    opt.ioSenderOpt.chunkserverWriteBatchMaxNum = 2;
+
+    brpc::Server server;
+    std::string listenAddr = "127.0.0.1:9109";
+    FakeChunkServiceImpl fakeChunkService;
+    ASSERT_EQ(server.AddService(&fakeChunkService,
+                                brpc::SERVER_DOESNT_OWN_SERVICE), 0);
+    brpc::ServerOptions option;
+    option.idle_timeout_sec = -1;
+    ASSERT_EQ(server.Start(listenAddr.c_str(), &option), 0);
+
+    RequestScheduler requestScheduler;
+    MockMetaCache mockMetaCache;
+    mockMetaCache.DelegateToFake();
+    EXPECT_CALL(mockMetaCache, GetLeader(_, _, _, _, _, _)).Times(AnyNumber());
+    FileMetric fm("test");
+    ASSERT_EQ(0, requestScheduler.Init(opt, &mockMetaCache, &fm));
+    ASSERT_EQ(0, requestScheduler.Run());
+
+    IOTracker iot(nullptr, nullptr, nullptr, &fm);
+    const size_t len = 8;
+    const std::string datas[] = {std::string(len, 'a'), std::string(len, 'b'),
+                                 std::string(len, 'c')};
+    curve::common::CountDownEvent cond(3);
+    std::vector<RequestContext *> reqCtxs;
+    for (int i = 0; i < 3; ++i) {
+        RequestContext *reqCtx = new FakeRequestContext();
+        reqCtx->optype_ = OpType::WRITE;
+        reqCtx->idinfo_ = ChunkIDInfo(i + 1, 1, 100001);
+        reqCtx->writeData_.append(datas[i]);
+        reqCtx->offset_ = i * len;
+        reqCtx->rawlength_ = len;
+        reqCtx->subIoIndex_ = i;
+
+        RequestClosure *reqDone = new FakeRequestClosure(&cond, reqCtx);
+        reqDone->SetFileMetric(&fm);
+        reqDone->SetIOTracker(&iot);
+        reqCtx->done_ = reqDone;
+        reqCtxs.push_back(reqCtx);
+    }
+
+    // 前两个请求合并成一个批量写, 第三个请求单独发送
+    ASSERT_EQ(0, requestScheduler.ScheduleRequest(reqCtxs));
+    cond.Wait();
+    for (auto reqCtx : reqCtxs) {
+        ASSERT_EQ(0, reqCtx->done_->GetErrorCode());
+        ASSERT_TRUE(reqCtx->batchRequests_.empty());
+        delete reqCtx->done_;
+        delete reqCtx;
+    }
+    ASSERT_EQ(1, fakeChunkService.GetWriteBatchNum());
+    ASSERT_EQ(1, fakeChunkService.GetWriteNum());
+    ASSERT_EQ(datas[0] + datas[1] + datas[2],
+              fakeChunkService.GetData(0, 3 * len));
+
+    requestScheduler.Fini();
+    ASSERT_EQ(0, server.Stop(0));
+    ASSERT_EQ(0, server.Join());
+}
+
 TEST(RequestSchedulerTest, CommonTest) {
     RequestScheduleOption opt;
     opt.scheduleQueueCapacity = 4096;
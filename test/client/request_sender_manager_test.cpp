@@ -22,7 +22,10 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+
 #include "src/client/request_sender_manager.h"
+#include "src/client/request_sender.h"
 #include "src/client/client_common.h"
 
 namespace curve {
@@ -66,5 +69,75 @@ TEST(RequestSenderManagerTest, fail_test) {
         leaderId, leaderAddr, ioSenderOpt));
 }
 
+TEST(RequestSenderManagerTest, multi_connection_copyset_test) {
+    IOSenderOption ioSenderOpt;
+    ioSenderOpt.chunkserverEnableAppliedIndexRead = 1;
+    ioSenderOpt.chunkserverConnectionNum = 4;
+    ioSenderOpt.chunkserverConnectionSelectPolicy =
+        ConnectionSelectPolicy::CopysetHash;
+
+    RequestSenderManager senderManager;
+    ChunkServerID leaderId = 123456789;
+    butil::EndPoint leaderAddr;
+    butil::str2endpoint("127.0.0.1:9109", &leaderAddr);
+
+    std::set<RequestSender*> senders;
+    for (CopysetID copysetId = 1; copysetId <= 8; ++copysetId) {
+        auto sender = senderManager.GetOrCreateSender(
+            leaderId, leaderAddr, ioSenderOpt, copysetId);
+        ASSERT_NE(nullptr, sender);
+        ASSERT_EQ(copysetId % 4, sender->GetConnectionIndex());
+        senders.insert(sender.get());
+    }
+    ASSERT_EQ(4, senders.size());
+
+    // requests of the same copyset always use the same connection
+    ASSERT_EQ(senderManager.GetOrCreateSender(leaderId, leaderAddr,
+                                              ioSenderOpt, 1),
+              senderManager.GetOrCreateSender(leaderId, leaderAddr,
+                                              ioSenderOpt, 5));
+
+    // resetting an unknown connection does nothing
+    auto sender = senderManager.GetOrCreateSender(leaderId, leaderAddr,
+                                                  ioSenderOpt, 2);
+    senderManager.ResetSenderIfNotHealth(leaderId, 10);
+    senderManager.ResetSenderIfNotHealth(leaderId + 1, 2);
+    ASSERT_EQ(sender, senderManager.GetOrCreateSender(leaderId, leaderAddr,
+                                                      ioSenderOpt, 2));
+}
+
+TEST(RequestSenderManagerTest, multi_connection_inflight_test) {
+    IOSenderOption ioSenderOpt;
+    ioSenderOpt.chunkserverEnableAppliedIndexRead = 1;
+    ioSenderOpt.chunkserverConnectionNum = 3;
+    ioSenderOpt.chunkserverConnectionSelectPolicy =
+        ConnectionSelectPolicy::LeastInflight;
+
+    RequestSenderManager senderManager;
+    ChunkServerID leaderId = 123456789;
+    butil::EndPoint leaderAddr;
+    butil::str2endpoint("127.0.0.1:9109", &leaderAddr);
+
+    // connections are created before existing ones are reused
+    std::set<uint32_t> indexes;
+    for (int i = 0; i < 3; ++i) {
+        auto sender = senderManager.GetOrCreateSender(
+            leaderId, leaderAddr, ioSenderOpt);
+        ASSERT_NE(nullptr, sender);
+        ASSERT_EQ(0, sender->GetInflightNum());
+        indexes.insert(sender->GetConnectionIndex());
+    }
+    ASSERT_EQ(3, indexes.size());
+
+    auto sender = senderManager.GetOrCreateSender(
+        leaderId, leaderAddr, ioSenderOpt);
+    ASSERT_NE(nullptr, sender);
+    ASSERT_EQ(0, sender->GetConnectionIndex());
+
+    // inflight of a chunkserver is the sum of all its connections
+    ASSERT_EQ(0, senderManager.GetInflightNum(leaderId));
+    ASSERT_EQ(0, senderManager.GetInflightNum(leaderId + 1));
+}
+
 }   // namespace client
 }   // namespace curve
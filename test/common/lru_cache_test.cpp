@@ -23,6 +23,11 @@
 #include <gtest/gtest.h>
 #include <glog/logging.h>
 
+#include <chrono>  // NOLINT
+#include <random>
+#include <thread>  // NOLINT
+#include <vector>
+
 #include "src/common/lru_cache.h"
 #include "src/common/timeutility.h"
 
@@ -264,6 +269,156 @@ TEST(SglCaCheTest, TestCacheHitAndMissMetric) {
     ASSERT_EQ(10, cache->GetCacheMetrics()->cacheMiss.get_value());
 }
 
+TEST(ShardedCacheTest, TestPutGetRemove) {
+    auto cache = std::make_shared<ShardedLRUCache<std::string, std::string>>(
+        2, 0, std::make_shared<CacheMetrics>("ShardedLruCache"));
+
+    std::string res;
+    uint64_t cacheSize = 0;
+    for (int i = 1; i <= 100; i++) {
+        cache->Put(std::to_string(i), std::to_string(i));
+        cacheSize += std::to_string(i).size() * 2;
+        ASSERT_TRUE(cache->Get(std::to_string(i), &res));
+        ASSERT_EQ(std::to_string(i), res);
+    }
+    ASSERT_EQ(100, cache->Size());
+    ASSERT_EQ(100, cache->GetCacheMetrics()->cacheCount.get_value());
+    ASSERT_EQ(cacheSize, cache->GetCacheMetrics()->cacheBytes.get_value());
+
+    // put an existing key updates the value in place
+    cache->Put("4", "hello");
+    ASSERT_TRUE(cache->Get("4", &res));
+    ASSERT_EQ("hello", res);
+    ASSERT_EQ(100, cache->Size());
+    cacheSize = cacheSize - 1 + std::string("hello").size();
+    ASSERT_EQ(cacheSize, cache->GetCacheMetrics()->cacheBytes.get_value());
+
+    cache->Remove("not exist");
+    cache->Remove("4");
+    ASSERT_FALSE(cache->Get("4", &res));
+    ASSERT_EQ(99, cache->Size());
+    ASSERT_EQ(99, cache->GetCacheMetrics()->cacheCount.get_value());
+    cacheSize -= 1 + std::string("hello").size();
+    ASSERT_EQ(cacheSize, cache->GetCacheMetrics()->cacheBytes.get_value());
+}
+
+TEST(ShardedCacheTest, TestCountLimitWithSecondChance) {
+    int maxCount = 5;
+    auto cache = std::make_shared<ShardedLRUCache<int, int>>(
+        0, maxCount, std::make_shared<CacheMetrics>("ShardedLruCache"));
+
+    int eliminated;
+    for (int i = 1; i <= maxCount; i++) {
+        ASSERT_FALSE(cache->Put(i, i, &eliminated));
+    }
+
+    // 1 is referenced and gets a second chance, 2 is the oldest one left
+    int res;
+    ASSERT_TRUE(cache->Get(1, &res));
+    ASSERT_TRUE(cache->Put(6, 6, &eliminated));
+    ASSERT_EQ(2, eliminated);
+    ASSERT_TRUE(cache->Get(1, &res));
+    ASSERT_FALSE(cache->Get(2, &res));
+
+    // without hits, it behaves as fifo
+    ASSERT_TRUE(cache->Put(7, 7, &eliminated));
+    ASSERT_EQ(3, eliminated);
+    ASSERT_EQ(maxCount, cache->Size());
+    ASSERT_EQ(maxCount, cache->GetCacheMetrics()->cacheCount.get_value());
+}
+
+TEST(ShardedCacheTest, TestBytesLimit) {
+    auto cache = std::make_shared<ShardedLRUCache<std::string, std::string>>(
+        0, 0, 20, std::make_shared<CacheMetrics>("ShardedLruCache"));
+
+    // each item costs 10 bytes
+    std::string eliminated;
+    ASSERT_FALSE(cache->Put("key01", "value", &eliminated));
+    ASSERT_FALSE(cache->Put("key02", "value", &eliminated));
+    ASSERT_TRUE(cache->Put("key03", "value", &eliminated));
+    ASSERT_EQ(2, cache->Size());
+    ASSERT_EQ(20, cache->GetCacheMetrics()->cacheBytes.get_value());
+
+    // a large item evicts more than one item
+    ASSERT_TRUE(cache->Put("key04", "valuevalue", &eliminated));
+    ASSERT_EQ("value", eliminated);
+    ASSERT_EQ(1, cache->Size());
+    ASSERT_EQ(15, cache->GetCacheMetrics()->cacheBytes.get_value());
+
+    // item larger than capacity is not cached
+    ASSERT_TRUE(cache->Put("key05", std::string(100, 'a'), &eliminated));
+    ASSERT_EQ(0, cache->Size());
+    ASSERT_EQ(0, cache->GetCacheMetrics()->cacheBytes.get_value());
+}
+
+TEST(ShardedCacheTest, TestCacheHitAndMissMetric) {
+    auto cache = std::make_shared<ShardedLRUCache<std::string, std::string>>(
+        4, 0, std::make_shared<CacheMetrics>("ShardedLruCache"));
+
+    std::string existKey = "hello";
+    std::string notExistKey = "world";
+    cache->Put(existKey, existKey);
+
+    std::string out;
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(cache->Get(existKey, &out));
+        ASSERT_FALSE(cache->Get(notExistKey, &out));
+    }
+
+    ASSERT_EQ(10, cache->GetCacheMetrics()->cacheHit.get_value());
+    ASSERT_EQ(10, cache->GetCacheMetrics()->cacheMiss.get_value());
+}
+
+TEST(ShardedCacheTest, MultiThreadBenchmark) {
+    const int kThreads = 16;
+    const int kOpsPerThread = 100000;
+    const uint64_t kKeys = 100000;
+    const uint64_t kMaxCount = kKeys / 2;
+
+    // 90% get, 10% put, keys skewed towards the low end
+    auto run = [&](LRUCacheInterface<uint64_t, uint64_t> *cache) {
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kThreads; ++i) {
+            threads.emplace_back([&, i]() {
+                std::mt19937_64 rng(i);
+                uint64_t value;
+                for (int j = 0; j < kOpsPerThread; ++j) {
+                    uint64_t r = rng();
+                    uint64_t key = (r % kKeys) * (r % kKeys) / kKeys;
+                    if (r % 10 == 0) {
+                        cache->Put(key, key);
+                    } else if (cache->Get(key, &value)) {
+                        ASSERT_EQ(key, value);
+                    }
+                }
+            });
+        }
+        for (auto &t : threads) {
+            t.join();
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    };
+
+    auto lruMetrics = std::make_shared<CacheMetrics>("BenchLruCache");
+    LRUCache<uint64_t, uint64_t> lru(kMaxCount, lruMetrics);
+    auto lruTime = run(&lru);
+
+    auto shardedMetrics = std::make_shared<CacheMetrics>("BenchShardedCache");
+    ShardedLRUCache<uint64_t, uint64_t> sharded(5, kMaxCount, shardedMetrics);
+    auto shardedTime = run(&sharded);
+
+    ASSERT_GE(kMaxCount + (1 << 5), sharded.Size());
+    LOG(INFO) << "threads: " << kThreads
+              << ", ops: " << kThreads * kOpsPerThread
+              << ", lru: " << lruTime << "us, hit "
+              << lruMetrics->cacheHit.get_value()
+              << ", sharded: " << shardedTime << "us, hit "
+              << shardedMetrics->cacheHit.get_value();
+}
+
 }  // namespace common
 }  // namespace curve
 
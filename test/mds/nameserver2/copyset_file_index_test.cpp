@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "src/mds/nameserver2/copyset_file_index.h"
+
+namespace curve {
+namespace mds {
+
+namespace {
+
+PageFileSegment MakeSegment(LogicalPoolID lpid, uint64_t offset,
+                            const std::vector<CopysetID>& copysets) {
+    PageFileSegment segment;
+    segment.set_logicalpoolid(lpid);
+    segment.set_startoffset(offset);
+    uint64_t chunkId = offset;
+    for (auto copysetId : copysets) {
+        auto chunk = segment.add_chunks();
+        chunk->set_copysetid(copysetId);
+        chunk->set_chunkid(++chunkId);
+    }
+    return segment;
+}
+
+common::CopysetInfo MakeCopyset(LogicalPoolID lpid, CopysetID copysetId) {
+    common::CopysetInfo copyset;
+    copyset.set_logicalpoolid(lpid);
+    copyset.set_copysetid(copysetId);
+    return copyset;
+}
+
+}  // namespace
+
+TEST(CopysetFileIndexTest, TestAddAndRemoveSegment) {
+    CopysetFileIndex index;
+    ASSERT_FALSE(index.IsReady());
+
+    auto seg1 = MakeSegment(1, 0, {1, 2, 2});
+    auto seg2 = MakeSegment(1, 100, {2, 3});
+    auto seg3 = MakeSegment(2, 0, {1});
+    index.AddSegment(10, "file1", seg1);
+    index.AddSegment(10, "file1", seg2);
+    index.AddSegment(11, "file2", seg3);
+
+    ASSERT_EQ(1, index.GetChunkNum(1, 1, 10));
+    ASSERT_EQ(3, index.GetChunkNum(1, 2, 10));
+    ASSERT_EQ(1, index.GetChunkNum(1, 3, 10));
+    ASSERT_EQ(0, index.GetChunkNum(1, 1, 11));
+    ASSERT_EQ(1, index.GetChunkNum(2, 1, 11));
+
+    std::vector<std::string> fileNames;
+    index.ListFiles({MakeCopyset(1, 1)}, &fileNames);
+    ASSERT_EQ(std::vector<std::string>{"file1"}, fileNames);
+
+    // copysets with the same id in different logical pools are different
+    fileNames.clear();
+    index.ListFiles({MakeCopyset(1, 1), MakeCopyset(2, 1)}, &fileNames);
+    ASSERT_EQ(2, fileNames.size());
+
+    // a file appears once even if it is on several copysets
+    fileNames.clear();
+    index.ListFiles({MakeCopyset(1, 2), MakeCopyset(1, 3)}, &fileNames);
+    ASSERT_EQ(std::vector<std::string>{"file1"}, fileNames);
+
+    index.RemoveSegment(10, seg1);
+    ASSERT_EQ(0, index.GetChunkNum(1, 1, 10));
+    ASSERT_EQ(1, index.GetChunkNum(1, 2, 10));
+    fileNames.clear();
+    index.ListFiles({MakeCopyset(1, 1)}, &fileNames);
+    ASSERT_TRUE(fileNames.empty());
+
+    // removing an unknown segment does nothing
+    index.RemoveSegment(12, seg1);
+    index.RemoveSegment(10, seg3);
+    ASSERT_EQ(1, index.GetChunkNum(2, 1, 11));
+
+    index.RemoveSegment(10, seg2);
+    fileNames.clear();
+    index.ListFiles({MakeCopyset(1, 2), MakeCopyset(1, 3)}, &fileNames);
+    ASSERT_TRUE(fileNames.empty());
+}
+
+TEST(CopysetFileIndexTest, TestRenameFile) {
+    CopysetFileIndex index;
+    index.AddSegment(10, "file1", MakeSegment(1, 0, {1}));
+
+    index.RenameFile(10, "file1-10-1620453738");
+    // file not indexed
+    index.RenameFile(11, "file2");
+
+    std::vector<std::string> fileNames;
+    index.ListFiles({MakeCopyset(1, 1)}, &fileNames);
+    ASSERT_EQ(std::vector<std::string>{"file1-10-1620453738"}, fileNames);
+}
+
+TEST(CopysetFileIndexTest, TestClear) {
+    CopysetFileIndex index;
+    index.AddSegment(10, "file1", MakeSegment(1, 0, {1}));
+    index.SetReady(true);
+    ASSERT_TRUE(index.IsReady());
+
+    index.Clear();
+    ASSERT_EQ(0, index.GetChunkNum(1, 1, 10));
+    std::vector<std::string> fileNames;
+    index.ListFiles({MakeCopyset(1, 1)}, &fileNames);
+    ASSERT_TRUE(fileNames.empty());
+}
+
+}  // namespace mds
+}  // namespace curve
@@ -1033,6 +1033,36 @@ TEST_F(CurveFSTest, testGetAllocatedSize) {
         std::unordered_map<PoolIdType, uint64_t> expected =
                         {{1, 6 * segmentSize}, {2, 3 * segmentSize}};
     }
+    // test files with allocated size counters, segments are not listed
+    {
+        FileInfo counted = fileInfo;
+        counted.set_allocatedsize(3 * segmentSize);
+        (*counted.mutable_allocatedsizeinpool())[1] = 2 * segmentSize;
+        (*counted.mutable_allocatedsizeinpool())[2] = segmentSize;
+
+        FileInfo dirInfo;
+        dirInfo.set_filetype(FileType::INODE_DIRECTORY);
+        std::vector<FileInfo> files;
+        for (int i = 0; i < 3; ++i) {
+            files.emplace_back(counted);
+        }
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(dirInfo),
+            Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, ListFile(_, _, _))
+        .Times(1)
+        .WillOnce(DoAll(SetArgPointee<2>(files),
+                        Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, ListSegment(_, _))
+        .Times(0);
+        ASSERT_EQ(StatusCode::kOK,
+                    curvefs_->GetAllocatedSize("/tests", &allocSize));
+        ASSERT_EQ(9 * segmentSize, allocSize.total);
+        std::unordered_map<PoolIdType, uint64_t> expected =
+                        {{1, 6 * segmentSize}, {2, 3 * segmentSize}};
+        ASSERT_EQ(expected, allocSize.allocSizeMap);
+    }
     // test GetFile fail
     {
         EXPECT_CALL(*storage_, GetFile(_, _, _))
@@ -2199,6 +2229,8 @@ TEST_F(CurveFSTest, testGetOrAllocateSegment) {
         fileInfo2.set_filetype(FileType::INODE_PAGEFILE);
         fileInfo2.set_length(kMiniFileLength);
         fileInfo2.set_segmentsize(DefaultSegmentSize);
+        fileInfo2.set_allocatedsize(DefaultSegmentSize);
+        (*fileInfo2.mutable_allocatedsizeinpool())[1] = DefaultSegmentSize;
 
         EXPECT_CALL(*storage_, GetFile(_, _, _))
         .Times(2)
@@ -2211,18 +2243,73 @@ TEST_F(CurveFSTest, testGetOrAllocateSegment) {
         .Times(1)
         .WillOnce(Return(StoreStatus::KeyNotExist));
 
-
+        PageFileSegment allocated;
+        allocated.set_logicalpoolid(2);
         EXPECT_CALL(*mockChunkAllocator_, AllocateChunkSegment(_, _, _, _, _))
         .Times(1)
-        .WillOnce(Return(true));
+        .WillOnce(DoAll(SetArgPointee<4>(allocated), Return(true)));
+
+        FileInfo putFileInfo;
+        EXPECT_CALL(*storage_, PutSegmentWithFile(_, _, _, _))
+        .Times(1)
+        .WillOnce(DoAll(SaveArg<0>(&putFileInfo),
+                        Return(StoreStatus::OK)));
 
+        ASSERT_EQ(curvefs_->GetOrAllocateSegment("/user1/file2",
+                  0, true,  &segment), StatusCode::kOK);
+        ASSERT_EQ(2 * DefaultSegmentSize, putFileInfo.allocatedsize());
+        ASSERT_EQ(2, putFileInfo.allocatedsizeinpool().size());
+        ASSERT_EQ(DefaultSegmentSize, putFileInfo.allocatedsizeinpool().at(1));
+        ASSERT_EQ(DefaultSegmentSize, putFileInfo.allocatedsizeinpool().at(2));
+    }
+
+    // allocate segment of file created before allocated size counters
+    {
+        PageFileSegment segment;
+
+        FileInfo fileInfo1;
+        fileInfo1.set_filetype(FileType::INODE_DIRECTORY);
+
+        FileInfo fileInfo2;
+        fileInfo2.set_filetype(FileType::INODE_PAGEFILE);
+        fileInfo2.set_length(kMiniFileLength);
+        fileInfo2.set_segmentsize(DefaultSegmentSize);
 
-        EXPECT_CALL(*storage_, PutSegment(_, _, _, _))
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo1),
+                        Return(StoreStatus::OK)))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo2),
+                        Return(StoreStatus::OK)));
+
+        EXPECT_CALL(*storage_, GetSegment(_, _, _))
         .Times(1)
-        .WillOnce(Return(StoreStatus::OK));
+        .WillOnce(Return(StoreStatus::KeyNotExist));
+
+        std::vector<PageFileSegment> segments(2);
+        segments[0].set_logicalpoolid(1);
+        segments[1].set_logicalpoolid(1);
+        EXPECT_CALL(*storage_, ListSegment(_, _))
+        .WillOnce(DoAll(SetArgPointee<1>(segments),
+                        Return(StoreStatus::OK)));
+
+        PageFileSegment allocated;
+        allocated.set_logicalpoolid(1);
+        EXPECT_CALL(*mockChunkAllocator_, AllocateChunkSegment(_, _, _, _, _))
+        .Times(1)
+        .WillOnce(DoAll(SetArgPointee<4>(allocated), Return(true)));
+
+        FileInfo putFileInfo;
+        EXPECT_CALL(*storage_, PutSegmentWithFile(_, _, _, _))
+        .Times(1)
+        .WillOnce(DoAll(SaveArg<0>(&putFileInfo),
+                        Return(StoreStatus::OK)));
 
         ASSERT_EQ(curvefs_->GetOrAllocateSegment("/user1/file2",
                   0, true,  &segment), StatusCode::kOK);
+        ASSERT_EQ(3 * DefaultSegmentSize, putFileInfo.allocatedsize());
+        ASSERT_EQ(3 * DefaultSegmentSize,
+                  putFileInfo.allocatedsizeinpool().at(1));
     }
 
     // file is a directory
@@ -2303,6 +2390,7 @@ TEST_F(CurveFSTest, testGetOrAllocateSegment) {
         fileInfo2.set_filetype(FileType::INODE_PAGEFILE);
         fileInfo2.set_length(kMiniFileLength);
         fileInfo2.set_segmentsize(DefaultSegmentSize);
+        fileInfo2.set_allocatedsize(0);
 
         EXPECT_CALL(*storage_, GetFile(_, _, _))
         .Times(2)
@@ -2335,6 +2423,7 @@ TEST_F(CurveFSTest, testGetOrAllocateSegment) {
         fileInfo2.set_filetype(FileType::INODE_PAGEFILE);
         fileInfo2.set_length(kMiniFileLength);
         fileInfo2.set_segmentsize(DefaultSegmentSize);
+        fileInfo2.set_allocatedsize(0);
 
         EXPECT_CALL(*storage_, GetFile(_, _, _))
         .Times(2)
@@ -2353,7 +2442,7 @@ TEST_F(CurveFSTest, testGetOrAllocateSegment) {
         .WillOnce(Return(true));
 
 
-        EXPECT_CALL(*storage_, PutSegment(_, _, _, _))
+        EXPECT_CALL(*storage_, PutSegmentWithFile(_, _, _, _))
         .Times(1)
         .WillOnce(Return(StoreStatus::InternalError));
 
@@ -2362,6 +2451,179 @@ TEST_F(CurveFSTest, testGetOrAllocateSegment) {
     }
 }
 
+TEST_F(CurveFSTest, testGetOrAllocateSegments) {
+    FileInfo dirInfo;
+    dirInfo.set_filetype(FileType::INODE_DIRECTORY);
+
+    FileInfo fileInfo;
+    fileInfo.set_id(10);
+    fileInfo.set_filetype(FileType::INODE_PAGEFILE);
+    fileInfo.set_length(3 * DefaultSegmentSize);
+    fileInfo.set_segmentsize(DefaultSegmentSize);
+    fileInfo.set_chunksize(curvefs_->GetDefaultChunkSize());
+    fileInfo.set_allocatedsize(DefaultSegmentSize);
+    (*fileInfo.mutable_allocatedsizeinpool())[1] = DefaultSegmentSize;
+
+    PageFileSegment existSegment;
+    existSegment.set_logicalpoolid(1);
+    existSegment.set_startoffset(0);
+    existSegment.set_segmentsize(DefaultSegmentSize);
+
+    PageFileSegment newSegment;
+    newSegment.set_logicalpoolid(2);
+    newSegment.set_segmentsize(DefaultSegmentSize);
+
+    // the first segment exists, the rest are allocated in one transaction,
+    // the segment num is truncated by the file length
+    {
+        std::vector<PageFileSegment> segments;
+        FileInfo putFileInfo;
+        std::vector<PageFileSegment> putSegments;
+
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<2>(dirInfo),
+                        Return(StoreStatus::OK)))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
+                        Return(StoreStatus::OK)));
+
+        EXPECT_CALL(*storage_, GetSegment(_, _, _))
+        .Times(3)
+        .WillOnce(DoAll(SetArgPointee<2>(existSegment),
+                        Return(StoreStatus::OK)))
+        .WillRepeatedly(Return(StoreStatus::KeyNotExist));
+
+        EXPECT_CALL(*mockChunkAllocator_, AllocateChunkSegment(_, _, _, _, _))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgPointee<4>(newSegment), Return(true)));
+
+        EXPECT_CALL(*storage_, PutSegmentWithFile(_, _, _, _))
+        .Times(0);
+        EXPECT_CALL(*storage_, PutSegmentsWithFile(_, _, _))
+        .WillOnce(DoAll(SaveArg<0>(&putFileInfo),
+                        SaveArg<1>(&putSegments),
+                        Return(StoreStatus::OK)));
+
+        ASSERT_EQ(curvefs_->GetOrAllocateSegments("/user1/file2",
+                  0, 16, &segments), StatusCode::kOK);
+        ASSERT_EQ(3, segments.size());
+        ASSERT_EQ(1, segments[0].logicalpoolid());
+        ASSERT_EQ(2, segments[1].logicalpoolid());
+        ASSERT_EQ(2, segments[2].logicalpoolid());
+        ASSERT_EQ(2, putSegments.size());
+        ASSERT_EQ(3 * DefaultSegmentSize, putFileInfo.allocatedsize());
+        ASSERT_EQ(DefaultSegmentSize,
+                  putFileInfo.allocatedsizeinpool().at(1));
+        ASSERT_EQ(2 * DefaultSegmentSize,
+                  putFileInfo.allocatedsizeinpool().at(2));
+    }
+
+    // all segments exist, nothing is written
+    {
+        std::vector<PageFileSegment> segments;
+
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<2>(dirInfo),
+                        Return(StoreStatus::OK)))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
+                        Return(StoreStatus::OK)));
+
+        EXPECT_CALL(*storage_, GetSegment(_, _, _))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(existSegment),
+                              Return(StoreStatus::OK)));
+
+        EXPECT_CALL(*storage_, PutSegmentsWithFile(_, _, _))
+        .Times(0);
+
+        ASSERT_EQ(curvefs_->GetOrAllocateSegments("/user1/file2",
+                  DefaultSegmentSize, 2, &segments), StatusCode::kOK);
+        ASSERT_EQ(2, segments.size());
+    }
+
+    // allocating a later segment fails, return what was allocated
+    {
+        std::vector<PageFileSegment> segments;
+        std::vector<PageFileSegment> putSegments;
+
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<2>(dirInfo),
+                        Return(StoreStatus::OK)))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
+                        Return(StoreStatus::OK)));
+
+        EXPECT_CALL(*storage_, GetSegment(_, _, _))
+        .Times(2)
+        .WillRepeatedly(Return(StoreStatus::KeyNotExist));
+
+        EXPECT_CALL(*mockChunkAllocator_, AllocateChunkSegment(_, _, _, _, _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<4>(newSegment), Return(true)))
+        .WillOnce(Return(false));
+
+        EXPECT_CALL(*storage_, PutSegmentsWithFile(_, _, _))
+        .WillOnce(DoAll(SaveArg<1>(&putSegments),
+                        Return(StoreStatus::OK)));
+
+        ASSERT_EQ(curvefs_->GetOrAllocateSegments("/user1/file2",
+                  0, 3, &segments), StatusCode::kOK);
+        ASSERT_EQ(1, segments.size());
+        ASSERT_EQ(1, putSegments.size());
+    }
+
+    // allocating the first segment fails
+    {
+        std::vector<PageFileSegment> segments;
+
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<2>(dirInfo),
+                        Return(StoreStatus::OK)))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
+                        Return(StoreStatus::OK)));
+
+        EXPECT_CALL(*storage_, GetSegment(_, _, _))
+        .WillOnce(Return(StoreStatus::KeyNotExist));
+
+        EXPECT_CALL(*mockChunkAllocator_, AllocateChunkSegment(_, _, _, _, _))
+        .WillOnce(Return(false));
+
+        ASSERT_EQ(curvefs_->GetOrAllocateSegments("/user1/file2",
+                  0, 3, &segments), StatusCode::kSegmentAllocateError);
+        ASSERT_TRUE(segments.empty());
+    }
+
+    // put segments fail
+    {
+        std::vector<PageFileSegment> segments;
+
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<2>(dirInfo),
+                        Return(StoreStatus::OK)))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
+                        Return(StoreStatus::OK)));
+
+        EXPECT_CALL(*storage_, GetSegment(_, _, _))
+        .Times(2)
+        .WillRepeatedly(Return(StoreStatus::KeyNotExist));
+
+        EXPECT_CALL(*mockChunkAllocator_, AllocateChunkSegment(_, _, _, _, _))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgPointee<4>(newSegment), Return(true)));
+
+        EXPECT_CALL(*storage_, PutSegmentsWithFile(_, _, _))
+        .WillOnce(Return(StoreStatus::InternalError));
+
+        ASSERT_EQ(curvefs_->GetOrAllocateSegments("/user1/file2",
+                  DefaultSegmentSize, 2, &segments),
+                  StatusCode::kStorageError);
+        ASSERT_TRUE(segments.empty());
+    }
+}
+
 TEST_F(CurveFSTest, TestDeAllocateSegment) {
     const std::string filename = "/TestDeAllocateSegment";
     const uint64_t offset = 1ull * 1024 * 1024 * 1024;
@@ -2537,6 +2799,10 @@ TEST_F(CurveFSTest, TestDeAllocateSegment) {
         EXPECT_CALL(*storage_, ListSnapshotFile(_, _, _))
             .WillOnce(DoAll(SetArgPointee<2>(snapshotFiles),
                             Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, ListSegment(_, _))
+            .WillOnce(DoAll(SetArgPointee<1>(std::vector<PageFileSegment>{
+                                segment}),
+                            Return(StoreStatus::OK)));
         EXPECT_CALL(*storage_, DiscardSegment(_, _))
             .WillOnce(Return(StoreStatus::InternalError));
 
@@ -2551,9 +2817,12 @@ TEST_F(CurveFSTest, TestDeAllocateSegment) {
         fileInfo.set_length(kMiniFileLength);
         fileInfo.set_segmentsize(DefaultSegmentSize);
         fileInfo.set_filestatus(FileStatus::kFileCreated);
+        fileInfo.set_allocatedsize(2 * DefaultSegmentSize);
+        (*fileInfo.mutable_allocatedsizeinpool())[1] = 2 * DefaultSegmentSize;
 
         PageFileSegment segment;
         segment.set_startoffset(offset);
+        segment.set_logicalpoolid(1);
 
         std::vector<FileInfo> snapshotFiles;
 
@@ -2566,11 +2835,16 @@ TEST_F(CurveFSTest, TestDeAllocateSegment) {
         EXPECT_CALL(*storage_, ListSnapshotFile(_, _, _))
             .WillOnce(DoAll(SetArgPointee<2>(snapshotFiles),
                             Return(StoreStatus::OK)));
+        FileInfo discardFileInfo;
         EXPECT_CALL(*storage_, DiscardSegment(_, _))
-            .WillOnce(Return(StoreStatus::OK));
+            .WillOnce(DoAll(SaveArg<0>(&discardFileInfo),
+                            Return(StoreStatus::OK)));
 
         ASSERT_EQ(StatusCode::kOK,
                   curvefs_->DeAllocateSegment(filename, offset));
+        ASSERT_EQ(DefaultSegmentSize, discardFileInfo.allocatedsize());
+        ASSERT_EQ(DefaultSegmentSize,
+                  discardFileInfo.allocatedsizeinpool().at(1));
     }
 }
 
@@ -4403,6 +4677,119 @@ TEST_F(CurveFSTest, ListAllVolumesOnCopyset) {
     }
 }
 
+TEST_F(CurveFSTest, ListVolumesOnCopysetWithIndex) {
+    auto copysetFileIndex = std::make_shared<CopysetFileIndex>();
+    FileInfo recycleBin;
+    recycleBin.set_parentid(ROOTINODEID);
+    recycleBin.set_id(RECYCLEBININODEID);
+    recycleBin.set_filename(RECYCLEBINDIRNAME);
+    recycleBin.set_filetype(FileType::INODE_DIRECTORY);
+    recycleBin.set_owner(authOptions_.rootOwner);
+    EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(recycleBin),
+                        Return(StoreStatus::OK)));
+    ASSERT_TRUE(curvefs_->Init(storage_, inodeIdGenerator_,
+                               mockChunkAllocator_, mockcleanManager_,
+                               fileRecordManager_, allocStatistic_,
+                               curveFSOptions_, topology_, snapshotClient_,
+                               copysetFileIndex));
+
+    FileInfo file1;
+    file1.set_id(10);
+    file1.set_filetype(FileType::INODE_PAGEFILE);
+    file1.set_filename("file1");
+    FileInfo file2;
+    file2.set_id(11);
+    file2.set_filetype(FileType::INODE_PAGEFILE);
+    file2.set_filename("file2");
+    std::vector<FileInfo> fileVec = {file1, file2};
+
+    PageFileSegment segment1;
+    segment1.set_logicalpoolid(1);
+    segment1.set_startoffset(0);
+    auto chunk = segment1.add_chunks();
+    chunk->set_copysetid(100);
+    chunk->set_chunkid(200);
+    PageFileSegment segment2 = segment1;
+    segment2.mutable_chunks(0)->set_copysetid(101);
+    std::vector<PageFileSegment> segVec1 = {segment1};
+    std::vector<PageFileSegment> segVec2 = {segment2};
+
+    common::CopysetInfo copyset;
+    copyset.set_logicalpoolid(1);
+    copyset.set_copysetid(100);
+    std::vector<common::CopysetInfo> copysetVec = {copyset};
+
+    // build index fail, fall back to scanning
+    {
+        EXPECT_CALL(*storage_, ListFile(_, _, _))
+            .WillOnce(DoAll(SetArgPointee<2>(fileVec),
+                            Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, ListSegment(_, _))
+            .WillOnce(Return(StoreStatus::InternalError));
+        ASSERT_EQ(StatusCode::kStorageError,
+                  curvefs_->BuildCopysetFileIndex());
+        ASSERT_FALSE(copysetFileIndex->IsReady());
+    }
+
+    // build index success
+    {
+        EXPECT_CALL(*storage_, ListFile(_, _, _))
+            .WillOnce(DoAll(SetArgPointee<2>(fileVec),
+                            Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, ListSegment(_, _))
+            .Times(2)
+            .WillOnce(DoAll(SetArgPointee<1>(segVec1),
+                            Return(StoreStatus::OK)))
+            .WillOnce(DoAll(SetArgPointee<1>(segVec2),
+                            Return(StoreStatus::OK)));
+        ASSERT_EQ(StatusCode::kOK, curvefs_->BuildCopysetFileIndex());
+        ASSERT_TRUE(copysetFileIndex->IsReady());
+    }
+
+    // query from index, no storage access
+    {
+        std::vector<std::string> fileNames;
+        EXPECT_CALL(*storage_, ListFile(_, _, _)).Times(0);
+        EXPECT_CALL(*storage_, ListSegment(_, _)).Times(0);
+        ASSERT_EQ(StatusCode::kOK,
+                  curvefs_->ListVolumesOnCopyset(copysetVec, &fileNames));
+        ASSERT_EQ(1, fileNames.size());
+        ASSERT_EQ("file1", fileNames[0]);
+    }
+
+    // deallocate segment removes the file from index
+    {
+        FileInfo dirInfo;
+        dirInfo.set_filetype(FileType::INODE_DIRECTORY);
+        FileInfo fileInfo = file1;
+        fileInfo.set_length(kMiniFileLength);
+        fileInfo.set_segmentsize(DefaultSegmentSize);
+        fileInfo.set_allocatedsize(DefaultSegmentSize);
+        (*fileInfo.mutable_allocatedsizeinpool())[1] = DefaultSegmentSize;
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+            .Times(2)
+            .WillOnce(DoAll(SetArgPointee<2>(dirInfo),
+                            Return(StoreStatus::OK)))
+            .WillOnce(DoAll(SetArgPointee<2>(fileInfo),
+                            Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, GetSegment(_, _, _))
+            .WillOnce(DoAll(SetArgPointee<2>(segment1),
+                            Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, ListSnapshotFile(_, _, _))
+            .WillOnce(Return(StoreStatus::OK));
+        EXPECT_CALL(*storage_, DiscardSegment(_, _))
+            .WillOnce(Return(StoreStatus::OK));
+        ASSERT_EQ(StatusCode::kOK,
+                  curvefs_->DeAllocateSegment("/user1/file1", 0));
+
+        std::vector<std::string> fileNames;
+        ASSERT_EQ(StatusCode::kOK,
+                  curvefs_->ListVolumesOnCopyset(copysetVec, &fileNames));
+        ASSERT_TRUE(fileNames.empty());
+    }
+}
+
 TEST_F(CurveFSTest, TestUpdateFileThrottleParams) {
     // GetFileInfo failed
     {
@@ -377,6 +377,38 @@ class FakeNameServerStorage : public NameServerStorage {
         return StoreStatus::OK;
     }
 
+    StoreStatus PutSegmentWithFile(const FileInfo &fileInfo,
+                                   uint64_t off,
+                                   const PageFileSegment *segment,
+                                   int64_t *revision) override {
+        std::lock_guard<std::mutex> guard(lock_);
+        std::string fileKey = NameSpaceStorageCodec::EncodeFileStoreKey(
+            fileInfo.parentid(), fileInfo.filename());
+        std::string segmentKey =
+            NameSpaceStorageCodec::EncodeSegmentStoreKey(fileInfo.id(), off);
+
+        memKvMap_[fileKey] = fileInfo.SerializeAsString();
+        memKvMap_[segmentKey] = segment->SerializeAsString();
+        return StoreStatus::OK;
+    }
+
+    StoreStatus PutSegmentsWithFile(
+        const FileInfo &fileInfo,
+        const std::vector<PageFileSegment> &segments,
+        int64_t *revision) override {
+        std::lock_guard<std::mutex> guard(lock_);
+        std::string fileKey = NameSpaceStorageCodec::EncodeFileStoreKey(
+            fileInfo.parentid(), fileInfo.filename());
+        for (const auto &segment : segments) {
+            std::string segmentKey =
+                NameSpaceStorageCodec::EncodeSegmentStoreKey(
+                    fileInfo.id(), segment.startoffset());
+            memKvMap_[segmentKey] = segment.SerializeAsString();
+        }
+        memKvMap_[fileKey] = fileInfo.SerializeAsString();
+        return StoreStatus::OK;
+    }
+
     StoreStatus DeleteSegment(
         InodeID id, uint64_t off, int64_t *revision) override {
         std::lock_guard<std::mutex> guard(lock_);
@@ -458,6 +490,9 @@ class FakeNameServerStorage : public NameServerStorage {
 
         memKvMap_.erase(segmentKey);
         memKvMap_.emplace(cleanSegmentKey, encodeDiscardSegment);
+        memKvMap_[NameSpaceStorageCodec::EncodeFileStoreKey(
+            fileInfo.parentid(), fileInfo.filename())] =
+            fileInfo.SerializeAsString();
 
         return StoreStatus::OK;
     }
@@ -77,6 +77,15 @@ class MockNameServerStorage : public NameServerStorage {
                                          const PageFileSegment *,
                                          int64_t *));
 
+    MOCK_METHOD4(PutSegmentWithFile, StoreStatus(const FileInfo &,
+                                                 uint64_t,
+                                                 const PageFileSegment *,
+                                                 int64_t *));
+
+    MOCK_METHOD3(PutSegmentsWithFile, StoreStatus(const FileInfo &,
+                                    const std::vector<PageFileSegment> &,
+                                    int64_t *));
+
     MOCK_METHOD3(DeleteSegment, StoreStatus(InodeID, uint64_t, int64_t*));
 
     MOCK_METHOD2(SnapShotFile, StoreStatus(const FileInfo *,
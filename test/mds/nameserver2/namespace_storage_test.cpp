@@ -34,7 +34,10 @@ using ::testing::Return;
 using ::testing::AtLeast;
 using ::testing::SetArgPointee;
 using ::testing::DoAll;
+using ::testing::Invoke;
 using ::testing::Matcher;
+using ::testing::SaveArg;
+using ::curve::kvstorage::kMaxTxnOps;
 
 namespace curve {
 namespace mds {
@@ -199,6 +202,96 @@ TEST_F(TestNameServerStorageImp, test_GetFile) {
     ASSERT_EQ(fileinfo.parentid(), getInfo.parentid());
 }
 
+TEST_F(TestNameServerStorageImp, test_GetFileWithFileInfoCache) {
+    auto fileInfoCache = std::make_shared<
+        ::curve::common::LRUCache<std::string, std::shared_ptr<FileInfo>>>(
+        100);
+    storage_ = std::make_shared<NameServerStorageImp>(client_, cache_,
+                                                      fileInfoCache);
+
+    FileInfo fileinfo;
+    GetFileInfoForTest(&fileinfo);
+    std::string encodeFileinfo;
+    ASSERT_TRUE(NameSpaceStorageCodec::EncodeFileInfo(fileinfo,
+                                                      &encodeFileinfo));
+
+    // 1. first lookup decodes the value and fills the file info cache
+    FileInfo getInfo;
+    EXPECT_CALL(*cache_, Get(_, _)).WillOnce(Return(false));
+    EXPECT_CALL(*cache_, Put(_, _)).Times(1);
+    EXPECT_CALL(*cache_, Remove(_)).Times(0);
+    EXPECT_CALL(*client_, Get(_, _))
+        .WillOnce(DoAll(SetArgPointee<1>(encodeFileinfo),
+                        Return(EtcdErrCode::EtcdOK)));
+    ASSERT_EQ(StoreStatus::OK, storage_->GetFile(fileinfo.parentid(),
+                                                 fileinfo.filename(),
+                                                 &getInfo));
+    ASSERT_EQ(fileinfo.id(), getInfo.id());
+
+    // 2. second lookup hits the file info cache
+    FileInfo getInfo2;
+    EXPECT_CALL(*cache_, Get(_, _)).Times(0);
+    EXPECT_CALL(*client_, Get(_, _)).Times(0);
+    ASSERT_EQ(StoreStatus::OK, storage_->GetFile(fileinfo.parentid(),
+                                                 fileinfo.filename(),
+                                                 &getInfo2));
+    ASSERT_EQ(fileinfo.SerializeAsString(), getInfo2.SerializeAsString());
+
+    // 3. put file invalidates the file info cache
+    fileinfo.set_length(20 << 20);
+    ASSERT_TRUE(NameSpaceStorageCodec::EncodeFileInfo(fileinfo,
+                                                      &encodeFileinfo));
+    EXPECT_CALL(*client_, Put(_, _)).WillOnce(Return(EtcdErrCode::EtcdOK));
+    EXPECT_CALL(*cache_, Put(_, _)).Times(1);
+    ASSERT_EQ(StoreStatus::OK, storage_->PutFile(fileinfo));
+
+    EXPECT_CALL(*cache_, Get(_, _))
+        .WillOnce(DoAll(SetArgPointee<1>(encodeFileinfo), Return(true)));
+    ASSERT_EQ(StoreStatus::OK, storage_->GetFile(fileinfo.parentid(),
+                                                 fileinfo.filename(),
+                                                 &getInfo));
+    ASSERT_EQ(20 << 20, getInfo.length());
+
+    // 4. delete file invalidates the file info cache
+    EXPECT_CALL(*cache_, Remove(_)).Times(1);
+    EXPECT_CALL(*client_, Delete(_)).WillOnce(Return(EtcdErrCode::EtcdOK));
+    ASSERT_EQ(StoreStatus::OK, storage_->DeleteFile(fileinfo.parentid(),
+                                                    fileinfo.filename()));
+
+    EXPECT_CALL(*cache_, Get(_, _)).WillOnce(Return(false));
+    EXPECT_CALL(*client_, Get(_, _))
+        .WillOnce(Return(EtcdErrCode::EtcdKeyNotExist));
+    ASSERT_EQ(StoreStatus::KeyNotExist,
+              storage_->GetFile(fileinfo.parentid(), fileinfo.filename(),
+                                &getInfo));
+
+    // 5. file is updated after its old value is read by a lookup, the old
+    //    value decoded by the lookup is not left in the file info cache
+    std::string oldEncodeFileinfo = encodeFileinfo;
+    FileInfo newFileinfo = fileinfo;
+    newFileinfo.set_length(30 << 20);
+    std::string newEncodeFileinfo;
+    ASSERT_TRUE(NameSpaceStorageCodec::EncodeFileInfo(newFileinfo,
+                                                      &newEncodeFileinfo));
+    EXPECT_CALL(*client_, Put(_, _)).WillOnce(Return(EtcdErrCode::EtcdOK));
+    EXPECT_CALL(*cache_, Put(_, _)).Times(1);
+    EXPECT_CALL(*cache_, Get(_, _))
+        .WillOnce(Invoke([&](const std::string&, std::string* value) {
+            *value = oldEncodeFileinfo;
+            EXPECT_EQ(StoreStatus::OK, storage_->PutFile(newFileinfo));
+            return true;
+        }))
+        .WillOnce(DoAll(SetArgPointee<1>(newEncodeFileinfo), Return(true)));
+    ASSERT_EQ(StoreStatus::OK, storage_->GetFile(fileinfo.parentid(),
+                                                 fileinfo.filename(),
+                                                 &getInfo));
+    ASSERT_EQ(20 << 20, getInfo.length());
+    ASSERT_EQ(StoreStatus::OK, storage_->GetFile(fileinfo.parentid(),
+                                                 fileinfo.filename(),
+                                                 &getInfo));
+    ASSERT_EQ(30 << 20, getInfo.length());
+}
+
 TEST_F(TestNameServerStorageImp, test_DeleteFile) {
     EXPECT_CALL(*client_, Delete(_))
         .WillOnce(Return(EtcdErrCode::EtcdOK))
@@ -460,17 +553,121 @@ TEST_F(TestNameServerStorageImp, test_DiscardSegment) {
     {
         EXPECT_CALL(*client_, TxnN(_))
             .WillOnce(Return(EtcdErrCode::EtcdTxnUnkownOp));
+        EXPECT_CALL(*cache_, Remove(_)).Times(1);
 
         ASSERT_EQ(StoreStatus::InternalError,
                   storage_->DiscardSegment(fileInfo, segment));
     }
 
+    // ok, segment and file info are updated in one transaction
+    {
+        std::vector<Operation> ops;
+        EXPECT_CALL(*client_, TxnN(_))
+            .WillOnce(DoAll(SaveArg<0>(&ops), Return(EtcdErrCode::EtcdOK)));
+        EXPECT_CALL(*cache_, Remove(_)).Times(2);
+        EXPECT_CALL(*cache_, Put(_, _)).Times(1);
+
+        ASSERT_EQ(StoreStatus::OK, storage_->DiscardSegment(fileInfo, segment));
+        ASSERT_EQ(3, ops.size());
+    }
+}
+
+TEST_F(TestNameServerStorageImp, test_PutSegmentWithFile) {
+    FileInfo fileInfo;
+    fileInfo.set_id(1);
+    fileInfo.set_parentid(0);
+    fileInfo.set_filename("test_PutSegmentWithFile");
+    fileInfo.set_filetype(FileType::INODE_PAGEFILE);
+    fileInfo.set_allocatedsize(1024 * 1024 * 1024);
+
+    PageFileSegment segment;
+    segment.set_segmentsize(1024 * 1024 * 1024);
+    segment.set_chunksize(16 * 1024 * 1024);
+    segment.set_startoffset(0);
+    segment.set_logicalpoolid(1);
+
+    // transaction failed
+    {
+        EXPECT_CALL(*client_, TxnNWithRevision(_, _))
+            .WillOnce(Return(EtcdErrCode::EtcdCanceled));
+        EXPECT_CALL(*cache_, Remove(_)).Times(1);
+        int64_t revision;
+        ASSERT_EQ(StoreStatus::InternalError,
+                  storage_->PutSegmentWithFile(fileInfo, 0, &segment,
+                                               &revision));
+    }
+
     // ok
     {
-        EXPECT_CALL(*client_, TxnN(_)).WillOnce(Return(EtcdErrCode::EtcdOK));
+        std::vector<Operation> ops;
+        EXPECT_CALL(*client_, TxnNWithRevision(_, _))
+            .WillOnce(DoAll(SaveArg<0>(&ops), SetArgPointee<1>(100),
+                            Return(EtcdErrCode::EtcdOK)));
         EXPECT_CALL(*cache_, Remove(_)).Times(1);
+        EXPECT_CALL(*cache_, Put(_, _)).Times(2);
+        int64_t revision;
+        ASSERT_EQ(StoreStatus::OK,
+                  storage_->PutSegmentWithFile(fileInfo, 0, &segment,
+                                               &revision));
+        ASSERT_EQ(100, revision);
+        ASSERT_EQ(2, ops.size());
+    }
+}
 
-        ASSERT_EQ(StoreStatus::OK, storage_->DiscardSegment(fileInfo, segment));
+TEST_F(TestNameServerStorageImp, test_PutSegmentsWithFile) {
+    FileInfo fileInfo;
+    fileInfo.set_id(1);
+    fileInfo.set_parentid(0);
+    fileInfo.set_filename("test_PutSegmentsWithFile");
+    fileInfo.set_filetype(FileType::INODE_PAGEFILE);
+    fileInfo.set_allocatedsize(2ULL * 1024 * 1024 * 1024);
+
+    std::vector<PageFileSegment> segments(2);
+    for (size_t i = 0; i < segments.size(); ++i) {
+        segments[i].set_segmentsize(1024 * 1024 * 1024);
+        segments[i].set_chunksize(16 * 1024 * 1024);
+        segments[i].set_startoffset(i * 1024 * 1024 * 1024);
+        segments[i].set_logicalpoolid(1);
+    }
+
+    // invalid segment number
+    {
+        int64_t revision;
+        EXPECT_CALL(*client_, TxnNWithRevision(_, _)).Times(0);
+        ASSERT_EQ(StoreStatus::InternalError,
+                  storage_->PutSegmentsWithFile(
+                      fileInfo, std::vector<PageFileSegment>(), &revision));
+        ASSERT_EQ(StoreStatus::InternalError,
+                  storage_->PutSegmentsWithFile(
+                      fileInfo, std::vector<PageFileSegment>(kMaxTxnOps),
+                      &revision));
+    }
+
+    // transaction failed
+    {
+        EXPECT_CALL(*client_, TxnNWithRevision(_, _))
+            .WillOnce(Return(EtcdErrCode::EtcdCanceled));
+        EXPECT_CALL(*cache_, Remove(_)).Times(1);
+        int64_t revision;
+        ASSERT_EQ(StoreStatus::InternalError,
+                  storage_->PutSegmentsWithFile(fileInfo, segments,
+                                                &revision));
+    }
+
+    // ok
+    {
+        std::vector<Operation> ops;
+        EXPECT_CALL(*client_, TxnNWithRevision(_, _))
+            .WillOnce(DoAll(SaveArg<0>(&ops), SetArgPointee<1>(100),
+                            Return(EtcdErrCode::EtcdOK)));
+        EXPECT_CALL(*cache_, Remove(_)).Times(1);
+        EXPECT_CALL(*cache_, Put(_, _)).Times(3);
+        int64_t revision;
+        ASSERT_EQ(StoreStatus::OK,
+                  storage_->PutSegmentsWithFile(fileInfo, segments,
+                                                &revision));
+        ASSERT_EQ(100, revision);
+        ASSERT_EQ(3, ops.size());
     }
 }
 
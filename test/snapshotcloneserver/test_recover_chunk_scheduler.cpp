@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2022 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2022-10-18
+ * Author: curve
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "src/snapshotcloneserver/clone/recover_chunk_scheduler.h"
+
+namespace curve {
+namespace snapshotcloneserver {
+
+TEST(TestRecoverChunkScheduler, TestCopysetConcurrency) {
+    RecoverChunkScheduler scheduler(8, 2, 0);
+    ChunkIDInfo chunk1(1, 1, 1);
+    ChunkIDInfo chunk2(2, 1, 2);
+
+    scheduler.Acquire(chunk1);
+    scheduler.Acquire(chunk1);
+    // other copysets are not blocked
+    scheduler.Acquire(chunk2);
+    ASSERT_EQ(3, scheduler.GetInflightNum());
+
+    std::atomic<bool> acquired(false);
+    std::thread t([&] {
+        scheduler.Acquire(chunk1);
+        acquired = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_FALSE(acquired);
+
+    scheduler.Release(chunk1, 1000, true);
+    t.join();
+    ASSERT_TRUE(acquired);
+    ASSERT_EQ(3, scheduler.GetInflightNum());
+
+    scheduler.Release(chunk1, 1000, true);
+    scheduler.Release(chunk1, 1000, true);
+    scheduler.Release(chunk2, 1000, true);
+    ASSERT_EQ(0, scheduler.GetInflightNum());
+}
+
+TEST(TestRecoverChunkScheduler, TestGlobalConcurrency) {
+    RecoverChunkScheduler scheduler(2, 2, 0);
+    ChunkIDInfo chunk1(1, 1, 1);
+    ChunkIDInfo chunk2(2, 1, 2);
+    ChunkIDInfo chunk3(3, 1, 3);
+
+    scheduler.Acquire(chunk1);
+    scheduler.Acquire(chunk2);
+
+    std::atomic<bool> acquired(false);
+    std::thread t([&] {
+        scheduler.Acquire(chunk3);
+        acquired = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_FALSE(acquired);
+
+    scheduler.Release(chunk2, 1000, true);
+    t.join();
+    ASSERT_TRUE(acquired);
+
+    scheduler.Release(chunk1, 1000, true);
+    scheduler.Release(chunk3, 1000, true);
+    ASSERT_EQ(0, scheduler.GetInflightNum());
+}
+
+TEST(TestRecoverChunkScheduler, TestLatencyWindow) {
+    RecoverChunkScheduler scheduler(64, 4, 10);
+    ChunkIDInfo chunk1(1, 1, 1);
+    ChunkIDInfo chunk2(2, 1, 2);
+    ASSERT_EQ(4, scheduler.GetCopysetWindow(chunk1));
+
+    // slow responses shrink the window down to 1
+    for (int i = 0; i < 8; ++i) {
+        scheduler.Acquire(chunk1);
+        scheduler.Release(chunk1, 100 * 1000, true);
+    }
+    ASSERT_EQ(1, scheduler.GetCopysetWindow(chunk1));
+    // other copysets are not affected
+    ASSERT_EQ(4, scheduler.GetCopysetWindow(chunk2));
+
+    // fast responses grow the window back after the average latency drops
+    for (int i = 0; i < 100; ++i) {
+        scheduler.Acquire(chunk1);
+        scheduler.Release(chunk1, 1000, true);
+    }
+    ASSERT_EQ(4, scheduler.GetCopysetWindow(chunk1));
+
+    // failed responses shrink the window too
+    scheduler.Acquire(chunk1);
+    scheduler.Release(chunk1, 1000, false);
+    ASSERT_EQ(3, scheduler.GetCopysetWindow(chunk1));
+}
+
+}  // namespace snapshotcloneserver
+}  // namespace curve
@@ -93,6 +93,7 @@ import (
 	"strings"
 	"sync"
 	"time"
+	"unsafe"
 )
 
 const (
@@ -103,6 +104,7 @@ const (
 	EtcdDelete     = "Delete"
 	EtcdTxn2       = "Txn2"
 	EtcdTxn3       = "Txn3"
+	EtcdTxnN       = "TxnN"
 	EtcdCmpAndSwp  = "CmpAndSwp"
 	EtcdNewMutex   = "NewMutex"
 	EtcdNewSession = "NewSession"
@@ -360,38 +362,65 @@ func EtcdClientDeleteRewithRevision(
 
 //export EtcdClientTxn2
 func EtcdClientTxn2(
-	timeout C.int, op1, op2 C.struct_Operation) C.enum_EtcdErrCode {
+	timeout C.int, op1, op2 C.struct_Operation) (C.enum_EtcdErrCode, int64) {
 	ops := []C.struct_Operation{op1, op2}
 	etcdOps, err := GenOpList(ops)
 	if err != nil {
 		log.Printf("unknown op types, err: %v", err)
-		return C.EtcdTxnUnkownOp
+		return C.EtcdTxnUnkownOp, 0
 	}
 
 	ctx, cancel := context.WithTimeout(context.Background(),
 		time.Duration(int(timeout))*time.Millisecond)
 	defer cancel()
 
-	_, err = globalClient.Txn(ctx).Then(etcdOps...).Commit()
-	return GetErrCode(EtcdTxn2, err)
+	resp, err := globalClient.Txn(ctx).Then(etcdOps...).Commit()
+	if err == nil {
+		return GetErrCode(EtcdTxn2, err), resp.Header.Revision
+	}
+	return GetErrCode(EtcdTxn2, err), 0
 }
 
 //export EtcdClientTxn3
 func EtcdClientTxn3(
-	timeout C.int, op1, op2, op3 C.struct_Operation) C.enum_EtcdErrCode {
+	timeout C.int, op1, op2, op3 C.struct_Operation) (C.enum_EtcdErrCode, int64) {
 	ops := []C.struct_Operation{op1, op2, op3}
 	etcdOps, err := GenOpList(ops)
 	if err != nil {
 		log.Printf("unknown op types, err: %v", err)
-		return C.EtcdTxnUnkownOp
+		return C.EtcdTxnUnkownOp, 0
+	}
+
+	ctx, cancel := context.WithTimeout(context.Background(),
+		time.Duration(int(timeout))*time.Millisecond)
+	defer cancel()
+
+	resp, err := globalClient.Txn(ctx).Then(etcdOps...).Commit()
+	if err == nil {
+		return GetErrCode(EtcdTxn3, err), resp.Header.Revision
+	}
+	return GetErrCode(EtcdTxn3, err), 0
+}
+
+//export EtcdClientTxnN
+func EtcdClientTxnN(
+	timeout C.int, ops *C.struct_Operation, num C.int) (C.enum_EtcdErrCode, int64) {
+	cops := (*[1 << 16]C.struct_Operation)(unsafe.Pointer(ops))[:num:num]
+	etcdOps, err := GenOpList(cops)
+	if err != nil {
+		log.Printf("unknown op types, err: %v", err)
+		return C.EtcdTxnUnkownOp, 0
 	}
 
 	ctx, cancel := context.WithTimeout(context.Background(),
 		time.Duration(int(timeout))*time.Millisecond)
 	defer cancel()
 
-	_, err = globalClient.Txn(ctx).Then(etcdOps...).Commit()
-	return GetErrCode(EtcdTxn3, err)
+	resp, err := globalClient.Txn(ctx).Then(etcdOps...).Commit()
+	if err == nil {
+		return GetErrCode(EtcdTxnN, err), resp.Header.Revision
+	}
+	return GetErrCode(EtcdTxnN, err), 0
 }
 
 //export EtcdClientCompareAndSwap